@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace Yiso::Bench
+{
+    using Clock = std::chrono::steady_clock;
+    using Args = std::vector<std::string>; // 모드 이름 뒤의 인자
+
+    // 위치 인자 (없거나 비어 있으면 기본값)
+    inline uint64_t ArgU64(const Args& args, size_t index, uint64_t fallback)
+    {
+        return index < args.size() && !args[index].empty() ? std::strtoull(args[index].c_str(), nullptr, 10) : fallback;
+    }
+
+    inline double SecondsSince(Clock::time_point begin)
+    {
+        return std::chrono::duration<double>(Clock::now() - begin).count();
+    }
+
+    // 모드별 진입점 (0 = 성공)
+    int RunFilter(const Args& args);
+    int RunDojo(const Args& args);
+    int RunEnemy(const Args& args);
+    int RunQueue(const Args& args);
+    int RunSessions(const Args& args);
+}
@@ -0,0 +1,106 @@
+#include "Bench.h"
+#include "Dojo/DojoManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+// 무한 도장 틱 스케줄러 (user-033)
+// - 인스턴스를 전부 입장시킨 뒤 seconds 동안 틱을 돌림 (서버와 같은 워커 수: 하드웨어 스레드 - 1)
+// - 그동안 로직 스레드 역할로 이동 / 퇴장+재입장을 섞어 호출 -> 틱 중에도 Enter / Exit가 막히지 않는지 지연 측정
+// - 인스턴스 틱 CPU / 예산 초과 / 건너뛴 틱 / 기상 지터는 DojoManager::Stats 그대로
+
+namespace Yiso::Bench
+{
+    namespace
+    {
+        using Game::DojoManager;
+
+        constexpr uint32_t SEED = 33;
+        constexpr auto CHURN_INTERVAL = std::chrono::microseconds(200); // 로직 스레드 호출 간격
+
+        struct Latency
+        {
+            std::vector<uint64_t> samples_ns;
+
+            void Add(Clock::time_point begin) { samples_ns.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count())); }
+
+            void Print(const char* name)
+            {
+                if (samples_ns.empty()) return;
+                std::sort(samples_ns.begin(), samples_ns.end());
+                uint64_t sum = 0;
+                for (uint64_t ns : samples_ns)
+                    sum += ns;
+                std::printf("[Bench] dojo %-5s calls=%zu avg=%.2fus p99=%.2fus max=%.2fus\n", name, samples_ns.size(),
+                    static_cast<double>(sum) / samples_ns.size() / 1000.0,
+                    static_cast<double>(samples_ns[samples_ns.size() * 99 / 100]) / 1000.0,
+                    static_cast<double>(samples_ns.back()) / 1000.0);
+            }
+        };
+    }
+
+    int RunDojo(const Args& args)
+    {
+        size_t defaultWorkers = std::max<size_t>(std::max(1u, std::thread::hardware_concurrency()) - 1, 1);
+        size_t instances = static_cast<size_t>(ArgU64(args, 0, 10000));
+        size_t workers = static_cast<size_t>(ArgU64(args, 1, defaultWorkers));
+        double seconds = static_cast<double>(ArgU64(args, 2, 5));
+        if (instances == 0 || workers == 0)
+        {
+            std::fprintf(stderr, "[Bench] instances / workers는 1 이상\n");
+            return 1;
+        }
+
+        DojoManager dojo(instances, workers);
+        dojo.Start();
+        for (uint32_t id = 1; id <= instances; ++id)
+            dojo.Enter(id, 0.0f, 0.0f);
+
+        std::mt19937_64 rng(SEED);
+        std::uniform_real_distribution<float> coord(-20.0f, 20.0f);
+        Latency enter, exit, move;
+        uint64_t enterFailed = 0;
+        auto begin = Clock::now();
+        while (SecondsSince(begin) < seconds)
+        {
+            uint32_t id = 1 + static_cast<uint32_t>(rng() % instances);
+            auto call = Clock::now();
+            if (rng() % 10 == 0)
+            {
+                // 풀이 가득 차 있어도 워커가 반납하기 전의 퇴장 슬롯을 이어 받음 -> enter_failed는 0이어야 함
+                dojo.Exit(id);
+                exit.Add(call);
+                call = Clock::now();
+                enterFailed += !dojo.Enter(id, coord(rng), coord(rng));
+                enter.Add(call);
+            }
+            else
+            {
+                dojo.Move(id, coord(rng), coord(rng));
+                move.Add(call);
+            }
+            std::this_thread::sleep_for(CHURN_INTERVAL);
+        }
+
+        auto stats = dojo.GetStats();
+        dojo.Stop();
+
+        std::printf("[Bench] dojo instances=%zu workers=%zu seconds=%.0f active=%zu enter_failed=%llu\n", instances, workers, seconds, stats.active,
+            static_cast<unsigned long long>(enterFailed));
+        std::printf("[Bench] dojo ticks=%llu instance_ticks=%llu cpu/instance tick=%.0fns cpu/worker tick=%.3fms overruns=%llu skipped=%llu jitter avg=%lluus max=%lluus\n",
+            static_cast<unsigned long long>(stats.ticks),
+            static_cast<unsigned long long>(stats.instance_ticks),
+            stats.instance_ticks > 0 ? static_cast<double>(stats.instance_cpu_ns) / stats.instance_ticks : 0.0,
+            stats.ticks > 0 ? static_cast<double>(stats.instance_cpu_ns) / stats.ticks / 1e6 : 0.0,
+            static_cast<unsigned long long>(stats.budget_overruns),
+            static_cast<unsigned long long>(stats.skipped_ticks),
+            static_cast<unsigned long long>(stats.jitter_avg_us),
+            static_cast<unsigned long long>(stats.jitter_max_us));
+        enter.Print("enter");
+        exit.Print("exit");
+        move.Print("move");
+        return 0;
+    }
+}
@@ -0,0 +1,237 @@
+#include "Bench.h"
+#include "Enemy/EnemyWorld.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 적 틱 SoA vs AoS (user-034)
+// - EnemyWorld::Update와 적 하나당 구조체 배열을 도는 단순 루프 (빈 / 죽은 적은 건너뜀)를 같은 입력으로 비교
+// - 크기는 커밋 메시지와 같음: 대상 4 / 적 4096, 대상 4 / 적 100k, 대상 1 / 적 4096 -> 라운드마다 가장 빠른 값 (M updates/s)
+// - 적은 모두 스포너 소속 (respawn delay > 0), 매 틱 일부에 Damage -> 죽음 / 리스폰 타이머 / 부활 경로까지 같이 돎
+//   (Damage 호출도 양쪽 시간에 포함, 끝나고 살아 있는 수 / 부활 수가 다르면 경고)
+// - 대상은 맵 가운데를 원을 그리며 돌아서 어그로 / 추적 / 복귀가 섞임
+
+namespace Yiso::Bench
+{
+    namespace
+    {
+        using Game::EnemyWorld;
+
+        constexpr uint32_t SEED = 34;
+        constexpr float DT = 0.05f; // 20Hz
+        constexpr float WORLD_SIZE = 64.0f;
+        constexpr float MAX_HP = 100.0f;
+        constexpr float HIT = 40.0f; // 3번 맞으면 죽음
+        constexpr float RESPAWN_DELAY = 0.5f;
+        constexpr uint32_t SPAWNER_ID = 1;
+        constexpr uint32_t ENEMY_ID = 1;
+        constexpr uint32_t HITS_PER_1000 = 10; // 틱마다 적 1000마리당 맞는 수
+
+        struct Case
+        {
+            uint32_t targets;
+            uint32_t enemies;
+        };
+
+        constexpr Case CASES[] = { { 4, 4096 }, { 4, 100'000 }, { 1, 4096 } };
+
+        // EnemyWorld 이전 방식: 적 하나 = 구조체 하나
+        struct AosEnemy
+        {
+            float x, y;
+            float home_x, home_y;
+            float hp, max_hp;
+            float respawn_delay, respawn_timer;
+            uint32_t state;
+            uint32_t spawner_id;
+            uint32_t enemy_id;
+        };
+
+        // 모두 스포너 소속이라 죽으면 리스폰 대기만 (슬롯 반환 없음)
+        bool AosDamage(AosEnemy& e, float amount)
+        {
+            if (e.state < EnemyWorld::STATE_IDLE) return false;
+            e.hp -= amount;
+            if (e.hp > 0.0f) return false;
+            e.state = EnemyWorld::STATE_DEAD;
+            e.respawn_timer = e.respawn_delay;
+            return true;
+        }
+
+        void AosUpdate(std::vector<AosEnemy>& enemies, float dt, const float* targetX, const float* targetY, uint32_t targetCount)
+        {
+            constexpr float aggroSq = EnemyWorld::AGGRO_RANGE * EnemyWorld::AGGRO_RANGE;
+            const float maxStep = EnemyWorld::MOVE_SPEED * dt;
+            for (auto& e : enemies)
+            {
+                if (e.state == EnemyWorld::STATE_DEAD)
+                {
+                    e.respawn_timer -= dt;
+                    if (e.respawn_timer <= 0.0f)
+                    {
+                        e.hp = e.max_hp;
+                        e.x = e.home_x;
+                        e.y = e.home_y;
+                        e.state = EnemyWorld::STATE_IDLE;
+                    }
+                    continue;
+                }
+                if (e.state < EnemyWorld::STATE_IDLE) continue;
+
+                float best = aggroSq;
+                float goalX = e.home_x;
+                float goalY = e.home_y;
+                for (uint32_t t = 0; t < targetCount; ++t)
+                {
+                    const float dx = targetX[t] - e.x;
+                    const float dy = targetY[t] - e.y;
+                    const float d2 = dx * dx + dy * dy;
+                    if (d2 < best)
+                    {
+                        best = d2;
+                        goalX = targetX[t];
+                        goalY = targetY[t];
+                    }
+                }
+                e.state = best < aggroSq ? EnemyWorld::STATE_CHASE : EnemyWorld::STATE_IDLE;
+
+                const float dx = goalX - e.x;
+                const float dy = goalY - e.y;
+                const float len = std::sqrt(dx * dx + dy * dy);
+                if (len <= 1e-4f) continue;
+                const float scale = std::min(maxStep, len) / len;
+                e.x += dx * scale;
+                e.y += dy * scale;
+            }
+        }
+
+        // 양쪽이 같은 순서로 쓰는 입력 (스폰 위치 / 틱별 대상 위치 / 틱별 맞는 적)
+        struct Scenario
+        {
+            std::vector<float> home_x, home_y;
+            std::vector<float> target_x, target_y; // [tick * targets + t]
+            std::vector<uint32_t> hits; // [tick * hitsPerTick + h]
+            uint32_t targets = 0;
+            uint32_t ticks = 0;
+            uint32_t hits_per_tick = 0;
+        };
+
+        Scenario MakeScenario(const Case& c, uint32_t ticks)
+        {
+            std::mt19937_64 rng(SEED);
+            std::uniform_real_distribution<float> coord(0.0f, WORLD_SIZE);
+            Scenario s;
+            s.targets = c.targets;
+            s.ticks = ticks;
+            s.hits_per_tick = std::max<uint32_t>(1, c.enemies / 1000 * HITS_PER_1000);
+            for (uint32_t i = 0; i < c.enemies; ++i)
+            {
+                s.home_x.push_back(coord(rng));
+                s.home_y.push_back(coord(rng));
+            }
+            for (uint32_t tick = 0; tick < ticks; ++tick)
+            {
+                for (uint32_t t = 0; t < c.targets; ++t)
+                {
+                    float angle = 0.05f * static_cast<float>(tick) + 6.2831853f * static_cast<float>(t) / static_cast<float>(c.targets);
+                    float radius = WORLD_SIZE * (0.15f + 0.1f * static_cast<float>(t));
+                    s.target_x.push_back(WORLD_SIZE * 0.5f + radius * std::cos(angle));
+                    s.target_y.push_back(WORLD_SIZE * 0.5f + radius * std::sin(angle));
+                }
+                for (uint32_t h = 0; h < s.hits_per_tick; ++h)
+                    s.hits.push_back(static_cast<uint32_t>(rng() % c.enemies));
+            }
+            return s;
+        }
+
+        struct Result
+        {
+            double seconds;
+            uint32_t alive;
+            uint64_t revived;
+        };
+
+        Result RunSoa(const Scenario& s)
+        {
+            auto enemies = static_cast<uint32_t>(s.home_x.size());
+            EnemyWorld world(enemies);
+            for (uint32_t i = 0; i < enemies; ++i)
+                world.Spawn(ENEMY_ID, SPAWNER_ID, s.home_x[i], s.home_y[i], MAX_HP, RESPAWN_DELAY);
+
+            uint64_t killed = 0;
+            auto begin = Clock::now();
+            for (uint32_t tick = 0; tick < s.ticks; ++tick)
+            {
+                for (uint32_t h = 0; h < s.hits_per_tick; ++h)
+                    killed += world.Damage(s.hits[tick * s.hits_per_tick + h], HIT) ? 1 : 0;
+                world.Update(DT, &s.target_x[tick * s.targets], &s.target_y[tick * s.targets], s.targets);
+            }
+            double seconds = SecondsSince(begin);
+
+            uint32_t alive = world.AliveCount();
+            return { seconds, alive, killed - (enemies - alive) };
+        }
+
+        Result RunAos(const Scenario& s)
+        {
+            auto count = static_cast<uint32_t>(s.home_x.size());
+            std::vector<AosEnemy> enemies(count);
+            for (uint32_t i = 0; i < count; ++i)
+                enemies[i] = { s.home_x[i], s.home_y[i], s.home_x[i], s.home_y[i], MAX_HP, MAX_HP, RESPAWN_DELAY, 0.0f, EnemyWorld::STATE_IDLE, SPAWNER_ID, ENEMY_ID };
+
+            uint64_t killed = 0;
+            auto begin = Clock::now();
+            for (uint32_t tick = 0; tick < s.ticks; ++tick)
+            {
+                for (uint32_t h = 0; h < s.hits_per_tick; ++h)
+                    killed += AosDamage(enemies[s.hits[tick * s.hits_per_tick + h]], HIT) ? 1 : 0;
+                AosUpdate(enemies, DT, &s.target_x[tick * s.targets], &s.target_y[tick * s.targets], s.targets);
+            }
+            double seconds = SecondsSince(begin);
+
+            uint32_t alive = 0;
+            for (const auto& e : enemies)
+                alive += e.state >= EnemyWorld::STATE_IDLE ? 1 : 0;
+            return { seconds, alive, killed - (count - alive) };
+        }
+    }
+
+    int RunEnemy(const Args& args)
+    {
+        uint64_t rounds = ArgU64(args, 0, 7);
+        uint64_t updates = ArgU64(args, 1, 20'000'000); // 라운드마다 적 업데이트 수 (틱 수 = updates / 적 수)
+        if (rounds == 0 || updates == 0)
+        {
+            std::fprintf(stderr, "[Bench] rounds / updates는 1 이상\n");
+            return 1;
+        }
+
+        std::printf("[Bench] enemy rounds=%llu updates/round=%llu respawn_delay=%.1fs hits/tick=%u per 1000\n",
+            static_cast<unsigned long long>(rounds), static_cast<unsigned long long>(updates), RESPAWN_DELAY, HITS_PER_1000);
+        for (const auto& c : CASES)
+        {
+            auto ticks = static_cast<uint32_t>(std::max<uint64_t>(1, updates / c.enemies));
+            Scenario scenario = MakeScenario(c, ticks);
+
+            Result soa{}, aos{};
+            double soaBest = 0.0, aosBest = 0.0;
+            for (uint64_t r = 0; r < rounds; ++r)
+            {
+                soa = RunSoa(scenario);
+                aos = RunAos(scenario);
+                soaBest = r == 0 ? soa.seconds : std::min(soaBest, soa.seconds);
+                aosBest = r == 0 ? aos.seconds : std::min(aosBest, aos.seconds);
+            }
+
+            double total = static_cast<double>(c.enemies) * ticks;
+            std::printf("[Bench] enemy targets=%u enemies=%u ticks=%u soa=%.0f M aos=%.0f M updates/s (%.2fx) alive=%u revived=%llu\n",
+                c.targets, c.enemies, ticks, total / soaBest / 1e6, total / aosBest / 1e6, aosBest / soaBest,
+                soa.alive, static_cast<unsigned long long>(soa.revived));
+            if (soa.alive != aos.alive || soa.revived != aos.revived)
+                std::fprintf(stderr, "[Bench] enemy 결과 불일치: aos alive=%u revived=%llu\n", aos.alive, static_cast<unsigned long long>(aos.revived));
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,150 @@
+#include "Bench.h"
+#include "Chat/ChatFilter.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// 금칙어 필터 처리량 (user-027)
+// - 금칙어: 영문 소문자 4~8글자 / 한글 음절 2~4글자 반반 (더 짧으면 무작위 본문 대부분이 걸려 가리기만 재게 됨)
+// - 메시지: 20~120바이트, 데이터셋마다 ASCII만 / 한글만 / 섞임 (한글 메시지는 SSE2 경로의 멀티바이트 검증을 탐)
+// - 메시지 일부에는 금칙어를 끼워 넣어 가리기까지 포함
+// - Apply (검증 + 접기 + 스캔 + 가리기)와 FoldAndValidateUtf8만 따로 잼, 원본을 복사해 두고 매번 되돌려 같은 입력으로
+
+namespace Yiso::Bench
+{
+    namespace
+    {
+        using Game::ChatFilter;
+
+        constexpr uint32_t SEED = 27;
+        constexpr uint64_t MATCH_PERCENT = 10; // 금칙어가 들어간 메시지 비율
+
+        void AppendHangul(std::string& out, std::mt19937_64& rng)
+        {
+            uint32_t cp = 0xAC00 + static_cast<uint32_t>(rng() % (0xD7A3 - 0xAC00 + 1));
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+
+        void AppendAscii(std::string& out, std::mt19937_64& rng)
+        {
+            static constexpr char CHARS[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,!?";
+            out += CHARS[rng() % (sizeof(CHARS) - 1)];
+        }
+
+        std::vector<std::string> MakeWords(size_t count, std::mt19937_64& rng)
+        {
+            std::vector<std::string> words(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t letters = i % 2 == 0 ? 4 + rng() % 5 : 2 + rng() % 3;
+                for (size_t j = 0; j < letters; ++j)
+                {
+                    if (i % 2 == 0)
+                        words[i] += static_cast<char>('a' + rng() % 26);
+                    else
+                        AppendHangul(words[i], rng);
+                }
+            }
+            return words;
+        }
+
+        // hangulPercent: 글자마다 한글일 확률
+        std::vector<std::string> MakeMessages(size_t count, uint64_t hangulPercent, const std::vector<std::string>& words, std::mt19937_64& rng)
+        {
+            std::vector<std::string> messages(count);
+            for (auto& message : messages)
+            {
+                size_t target = 20 + rng() % 101;
+                bool withWord = rng() % 100 < MATCH_PERCENT;
+                while (message.size() < target)
+                {
+                    if (withWord && message.size() >= target / 2)
+                    {
+                        size_t word = rng() % words.size(); // 짝수 = 영문, 홀수 = 한글
+                        if (hangulPercent == 0) word &= ~size_t(1);
+                        else if (hangulPercent == 100 && words.size() > 1) word = (word | 1) % words.size();
+                        message += words[word];
+                        withWord = false;
+                    }
+                    else if (rng() % 100 < hangulPercent)
+                        AppendHangul(message, rng);
+                    else
+                        AppendAscii(message, rng);
+                }
+            }
+            return messages;
+        }
+
+        void Measure(const char* name, const ChatFilter& filter, const std::vector<std::string>& messages, double seconds)
+        {
+            size_t bytes = 0;
+            for (const auto& message : messages)
+                bytes += message.size();
+            std::vector<std::string> work = messages;
+            std::vector<uint8_t> folded(256);
+
+            uint64_t passes = 0;
+            uint64_t masked = 0;
+            auto begin = Clock::now();
+            while (SecondsSince(begin) < seconds)
+            {
+                for (size_t i = 0; i < work.size(); ++i)
+                {
+                    work[i].assign(messages[i]); // 가린 결과를 되돌림 (길이 같음 -> 재할당 없음)
+                    masked += filter.Apply(work[i].data(), work[i].size()).masked;
+                }
+                ++passes;
+            }
+            double applySec = SecondsSince(begin);
+
+            uint64_t foldPasses = 0;
+            uint64_t valid = 0;
+            begin = Clock::now();
+            while (SecondsSince(begin) < seconds)
+            {
+                for (const auto& message : messages)
+                {
+                    if (folded.size() < message.size()) folded.resize(message.size());
+                    valid += ChatFilter::FoldAndValidateUtf8(reinterpret_cast<const uint8_t*>(message.data()), folded.data(), message.size());
+                }
+                ++foldPasses;
+            }
+            double foldSec = SecondsSince(begin);
+
+            std::printf("[Bench] filter %-7s bytes/pass=%zu apply=%.3f GB/s (%.2f M msg/s, masked/pass=%llu) fold+validate=%.3f GB/s (valid=%llu)\n",
+                name, bytes,
+                static_cast<double>(bytes * passes) / applySec / 1e9,
+                static_cast<double>(messages.size() * passes) / applySec / 1e6,
+                static_cast<unsigned long long>(passes > 0 ? masked / passes : 0),
+                static_cast<double>(bytes * foldPasses) / foldSec / 1e9,
+                static_cast<unsigned long long>(foldPasses > 0 ? valid / foldPasses : 0));
+        }
+    }
+
+    int RunFilter(const Args& args)
+    {
+        size_t wordCount = static_cast<size_t>(ArgU64(args, 0, 2000));
+        size_t messageCount = static_cast<size_t>(ArgU64(args, 1, 20000));
+        double seconds = static_cast<double>(ArgU64(args, 2, 2));
+        if (wordCount == 0 || messageCount == 0)
+        {
+            std::fprintf(stderr, "[Bench] words / messages는 1 이상\n");
+            return 1;
+        }
+
+        std::mt19937_64 rng(SEED);
+        auto words = MakeWords(wordCount, rng);
+        ChatFilter filter;
+        auto compileBegin = Clock::now();
+        filter.SetWords(words);
+        std::printf("[Bench] filter words=%zu messages=%zu compile=%.1fms\n", wordCount, messageCount, SecondsSince(compileBegin) * 1000.0);
+
+        Measure("ascii", filter, MakeMessages(messageCount, 0, words, rng), seconds);
+        Measure("hangul", filter, MakeMessages(messageCount, 100, words, rng), seconds);
+        Measure("mixed", filter, MakeMessages(messageCount, 50, words, rng), seconds);
+        return 0;
+    }
+}
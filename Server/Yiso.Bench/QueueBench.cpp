@@ -0,0 +1,168 @@
+#include "Bench.h"
+#include "Logic/LogicLoop.h"
+#include "Logic/MpscQueue.h"
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 로직 스레드 큐 (user-038)
+// - MpscQueue와 mutex + deque를 생산자 1 / 2 / 4개로 비교 (u64 항목, 소비자 1개)
+// - 드문 Post -> 핸들러 지연: 소비자가 잠든 상태에서 깨우기까지 포함 (LogicLoop::Stats의 대기 시간)
+// - 64바이트 수신 작업 연속 처리량: 복사 + 큐 + 배치 꺼내기 + 핸들러 호출까지
+//   (파티션당 MAX_QUEUE_DEPTH를 넘으면 PostRecv가 거절 -> 양보 후 다시 넣고 그 횟수도 출력)
+
+namespace Yiso::Bench
+{
+    namespace
+    {
+        using Game::LogicLoop;
+        using Game::MpscQueue;
+
+        constexpr auto SPARSE_INTERVAL = std::chrono::milliseconds(1);
+        constexpr uint32_t RECV_SIZE = 64;
+
+        class MutexQueue
+        {
+        public:
+            void Push(uint64_t value)
+            {
+                std::lock_guard lock(mutex_);
+                queue_.push_back(value);
+            }
+
+            bool Pop(uint64_t& out)
+            {
+                std::lock_guard lock(mutex_);
+                if (queue_.empty()) return false;
+                out = queue_.front();
+                queue_.pop_front();
+                return true;
+            }
+
+        private:
+            std::mutex mutex_;
+            std::deque<uint64_t> queue_;
+        };
+
+        // 생산자 수만큼 나눠 넣고 소비자가 모두 꺼낼 때까지 (Mops/s)
+        template<typename Queue>
+        double MeasureQueue(size_t producers, uint64_t items)
+        {
+            Queue queue;
+            uint64_t perProducer = items / producers;
+            uint64_t total = perProducer * producers;
+
+            auto begin = Clock::now();
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < producers; ++p)
+            {
+                threads.emplace_back([&queue, perProducer]
+                {
+                    for (uint64_t i = 0; i < perProducer; ++i)
+                        queue.Push(i);
+                });
+            }
+
+            uint64_t popped = 0;
+            uint64_t sum = 0;
+            uint64_t value = 0;
+            while (popped < total)
+            {
+                if (queue.Pop(value))
+                {
+                    sum += value;
+                    ++popped;
+                }
+                else
+                    std::this_thread::yield();
+            }
+            double elapsed = SecondsSince(begin);
+            for (auto& thread : threads)
+                thread.join();
+            if (sum != perProducer * (perProducer - 1) / 2 * producers)
+                std::fprintf(stderr, "[Bench] queue 합계 불일치\n");
+            return static_cast<double>(total) / elapsed / 1e6;
+        }
+
+        LogicLoop::Handlers CountingHandlers(std::atomic<uint64_t>& received)
+        {
+            LogicLoop::Handlers handlers;
+            handlers.on_connect = [](LogicLoop::SessionId, const std::string&) {};
+            handlers.on_recv = [&received](LogicLoop::SessionId, Network::PacketType, const uint8_t*, uint32_t) { received.fetch_add(1, std::memory_order_relaxed); };
+            handlers.on_disconnect = [](LogicLoop::SessionId) {};
+            handlers.on_remote = [](const uint8_t*, uint32_t) {};
+            return handlers;
+        }
+    }
+
+    int RunQueue(const Args& args)
+    {
+        uint64_t items = ArgU64(args, 0, 2'000'000);
+        uint64_t recvJobs = ArgU64(args, 1, 1'000'000);
+        uint64_t sparse = ArgU64(args, 2, 1000);
+        if (items == 0 || recvJobs == 0 || sparse == 0)
+        {
+            std::fprintf(stderr, "[Bench] items / recv_jobs / sparse는 1 이상\n");
+            return 1;
+        }
+
+        std::printf("[Bench] queue items=%llu hardware_threads=%u\n", static_cast<unsigned long long>(items), std::thread::hardware_concurrency());
+        for (size_t producers : { 1, 2, 4 })
+        {
+            double mpsc = MeasureQueue<MpscQueue<uint64_t>>(producers, items);
+            double locked = MeasureQueue<MutexQueue>(producers, items);
+            std::printf("[Bench] queue producers=%zu mpsc=%.1f Mops/s mutex+deque=%.1f Mops/s\n", producers, mpsc, locked);
+        }
+
+        uint8_t body[RECV_SIZE] = {};
+        {
+            std::atomic<uint64_t> received{0};
+            LogicLoop loop(1, CountingHandlers(received));
+            loop.Start();
+            for (uint64_t i = 0; i < sparse; ++i)
+            {
+                std::this_thread::sleep_for(SPARSE_INTERVAL); // 소비자가 잠들 시간
+                loop.PostRecv(1, Network::PacketType::C2S_CHAT, body, RECV_SIZE);
+            }
+            loop.Drain();
+            auto stats = loop.GetStats();
+            loop.Stop();
+            std::printf("[Bench] queue sparse post->handler jobs=%llu avg=%lluus max=%lluus\n",
+                static_cast<unsigned long long>(received.load()),
+                static_cast<unsigned long long>(stats.queue_wait_avg_us),
+                static_cast<unsigned long long>(stats.queue_wait_max_us));
+        }
+
+        {
+            std::atomic<uint64_t> received{0};
+            LogicLoop loop(1, CountingHandlers(received));
+            loop.Start();
+            uint64_t retries = 0;
+            auto begin = Clock::now();
+            for (uint64_t i = 0; i < recvJobs; ++i)
+            {
+                while (!loop.PostRecv(1, Network::PacketType::C2S_CHAT, body, RECV_SIZE))
+                {
+                    ++retries;
+                    std::this_thread::yield();
+                }
+            }
+            loop.Drain();
+            double elapsed = SecondsSince(begin);
+            auto stats = loop.GetStats();
+            loop.Stop();
+            std::printf("[Bench] queue recv %uB jobs=%llu %.2f M jobs/s batches=%llu max_batch=%llu wait avg=%lluus max=%lluus full_retries=%llu\n",
+                RECV_SIZE,
+                static_cast<unsigned long long>(received.load()),
+                static_cast<double>(recvJobs) / elapsed / 1e6,
+                static_cast<unsigned long long>(stats.batches),
+                static_cast<unsigned long long>(stats.max_batch),
+                static_cast<unsigned long long>(stats.queue_wait_avg_us),
+                static_cast<unsigned long long>(stats.queue_wait_max_us),
+                static_cast<unsigned long long>(retries));
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,146 @@
+#include "Bench.h"
+#include "Network/YisoServer.h"
+#include <boost/asio.hpp>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// 세션당 메모리 (user-041)
+// - 같은 프로세스의 YisoServer에 루프백 연결 N개를 열고 단계마다 힙 증가량 / N
+//   유휴 -> 64B 요청 + 4KB 응답 직후 -> 다음 sweep 뒤 (버퍼 / 송신 상태 반납)
+// - 클라이언트 소켓은 먼저 열어 두고 기준을 잼 -> 증가량은 서버 쪽 세션 (+ 소켓 reactor 상태)만
+// - 힙: glibc는 mallinfo2 사용 중 바이트, Windows는 PrivateUsage (커밋 단위라 거침), 커널 소켓 버퍼는 빠짐
+// - 연결마다 fd 2개 (클라이언트 + 서버) -> fd 한도가 낮으면 connections를 줄임
+
+namespace Yiso::Bench
+{
+    namespace
+    {
+        using boost::asio::ip::tcp;
+        using Network::YisoSession;
+
+        constexpr uint32_t REQUEST_SIZE = 64;
+        constexpr uint32_t REPLY_SIZE = 4096;
+        constexpr auto SETTLE_WAIT = std::chrono::milliseconds(200);
+
+        // 0 = 이 플랫폼에서 못 잼
+        uint64_t HeapBytes()
+        {
+#ifdef _WIN32
+            PROCESS_MEMORY_COUNTERS_EX counters{};
+            GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters));
+            return counters.PrivateUsage;
+#elif defined(__GLIBC__)
+            return mallinfo2().uordblks;
+#else
+            return 0;
+#endif
+        }
+
+        std::vector<uint8_t> MakeFrame(Network::PacketType type, uint32_t bodySize)
+        {
+            std::vector<uint8_t> frame(Network::HEADER_SIZE + bodySize, 'x');
+            Network::PacketHeader header{ bodySize, static_cast<uint16_t>(type) };
+            std::memcpy(frame.data(), &header, Network::HEADER_SIZE);
+            return frame;
+        }
+
+        void Report(const char* phase, uint64_t base, uint64_t now, size_t connections)
+        {
+            double delta = static_cast<double>(now) - static_cast<double>(base);
+            std::printf("[Bench] sessions %-6s heap=%+.1fMB %.0f B/session\n", phase, delta / (1024.0 * 1024.0), delta / connections);
+        }
+    }
+
+    int RunSessions(const Args& args)
+    {
+        size_t connections = static_cast<size_t>(ArgU64(args, 0, 9000));
+        uint16_t port = static_cast<uint16_t>(ArgU64(args, 1, 17777));
+        if (connections == 0)
+        {
+            std::fprintf(stderr, "[Bench] connections는 1 이상\n");
+            return 1;
+        }
+        if (HeapBytes() == 0)
+        {
+            std::fprintf(stderr, "[Bench] 이 플랫폼에서는 힙 사용량을 잴 수 없음\n");
+            return 1;
+        }
+
+        boost::asio::io_context io;
+        auto guard = boost::asio::make_work_guard(io);
+        std::unique_ptr<Network::YisoServer> server;
+        auto reply = MakeFrame(Network::PacketType::S2C_CHAT, REPLY_SIZE);
+        server = std::make_unique<Network::YisoServer>(io, port,
+            [](YisoSession::SessionId) {},
+            [&server, &reply](YisoSession::SessionId id, Network::PacketType, const uint8_t*, uint32_t)
+            {
+                server->GetSessionManager().Send(id, Network::Buffer(reply.begin(), reply.end()));
+            },
+            [](YisoSession::SessionId) {});
+        std::thread ioThread([&io] { io.run(); });
+
+        boost::asio::io_context clientIo; // 동기 호출만 (돌리지 않음)
+        std::vector<tcp::socket> clients;
+        clients.reserve(connections);
+        for (size_t i = 0; i < connections; ++i)
+        {
+            clients.emplace_back(clientIo);
+            clients.back().open(tcp::v4());
+        }
+
+        std::this_thread::sleep_for(SETTLE_WAIT);
+        uint64_t base = HeapBytes();
+        tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), port);
+        for (size_t i = 0; i < connections; ++i)
+        {
+            boost::system::error_code ec;
+            clients[i].connect(endpoint, ec);
+            if (ec)
+            {
+                std::fprintf(stderr, "[Bench] 연결 %zu 실패: %s (fd 한도 확인)\n", i, ec.message().c_str());
+                connections = i;
+                break;
+            }
+        }
+        while (connections > 0 && server->GetSessionManager().Count() < connections)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::this_thread::sleep_for(SETTLE_WAIT);
+
+        if (connections > 0)
+        {
+            std::printf("[Bench] sessions connections=%zu sizeof(YisoSession)=%zu\n", connections, sizeof(YisoSession));
+            Report("idle", base, HeapBytes(), connections);
+
+            auto request = MakeFrame(Network::PacketType::C2S_CHAT, REQUEST_SIZE);
+            std::vector<uint8_t> received(Network::HEADER_SIZE + REPLY_SIZE);
+            for (size_t i = 0; i < connections; ++i)
+                boost::asio::write(clients[i], boost::asio::buffer(request));
+            for (size_t i = 0; i < connections; ++i)
+                boost::asio::read(clients[i], boost::asio::buffer(received));
+            std::this_thread::sleep_for(SETTLE_WAIT);
+            Report("active", base, HeapBytes(), connections);
+
+            std::this_thread::sleep_for(std::chrono::seconds(Network::YisoServer::SWEEP_INTERVAL_SEC + 1));
+            Report("swept", base, HeapBytes(), connections);
+        }
+
+        for (auto& client : clients)
+        {
+            boost::system::error_code ec;
+            client.close(ec);
+        }
+        boost::asio::post(io, [&server] { server->Stop(); });
+        guard.reset();
+        ioThread.join();
+        return connections > 0 ? 0 : 1;
+    }
+}
@@ -0,0 +1,62 @@
+#include "Bench.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 성능 측정 모음: 커밋 메시지에 적은 수치를 같은 조건으로 다시 재기 위한 도구 (Release 빌드로)
+// - 모드마다 입력은 고정 시드로 만들어 실행마다 같은 데이터
+// 사용법:
+//   Yiso.Bench filter [words] [messages] [seconds]     금칙어 필터 처리량 (ASCII / 한글 / 섞임)
+//   Yiso.Bench dojo [instances] [workers] [seconds]    도장 틱 CPU / 지터, 틱 중 입장 / 퇴장 지연
+//   Yiso.Bench enemy [rounds] [updates]                적 틱 SoA (EnemyWorld) vs AoS, 리스폰 포함
+//   Yiso.Bench queue [items] [recv_jobs] [sparse]      MPSC 큐 vs mutex, 로직 스레드 지연 / 처리량
+//   Yiso.Bench sessions [connections] [port]           루프백 연결당 서버 힙 (유휴 / 요청 직후 / sweep 뒤)
+
+namespace
+{
+    struct Mode
+    {
+        const char* name;
+        int (*run)(const Yiso::Bench::Args&);
+        const char* usage;
+    };
+
+    const Mode MODES[] = {
+        { "filter", Yiso::Bench::RunFilter, "filter [words=2000] [messages=20000] [seconds=2]" },
+        { "dojo", Yiso::Bench::RunDojo, "dojo [instances=10000] [workers=hw-1] [seconds=5]" },
+        { "enemy", Yiso::Bench::RunEnemy, "enemy [rounds=7] [updates=20000000]" },
+        { "queue", Yiso::Bench::RunQueue, "queue [items=2000000] [recv_jobs=1000000] [sparse=1000]" },
+        { "sessions", Yiso::Bench::RunSessions, "sessions [connections=9000] [port=17777]" },
+    };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr, "usage: Yiso.Bench <mode> [args...]\n");
+        for (const auto& mode : MODES)
+            std::fprintf(stderr, "  Yiso.Bench %s\n", mode.usage);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::warn); // 측정 대상이 찍는 정보 로그 생략
+    for (const auto& mode : MODES)
+    {
+        if (std::strcmp(argv[1], mode.name) != 0) continue;
+        return mode.run(Yiso::Bench::Args(argv + 2, argv + argc));
+    }
+    PrintUsage();
+    return 1;
+}
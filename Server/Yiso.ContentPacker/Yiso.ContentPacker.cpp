@@ -0,0 +1,295 @@
+#include "Content/ContentFormat.h"
+#include "game_packet.pb.h"
+#include <google/protobuf/text_format.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 콘텐츠 패커: 텍스트 콘텐츠를 서버가 mmap으로 읽는 바이너리 파일 하나로 컴파일
+// 입력 (protobuf text format):
+//   <input_dir>/maps/*.txt      -> S2C_MapData (map_id가 0이면 파일 이름에서 읽음)
+//   <input_dir>/chapters/*.txt  -> S2C_ChapterInfo (chapter_id가 0이면 파일 이름에서 읽음)
+// 사용법:
+//   Yiso.ContentPacker <input_dir> <output_file>
+
+namespace fs = std::filesystem;
+using namespace Yiso::Game::Content;
+
+namespace
+{
+    template<typename T>
+    bool ReadTextMessage(const fs::path& path, T& out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return google::protobuf::TextFormat::ParseFromString(ss.str(), &out);
+    }
+
+    // 파일 이름(확장자 제외)이 숫자면 그 값, 아니면 0
+    uint32_t IdFromFileName(const fs::path& path)
+    {
+        try { return static_cast<uint32_t>(std::stoul(path.stem().string())); }
+        catch (...) { return 0; }
+    }
+
+    std::vector<fs::path> ListTextFiles(const fs::path& dir)
+    {
+        std::vector<fs::path> files;
+        if (!fs::is_directory(dir)) return files;
+        for (const auto& entry : fs::directory_iterator(dir))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".txt")
+                files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    class StringTable
+    {
+    public:
+        uint32_t Intern(const std::string& value)
+        {
+            if (value.empty()) return NO_STRING;
+            auto it = index_.find(value);
+            if (it != index_.end()) return it->second;
+
+            uint32_t id = static_cast<uint32_t>(refs_.size());
+            refs_.push_back({ static_cast<uint32_t>(data_.size()), static_cast<uint32_t>(value.size()) });
+            data_.insert(data_.end(), value.begin(), value.end());
+            index_.emplace(value, id);
+            return id;
+        }
+
+        const std::vector<StringRef>& Refs() const { return refs_; }
+        const std::vector<char>& Data() const { return data_; }
+
+    private:
+        std::unordered_map<std::string, uint32_t> index_;
+        std::vector<StringRef> refs_;
+        std::vector<char> data_;
+    };
+
+    struct Tables
+    {
+        StringTable strings;
+        std::vector<MapRecord> maps;
+        std::vector<NpcRecord> npcs;
+        std::vector<ReactorRecord> reactors;
+        std::vector<SpawnerRecord> spawners;
+        std::vector<uint32_t> spawner_enemy_ids;
+        std::vector<EnemyRecord> enemies;
+        std::vector<PortalRecord> portals;
+        std::vector<ChapterRecord> chapters;
+        std::vector<uint32_t> field_map_ids;
+    };
+
+    template<typename V>
+    Range Begin(const V& v) { return { static_cast<uint32_t>(v.size()), 0 }; }
+
+    template<typename V>
+    void End(Range& range, const V& v) { range.count = static_cast<uint32_t>(v.size()) - range.begin; }
+
+    void AddMap(Tables& t, const yiso::game::S2C_MapData& m)
+    {
+        MapRecord r{};
+        r.map_id = m.map_id();
+        r.addressable_key = t.strings.Intern(m.addressable_key());
+        r.map_type = static_cast<uint32_t>(m.map_type());
+        r.spawn_x = m.spawn_position().x();
+        r.spawn_y = m.spawn_position().y();
+
+        r.npcs = Begin(t.npcs);
+        for (const auto& o : m.npcs())
+            t.npcs.push_back({ o.npc_id(), t.strings.Intern(o.template_key()), o.position().x(), o.position().y(), o.active() ? 1u : 0u });
+        End(r.npcs, t.npcs);
+
+        r.reactors = Begin(t.reactors);
+        for (const auto& o : m.reactors())
+            t.reactors.push_back({ o.object_id(), o.reactor_id(), t.strings.Intern(o.template_key()), o.position().x(), o.position().y(), o.active() ? 1u : 0u });
+        End(r.reactors, t.reactors);
+
+        r.spawners = Begin(t.spawners);
+        for (const auto& o : m.spawners())
+        {
+            SpawnerRecord s{ o.spawner_id(), t.strings.Intern(o.template_key()), o.position().x(), o.position().y(), o.active() ? 1u : 0u, Begin(t.spawner_enemy_ids) };
+            t.spawner_enemy_ids.insert(t.spawner_enemy_ids.end(), o.enemy_ids().begin(), o.enemy_ids().end());
+            End(s.enemy_ids, t.spawner_enemy_ids);
+            t.spawners.push_back(s);
+        }
+        End(r.spawners, t.spawners);
+
+        r.enemies = Begin(t.enemies);
+        for (const auto& o : m.enemies())
+            t.enemies.push_back({ o.enemy_id(), t.strings.Intern(o.template_key()), o.position().x(), o.position().y(), o.active() ? 1u : 0u });
+        End(r.enemies, t.enemies);
+
+        r.portals = Begin(t.portals);
+        for (const auto& o : m.portals())
+            t.portals.push_back({ o.connect_map_id(), t.strings.Intern(o.template_key()), o.position().x(), o.position().y(), static_cast<uint32_t>(o.state()) });
+        End(r.portals, t.portals);
+
+        t.maps.push_back(r);
+    }
+
+    void AddChapter(Tables& t, const yiso::game::S2C_ChapterInfo& c)
+    {
+        ChapterRecord r{};
+        r.chapter_id = c.chapter_id();
+        r.chapter_name = t.strings.Intern(c.chapter_name());
+        r.recommended_stat = c.recommended_stat();
+        r.town_map_id = c.town_map_id();
+        r.field_map_ids = Begin(t.field_map_ids);
+        t.field_map_ids.insert(t.field_map_ids.end(), c.field_map_ids().begin(), c.field_map_ids().end());
+        End(r.field_map_ids, t.field_map_ids);
+        r.boss_area_map_id = c.boss_area_map_id();
+        r.boss_reward_skill_id = c.boss_reward_skill_id();
+        t.chapters.push_back(r);
+    }
+
+    class Writer
+    {
+    public:
+        Writer() : bytes_(sizeof(FileHeader), 0) {}
+
+        template<typename T>
+        void WriteSection(Section section, const std::vector<T>& values)
+        {
+            while (bytes_.size() % 4 != 0) bytes_.push_back(0);
+            header_.sections[section] = { static_cast<uint32_t>(bytes_.size()), static_cast<uint32_t>(values.size()) };
+            const auto* begin = reinterpret_cast<const uint8_t*>(values.data());
+            bytes_.insert(bytes_.end(), begin, begin + values.size() * sizeof(T));
+        }
+
+        bool Save(const fs::path& path)
+        {
+            while (bytes_.size() % 4 != 0) bytes_.push_back(0);
+            header_.magic = CONTENT_MAGIC;
+            header_.version = CONTENT_VERSION;
+            header_.file_size = static_cast<uint32_t>(bytes_.size());
+            std::memcpy(bytes_.data(), &header_, sizeof(FileHeader));
+
+            // 임시 파일에 쓰고 교체 -> 서버가 매핑 중인 파일을 덮어쓰다 깨지는 일 방지
+            fs::path temp = path;
+            temp += ".tmp";
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                if (!file.write(reinterpret_cast<const char*>(bytes_.data()), bytes_.size())) return false;
+            }
+            std::error_code ec;
+            fs::rename(temp, path, ec);
+            return !ec;
+        }
+
+        size_t Size() const { return bytes_.size(); }
+
+    private:
+        FileHeader header_{};
+        std::vector<uint8_t> bytes_;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    if (argc < 3)
+    {
+        std::cerr << "usage: Yiso.ContentPacker <input_dir> <output_file>\n";
+        return 1;
+    }
+    fs::path inputDir = argv[1];
+    fs::path outputFile = argv[2];
+
+    Tables tables;
+
+    for (const auto& path : ListTextFiles(inputDir / "maps"))
+    {
+        yiso::game::S2C_MapData map;
+        if (!ReadTextMessage(path, map))
+        {
+            std::cerr << "[Packer] 맵 파싱 실패: " << path.string() << "\n";
+            return 1;
+        }
+        if (map.map_id() == 0) map.set_map_id(IdFromFileName(path));
+        if (map.map_id() == 0)
+        {
+            std::cerr << "[Packer] map_id 없음: " << path.string() << "\n";
+            return 1;
+        }
+        AddMap(tables, map);
+    }
+
+    for (const auto& path : ListTextFiles(inputDir / "chapters"))
+    {
+        yiso::game::S2C_ChapterInfo chapter;
+        if (!ReadTextMessage(path, chapter))
+        {
+            std::cerr << "[Packer] 챕터 파싱 실패: " << path.string() << "\n";
+            return 1;
+        }
+        if (chapter.chapter_id() == 0) chapter.set_chapter_id(IdFromFileName(path));
+        if (chapter.chapter_id() == 0)
+        {
+            std::cerr << "[Packer] chapter_id 없음: " << path.string() << "\n";
+            return 1;
+        }
+        AddChapter(tables, chapter);
+    }
+
+    // 서버는 id로 이진 탐색 -> 정렬 + 중복 검사
+    std::sort(tables.maps.begin(), tables.maps.end(), [](auto& a, auto& b) { return a.map_id < b.map_id; });
+    std::sort(tables.chapters.begin(), tables.chapters.end(), [](auto& a, auto& b) { return a.chapter_id < b.chapter_id; });
+    for (size_t i = 1; i < tables.maps.size(); ++i)
+    {
+        if (tables.maps[i].map_id == tables.maps[i - 1].map_id)
+        {
+            std::cerr << "[Packer] 중복 map_id: " << tables.maps[i].map_id << "\n";
+            return 1;
+        }
+    }
+    for (size_t i = 1; i < tables.chapters.size(); ++i)
+    {
+        if (tables.chapters[i].chapter_id == tables.chapters[i - 1].chapter_id)
+        {
+            std::cerr << "[Packer] 중복 chapter_id: " << tables.chapters[i].chapter_id << "\n";
+            return 1;
+        }
+    }
+
+    Writer writer;
+    writer.WriteSection(SECTION_STRING_REFS, tables.strings.Refs());
+    writer.WriteSection(SECTION_STRING_DATA, tables.strings.Data());
+    writer.WriteSection(SECTION_MAPS, tables.maps);
+    writer.WriteSection(SECTION_NPCS, tables.npcs);
+    writer.WriteSection(SECTION_REACTORS, tables.reactors);
+    writer.WriteSection(SECTION_SPAWNERS, tables.spawners);
+    writer.WriteSection(SECTION_SPAWNER_ENEMY_IDS, tables.spawner_enemy_ids);
+    writer.WriteSection(SECTION_ENEMIES, tables.enemies);
+    writer.WriteSection(SECTION_PORTALS, tables.portals);
+    writer.WriteSection(SECTION_CHAPTERS, tables.chapters);
+    writer.WriteSection(SECTION_FIELD_MAP_IDS, tables.field_map_ids);
+
+    if (!writer.Save(outputFile))
+    {
+        std::cerr << "[Packer] 쓰기 실패: " << outputFile.string() << "\n";
+        return 1;
+    }
+
+    std::cout << "[Packer] " << outputFile.string() << " (v" << CONTENT_VERSION << ", " << writer.Size() << " bytes)\n"
+              << "  maps=" << tables.maps.size() << " chapters=" << tables.chapters.size()
+              << " strings=" << tables.strings.Refs().size() << "\n";
+    return 0;
+}
@@ -1,8 +1,11 @@
 #include "Network/PacketHeader.h"
 #include "Network/PacketCodec.h"
+#include "Network/ChunkAssembler.h"
+#include "Network/Envelope.h"
 #include "game_packet.pb.h"
 #include <boost/asio.hpp>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -23,6 +26,9 @@ using namespace Yiso::Network;
 //   /jr <room_id>          -> 채팅방 입장
 //   /lr <room_id>          -> 채팅방 퇴장
 //   /rc <room_id> <msg>    -> 채팅방 채팅
+//   /reconnect             -> 연결을 끊고 세션 재개 (짧은 끊김 흉내)
+//   /login <session_id>    -> 로그인 (Yiso.Web 로그인 응답의 SessionId, 실행 인자 3번째로 주면 접속 직후 자동)
+//   /env <cmd> ; <cmd> ... -> 여러 커맨드를 봉투 프레임 하나로 (예: /env /jr 3 ; /rc 3 hi ; /w 2 hey)
 //   /help                  -> 커맨드 목록 출력
 
 static void PrintHelp()
@@ -36,14 +42,17 @@ static void PrintHelp()
         "  /jr <room_id>       - 채팅방 입장\n"
         "  /lr <room_id>       - 채팅방 퇴장\n"
         "  /rc <room_id> <msg> - 채팅방 채팅\n"
+        "  /reconnect          - 끊고 다시 접속해 세션 재개\n"
+        "  /login <session_id> - 로그인 (인증을 켠 서버는 로그인 전 패킷을 버림)\n"
+        "  /env <cmd> ; <cmd>  - 여러 커맨드를 봉투 하나로 보냄\n"
         "  /help               - 이 도움말\n";
 }
 
 class DummyClient
 {
 public:
-    DummyClient(boost::asio::io_context& io, const std::string& host, uint16_t port)
-        : io_(io), socket_(io)
+    DummyClient(boost::asio::io_context& io, const std::string& host, uint16_t port, const std::string& login)
+        : io_(io), socket_(io), host_(host), port_(port)
     {
         tcp::resolver resolver(io);
         auto endpoints = resolver.resolve(host, std::to_string(port));
@@ -51,6 +60,9 @@ public:
         std::cout << "[Client] Connected to " << host << ":" << port << "\n";
         PrintHelp();
 
+        SendHello(); // 서버도 이 연결에는 봉투로 묶어 보냄
+        if (!login.empty())
+            Login(login);
         DoReadHeader();
     }
 
@@ -65,11 +77,42 @@ public:
             return;
         }
 
+        if (line == "/reconnect")
+        {
+            boost::asio::post(io_, [this]() { Reconnect(); });
+            return;
+        }
+
         std::istringstream ss(line);
         std::string cmd;
         ss >> cmd;
 
-        if (cmd == "/w")
+        if (cmd == "/env")
+        {
+            // 각 커맨드가 post하는 전송을 시작 / 끝 사이에 넣어 봉투 하나로 모음 (io 스레드에서 순서대로 실행)
+            boost::asio::post(io_, [this]() { batch_.emplace(batch_buf_); });
+            std::string part;
+            while (std::getline(ss >> std::ws, part, ';'))
+            {
+                while (!part.empty() && part.back() == ' ')
+                    part.pop_back();
+                if (part.rfind("/env", 0) == 0 || part == "/reconnect" || part == "/help")
+                    continue;
+                HandleInput(part);
+            }
+            boost::asio::post(io_, [this]() { SendEnvelope(); });
+        }
+        else if (cmd == "/login")
+        {
+            std::string sessionId;
+            if (!(ss >> sessionId))
+            {
+                std::cout << "[usage] /login <session_id>\n";
+                return;
+            }
+            boost::asio::post(io_, [this, sessionId]() { Login(sessionId); });
+        }
+        else if (cmd == "/w")
         {
             uint32_t sid; std::string msg;
             if (!(ss >> sid) || !std::getline(ss >> std::ws, msg))
@@ -178,13 +221,70 @@ public:
     }
 
 private:
+    void Login(const std::string& sessionId)
+    {
+        yiso::game::C2S_Login req;
+        req.set_session_id(sessionId);
+        Send(PacketType::C2S_LOGIN, req);
+    }
+
+    // 소켓만 새로 -> 첫 패킷으로 재개 요청 (서버는 받은 프레임 수 뒤의 것만 다시 보냄)
+    void Reconnect()
+    {
+        if (token_ == 0)
+        {
+            std::cout << "[Client] 재개 토큰 없음 (서버가 재개 모드가 아님)\n";
+            return;
+        }
+
+        boost::system::error_code ignored;
+        socket_.close(ignored); // 진행 중인 읽기는 operation_aborted로 끝남
+        socket_ = tcp::socket(io_);
+        tcp::resolver resolver(io_);
+        boost::asio::connect(socket_, resolver.resolve(host_, std::to_string(port_)));
+        assembler_ = ChunkAssembler();
+
+        yiso::game::C2S_ResumeSession req;
+        req.set_session_id(session_id_);
+        req.set_token(token_);
+        req.set_received(received_);
+        Send(PacketType::C2S_RESUME_SESSION, req); // 첫 패킷이어야 함 (봉투에 담지 않음)
+        SendHello(); // 봉투는 연결마다 다시 켬
+        std::cout << "[Client] 재접속, 세션 " << session_id_ << " 재개 요청 (받은 프레임 " << received_ << "개)\n";
+        DoReadHeader();
+    }
+
     template<typename T>
     void Send(PacketType type, const T& msg)
     {
         auto frame = PacketCodec::Encode(type, msg);
+        if (batch_ && IsEnvelopeItemType(type))
+        {
+            batch_->AddFrame(frame.data()); // /env 중 -> SendEnvelope에서 한 번에
+            return;
+        }
         boost::asio::write(socket_, boost::asio::buffer(frame));
     }
 
+    void SendHello()
+    {
+        yiso::game::C2S_Hello req;
+        req.set_envelope(true);
+        Send(PacketType::C2S_HELLO, req); // 봉투에 담지 않음 (IsEnvelopeItemType)
+    }
+
+    // 모은 메시지를 봉투 하나로 (모은 게 없으면 빈 봉투)
+    void SendEnvelope()
+    {
+        if (!batch_)
+            batch_.emplace(batch_buf_);
+        batch_->Finish(PacketType::C2S_ENVELOPE);
+        if (batch_->Count() > 0)
+            std::cout << "[Client] 봉투 전송 (" << batch_->Count() << "개 메시지, " << batch_buf_.size() << " bytes)\n";
+        boost::asio::write(socket_, boost::asio::buffer(batch_buf_));
+        batch_.reset();
+    }
+
     void DoReadHeader()
     {
         boost::asio::async_read(
@@ -194,7 +294,8 @@ private:
             {
                 if (ec)
                 {
-                    std::cerr << "[Client] read error: " << ec.message() << "\n";
+                    if (ec != boost::asio::error::operation_aborted) // 재접속으로 닫은 소켓
+                        std::cerr << "[Client] read error: " << ec.message() << "\n";
                     return;
                 }
                 DoReadBody();
@@ -212,20 +313,55 @@ private:
             {
                 if (ec)
                 {
-                    std::cerr << "[Client] read error: " << ec.message() << "\n";
+                    if (ec != boost::asio::error::operation_aborted)
+                        std::cerr << "[Client] read error: " << ec.message() << "\n";
                     return;
                 }
 
-                HandlePacket(static_cast<PacketType>(header_buf_.type));
+                if (header_buf_.type == static_cast<uint16_t>(PacketType::S2C_FRAME_CHUNK))
+                {
+                    // 큰 메시지 조각 -> 다 모이면 원래 패킷으로 처리
+                    PacketType type;
+                    const uint8_t* body;
+                    uint32_t bodySize;
+                    auto result = assembler_.Feed(body_buf_.data(), static_cast<uint32_t>(body_buf_.size()), type, body, bodySize);
+                    if (result == ChunkAssembler::Result::Error)
+                    {
+                        std::cerr << "[Client] invalid chunk\n";
+                        return;
+                    }
+                    if (result == ChunkAssembler::Result::Complete)
+                        HandlePacket(type, body, static_cast<int>(bodySize));
+                }
+                else if (header_buf_.type == static_cast<uint16_t>(PacketType::S2C_ENVELOPE))
+                {
+                    // 여러 메시지 -> 담긴 순서대로 하나씩 처리
+                    EnvelopeReader reader(body_buf_.data(), static_cast<uint32_t>(body_buf_.size()));
+                    PacketType type;
+                    const uint8_t* body;
+                    uint32_t bodySize;
+                    EnvelopeReader::Result result;
+                    while ((result = reader.Next(type, body, bodySize)) == EnvelopeReader::Result::Item)
+                        HandlePacket(type, body, static_cast<int>(bodySize));
+                    if (result == EnvelopeReader::Result::Error)
+                    {
+                        std::cerr << "[Client] invalid envelope\n";
+                        return;
+                    }
+                }
+                else
+                {
+                    HandlePacket(static_cast<PacketType>(header_buf_.type), body_buf_.data(), static_cast<int>(body_buf_.size()));
+                }
                 DoReadHeader();
             }
         );
     }
 
-    void HandlePacket(PacketType type)
+    void HandlePacket(PacketType type, const uint8_t* data, int size)
     {
-        const uint8_t* data = body_buf_.data();
-        const int size = static_cast<int>(body_buf_.size());
+        if (IsSequencedType(type))
+            ++received_; // 재개 요청에 실어 보낼 받은 프레임 수
 
         switch (type)
         {
@@ -287,6 +423,43 @@ private:
                 std::cout << "[방 " << msg.room_id() << "] [" << msg.from_session_id() << "] " << msg.message() << "\n";
             break;
         }
+        case PacketType::S2C_SERVER_BUSY:
+        {
+            yiso::game::S2C_ServerBusy msg;
+            if (msg.ParseFromArray(data, size))
+                std::cout << "[서버 혼잡] " << msg.retry_after_ms() << "ms 후 다시 접속하세요\n";
+            break;
+        }
+        case PacketType::S2C_SESSION_TOKEN:
+        {
+            yiso::game::S2C_SessionToken msg;
+            if (!msg.ParseFromArray(data, size)) break;
+            session_id_ = msg.session_id();
+            token_ = msg.token();
+            received_ = 0; // 새 세션
+            std::cout << "[세션] id=" << session_id_ << " (끊기면 " << msg.grace_sec() << "초 안에 /reconnect로 재개)\n";
+            break;
+        }
+        case PacketType::S2C_RESUME_RESULT:
+        {
+            yiso::game::S2C_ResumeResult msg;
+            if (!msg.ParseFromArray(data, size)) break;
+            if (msg.success())
+                std::cout << "[세션 재개] id=" << msg.session_id() << " (놓친 패킷을 이어서 받음)\n";
+            else
+                std::cout << "[세션 재개 실패] " << msg.error() << " -> 새 세션으로 계속\n";
+            break;
+        }
+        case PacketType::S2C_LOGIN_RESULT:
+        {
+            yiso::game::S2C_LoginResult msg;
+            if (!msg.ParseFromArray(data, size)) break;
+            if (msg.success())
+                std::cout << "[로그인] 성공\n";
+            else
+                std::cout << "[로그인 실패] " << msg.error() << "\n";
+            break;
+        }
         default:
             std::cerr << "[Client] unknown packet type: " << static_cast<uint16_t>(type) << "\n";
             break;
@@ -295,8 +468,20 @@ private:
 
     boost::asio::io_context& io_;
     tcp::socket socket_;
+    std::string host_;
+    uint16_t port_;
     PacketHeader header_buf_{};
     std::vector<uint8_t> body_buf_;
+    ChunkAssembler assembler_;
+
+    // 봉투 송신 (/env 동안 모음)
+    Buffer batch_buf_;
+    std::optional<EnvelopeWriter> batch_;
+
+    // 세션 재개
+    uint32_t session_id_ = 0;
+    uint64_t token_ = 0;
+    uint64_t received_ = 0;
 };
 
 int main(int argc, char* argv[])
@@ -309,11 +494,12 @@ int main(int argc, char* argv[])
     uint16_t port = 7777;
     if (argc > 1) host = argv[1];
     if (argc > 2) port = static_cast<uint16_t>(std::stoi(argv[2]));
+    std::string login = argc > 3 ? argv[3] : ""; // Yiso.Web 세션 ID
 
     try
     {
         boost::asio::io_context io;
-        DummyClient client(io, host, port);
+        DummyClient client(io, host, port, login);
 
         std::thread input_thread([&client]()
         {
@@ -0,0 +1,210 @@
+#include "AllocAccounting.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#ifdef YISO_ALLOC_ACCOUNTING
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+namespace Yiso::Network
+{
+#ifdef YISO_ALLOC_ACCOUNTING
+    namespace
+    {
+        struct Slot
+        {
+            std::atomic<uint64_t> calls;
+            std::atomic<uint64_t> cpu;
+            std::atomic<uint64_t> allocs;
+            std::atomic<uint64_t> alloc_bytes;
+            std::atomic<uint64_t> frees;
+            std::atomic<uint64_t> free_bytes;
+            std::atomic<uint64_t> pool_allocs;
+            std::atomic<uint64_t> pool_bytes;
+        };
+
+        // 정적 0 초기화 + 소멸자 없음 -> main 이전 / 정적 파괴 이후의 operator new에서도 안전
+        Slot g_slots[AllocAccounting::TAG_COUNT];
+        thread_local uint32_t t_tag = AllocAccounting::TAG_UNTAGGED;
+
+        void Add(std::atomic<uint64_t>& counter, uint64_t value) { counter.fetch_add(value, std::memory_order_relaxed); }
+
+        size_t UsableSize(void* p)
+        {
+#ifdef _WIN32
+            return _msize(p);
+#else
+            return malloc_usable_size(p);
+#endif
+        }
+
+        uint64_t ThreadCpu()
+        {
+#ifdef _WIN32
+            ULONG64 cycles = 0;
+            QueryThreadCycleTime(GetCurrentThread(), &cycles); // GetThreadTimes는 스케줄러 틱 단위라 핸들러 하나 재기엔 거칠음
+            return cycles;
+#else
+            timespec ts{};
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+        }
+
+        void* CountedAlloc(size_t size) noexcept
+        {
+            void* p = std::malloc(size == 0 ? 1 : size);
+            if (!p) return nullptr;
+            Slot& slot = g_slots[t_tag];
+            Add(slot.allocs, 1);
+            Add(slot.alloc_bytes, UsableSize(p));
+            return p;
+        }
+
+        void* CountedAllocOrThrow(size_t size)
+        {
+            while (true)
+            {
+                if (void* p = CountedAlloc(size)) return p;
+                std::new_handler handler = std::get_new_handler();
+                if (!handler) throw std::bad_alloc();
+                handler();
+            }
+        }
+
+        void CountedFree(void* p) noexcept
+        {
+            if (!p) return;
+            Slot& slot = g_slots[t_tag];
+            Add(slot.frees, 1);
+            Add(slot.free_bytes, UsableSize(p));
+            std::free(p);
+        }
+    }
+
+    AllocAccounting::Scope::Scope(uint32_t tag)
+        : previous_(t_tag), cpu_begin_(ThreadCpu())
+    {
+        t_tag = tag;
+    }
+
+    AllocAccounting::Scope::~Scope()
+    {
+        Slot& slot = g_slots[t_tag];
+        Add(slot.cpu, ThreadCpu() - cpu_begin_);
+        Add(slot.calls, 1);
+        t_tag = previous_;
+    }
+
+    void AllocAccounting::OnPoolAlloc(size_t bytes)
+    {
+        Slot& slot = g_slots[t_tag];
+        Add(slot.pool_allocs, 1);
+        Add(slot.pool_bytes, bytes);
+    }
+
+    const char* AllocAccounting::CpuUnit()
+    {
+#ifdef _WIN32
+        return "cycles";
+#else
+        return "ns";
+#endif
+    }
+
+    std::vector<AllocAccounting::Row> AllocAccounting::GetRows()
+    {
+        std::vector<Row> rows;
+        for (uint32_t tag = 0; tag < TAG_COUNT; ++tag)
+        {
+            const Slot& slot = g_slots[tag];
+            Row row{
+                tag,
+                slot.calls.load(std::memory_order_relaxed),
+                slot.cpu.load(std::memory_order_relaxed),
+                slot.allocs.load(std::memory_order_relaxed),
+                slot.alloc_bytes.load(std::memory_order_relaxed),
+                slot.frees.load(std::memory_order_relaxed),
+                slot.free_bytes.load(std::memory_order_relaxed),
+                slot.pool_allocs.load(std::memory_order_relaxed),
+                slot.pool_bytes.load(std::memory_order_relaxed),
+            };
+            if (row.calls == 0 && row.allocs == 0 && row.frees == 0 && row.pool_allocs == 0) continue;
+            rows.push_back(row);
+        }
+        std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.alloc_bytes > b.alloc_bytes; });
+        return rows;
+    }
+#else
+    const char* AllocAccounting::CpuUnit() { return "ns"; }
+    std::vector<AllocAccounting::Row> AllocAccounting::GetRows() { return {}; }
+#endif
+
+    std::string AllocAccounting::TagName(uint32_t tag)
+    {
+        switch (tag)
+        {
+        case TAG_UNTAGGED: return "(untagged)";
+        case TAG_CONNECT: return "connect";
+        case TAG_DISCONNECT: return "disconnect";
+        case TAG_OTHER: return "(other)";
+        default: return "type " + std::to_string(tag);
+        }
+    }
+
+    int64_t AllocAccounting::DumpTable(const std::filesystem::path& path)
+    {
+        auto rows = GetRows();
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return -1;
+
+        std::string cpuColumn = std::string("cpu_") + CpuUnit() + "/call";
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-12s %10s %16s %10s %12s %12s %12s %12s %12s\n",
+            "tag", "calls", cpuColumn.c_str(),
+            "allocs", "bytes", "allocs/call", "bytes/call", "net_bytes", "pool_bytes");
+        out << line;
+        for (const Row& row : rows)
+        {
+            // 호출 수가 없는 태그(untagged)는 호출당 값 대신 0
+            auto perCall = [&row](uint64_t value) { return row.calls > 0 ? value / row.calls : 0; };
+            std::snprintf(line, sizeof(line), "%-12s %10llu %16llu %10llu %12llu %12llu %12llu %12lld %12llu\n",
+                TagName(row.tag).c_str(),
+                static_cast<unsigned long long>(row.calls),
+                static_cast<unsigned long long>(perCall(row.cpu)),
+                static_cast<unsigned long long>(row.allocs),
+                static_cast<unsigned long long>(row.alloc_bytes),
+                static_cast<unsigned long long>(perCall(row.allocs)),
+                static_cast<unsigned long long>(perCall(row.alloc_bytes)),
+                static_cast<long long>(row.alloc_bytes) - static_cast<long long>(row.free_bytes),
+                static_cast<unsigned long long>(row.pool_bytes));
+            out << line;
+        }
+        return out ? static_cast<int64_t>(rows.size()) : -1;
+    }
+}
+
+#ifdef YISO_ALLOC_ACCOUNTING
+// 전역 operator new/delete 교체 (정렬 지정 버전은 기본 구현 그대로 -> 집계 안 됨)
+// Scope와 같은 번역 단위에 두어 정적 라이브러리에서도 링크에 포함되게 함
+void* operator new(size_t size) { return Yiso::Network::CountedAllocOrThrow(size); }
+void* operator new[](size_t size) { return Yiso::Network::CountedAllocOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Yiso::Network::CountedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Yiso::Network::CountedAlloc(size); }
+void operator delete(void* p) noexcept { Yiso::Network::CountedFree(p); }
+void operator delete[](void* p) noexcept { Yiso::Network::CountedFree(p); }
+void operator delete(void* p, size_t) noexcept { Yiso::Network::CountedFree(p); }
+void operator delete[](void* p, size_t) noexcept { Yiso::Network::CountedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { Yiso::Network::CountedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { Yiso::Network::CountedFree(p); }
+#endif
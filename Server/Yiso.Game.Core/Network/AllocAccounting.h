@@ -0,0 +1,97 @@
+#pragma once
+#include "PacketHeader.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 패킷 종류별 힙 할당 / 스레드 CPU 시간 집계 (계측 빌드 전용)
+    // - Yiso.Game.Core, Yiso.Game 양쪽 전처리기 정의에 YISO_ALLOC_ACCOUNTING 추가 -> 전역 operator new/delete 교체
+    // - 로직 스레드가 핸들러를 부르는 동안 Scope로 현재 태그 지정 -> 그 사이의 할당/해제/CPU 시간을 태그로 돌림
+    //   (해제는 해제한 쪽 태그로 집계 -> net_bytes가 양수면 그 패킷 처리 후 남아 있는 메모리)
+    // - BufferPool 블록은 힙과 따로 pool 열로 집계
+    // - 정의하지 않으면 Scope는 빈 객체, 훅 없음
+    // Scope는 중첩하지 않음 (안쪽 Scope의 CPU 시간이 바깥 태그에도 한 번 더 더해짐)
+    class AllocAccounting
+    {
+    public:
+        enum class Event : uint8_t
+        {
+            Connect,
+            Disconnect, // 세션 제거 + 방 퇴장 알림 팬아웃
+        };
+
+        static constexpr uint32_t MAX_PACKET_TYPE = 2048; // 이 이상 값은 TAG_OTHER로
+        static constexpr uint32_t TAG_UNTAGGED = 0; // Scope 밖 (io 스레드, 타이머 등)
+        static constexpr uint32_t TAG_CONNECT = MAX_PACKET_TYPE;
+        static constexpr uint32_t TAG_DISCONNECT = MAX_PACKET_TYPE + 1;
+        static constexpr uint32_t TAG_OTHER = MAX_PACKET_TYPE + 2;
+        static constexpr uint32_t TAG_COUNT = MAX_PACKET_TYPE + 3;
+
+        static constexpr bool Enabled()
+        {
+#ifdef YISO_ALLOC_ACCOUNTING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        struct Row
+        {
+            uint32_t tag;
+            uint64_t calls;
+            uint64_t cpu; // CpuUnit() 단위
+            uint64_t allocs;
+            uint64_t alloc_bytes; // malloc이 실제로 잡은 크기 (usable size)
+            uint64_t frees;
+            uint64_t free_bytes;
+            uint64_t pool_allocs;
+            uint64_t pool_bytes; // 등급 크기 기준
+        };
+
+        static std::string TagName(uint32_t tag);
+        static const char* CpuUnit(); // "ns" (스레드 CPU 시계) / "cycles" (Windows 스레드 사이클)
+
+        // 활동이 있었던 태그만, 할당 바이트 많은 순 (꺼져 있으면 빈 목록)
+        static std::vector<Row> GetRows();
+
+        // 표 형태 텍스트로 저장 (반환: 기록한 행 수, 실패 시 -1)
+        static int64_t DumpTable(const std::filesystem::path& path);
+
+#ifdef YISO_ALLOC_ACCOUNTING
+        static void OnPoolAlloc(size_t bytes); // 풀 블록은 순환이 목적이라 해제는 세지 않음 (잔량은 BufferPool 통계의 live)
+
+        // 범위 동안 현재 스레드의 할당을 태그로 집계 + 범위의 스레드 CPU 시간과 호출 수 기록
+        class Scope
+        {
+        public:
+            explicit Scope(PacketType type) : Scope(TagOf(type)) {}
+            explicit Scope(Event event) : Scope(event == Event::Connect ? TAG_CONNECT : TAG_DISCONNECT) {}
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            explicit Scope(uint32_t tag);
+            static uint32_t TagOf(PacketType type)
+            {
+                auto value = static_cast<uint32_t>(type);
+                return value < MAX_PACKET_TYPE ? value : TAG_OTHER;
+            }
+
+            uint32_t previous_;
+            uint64_t cpu_begin_;
+        };
+#else
+        class Scope
+        {
+        public:
+            explicit Scope(PacketType) {}
+            explicit Scope(Event) {}
+        };
+#endif
+    };
+}
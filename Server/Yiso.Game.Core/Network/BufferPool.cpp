@@ -0,0 +1,386 @@
+#include "BufferPool.h"
+#include "AllocAccounting.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+namespace Yiso::Network
+{
+    namespace
+    {
+        struct ThreadCache;
+
+        constexpr uint32_t OVERSIZE_CLASS = static_cast<uint32_t>(BufferPool::CLASS_COUNT);
+
+        // 블록 앞 16바이트 (사용자 포인터 16바이트 정렬 유지)
+        struct BlockHeader
+        {
+            ThreadCache* owner; // 마지막으로 할당한 스레드 캐시 (oversize / 전역 경로면 nullptr)
+            uint32_t size_class;
+            uint32_t reserved; // oversize면 요청 크기
+        };
+        static_assert(sizeof(BlockHeader) == 16);
+
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        BlockHeader* HeaderOf(void* p) { return reinterpret_cast<BlockHeader*>(static_cast<std::byte*>(p) - sizeof(BlockHeader)); }
+        void* UserOf(BlockHeader* header) { return reinterpret_cast<std::byte*>(header) + sizeof(BlockHeader); }
+        constexpr size_t ClassSize(size_t cls) { return BufferPool::MIN_CLASS_SIZE << cls; }
+        constexpr size_t ThreadCacheLimit(size_t cls) { return std::max<size_t>(4, BufferPool::THREAD_CACHE_BYTES / ClassSize(cls)); }
+        constexpr size_t GlobalCacheLimit(size_t cls) { return std::max<size_t>(8, BufferPool::GLOBAL_CACHE_BYTES / ClassSize(cls)); }
+
+        size_t ClassOf(size_t size)
+        {
+            size_t cls = 0;
+            while (ClassSize(cls) < size) ++cls;
+            return cls;
+        }
+
+        // 주인 스레드만 쓰는 카운터 (다른 스레드는 통계용으로 읽기만 -> RMW 없이 load + store)
+        struct Counter
+        {
+            std::atomic<uint64_t> value{0};
+            void Add(uint64_t n = 1) { value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+            uint64_t Get() const { return value.load(std::memory_order_relaxed); }
+        };
+
+        struct ThreadCache
+        {
+            std::array<FreeNode*, BufferPool::CLASS_COUNT> local{};
+            std::array<size_t, BufferPool::CLASS_COUNT> local_count{};
+            std::atomic<FreeNode*> remote{nullptr}; // 다른 스레드가 놓은 블록 (등급 섞임, 헤더로 구분)
+            std::atomic<bool> alive{true};
+
+            std::array<Counter, BufferPool::CLASS_COUNT> allocs;
+            std::array<Counter, BufferPool::CLASS_COUNT> hits;
+            std::array<Counter, BufferPool::CLASS_COUNT> frees;
+            Counter remote_frees;
+        };
+
+        struct GlobalPool
+        {
+            std::mutex mutex;
+            std::vector<ThreadCache*> caches; // 스레드가 끝나도 지우지 않음 (통계 보존 + 다음 스레드가 재사용)
+            std::array<FreeNode*, BufferPool::CLASS_COUNT> free{};
+            std::array<size_t, BufferPool::CLASS_COUNT> free_count{};
+
+            // 전역 경로(스레드 캐시 없음) 할당/해제 카운터
+            std::array<std::atomic<uint64_t>, BufferPool::CLASS_COUNT> allocs{};
+            std::array<std::atomic<uint64_t>, BufferPool::CLASS_COUNT> hits{};
+            std::array<std::atomic<uint64_t>, BufferPool::CLASS_COUNT> frees{};
+
+            // OS 할당은 캐시 미스 때만 -> 원자 연산 비용 무시 가능
+            std::array<std::atomic<uint64_t>, BufferPool::CLASS_COUNT> held{};
+            std::array<std::atomic<uint64_t>, BufferPool::CLASS_COUNT> high_water{};
+            std::atomic<uint64_t> oversize_allocs{0};
+            std::atomic<int64_t> oversize_live_bytes{0};
+        };
+
+        // 정적 파괴 순서와 무관하게 (전역 static 프레임이 종료 시 해제돼도) 살아 있도록 해제하지 않음
+        GlobalPool& Global()
+        {
+            static GlobalPool* pool = new GlobalPool();
+            return *pool;
+        }
+
+        void PushGlobal(GlobalPool& g, size_t cls, FreeNode* node)
+        {
+            // mutex_ 보유 상태에서 호출
+            if (g.free_count[cls] >= GlobalCacheLimit(cls))
+            {
+                std::free(HeaderOf(node));
+                g.held[cls].fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            node->next = g.free[cls];
+            g.free[cls] = node;
+            ++g.free_count[cls];
+        }
+
+        // 스레드 캐시 등급 하나의 절반을 전역 풀로
+        void SpillHalf(ThreadCache& cache, size_t cls)
+        {
+            auto& g = Global();
+            size_t spill = cache.local_count[cls] / 2;
+            std::lock_guard lock(g.mutex);
+            for (size_t i = 0; i < spill; ++i)
+            {
+                FreeNode* node = cache.local[cls];
+                cache.local[cls] = node->next;
+                PushGlobal(g, cls, node);
+            }
+            cache.local_count[cls] -= spill;
+        }
+
+        void PushLocal(ThreadCache& cache, size_t cls, FreeNode* node)
+        {
+            node->next = cache.local[cls];
+            cache.local[cls] = node;
+            if (++cache.local_count[cls] > ThreadCacheLimit(cls))
+                SpillHalf(cache, cls);
+        }
+
+        // 다른 스레드가 돌려보낸 블록을 내 캐시로
+        bool DrainRemote(ThreadCache& cache)
+        {
+            FreeNode* node = cache.remote.exchange(nullptr, std::memory_order_acquire);
+            if (!node) return false;
+            while (node)
+            {
+                FreeNode* next = node->next;
+                PushLocal(cache, HeaderOf(node)->size_class, node);
+                node = next;
+            }
+            return true;
+        }
+
+        ThreadCache* AdoptCache()
+        {
+            auto& g = Global();
+            std::lock_guard lock(g.mutex);
+            for (auto* cache : g.caches)
+            {
+                if (!cache->alive.load(std::memory_order_acquire))
+                {
+                    cache->alive.store(true, std::memory_order_release);
+                    return cache; // 끝난 스레드의 캐시 재사용 (남은 원격 해제는 다음 DrainRemote에서 회수)
+                }
+            }
+            g.caches.push_back(new ThreadCache());
+            return g.caches.back();
+        }
+
+        void RetireCache(ThreadCache* cache)
+        {
+            auto& g = Global();
+            cache->alive.store(false, std::memory_order_release); // 이후 원격 해제는 전역 풀로 감
+            FreeNode* remote = cache->remote.exchange(nullptr, std::memory_order_acquire);
+
+            std::lock_guard lock(g.mutex);
+            for (size_t cls = 0; cls < BufferPool::CLASS_COUNT; ++cls)
+            {
+                while (FreeNode* node = cache->local[cls])
+                {
+                    cache->local[cls] = node->next;
+                    PushGlobal(g, cls, node);
+                }
+                cache->local_count[cls] = 0;
+            }
+            while (remote)
+            {
+                FreeNode* next = remote->next;
+                PushGlobal(g, HeaderOf(remote)->size_class, remote);
+                remote = next;
+            }
+        }
+
+        // 스레드 종료 시 캐시를 전역으로 돌려놓음
+        // tls_cache는 소멸자가 없는 포인터 -> 종료 중 다른 thread_local 소멸자가 버퍼를 놓아도 안전하게 전역 경로로
+        thread_local ThreadCache* tls_cache = nullptr;
+        thread_local bool tls_retired = false;
+
+        struct CacheHolder
+        {
+            ~CacheHolder()
+            {
+                if (!tls_cache) return;
+                RetireCache(tls_cache);
+                tls_cache = nullptr;
+                tls_retired = true;
+            }
+        };
+
+        ThreadCache* CurrentCache()
+        {
+            if (tls_cache || tls_retired) return tls_cache;
+            thread_local CacheHolder holder;
+            tls_cache = AdoptCache();
+            return tls_cache;
+        }
+
+        void* AllocateFromOS(size_t cls, ThreadCache* owner)
+        {
+            auto* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + ClassSize(cls)));
+            if (!header) throw std::bad_alloc();
+            header->owner = owner;
+            header->size_class = static_cast<uint32_t>(cls);
+            header->reserved = 0;
+
+            auto& g = Global();
+            uint64_t held = g.held[cls].fetch_add(1, std::memory_order_relaxed) + 1;
+            uint64_t peak = g.high_water[cls].load(std::memory_order_relaxed);
+            while (held > peak && !g.high_water[cls].compare_exchange_weak(peak, held, std::memory_order_relaxed)) {}
+            return UserOf(header);
+        }
+    }
+
+    void* BufferPool::Allocate(size_t size)
+    {
+        if (size > MAX_POOLED_SIZE)
+        {
+            auto* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+            if (!header) throw std::bad_alloc();
+            header->owner = nullptr;
+            header->size_class = OVERSIZE_CLASS;
+            header->reserved = static_cast<uint32_t>(size); // 프레임 본문은 uint32 크기라 넘치지 않음
+            auto& g = Global();
+            g.oversize_allocs.fetch_add(1, std::memory_order_relaxed);
+            g.oversize_live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+#ifdef YISO_ALLOC_ACCOUNTING
+            AllocAccounting::OnPoolAlloc(size);
+#endif
+            return UserOf(header);
+        }
+
+        size_t cls = ClassOf(std::max<size_t>(size, 1));
+#ifdef YISO_ALLOC_ACCOUNTING
+        AllocAccounting::OnPoolAlloc(ClassSize(cls));
+#endif
+        ThreadCache* cache = CurrentCache();
+        auto& g = Global();
+
+        if (!cache)
+        {
+            // 스레드 종료 중 -> 전역 풀에서 직접
+            g.allocs[cls].fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard lock(g.mutex);
+                if (FreeNode* node = g.free[cls])
+                {
+                    g.free[cls] = node->next;
+                    --g.free_count[cls];
+                    g.hits[cls].fetch_add(1, std::memory_order_relaxed);
+                    HeaderOf(node)->owner = nullptr;
+                    return node;
+                }
+            }
+            return AllocateFromOS(cls, nullptr);
+        }
+
+        cache->allocs[cls].Add();
+        if (!cache->local[cls] && cache->remote.load(std::memory_order_relaxed))
+            DrainRemote(*cache);
+
+        if (!cache->local[cls])
+        {
+            // 전역 풀에서 묶음으로 가져와 다음 할당들도 캐시에서 나가게
+            std::lock_guard lock(g.mutex);
+            for (size_t i = 0; i < GLOBAL_BATCH && g.free[cls]; ++i)
+            {
+                FreeNode* node = g.free[cls];
+                g.free[cls] = node->next;
+                --g.free_count[cls];
+                node->next = cache->local[cls];
+                cache->local[cls] = node;
+                ++cache->local_count[cls];
+            }
+        }
+
+        if (FreeNode* node = cache->local[cls])
+        {
+            cache->local[cls] = node->next;
+            --cache->local_count[cls];
+            cache->hits[cls].Add();
+            HeaderOf(node)->owner = cache;
+            return node;
+        }
+        return AllocateFromOS(cls, cache);
+    }
+
+    void BufferPool::Free(void* p) noexcept
+    {
+        if (!p) return;
+        BlockHeader* header = HeaderOf(p);
+        auto& g = Global();
+
+        if (header->size_class == OVERSIZE_CLASS)
+        {
+            g.oversize_live_bytes.fetch_sub(static_cast<int64_t>(header->reserved), std::memory_order_relaxed);
+            std::free(header);
+            return;
+        }
+
+        size_t cls = header->size_class;
+        auto* node = static_cast<FreeNode*>(p);
+        ThreadCache* cache = CurrentCache();
+        ThreadCache* owner = header->owner;
+
+        if (cache && owner == cache)
+        {
+            cache->frees[cls].Add();
+            PushLocal(*cache, cls, node);
+            return;
+        }
+
+        if (cache)
+            cache->frees[cls].Add();
+        else
+            g.frees[cls].fetch_add(1, std::memory_order_relaxed);
+
+        if (owner && owner->alive.load(std::memory_order_acquire))
+        {
+            // 주인 스레드 원격 목록에 push (주인만 exchange로 통째 가져가므로 ABA 없음)
+            FreeNode* head = owner->remote.load(std::memory_order_relaxed);
+            do
+            {
+                node->next = head;
+            } while (!owner->remote.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+            if (cache) cache->remote_frees.Add();
+            return;
+        }
+
+        if (cache)
+        {
+            // 주인이 없거나 끝난 블록 -> 내 캐시가 입양
+            PushLocal(*cache, cls, node);
+            return;
+        }
+        std::lock_guard lock(g.mutex);
+        PushGlobal(g, cls, node);
+    }
+
+    BufferPool::Stats BufferPool::GetStats()
+    {
+        auto& g = Global();
+        Stats stats{};
+        std::array<uint64_t, CLASS_COUNT> frees{};
+
+        std::lock_guard lock(g.mutex);
+        for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+        {
+            auto& c = stats.classes[cls];
+            c.size = ClassSize(cls);
+            c.allocs = g.allocs[cls].load(std::memory_order_relaxed);
+            c.hits = g.hits[cls].load(std::memory_order_relaxed);
+            frees[cls] = g.frees[cls].load(std::memory_order_relaxed);
+        }
+        for (const auto* cache : g.caches)
+        {
+            for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+            {
+                stats.classes[cls].allocs += cache->allocs[cls].Get();
+                stats.classes[cls].hits += cache->hits[cls].Get();
+                frees[cls] += cache->frees[cls].Get();
+            }
+            stats.remote_frees += cache->remote_frees.Get();
+        }
+        for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+        {
+            auto& c = stats.classes[cls];
+            c.live = c.allocs >= frees[cls] ? c.allocs - frees[cls] : 0; // 스레드별 카운터를 따로 읽어 순간적으로 어긋날 수 있음
+            c.held = g.held[cls].load(std::memory_order_relaxed);
+            c.high_water = g.high_water[cls].load(std::memory_order_relaxed);
+            stats.allocs += c.allocs;
+            stats.hits += c.hits;
+            stats.live_bytes += c.live * c.size;
+            stats.held_bytes += c.held * c.size;
+        }
+        stats.oversize_allocs = g.oversize_allocs.load(std::memory_order_relaxed);
+        stats.oversize_live_bytes = static_cast<uint64_t>(std::max<int64_t>(0, g.oversize_live_bytes.load(std::memory_order_relaxed)));
+        return stats;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 프레임 / 수신 본문용 크기 등급 버퍼 풀
+    // - 64B ~ 64KB 2의 거듭제곱 등급, 그보다 큰 요청은 일반 할당 (oversize로 집계)
+    // - 스레드별 캐시에서 락 없이 꺼내고 넣음
+    // - 다른 스레드가 해제한 버퍼는 주인(마지막으로 할당한) 스레드의 원격 해제 목록으로 보냄
+    //   -> 주인 스레드 캐시가 비었을 때 한 번에 회수 (io 스레드에서 만든 프레임을 로직 스레드가 놓는 경우 등)
+    // - 스레드 캐시가 등급별 상한을 넘으면 절반을 전역 풀로, 전역 풀도 넘치면 OS에 반납
+    class BufferPool
+    {
+    public:
+        static constexpr size_t MIN_CLASS_SIZE = 64;
+        static constexpr size_t CLASS_COUNT = 11; // 64B .. 64KB
+        static constexpr size_t MAX_POOLED_SIZE = MIN_CLASS_SIZE << (CLASS_COUNT - 1);
+        static constexpr size_t THREAD_CACHE_BYTES = 256 * 1024; // 스레드 캐시 등급별 상한
+        static constexpr size_t GLOBAL_CACHE_BYTES = 4 * 1024 * 1024; // 전역 풀 등급별 상한
+        static constexpr size_t GLOBAL_BATCH = 16; // 전역 풀에서 한 번에 가져오는 블록 수
+
+        static void* Allocate(size_t size);
+        static void Free(void* p) noexcept;
+
+        struct ClassStats
+        {
+            size_t size;
+            uint64_t allocs;
+            uint64_t hits; // 캐시에서 바로 나간 할당
+            uint64_t live; // 사용 중인 블록
+            uint64_t held; // OS에서 받아 아직 반납하지 않은 블록 (사용 중 + 캐시)
+            uint64_t high_water; // held 최대치
+        };
+
+        struct Stats
+        {
+            uint64_t allocs;
+            uint64_t hits;
+            uint64_t oversize_allocs;
+            uint64_t oversize_live_bytes;
+            uint64_t remote_frees; // 다른 스레드 캐시로 돌려보낸 해제
+            uint64_t live_bytes; // 등급 크기 기준
+            uint64_t held_bytes; // live_bytes와의 차이 = 캐시에 놀고 있는 바이트
+            std::array<ClassStats, CLASS_COUNT> classes;
+        };
+
+        static Stats GetStats();
+    };
+
+    // std::vector 등에 꽂는 풀 할당자 (상태 없음)
+    template<typename T>
+    class BufferAllocator
+    {
+    public:
+        using value_type = T;
+
+        BufferAllocator() = default;
+        template<typename U>
+        BufferAllocator(const BufferAllocator<U>&) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(BufferPool::Allocate(n * sizeof(T))); }
+        void deallocate(T* p, size_t) noexcept { BufferPool::Free(p); }
+
+        template<typename U>
+        bool operator==(const BufferAllocator<U>&) const { return true; }
+        template<typename U>
+        bool operator!=(const BufferAllocator<U>&) const { return false; }
+    };
+
+    // 와이어 프레임 / 수신 본문 바이트 (인코딩 -> 송신 큐 -> write 완료 후 해제까지 풀 안에서 순환)
+    using Buffer = std::vector<uint8_t, BufferAllocator<uint8_t>>;
+}
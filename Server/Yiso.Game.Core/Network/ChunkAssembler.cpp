@@ -0,0 +1,106 @@
+#include "ChunkAssembler.h"
+#include "HotRestart.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Yiso::Network
+{
+    ChunkAssembler::ChunkAssembler(SizeLimit sizeLimit, uint32_t maxMessageSize)
+        : size_limit_(sizeLimit),
+          max_message_size_(maxMessageSize)
+    {
+    }
+
+    ChunkAssembler::Result ChunkAssembler::Feed(const uint8_t* data, uint32_t size, PacketType& type, const uint8_t*& body, uint32_t& bodySize)
+    {
+        if (size <= CHUNK_HEADER_SIZE) return Result::Error;
+
+        ChunkHeader header;
+        std::memcpy(&header, data, CHUNK_HEADER_SIZE);
+        if (header.stream >= MAX_STREAMS) return Result::Error;
+
+        auto& stream = streams_[header.stream];
+        if (stream.completed)
+        {
+            stream.buffer.clear(); // capacity 유지 -> 같은 stream의 다음 큰 메시지는 재할당 없음
+            stream.completed = false;
+        }
+
+        if (stream.buffer.empty())
+        {
+            uint32_t limit = max_message_size_;
+            if (size_limit_)
+                limit = std::min(limit, size_limit_(static_cast<PacketType>(header.type)));
+            if (header.total_size == 0 || header.total_size > limit) return Result::Error;
+            stream.total_size = header.total_size;
+            stream.type = header.type;
+            // 미리 reserve하지 않음 -> 첫 조각의 total_size만으로 메모리를 잡지 못하게 (조각이 오는 만큼 늘어남)
+        }
+        else if (header.total_size != stream.total_size || header.type != stream.type)
+        {
+            return Result::Error; // 이전 메시지가 끝나기 전에 다른 메시지 조각
+        }
+
+        uint32_t piece = size - CHUNK_HEADER_SIZE;
+        if (piece > stream.total_size - stream.buffer.size()) return Result::Error;
+        stream.buffer.insert(stream.buffer.end(), data + CHUNK_HEADER_SIZE, data + size);
+
+        if (stream.buffer.size() < stream.total_size) return Result::Incomplete;
+
+        stream.completed = true;
+        type = static_cast<PacketType>(stream.type);
+        body = stream.buffer.data();
+        bodySize = stream.total_size;
+        return Result::Complete;
+    }
+
+    bool ChunkAssembler::Idle() const
+    {
+        for (const auto& stream : streams_)
+        {
+            if (!stream.completed && !stream.buffer.empty()) return false;
+        }
+        return true;
+    }
+
+    void ChunkAssembler::ExportHandoff(HandoffWriter& writer) const
+    {
+        uint8_t count = 0;
+        for (const auto& stream : streams_)
+            count += !stream.completed && !stream.buffer.empty();
+        writer.Put(count);
+        for (size_t i = 0; i < MAX_STREAMS; ++i)
+        {
+            const auto& stream = streams_[i];
+            if (stream.completed || stream.buffer.empty()) continue;
+            ChunkHeader header;
+            header.total_size = stream.total_size;
+            header.type = stream.type;
+            header.stream = static_cast<uint8_t>(i);
+            header.reserved = 0;
+            writer.Put(header);
+            writer.PutBytes(stream.buffer.data(), stream.buffer.size());
+        }
+    }
+
+    bool ChunkAssembler::ImportHandoff(HandoffReader& reader)
+    {
+        // 받은 만큼을 조각 하나로 다시 넣음 (검사도 Feed와 같게)
+        auto count = reader.Get<uint8_t>();
+        for (uint8_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto header = reader.Get<ChunkHeader>();
+            Buffer piece(CHUNK_HEADER_SIZE);
+            std::memcpy(piece.data(), &header, CHUNK_HEADER_SIZE);
+            Buffer bytes = reader.GetBuffer();
+            piece.insert(piece.end(), bytes.begin(), bytes.end());
+
+            PacketType type;
+            const uint8_t* body;
+            uint32_t bodySize;
+            if (Feed(piece.data(), static_cast<uint32_t>(piece.size()), type, body, bodySize) != Result::Incomplete)
+                return false;
+        }
+        return reader.Ok();
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "PacketHeader.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Yiso::Network
+{
+    class HandoffWriter;
+    class HandoffReader;
+
+    // FRAME_CHUNK 조각을 stream별로 이어붙여 원본 패킷으로 복원
+    // 세션(연결)마다 하나, 읽기 스레드에서만 사용
+    class ChunkAssembler
+    {
+    public:
+        enum class Result
+        {
+            Incomplete,
+            Complete, // type / body / bodySize에 원본 패킷 (다음 Feed 전까지 유효)
+            Error, // 잘못된 조각 -> 연결 종료 대상
+        };
+
+        static constexpr size_t MAX_STREAMS = 4;
+
+        // 원본 type별 상한 (0이면 그 type은 조각 불가), 없으면 모든 type이 maxMessageSize까지
+        using SizeLimit = uint32_t (*)(PacketType);
+
+        explicit ChunkAssembler(SizeLimit sizeLimit = nullptr, uint32_t maxMessageSize = MAX_MESSAGE_SIZE);
+
+        Result Feed(const uint8_t* data, uint32_t size, PacketType& type, const uint8_t*& body, uint32_t& bodySize);
+        bool Idle() const; // 조립 중인 메시지 없음 (버리고 새로 만들어도 됨)
+
+        // 무중단 재시작: 조립 중인 stream만 옮김
+        void ExportHandoff(HandoffWriter& writer) const;
+        bool ImportHandoff(HandoffReader& reader);
+
+    private:
+        struct Stream
+        {
+            std::vector<uint8_t> buffer; // 받은 만큼만 커짐 (total_size를 미리 잡지 않음)
+            uint32_t total_size = 0;
+            uint16_t type = 0;
+            bool completed = false; // 직전 Feed에서 완성 -> 다음 조각 때 비움
+        };
+
+        SizeLimit size_limit_;
+        uint32_t max_message_size_;
+        std::array<Stream, MAX_STREAMS> streams_;
+    };
+}
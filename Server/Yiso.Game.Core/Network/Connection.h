@@ -0,0 +1,25 @@
+#pragma once
+#include "BufferPool.h"
+#include <cstdint>
+
+namespace Yiso::Network
+{
+    // 세션 매니저가 보는 연결 하나 (전송 계층과 무관한 부분만)
+    // - YisoSession: TCP 소켓
+    // - LoopbackTransport: 같은 프로세스 안의 가상 연결 (시뮬레이터)
+    class Connection
+    {
+    public:
+        using SessionId = uint32_t;
+
+        virtual ~Connection() = default;
+
+        virtual SessionId GetId() const = 0;
+        virtual void Send(Buffer frame) = 0; // 헤더 포함 프레임 (여러 프레임을 이어붙인 버퍼도 가능)
+        virtual void Disconnect() = 0; // 끊긴 뒤 on_disconnect -> 세션 매니저에서 제거
+
+        // 유휴 관리 (세션 매니저 SweepIdle) -> 시각/버퍼를 따로 관리하지 않는 전송 계층은 기본값
+        virtual uint32_t IdleSeconds(uint32_t now) const { return 0; }
+        virtual void ReleaseBuffers() {}
+    };
+}
@@ -0,0 +1,64 @@
+#include "Envelope.h"
+#include "WireFormat.h"
+#include <cstring>
+
+namespace Yiso::Network
+{
+    EnvelopeReader::Result EnvelopeReader::Next(PacketType& type, const uint8_t*& body, uint32_t& bodySize)
+    {
+        if (pos_ == end_) return Result::End;
+
+        uint64_t rawType;
+        uint64_t size;
+        size_t n = Wire::ReadVarint(pos_, end_, rawType);
+        if (n == 0 || rawType > UINT16_MAX) return Result::Error;
+        size_t m = Wire::ReadVarint(pos_ + n, end_, size);
+        if (m == 0 || size > static_cast<uint64_t>(end_ - pos_ - n - m)) return Result::Error;
+
+        type = static_cast<PacketType>(rawType);
+        if (!IsEnvelopeItemType(type)) return Result::Error;
+        body = pos_ + n + m;
+        bodySize = static_cast<uint32_t>(size);
+        pos_ = body + size;
+        return Result::Item;
+    }
+
+    EnvelopeWriter::EnvelopeWriter(Buffer& out)
+        : out_(out)
+    {
+        out_.resize(HEADER_SIZE);
+    }
+
+    void EnvelopeWriter::Add(PacketType type, const uint8_t* body, uint32_t size)
+    {
+        size_t at = out_.size();
+        out_.resize(at + MAX_ITEM_OVERHEAD + size);
+        uint8_t* dst = out_.data() + at;
+        dst += Wire::WriteVarint(dst, static_cast<uint16_t>(type));
+        dst += Wire::WriteVarint(dst, size);
+        if (size > 0)
+            std::memcpy(dst, body, size);
+        out_.resize(static_cast<size_t>(dst + size - out_.data()));
+        ++count_;
+    }
+
+    void EnvelopeWriter::AddFrame(const uint8_t* frame)
+    {
+        PacketHeader header;
+        std::memcpy(&header, frame, HEADER_SIZE);
+        Add(static_cast<PacketType>(header.type), frame + HEADER_SIZE, header.body_size);
+    }
+
+    void EnvelopeWriter::Finish(PacketType envelopeType)
+    {
+        PacketHeader header;
+        header.body_size = static_cast<uint32_t>(out_.size() - HEADER_SIZE);
+        header.type = static_cast<uint16_t>(envelopeType);
+        std::memcpy(out_.data(), &header, HEADER_SIZE);
+    }
+
+    size_t EnvelopeWriter::ItemSize(PacketType type, uint32_t size)
+    {
+        return Wire::VarintSize(static_cast<uint16_t>(type)) + Wire::VarintSize(size) + size;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "PacketHeader.h"
+#include "BufferPool.h"
+#include <cstdint>
+
+namespace Yiso::Network
+{
+    // 봉투 프레임 (type = C2S/S2C_ENVELOPE): 여러 메시지를 와이어 프레임 하나에
+    // [ PacketHeader ][ item ][ item ] ...
+    // item = [ type: varint ][ body_size: varint ][ body ] -> 메시지당 헤더 6바이트 대신 보통 2~4바이트
+    // - item은 FRAME_CHUNK / ENVELOPE / 재개 요청 / HELLO가 될 수 없음 (큰 메시지는 봉투 밖에서 조각으로)
+    //   서버는 C2S 게임 메시지만 받음 (IsGameC2SType, 그 밖의 item이면 연결 종료)
+    // - 협상: C2S_Hello.envelope를 켠 연결에만 서버가 S2C_ENVELOPE로 묶어 보냄 (C2S_ENVELOPE를 받았다고 켜지 않음)
+    //   재개로 소켓이 바뀌면 다시 보내야 함
+    // - 세션 재개 순번은 item 하나를 프레임 하나로 셈 (봉투 자체는 세지 않음)
+    class EnvelopeReader
+    {
+    public:
+        enum class Result
+        {
+            Item, // type / body / bodySize에 다음 item (봉투 버퍼가 살아 있는 동안 유효)
+            End,
+            Error, // 잘린 item / 허용되지 않는 type -> 연결 종료 대상
+        };
+
+        EnvelopeReader(const uint8_t* body, uint32_t size) : pos_(body), end_(body + size) {}
+
+        Result Next(PacketType& type, const uint8_t*& body, uint32_t& bodySize);
+
+    private:
+        const uint8_t* pos_;
+        const uint8_t* end_;
+    };
+
+    class EnvelopeWriter
+    {
+    public:
+        static constexpr size_t MAX_ITEM_OVERHEAD = 3 + 5; // varint(uint16) + varint(uint32)
+
+        // out을 비우고 헤더 자리부터 씀 (capacity는 그대로 재사용)
+        explicit EnvelopeWriter(Buffer& out);
+
+        void Add(PacketType type, const uint8_t* body, uint32_t size);
+        void AddFrame(const uint8_t* frame); // 완성된 [헤더][본문] 프레임 하나를 item으로
+        size_t Count() const { return count_; }
+        size_t BodySize() const { return out_.size() - HEADER_SIZE; }
+        void Finish(PacketType envelopeType); // 헤더 채움 -> out이 프레임 하나
+
+        static size_t ItemSize(PacketType type, uint32_t size);
+
+    private:
+        Buffer& out_;
+        size_t count_ = 0;
+    };
+
+    inline bool IsEnvelopeItemType(PacketType type)
+    {
+        return type != PacketType::C2S_ENVELOPE && type != PacketType::S2C_ENVELOPE &&
+               type != PacketType::C2S_FRAME_CHUNK && type != PacketType::S2C_FRAME_CHUNK &&
+               type != PacketType::C2S_RESUME_SESSION && type != PacketType::C2S_HELLO && type != PacketType::UNKNOWN;
+    }
+}
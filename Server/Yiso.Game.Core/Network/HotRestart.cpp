@@ -0,0 +1,352 @@
+#include "HotRestart.h"
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace Yiso::Network
+{
+    void HandoffWriter::PutBytes(const uint8_t* data, size_t size)
+    {
+        Put(static_cast<uint32_t>(size));
+        data_.insert(data_.end(), data, data + size);
+    }
+
+    bool HandoffReader::GetBytes(const uint8_t*& data, uint32_t& size)
+    {
+        size = Get<uint32_t>();
+        if (!ok_ || static_cast<size_t>(end_ - p_) < size)
+        {
+            ok_ = false;
+            p_ = end_;
+            data = nullptr;
+            size = 0;
+            return false;
+        }
+        data = p_;
+        p_ += size;
+        return true;
+    }
+
+    Buffer HandoffReader::GetBuffer()
+    {
+        const uint8_t* data;
+        uint32_t size;
+        if (!GetBytes(data, size)) return {};
+        return Buffer(data, data + size);
+    }
+
+    std::string HandoffReader::GetString()
+    {
+        const uint8_t* data;
+        uint32_t size;
+        if (!GetBytes(data, size)) return {};
+        return std::string(reinterpret_cast<const char*>(data), size);
+    }
+
+    int64_t HotRestart::NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+#ifdef __linux__
+    namespace
+    {
+        // 요청 / 응답 머리 (접속하면 새 프로세스가 Hello, 이전 프로세스가 Header를 보냄)
+        struct Hello
+        {
+            uint32_t magic;
+            uint32_t version;
+        };
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t fd_count; // 리슨 소켓 포함
+            uint32_t reserved;
+            uint64_t state_size;
+            int64_t paused_at_ns;
+        };
+
+        constexpr uint8_t FINISH_BYTE = 'F';
+
+        bool WriteAll(int fd, const void* data, size_t size)
+        {
+            const auto* p = static_cast<const uint8_t*>(data);
+            while (size > 0)
+            {
+                ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                p += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool ReadAll(int fd, void* data, size_t size)
+        {
+            auto* p = static_cast<uint8_t*>(data);
+            while (size > 0)
+            {
+                ssize_t n = ::recv(fd, p, size, 0);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                p += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        // fd 묶음 하나 = 1바이트 본문 + SCM_RIGHTS
+        bool SendFds(int fd, const int* fds, size_t count)
+        {
+            uint8_t byte = 0;
+            iovec iov{ &byte, 1 };
+            std::vector<uint8_t> control(CMSG_SPACE(sizeof(int) * count));
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control.data();
+            msg.msg_controllen = control.size();
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+            std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * count);
+
+            ssize_t n;
+            do { n = ::sendmsg(fd, &msg, MSG_NOSIGNAL); } while (n < 0 && errno == EINTR);
+            return n == 1;
+        }
+
+        bool ReceiveFds(int fd, std::vector<int>& out, size_t count)
+        {
+            uint8_t byte;
+            iovec iov{ &byte, 1 };
+            std::vector<uint8_t> control(CMSG_SPACE(sizeof(int) * count));
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control.data();
+            msg.msg_controllen = control.size();
+
+            ssize_t n;
+            do { n = ::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC); } while (n < 0 && errno == EINTR);
+            if (n != 1 || (msg.msg_flags & MSG_CTRUNC)) return false;
+
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+            {
+                if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+                size_t received = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                const uint8_t* data = CMSG_DATA(cmsg);
+                for (size_t i = 0; i < received; ++i)
+                {
+                    int value;
+                    std::memcpy(&value, data + i * sizeof(int), sizeof(int));
+                    out.push_back(value);
+                }
+            }
+            return true;
+        }
+    }
+
+    struct HotRestart::Impl
+    {
+        explicit Impl(boost::asio::io_context& io) : acceptor(io), connection(io) {}
+
+        boost::asio::local::stream_protocol::acceptor acceptor;
+        boost::asio::local::stream_protocol::socket connection;
+        Hello hello{};
+        std::function<void()> on_request;
+    };
+
+    HotRestart::HotRestart() = default;
+    HotRestart::~HotRestart() = default;
+
+    bool HotRestart::Receive(const std::string& path, Package& out)
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            ::close(fd);
+            spdlog::error("[HotRestart] 경로가 너무 김: {}", path);
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            ::close(fd);
+            spdlog::info("[HotRestart] 인계할 이전 프로세스 없음 ({}) -> 보통 시작", path);
+            return false;
+        }
+
+        timeval timeout{ RECEIVE_TIMEOUT_SEC, 0 };
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        Package package;
+        std::vector<int> fds;
+        Header header{};
+        Hello hello{ MAGIC, VERSION };
+        uint8_t finish = 0;
+        bool ok = WriteAll(fd, &hello, sizeof(hello)) && ReadAll(fd, &header, sizeof(header)) &&
+                  header.magic == MAGIC && header.version == VERSION && header.fd_count >= 1;
+        while (ok && fds.size() < header.fd_count)
+            ok = ReceiveFds(fd, fds, std::min<size_t>(MAX_FDS_PER_MESSAGE, header.fd_count - fds.size()));
+        if (ok)
+        {
+            package.state.resize(header.state_size);
+            ok = ReadAll(fd, package.state.data(), package.state.size()) && ReadAll(fd, &finish, 1) && finish == FINISH_BYTE;
+        }
+        ::close(fd);
+
+        if (!ok || fds.size() != header.fd_count)
+        {
+            spdlog::error("[HotRestart] 인계 받기 실패 (fd {}/{}개) -> 보통 시작", fds.size(), header.fd_count);
+            for (int received : fds)
+                ::close(received);
+            return false;
+        }
+
+        package.listen_fd = fds.front();
+        package.fds.assign(fds.begin() + 1, fds.end());
+        package.paused_at_ns = header.paused_at_ns;
+        out = std::move(package);
+        spdlog::info("[HotRestart] 인계 받음: 세션 소켓 {}개, 상태 {} bytes", out.fds.size(), out.state.size());
+        return true;
+    }
+
+    bool HotRestart::Listen(boost::asio::io_context& io, const std::string& path, std::function<void()> onRequest)
+    {
+        impl_ = std::make_unique<Impl>(io);
+        impl_->on_request = std::move(onRequest);
+
+        ::unlink(path.c_str()); // 이전 프로세스가 쓰던 경로 (그쪽 소켓은 인계가 끝났으면 더 쓰지 않음)
+        boost::system::error_code ec;
+        boost::asio::local::stream_protocol::endpoint endpoint(path);
+        impl_->acceptor.open(endpoint.protocol(), ec);
+        if (!ec) impl_->acceptor.bind(endpoint, ec);
+        if (!ec) impl_->acceptor.listen(1, ec);
+        if (ec)
+        {
+            spdlog::error("[HotRestart] {} 대기 실패: {}", path, ec.message());
+            impl_.reset();
+            return false;
+        }
+
+        impl_->acceptor.async_accept(impl_->connection, [this](boost::system::error_code ec)
+        {
+            if (ec) return;
+            boost::asio::async_read(impl_->connection, boost::asio::buffer(&impl_->hello, sizeof(Hello)),
+                [this](boost::system::error_code ec, size_t)
+                {
+                    if (ec || impl_->hello.magic != MAGIC || impl_->hello.version != VERSION)
+                    {
+                        spdlog::warn("[HotRestart] 잘못된 인계 요청 -> 무시");
+                        return; // 요청은 한 번만 받음 (재배포 스크립트가 다시 시도하려면 이 프로세스를 재시작)
+                    }
+                    spdlog::info("[HotRestart] 새 프로세스 인계 요청");
+                    boost::system::error_code ignored;
+                    impl_->acceptor.close(ignored);
+                    impl_->on_request();
+                });
+        });
+        spdlog::info("[HotRestart] {} 에서 인계 요청 대기", path);
+        return true;
+    }
+
+    bool HotRestart::Send(const Package& package)
+    {
+        if (!impl_) return false;
+        int fd = impl_->connection.native_handle();
+        boost::system::error_code ignored;
+        impl_->connection.non_blocking(false, ignored);
+
+        std::vector<int> fds;
+        fds.reserve(package.fds.size() + 1);
+        fds.push_back(package.listen_fd);
+        fds.insert(fds.end(), package.fds.begin(), package.fds.end());
+
+        Header header{};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.fd_count = static_cast<uint32_t>(fds.size());
+        header.state_size = package.state.size();
+        header.paused_at_ns = package.paused_at_ns;
+
+        bool ok = WriteAll(fd, &header, sizeof(header));
+        for (size_t sent = 0; ok && sent < fds.size(); sent += MAX_FDS_PER_MESSAGE)
+            ok = SendFds(fd, fds.data() + sent, std::min(MAX_FDS_PER_MESSAGE, fds.size() - sent));
+        ok = ok && WriteAll(fd, package.state.data(), package.state.size());
+        if (!ok)
+            spdlog::error("[HotRestart] 인계 보내기 실패 (errno={})", errno);
+        return ok;
+    }
+
+    void HotRestart::CloseHandle(int fd)
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    void HotRestart::StopListening()
+    {
+        if (!impl_) return;
+        boost::system::error_code ignored;
+        impl_->acceptor.close(ignored);
+        impl_->connection.close(ignored);
+    }
+
+    void HotRestart::Finish()
+    {
+        if (!impl_) return;
+        WriteAll(impl_->connection.native_handle(), &FINISH_BYTE, 1);
+        boost::system::error_code ignored;
+        impl_->connection.close(ignored);
+    }
+#else
+    struct HotRestart::Impl
+    {
+    };
+
+    HotRestart::HotRestart() = default;
+    HotRestart::~HotRestart() = default;
+
+    bool HotRestart::Receive(const std::string&, Package&)
+    {
+        return false;
+    }
+
+    bool HotRestart::Listen(boost::asio::io_context&, const std::string&, std::function<void()>)
+    {
+        spdlog::warn("[HotRestart] 이 플랫폼은 무중단 재시작을 지원하지 않음");
+        return false;
+    }
+
+    bool HotRestart::Send(const Package&)
+    {
+        return false;
+    }
+
+    void HotRestart::CloseHandle(int)
+    {
+    }
+
+    void HotRestart::Finish()
+    {
+    }
+
+    void HotRestart::StopListening()
+    {
+    }
+#endif
+}
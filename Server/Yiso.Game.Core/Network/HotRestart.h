@@ -0,0 +1,106 @@
+#pragma once
+#include "BufferPool.h"
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 인계 상태 직렬화 (같은 바이너리 계열끼리만 주고받으므로 엔디안 / 정렬은 호스트 그대로)
+    class HandoffWriter
+    {
+    public:
+        template <typename T>
+        void Put(T value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* p = reinterpret_cast<const uint8_t*>(&value);
+            data_.insert(data_.end(), p, p + sizeof(T));
+        }
+        void PutBytes(const uint8_t* data, size_t size); // [u32 길이][바이트]
+        void PutString(const std::string& text) { PutBytes(reinterpret_cast<const uint8_t*>(text.data()), text.size()); }
+
+        Buffer& Data() { return data_; }
+
+    private:
+        Buffer data_;
+    };
+
+    // 읽다가 범위를 벗어나면 이후 값은 모두 0 / 빈 값, Ok()가 false
+    class HandoffReader
+    {
+    public:
+        HandoffReader(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+        template <typename T>
+        T Get()
+        {
+            T value{};
+            if (static_cast<size_t>(end_ - p_) < sizeof(T))
+            {
+                ok_ = false;
+                p_ = end_;
+                return value;
+            }
+            std::memcpy(&value, p_, sizeof(T));
+            p_ += sizeof(T);
+            return value;
+        }
+        bool GetBytes(const uint8_t*& data, uint32_t& size); // 리더 버퍼 안을 가리킴
+        Buffer GetBuffer();
+        std::string GetString();
+
+        bool Ok() const { return ok_; }
+
+    private:
+        const uint8_t* p_;
+        const uint8_t* end_;
+        bool ok_ = true;
+    };
+
+    // 무중단 재시작 (Linux 전용, 다른 플랫폼에서는 항상 실패 -> 보통 재시작)
+    // - 이전 프로세스가 Unix 도메인 소켓(path)에서 대기, 새 프로세스가 접속해 인계 요청
+    // - 이전 프로세스: 수락 / 읽기를 멈추고 로직 큐를 비운 뒤 리슨 소켓 + 세션 소켓 fd(SCM_RIGHTS)와 상태를 보냄
+    //   -> 자기 쪽 소켓은 shutdown 없이 닫고 (연결은 새 프로세스의 fd로 계속) 남은 저장을 마친 뒤 Finish
+    // - 새 프로세스: Finish 신호까지 받은 뒤 (WAL 등 파일을 이전 프로세스가 다 놓은 뒤) 상태 복원 후 시작
+    class HotRestart
+    {
+    public:
+        struct Package
+        {
+            int listen_fd = -1;
+            std::vector<int> fds; // 세션 소켓 (상태에서는 인덱스로 참조)
+            Buffer state;
+            int64_t paused_at_ns = 0; // 이전 프로세스가 멈춘 시각 (steady_clock, 같은 머신이면 프로세스끼리 비교 가능)
+        };
+
+        static constexpr uint32_t MAGIC = 0x53524859; // "YHRS"
+        static constexpr uint32_t VERSION = 3; // 상태 형식이 바뀌면 올림 (버전이 다르면 인계하지 않고 보통 시작)
+        static constexpr size_t MAX_FDS_PER_MESSAGE = 200; // SCM_RIGHTS 한 메시지 한도(253)보다 작게
+        static constexpr int RECEIVE_TIMEOUT_SEC = 30; // 이전 프로세스가 저장을 마치고 Finish할 때까지 포함
+
+        HotRestart();
+        ~HotRestart();
+
+        // 새 프로세스: path에 이전 프로세스가 있으면 인계받음 (없거나 실패하면 false -> 보통 시작)
+        static bool Receive(const std::string& path, Package& out);
+
+        // 이전 프로세스 (io 스레드): path에서 다음 프로세스의 요청 대기 -> onRequest 호출 (요청은 한 번만 받음)
+        bool Listen(boost::asio::io_context& io, const std::string& path, std::function<void()> onRequest);
+        bool Send(const Package& package); // onRequest 이후 (io 스레드, 블로킹)
+        void Finish(); // 보낸 뒤 남은 정리까지 끝남 -> 새 프로세스 진행
+        void StopListening(); // 보통 종료: 요청 대기 중지 (io_context가 끝날 수 있게)
+
+        static void CloseHandle(int fd); // 넘긴 소켓의 이 프로세스 쪽 fd (Abandon / release 뒤, shutdown 없이)
+        static int64_t NowNs();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+}
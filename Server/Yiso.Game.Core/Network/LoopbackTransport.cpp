@@ -0,0 +1,150 @@
+#include "LoopbackTransport.h"
+#include "Envelope.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Network
+{
+    // 서버 핸들러가 보는 가상 연결 (보내면 SimClock 작업으로 클라이언트에 전달)
+    class LoopbackTransport::LoopbackConnection : public Connection
+    {
+    public:
+        LoopbackConnection(LoopbackTransport& transport, SessionId id)
+            : transport_(transport), id_(id)
+        {
+        }
+
+        SessionId GetId() const override { return id_; }
+
+        void Send(Buffer frame) override
+        {
+            if (closed_ || frame.size() < HEADER_SIZE) return;
+            transport_.clock_.Schedule(transport_.latency_, [&transport = transport_, id = id_, frame = std::move(frame)]()
+            {
+                transport.DeliverToClient(id, frame);
+            });
+        }
+
+        void Disconnect() override
+        {
+            if (closed_) return;
+            closed_ = true; // 이후 Send는 버림
+            // 핸들러 안에서 불려도 on_disconnect가 재진입하지 않도록 다음 작업으로
+            transport_.clock_.Post([&transport = transport_, id = id_]() { transport.Close(id, true); });
+        }
+
+    private:
+        LoopbackTransport& transport_;
+        SessionId id_;
+        bool closed_ = false;
+    };
+
+    LoopbackTransport::LoopbackTransport(SimClock& clock, YisoSessionManager& sessions, ServerHandlers server, ClientHandlers client,
+                                         SimClock::Duration latency)
+        : clock_(clock),
+          sessions_(sessions),
+          server_(std::move(server)),
+          client_(std::move(client)),
+          latency_(latency)
+    {
+    }
+
+    LoopbackTransport::SessionId LoopbackTransport::Connect()
+    {
+        SessionId id = next_id_++;
+        auto connection = std::make_shared<LoopbackConnection>(*this, id);
+        connections_.emplace(id, connection);
+        sessions_.AddSession(std::move(connection));
+        ++stats_.connects;
+        if (server_.on_connect)
+            server_.on_connect(id);
+        return id;
+    }
+
+    void LoopbackTransport::ClientSend(SessionId id, Buffer frame)
+    {
+        clock_.Schedule(latency_, [this, id, frame = std::move(frame)]() { DeliverToServer(id, frame); });
+    }
+
+    void LoopbackTransport::ClientClose(SessionId id)
+    {
+        clock_.Schedule(latency_, [this, id]() { Close(id, false); });
+    }
+
+    void LoopbackTransport::DeliverToServer(SessionId id, const Buffer& frame)
+    {
+        if (connections_.find(id) == connections_.end())
+        {
+            ++stats_.dropped_frames;
+            return;
+        }
+
+        PacketHeader header;
+        if (frame.size() < HEADER_SIZE) return;
+        std::memcpy(&header, frame.data(), HEADER_SIZE);
+        if (header.body_size != frame.size() - HEADER_SIZE)
+        {
+            spdlog::warn("[Loopback:{}] 프레임 크기 불일치 (header={}, actual={})", id, header.body_size, frame.size() - HEADER_SIZE);
+            return;
+        }
+
+        ++stats_.c2s_frames;
+        stats_.c2s_bytes += frame.size();
+        if (header.type == static_cast<uint16_t>(PacketType::C2S_ENVELOPE))
+        {
+            EnvelopeReader reader(frame.data() + HEADER_SIZE, header.body_size);
+            PacketType type;
+            const uint8_t* body;
+            uint32_t size;
+            while (reader.Next(type, body, size) == EnvelopeReader::Result::Item && IsGameC2SType(type) && connections_.count(id))
+                server_.on_recv(id, type, body, size);
+            return;
+        }
+        if (header.type == static_cast<uint16_t>(PacketType::C2S_HELLO))
+            return; // 루프백은 봉투로 묶어 보내지 않음 -> 협상할 것 없음
+        server_.on_recv(id, static_cast<PacketType>(header.type), frame.data() + HEADER_SIZE, header.body_size);
+    }
+
+    void LoopbackTransport::DeliverToClient(SessionId id, const Buffer& bytes)
+    {
+        if (connections_.find(id) == connections_.end())
+        {
+            ++stats_.dropped_frames;
+            return;
+        }
+
+        // 여러 프레임을 이어붙인 버퍼면 하나씩 잘라서 전달
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= bytes.size())
+        {
+            PacketHeader header;
+            std::memcpy(&header, bytes.data() + offset, HEADER_SIZE);
+            size_t end = offset + HEADER_SIZE + header.body_size;
+            if (end > bytes.size()) break;
+
+            ++stats_.s2c_frames;
+            stats_.s2c_bytes += end - offset;
+            if (client_.on_recv)
+                client_.on_recv(id, static_cast<PacketType>(header.type), bytes.data() + offset + HEADER_SIZE, header.body_size);
+            offset = end;
+        }
+    }
+
+    void LoopbackTransport::Close(SessionId id, bool byServer)
+    {
+        auto it = connections_.find(id);
+        if (it == connections_.end()) return;
+
+        auto connection = std::move(it->second); // 콜백이 끝날 때까지 살려 둠
+        connections_.erase(it);
+        ++stats_.disconnects;
+
+        // YisoServer와 같은 순서: 매니저에서 제거 -> 게임 핸들러
+        sessions_.RemoveSession(id);
+        if (server_.on_disconnect)
+            server_.on_disconnect(id);
+
+        if (byServer && client_.on_close)
+            clock_.Schedule(latency_, [this, id]() { client_.on_close(id); });
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Connection.h"
+#include "PacketHeader.h"
+#include "SimClock.h"
+#include "YisoSession.h"
+#include "YisoSessionManager.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace Yiso::Network
+{
+    // 소켓 없이 같은 프로세스 안에서 클라이언트 <-> 서버 프레임을 주고받는 전송 계층
+    // - 서버 쪽은 YisoServer와 같은 모양: 세션 매니저에 Connection 등록 + on_connect / on_recv / on_disconnect
+    // - 모든 전달은 SimClock 작업 (한 방향 지연 latency) -> 핸들러 재진입 없음, 같은 입력이면 같은 순서
+    // - 서버가 보낸 버퍼는 프레임 단위로 잘라 클라이언트 콜백에 하나씩 (이어붙인 채팅 기록 등)
+    // - 청크 분할 / 송신 레인 / 큐 한도 / 송신 봉투는 없음 (YisoSession 송신 경로는 흉내내지 않음), 클라이언트가 보낸 봉투는 풀어서 전달
+    class LoopbackTransport
+    {
+    public:
+        using SessionId = Connection::SessionId;
+        using OnConnect = std::function<void(SessionId)>;
+        using OnRecv = YisoSession::OnRecv; // 서버 핸들러 / 클라이언트 수신 모두 (세션ID, 타입, 본문, 크기)
+        using OnDisconnect = YisoSession::OnDisconnect;
+
+        struct ServerHandlers
+        {
+            OnConnect on_connect;
+            OnRecv on_recv;
+            OnDisconnect on_disconnect;
+        };
+
+        struct ClientHandlers
+        {
+            OnRecv on_recv; // 서버가 보낸 프레임 하나
+            OnDisconnect on_close; // 서버가 끊음
+        };
+
+        struct Stats
+        {
+            uint64_t connects;
+            uint64_t disconnects;
+            uint64_t c2s_frames;
+            uint64_t c2s_bytes;
+            uint64_t s2c_frames;
+            uint64_t s2c_bytes;
+            uint64_t dropped_frames; // 닫힌 연결로 가던 프레임
+        };
+
+        LoopbackTransport(SimClock& clock, YisoSessionManager& sessions, ServerHandlers server, ClientHandlers client,
+                          SimClock::Duration latency = SimClock::Duration::zero());
+
+        // 클라이언트 쪽 동작 (SimClock 스레드에서)
+        SessionId Connect(); // 바로 등록 + on_connect
+        void ClientSend(SessionId id, Buffer frame); // latency 뒤 서버 on_recv
+        void ClientClose(SessionId id); // latency 뒤 서버 쪽 끊김 처리
+
+        size_t OpenCount() const { return connections_.size(); }
+        const Stats& GetStats() const { return stats_; }
+
+    private:
+        class LoopbackConnection;
+
+        void DeliverToServer(SessionId id, const Buffer& frame);
+        void DeliverToClient(SessionId id, const Buffer& bytes);
+        void Close(SessionId id, bool byServer);
+
+        SimClock& clock_;
+        YisoSessionManager& sessions_;
+        ServerHandlers server_;
+        ClientHandlers client_;
+        SimClock::Duration latency_;
+        SessionId next_id_ = 1;
+        std::unordered_map<SessionId, std::shared_ptr<LoopbackConnection>> connections_;
+        Stats stats_{};
+    };
+}
@@ -0,0 +1,155 @@
+#include "OverloadController.h"
+#include "YisoSessionManager.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Network
+{
+    namespace
+    {
+        // 신호 하나의 단계 (scale < 1이면 복귀 판정용으로 임계값을 낮춰 봄)
+        template<typename T>
+        int LevelOf(T value, T elevated, T critical, double scale)
+        {
+            if (static_cast<double>(value) >= static_cast<double>(critical) * scale) return 2;
+            if (static_cast<double>(value) >= static_cast<double>(elevated) * scale) return 1;
+            return 0;
+        }
+    }
+
+    OverloadController::OverloadController(boost::asio::io_context& io, YisoSessionManager& sessions, Config config)
+        : timer_(io),
+          sessions_(sessions),
+          config_(config)
+    {
+    }
+
+    void OverloadController::Start()
+    {
+        expected_ = std::chrono::steady_clock::now() + PROBE_INTERVAL;
+        timer_.expires_at(expected_);
+        timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (!ec) Probe();
+        });
+    }
+
+    void OverloadController::Stop()
+    {
+        timer_.cancel();
+    }
+
+    void OverloadController::ProbeNow()
+    {
+        logic_ = ReadLogic();
+        auto queued = send_queue_bytes_.load(std::memory_order_relaxed);
+        Evaluate(0, queued > 0 ? static_cast<uint64_t>(queued) : 0, sessions_.Count());
+    }
+
+    void OverloadController::Probe()
+    {
+        // 타이머가 예정보다 늦게 깨어난 만큼 = io 스레드가 다른 일에 묶여 있던 시간
+        auto now = std::chrono::steady_clock::now();
+        auto lag = std::max(std::chrono::steady_clock::duration::zero(), now - expected_);
+        double lagUs = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(lag).count());
+        lag_ewma_us_ += (lagUs - lag_ewma_us_) * LAG_SMOOTHING;
+
+        logic_ = ReadLogic();
+        auto queued = send_queue_bytes_.load(std::memory_order_relaxed);
+        Evaluate(static_cast<uint64_t>(lag_ewma_us_), queued > 0 ? static_cast<uint64_t>(queued) : 0, sessions_.Count());
+
+        expected_ = now + PROBE_INTERVAL;
+        timer_.expires_at(expected_);
+        timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (!ec) Probe();
+        });
+    }
+
+    OverloadController::LogicLoad OverloadController::ReadLogic()
+    {
+        return logic_probe_ ? logic_probe_() : LogicLoad{};
+    }
+
+    void OverloadController::Evaluate(uint64_t lagUs, uint64_t queued, size_t sessions)
+    {
+        lag_us_.store(lagUs, std::memory_order_relaxed);
+        session_count_.store(sessions, std::memory_order_relaxed);
+        logic_queue_depth_.store(logic_.queue_depth, std::memory_order_relaxed);
+        logic_wait_us_.store(logic_.oldest_wait_us, std::memory_order_relaxed);
+
+        auto us = [](std::chrono::milliseconds ms) { return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(ms).count()); };
+        auto levelAt = [&](double scale)
+        {
+            return std::max({
+                LevelOf(lagUs, us(config_.lag_elevated), us(config_.lag_critical), scale),
+                LevelOf(logic_.queue_depth, config_.logic_queue_elevated, config_.logic_queue_critical, scale),
+                LevelOf(logic_.oldest_wait_us, us(config_.logic_wait_elevated), us(config_.logic_wait_critical), scale),
+                LevelOf(queued, config_.send_queue_elevated, config_.send_queue_critical, scale),
+                LevelOf(sessions, config_.sessions_elevated, config_.sessions_critical, scale),
+            });
+        };
+
+        int current = static_cast<int>(GetLevel());
+        int next = levelAt(1.0);
+        if (next < current)
+            next = std::min(current, levelAt(RECOVER_RATIO)); // 충분히 내려왔을 때만 단계 하강
+        if (next == current) return;
+
+        level_.store(static_cast<Level>(next), std::memory_order_relaxed);
+        transitions_.fetch_add(1, std::memory_order_relaxed);
+        spdlog::warn("[Overload] {} -> {} (lag_us={} logic_queue={} logic_wait_us={} send_queue_bytes={} sessions={})",
+            LevelName(static_cast<Level>(current)), LevelName(static_cast<Level>(next)), lagUs,
+            logic_.queue_depth, logic_.oldest_wait_us, queued, sessions);
+    }
+
+    const char* OverloadController::LevelName(Level level)
+    {
+        switch (level)
+        {
+        case Level::Normal: return "Normal";
+        case Level::Elevated: return "Elevated";
+        case Level::Critical: return "Critical";
+        }
+        return "?";
+    }
+
+    bool OverloadController::Admit(Work work)
+    {
+        Level level = GetLevel();
+        switch (work)
+        {
+        case Work::Presence:
+            if (level < Level::Elevated) return true;
+            shed_presence_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        case Work::GlobalChat:
+            if (level < Level::Critical) return true;
+            shed_global_chat_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        case Work::Join:
+            if (level < Level::Critical) return true;
+            rejected_joins_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    OverloadController::Stats OverloadController::GetStats() const
+    {
+        Stats stats{};
+        stats.level = GetLevel();
+        stats.lag_us = lag_us_.load(std::memory_order_relaxed);
+        auto queued = send_queue_bytes_.load(std::memory_order_relaxed);
+        stats.send_queue_bytes = queued > 0 ? static_cast<uint64_t>(queued) : 0;
+        stats.sessions = session_count_.load(std::memory_order_relaxed);
+        stats.logic_queue_depth = logic_queue_depth_.load(std::memory_order_relaxed);
+        stats.logic_wait_us = logic_wait_us_.load(std::memory_order_relaxed);
+        stats.transitions = transitions_.load(std::memory_order_relaxed);
+        stats.rejected_accepts = rejected_accepts_.load(std::memory_order_relaxed);
+        stats.shed_presence = shed_presence_.load(std::memory_order_relaxed);
+        stats.shed_global_chat = shed_global_chat_.load(std::memory_order_relaxed);
+        stats.rejected_joins = rejected_joins_.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
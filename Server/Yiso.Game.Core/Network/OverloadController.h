@@ -0,0 +1,121 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace Yiso::Network
+{
+    class YisoSessionManager;
+
+    // 과부하 보호: 이벤트 루프 지연 / 로직 큐 길이·대기 / 전체 송신 큐 바이트 / 세션 수를 보고 단계를 정함
+    // - Normal   : 제한 없음
+    // - Elevated : 접속 수락 속도 제한 + 접속/퇴장 알림 같은 저우선 작업 버림
+    // - Critical : 새 접속은 S2C_SERVER_BUSY 후 종료, 방 생성/입장 거절, 글로벌 채팅 버림
+    // 방 채팅 / 맵 / 도장 같은 제어 트래픽은 어느 단계에서도 버리지 않음
+    // 단계는 올라갈 땐 임계값에서 바로, 내려갈 땐 임계값의 RECOVER_RATIO 아래로 떨어져야 (출렁임 방지)
+    class OverloadController
+    {
+    public:
+        enum class Level : uint8_t
+        {
+            Normal = 0,
+            Elevated = 1,
+            Critical = 2,
+        };
+
+        // 단계별로 버리는 작업 종류
+        enum class Work : uint8_t
+        {
+            Presence, // 접속/퇴장 알림, 접속 직후 채팅 기록 -> Elevated부터 버림
+            GlobalChat, // 전체 방송 채팅 -> Critical에서 버림
+            Join, // 방 생성/입장 -> Critical에서 거절
+        };
+
+        struct Config
+        {
+            std::chrono::milliseconds lag_elevated{ 50 };
+            std::chrono::milliseconds lag_critical{ 200 };
+            uint64_t send_queue_elevated = 64ull * 1024 * 1024;
+            uint64_t send_queue_critical = 256ull * 1024 * 1024;
+            size_t sessions_elevated = 80000;
+            size_t sessions_critical = 100000;
+            uint64_t logic_queue_elevated = 10000; // 로직 큐에 쌓인 작업 수 (모든 파티션 합)
+            uint64_t logic_queue_critical = 50000;
+            std::chrono::milliseconds logic_wait_elevated{ 50 }; // 가장 오래 기다린 로직 작업 (핸들러가 막혀도 보임)
+            std::chrono::milliseconds logic_wait_critical{ 200 };
+        };
+
+        // 로직 스레드 부하 (io 스레드 지연만으로는 로직 스레드가 밀리는 걸 못 봄)
+        struct LogicLoad
+        {
+            uint64_t queue_depth = 0;
+            uint64_t oldest_wait_us = 0;
+        };
+        using LogicProbe = std::function<LogicLoad()>; // 판정마다 io 스레드에서 호출
+
+        struct Stats
+        {
+            Level level;
+            uint64_t lag_us; // 최근 지연 (EWMA)
+            uint64_t send_queue_bytes;
+            size_t sessions;
+            uint64_t logic_queue_depth;
+            uint64_t logic_wait_us;
+            uint64_t transitions;
+            uint64_t rejected_accepts;
+            uint64_t shed_presence;
+            uint64_t shed_global_chat;
+            uint64_t rejected_joins;
+        };
+
+        static constexpr auto PROBE_INTERVAL = std::chrono::milliseconds(100);
+        static constexpr double RECOVER_RATIO = 0.8;
+        static constexpr double LAG_SMOOTHING = 0.25; // EWMA 가중치 (한 번 튄 지연에 바로 반응하지 않게)
+
+        OverloadController(boost::asio::io_context& io, YisoSessionManager& sessions, Config config);
+
+        void Start(); // io 스레드에서 지연 측정 시작
+        void Stop();
+        void ProbeNow(); // 타이머 없이 지금 송신 큐 / 세션 수 / 로직 부하로 한 번 판정 (io_context를 돌리지 않는 시뮬레이터용, 지연은 0)
+        void SetLogicProbe(LogicProbe probe) { logic_probe_ = std::move(probe); } // Start / io.run 전
+
+        Level GetLevel() const { return level_.load(std::memory_order_relaxed); }
+        static const char* LevelName(Level level);
+
+        // false = 지금 단계에서는 이 작업을 버림/거절 (카운트됨), 어느 스레드에서나 호출 가능
+        bool Admit(Work work);
+        void OnAcceptRejected() { rejected_accepts_.fetch_add(1, std::memory_order_relaxed); }
+
+        // 세션 송신 큐 바이트 증감 (세션 io 스레드)
+        void AddQueuedBytes(int64_t delta) { send_queue_bytes_.fetch_add(delta, std::memory_order_relaxed); }
+
+        Stats GetStats() const;
+
+    private:
+        void Probe();
+        void Evaluate(uint64_t lagUs, uint64_t queued, size_t sessions);
+        LogicLoad ReadLogic();
+
+        boost::asio::steady_timer timer_;
+        YisoSessionManager& sessions_;
+        Config config_;
+        std::chrono::steady_clock::time_point expected_;
+        double lag_ewma_us_ = 0.0;
+        LogicProbe logic_probe_;
+        LogicLoad logic_; // 이번 판정의 로직 부하 (Evaluate에서 씀)
+
+        std::atomic<Level> level_{ Level::Normal };
+        std::atomic<int64_t> send_queue_bytes_{0};
+        std::atomic<uint64_t> lag_us_{0};
+        std::atomic<size_t> session_count_{0};
+        std::atomic<uint64_t> logic_queue_depth_{0};
+        std::atomic<uint64_t> logic_wait_us_{0};
+        std::atomic<uint64_t> transitions_{0};
+        std::atomic<uint64_t> rejected_accepts_{0};
+        std::atomic<uint64_t> shed_presence_{0};
+        std::atomic<uint64_t> shed_global_chat_{0};
+        std::atomic<uint64_t> rejected_joins_{0};
+    };
+}
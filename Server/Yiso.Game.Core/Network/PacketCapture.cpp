@@ -0,0 +1,150 @@
+#include "PacketCapture.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Network
+{
+    std::atomic<PacketCapture*> PacketCapture::active_{nullptr};
+
+    PacketCapture::~PacketCapture()
+    {
+        Stop();
+    }
+
+    bool PacketCapture::Start(const std::filesystem::path& path)
+    {
+        if (file_) return false;
+
+        file_ = std::fopen(path.string().c_str(), "wb");
+        if (!file_)
+        {
+            spdlog::error("[Capture] 파일 열기 실패: {}", path.string());
+            return false;
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.header_size = sizeof(FileHeader);
+        header.start_unix_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        std::fwrite(&header, sizeof(header), 1, file_);
+
+        start_ = std::chrono::steady_clock::now();
+        stopping_ = false;
+        thread_ = std::thread([this]() { Run(); });
+
+        PacketCapture* expected = nullptr;
+        if (!active_.compare_exchange_strong(expected, this, std::memory_order_acq_rel))
+            spdlog::warn("[Capture] 이미 다른 캡처가 활성 상태 -> 이 캡처에는 기록되지 않음");
+        spdlog::info("[Capture] 패킷 캡처 시작: {}", path.string());
+        return true;
+    }
+
+    void PacketCapture::Stop()
+    {
+        PacketCapture* self = this;
+        active_.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+        if (!thread_.joinable()) return;
+
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+
+        std::fclose(file_);
+        file_ = nullptr;
+        auto stats = GetStats();
+        spdlog::info("[Capture] 캡처 종료 (records={} bytes={} dropped={})", stats.records, stats.bytes, stats.dropped);
+    }
+
+    void PacketCapture::Record(uint32_t sessionId, Direction direction, const void* head, size_t headSize, const void* body, size_t bodySize)
+    {
+        RecordHeader record{};
+        record.ts_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+        record.session_id = sessionId;
+        record.size = static_cast<uint32_t>(headSize + bodySize);
+        record.direction = direction;
+
+        size_t total = sizeof(record) + headSize + bodySize;
+        bool wake = false;
+        {
+            std::lock_guard lock(mutex_);
+            if (pending_.size() + total > MAX_PENDING_BYTES)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            const auto* r = reinterpret_cast<const uint8_t*>(&record);
+            pending_.insert(pending_.end(), r, r + sizeof(record));
+            if (headSize) pending_.insert(pending_.end(), static_cast<const uint8_t*>(head), static_cast<const uint8_t*>(head) + headSize);
+            if (bodySize) pending_.insert(pending_.end(), static_cast<const uint8_t*>(body), static_cast<const uint8_t*>(body) + bodySize);
+            wake = pending_.size() >= WAKE_BYTES;
+        }
+        records_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(total, std::memory_order_relaxed);
+        if (wake)
+            cv_.notify_one();
+    }
+
+    void PacketCapture::Run()
+    {
+        std::vector<uint8_t> writing;
+        while (true)
+        {
+            bool stopping;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait_for(lock, FLUSH_INTERVAL, [this]() { return stopping_ || pending_.size() >= WAKE_BYTES; });
+                writing.swap(pending_); // io 스레드는 비워진 (capacity 유지된) 버퍼에 계속 덧붙임
+                stopping = stopping_;
+            }
+
+            if (!writing.empty())
+            {
+                if (std::fwrite(writing.data(), 1, writing.size(), file_) != writing.size())
+                    spdlog::error("[Capture] 쓰기 실패 ({} bytes)", writing.size());
+                std::fflush(file_);
+                writing.clear();
+            }
+            if (stopping) return;
+        }
+    }
+
+    PacketCapture::Stats PacketCapture::GetStats() const
+    {
+        Stats stats{};
+        stats.records = records_.load(std::memory_order_relaxed);
+        stats.bytes = bytes_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    PacketCapture::Reader::~Reader()
+    {
+        if (file_) std::fclose(file_);
+    }
+
+    bool PacketCapture::Reader::Open(const std::filesystem::path& path)
+    {
+        file_ = std::fopen(path.string().c_str(), "rb");
+        if (!file_) return false;
+
+        FileHeader header{};
+        if (std::fread(&header, sizeof(header), 1, file_) != 1) return false;
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) return false;
+        if (header.header_size > sizeof(FileHeader))
+            std::fseek(file_, header.header_size, SEEK_SET);
+        return true;
+    }
+
+    bool PacketCapture::Reader::Next(RecordHeader& header, std::vector<uint8_t>& bytes)
+    {
+        if (!file_ || std::fread(&header, sizeof(header), 1, file_) != 1) return false;
+        bytes.resize(header.size);
+        return header.size == 0 || std::fread(bytes.data(), 1, header.size, file_) == header.size;
+    }
+}
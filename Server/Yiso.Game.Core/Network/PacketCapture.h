@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 와이어 프레임 캡처 (성능 회귀 재현용, Yiso.Replay로 재생)
+    // 파일 = [FileHeader] + [RecordHeader + 바이트]* (리틀 엔디언 고정, PacketType 값 그대로)
+    // - io 스레드는 메모리 버퍼에 덧붙이기만 함 -> 백그라운드 스레드가 모아서 fwrite
+    // - 대기 중인 바이트가 MAX_PENDING_BYTES를 넘으면 버리고 dropped로 셈 (게임 스레드를 막지 않음)
+    class PacketCapture
+    {
+    public:
+        enum class Direction : uint8_t
+        {
+            ClientToServer = 0, // 수신한 프레임 (헤더 + 본문)
+            ServerToClient = 1, // 송신 큐에 넣은 버퍼 (프레임 여러 개가 이어져 있을 수 있음)
+            Open = 2, // 세션 시작 (바이트 없음)
+            Close = 3, // 세션 종료 (바이트 없음)
+        };
+
+#pragma pack(push, 1)
+        struct FileHeader
+        {
+            char magic[4]; // "YCAP"
+            uint16_t version;
+            uint16_t header_size; // sizeof(FileHeader) -> 이후 버전에서 필드가 늘어도 건너뛸 수 있게
+            uint64_t start_unix_ms; // 캡처 시작 시각 (참고용)
+        };
+
+        struct RecordHeader
+        {
+            uint64_t ts_ns; // 캡처 시작 기준 단조 시각
+            uint32_t session_id;
+            uint32_t size; // 뒤따르는 바이트 수
+            Direction direction;
+            uint8_t reserved[3];
+        };
+#pragma pack(pop)
+
+        struct Stats
+        {
+            uint64_t records;
+            uint64_t bytes;
+            uint64_t dropped;
+        };
+
+        static constexpr char MAGIC[4] = { 'Y', 'C', 'A', 'P' };
+        static constexpr uint16_t VERSION = 1;
+        static constexpr size_t MAX_PENDING_BYTES = 64 * 1024 * 1024;
+        static constexpr size_t WAKE_BYTES = 1024 * 1024; // 이만큼 쌓이면 주기 전이라도 쓰기
+        static constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(100);
+
+        ~PacketCapture();
+
+        // 캡처 시작 -> 이후 세션들이 Active()로 찾아 기록 (한 번에 하나)
+        bool Start(const std::filesystem::path& path);
+        void Stop(); // 남은 버퍼를 모두 쓰고 닫음
+
+        static PacketCapture* Active() { return active_.load(std::memory_order_acquire); }
+
+        void Record(uint32_t sessionId, Direction direction, const void* head, size_t headSize, const void* body = nullptr, size_t bodySize = 0);
+
+        Stats GetStats() const;
+
+        // 캡처 파일 순차 읽기 (재생 도구용)
+        class Reader
+        {
+        public:
+            ~Reader();
+            bool Open(const std::filesystem::path& path);
+            bool Next(RecordHeader& header, std::vector<uint8_t>& bytes); // 끝 또는 잘린 레코드면 false
+
+        private:
+            std::FILE* file_ = nullptr;
+        };
+
+    private:
+        void Run();
+
+        static std::atomic<PacketCapture*> active_;
+
+        std::FILE* file_ = nullptr;
+        std::thread thread_;
+        std::chrono::steady_clock::time_point start_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<uint8_t> pending_;
+        bool stopping_ = false;
+
+        std::atomic<uint64_t> records_{0};
+        std::atomic<uint64_t> bytes_{0};
+        std::atomic<uint64_t> dropped_{0};
+    };
+}
@@ -1,20 +1,21 @@
 #include "PacketCodec.h"
-#include "string"
+#include <cstring>
 #include <google/protobuf/message.h>
 
 namespace Yiso::Network
 {
-    std::vector<uint8_t> PacketCodec::Encode(PacketType type, const google::protobuf::Message& msg)
+    Buffer PacketCodec::Encode(PacketType type, const google::protobuf::Message& msg)
     {
-        std::string payload = msg.SerializeAsString();
+        size_t payloadSize = msg.ByteSizeLong();
 
         PacketHeader header;
-        header.body_size = static_cast<uint32_t>(payload.size());
+        header.body_size = static_cast<uint32_t>(payloadSize);
         header.type = static_cast<uint16_t>(type);
 
-        std::vector<uint8_t> frame(HEADER_SIZE + payload.size());
+        // 중간 std::string 없이 프레임 버퍼에 바로 직렬화 (ByteSizeLong 캐시를 그대로 사용)
+        Buffer frame(HEADER_SIZE + payloadSize);
         std::memcpy(frame.data(), &header, HEADER_SIZE);
-        std::memcpy(frame.data() + HEADER_SIZE, payload.data(), payload.size());
+        msg.SerializeWithCachedSizesToArray(frame.data() + HEADER_SIZE);
 
         return frame;
     }
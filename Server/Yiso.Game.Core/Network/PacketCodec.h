@@ -1,7 +1,7 @@
 #pragma once
 #include "PacketHeader.h"
+#include "BufferPool.h"
 #include <google/protobuf/message.h>
-#include <vector>
 #include <cstdint>
 
 namespace Yiso::Network
@@ -9,7 +9,7 @@ namespace Yiso::Network
     class PacketCodec
     {
     public:
-        // protobuf 메시지 -> [헤더 6바이트 + 페이로드] 바이트 배열
-        static std::vector<uint8_t> Encode(PacketType type, const google::protobuf::Message& msg);
+        // protobuf 메시지 -> [헤더 6바이트 + 페이로드] 바이트 배열 (풀 버퍼 한 번 할당)
+        static Buffer Encode(PacketType type, const google::protobuf::Message& msg);
     };
 }
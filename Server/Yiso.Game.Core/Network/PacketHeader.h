@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace Yiso::Network
@@ -15,6 +16,20 @@ namespace Yiso::Network
         C2S_JOIN_ROOM = 5,
         C2S_LEAVE_ROOM = 6,
         C2S_ROOM_CHAT = 7,
+        C2S_PLAYER_INFO = 8,
+        C2S_CHANGE_MAP = 9,
+        C2S_ENTER_CHAPTER = 10,
+        C2S_REQUEST_MAP_DATA = 11,
+        C2S_RETREAT_TO_BASE_CAMP = 12,
+        C2S_ENTER_DOJO = 13,
+        C2S_EXIT_DOJO = 14,
+        C2S_ACK_MAP_STATE = 15,
+        C2S_PLAYER_MOVE = 16,
+        C2S_FRAME_CHUNK = 17,
+        C2S_RESUME_SESSION = 18,
+        C2S_LOGIN = 19,
+        C2S_ENVELOPE = 20,
+        C2S_HELLO = 21,
 
         // Server -> Client
         S2C_CHAT = 1001,
@@ -24,6 +39,16 @@ namespace Yiso::Network
         S2C_JOIN_ROOM = 1005,
         S2C_LEAVE_ROOM = 1006,
         S2C_ROOM_CHAT = 1007,
+        S2C_PLAYER_INFO = 1008,
+        S2C_MAP_DATA = 1009,
+        S2C_CHAPTER_INFO = 1010,
+        S2C_MAP_STATE_DELTA = 1011,
+        S2C_FRAME_CHUNK = 1012,
+        S2C_SERVER_BUSY = 1013,
+        S2C_SESSION_TOKEN = 1014,
+        S2C_RESUME_RESULT = 1015,
+        S2C_LOGIN_RESULT = 1016,
+        S2C_ENVELOPE = 1017,
     };
 
     // 패킷 프레임 포맷:
@@ -34,6 +59,18 @@ namespace Yiso::Network
         uint32_t body_size; // protobuf의 payload 크기 (헤더 제외)
         uint16_t type; // PacketType
     };
+
+    // 큰 메시지 분할 (type = C2S/S2C_FRAME_CHUNK)
+    // [ PacketHeader ][ ChunkHeader ][ 원본 본문 조각 ]
+    // - 같은 stream의 조각은 순서대로 도착, 다른 stream 조각과는 섞여 도착할 수 있음
+    // - 수신 측은 stream별로 이어붙여 total_size가 차면 원본 type의 패킷 하나로 처리
+    struct ChunkHeader
+    {
+        uint32_t total_size; // 원본 본문 전체 크기
+        uint16_t type; // 원본 PacketType
+        uint8_t stream;
+        uint8_t reserved;
+    };
 #pragma pack(pop)
 
     inline bool IsValidPacketType(uint16_t type)
@@ -47,12 +84,84 @@ namespace Yiso::Network
         case PacketType::C2S_LEAVE_ROOM:
         case PacketType::C2S_ROOM_CHAT:
         case PacketType::C2S_WHISPER:
+        case PacketType::C2S_PLAYER_INFO:
+        case PacketType::C2S_CHANGE_MAP:
+        case PacketType::C2S_REQUEST_MAP_DATA:
+        case PacketType::C2S_RETREAT_TO_BASE_CAMP:
+        case PacketType::C2S_ENTER_DOJO:
+        case PacketType::C2S_EXIT_DOJO:
+        case PacketType::C2S_ACK_MAP_STATE:
+        case PacketType::C2S_PLAYER_MOVE:
+        case PacketType::C2S_FRAME_CHUNK:
+        case PacketType::C2S_RESUME_SESSION:
+        case PacketType::C2S_LOGIN:
+        case PacketType::C2S_ENVELOPE:
+        case PacketType::C2S_HELLO:
             return true;
         default:
             return false;
         }
     }
 
+    // 로직으로 넘기는 C2S 메시지 (프레임 계층 / 세션 제어 제외) -> 봉투 item / 재조립된 조각은 이것만
+    inline bool IsGameC2SType(PacketType type)
+    {
+        return IsValidPacketType(static_cast<uint16_t>(type)) &&
+               type != PacketType::C2S_FRAME_CHUNK && type != PacketType::C2S_ENVELOPE &&
+               type != PacketType::C2S_RESUME_SESSION && type != PacketType::C2S_HELLO;
+    }
+
+    // 세션 재개 순번: 클라이언트가 받은 프레임 수로 놓친 프레임을 가림 -> 재개 제어 프레임은 양쪽 모두 세지 않음
+    // 봉투는 담긴 item을 하나씩 셈 (봉투 프레임 자체는 세지 않음)
+    inline bool IsSequencedType(PacketType type)
+    {
+        return type != PacketType::S2C_SESSION_TOKEN && type != PacketType::S2C_RESUME_RESULT && type != PacketType::S2C_ENVELOPE;
+    }
+
+    // 송신 우선순위 레인 (낮은 값이 먼저) -> 큰 맵 데이터가 채팅/방 제어 패킷을 막지 않음
+    enum class SendLane : uint8_t
+    {
+        Control = 0,
+        Chat = 1,
+        Bulk = 2,
+    };
+    constexpr size_t SEND_LANE_COUNT = 3;
+
+    inline SendLane SendLaneOf(PacketType type)
+    {
+        switch (type)
+        {
+        case PacketType::S2C_CHAT:
+        case PacketType::S2C_WHISPER:
+        case PacketType::S2C_ROOM_CHAT:
+            return SendLane::Chat;
+        case PacketType::S2C_MAP_DATA:
+        case PacketType::S2C_CHAPTER_INFO:
+            return SendLane::Bulk;
+        default:
+            return SendLane::Control;
+        }
+    }
+
     constexpr uint32_t HEADER_SIZE = sizeof(PacketHeader); // 6 bytes
-    constexpr uint32_t MAX_PACKET_SIZE = 64 * 1024; // 64kb
+    constexpr uint32_t CHUNK_HEADER_SIZE = sizeof(ChunkHeader); // 8 bytes
+    constexpr uint32_t MAX_PACKET_SIZE = 64 * 1024; // 64kb (와이어 프레임 하나의 상한)
+    constexpr uint32_t CHUNK_SIZE = 16 * 1024; // 본문이 이보다 크면 조각으로 나눠 보냄 (우선순위 전환 단위)
+    constexpr uint32_t MAX_MESSAGE_SIZE = 4 * 1024 * 1024; // 재조립된 메시지 상한
+    constexpr uint32_t MAX_C2S_CHUNKED_CHAT_SIZE = 64 * 1024; // 조각으로 받는 채팅 본문 상한
+
+    // 클라이언트가 조각으로 보낼 수 있는 메시지와 그 상한 (0이면 조각 불가)
+    // 첫 조각의 total_size를 여기서 거름 -> 작은 조각 몇 개로 큰 재조립 버퍼를 잡지 못하게
+    inline uint32_t MaxChunkedC2SSize(PacketType type)
+    {
+        switch (type)
+        {
+        case PacketType::C2S_CHAT:
+        case PacketType::C2S_WHISPER:
+        case PacketType::C2S_ROOM_CHAT:
+            return MAX_C2S_CHUNKED_CHAT_SIZE;
+        default:
+            return 0; // 나머지 C2S는 한 프레임이면 충분, 봉투 / 재개 / 로그인은 조각으로 올 수 없음
+        }
+    }
 }
@@ -0,0 +1,74 @@
+#include "ReplayBuffer.h"
+
+namespace Yiso::Network
+{
+    ReplayBuffer::ReplayBuffer(size_t capacity)
+        : capacity_(capacity)
+    {
+    }
+
+    void ReplayBuffer::Push(uint64_t seq, const uint8_t* frame, size_t size, uint32_t nowSec)
+    {
+        last_push_sec_ = nowSec;
+        if (size > capacity_)
+        {
+            Clear(); // 이 프레임 이전 구간은 이어지지 않음 -> 다음 Push부터 새로
+            return;
+        }
+
+        if (first_ == sizes_.size())
+            first_seq_ = seq;
+        while (Bytes() + size > capacity_)
+            PopFront();
+
+        if (head_ > 0 && head_ * 2 >= bytes_.size())
+        {
+            // 앞쪽 버린 구간 정리 (capacity의 2배 이상 자라지 않게)
+            bytes_.erase(bytes_.begin(), bytes_.begin() + static_cast<std::ptrdiff_t>(head_));
+            head_ = 0;
+        }
+        if (first_ > 0 && first_ * 2 >= sizes_.size())
+        {
+            sizes_.erase(sizes_.begin(), sizes_.begin() + static_cast<std::ptrdiff_t>(first_));
+            first_ = 0;
+        }
+
+        bytes_.insert(bytes_.end(), frame, frame + size);
+        sizes_.push_back(static_cast<uint32_t>(size));
+    }
+
+    void ReplayBuffer::PopFront()
+    {
+        head_ += sizes_[first_++];
+        ++first_seq_;
+        if (first_ == sizes_.size())
+        {
+            bytes_.clear();
+            sizes_.clear();
+            head_ = 0;
+            first_ = 0;
+        }
+    }
+
+    void ReplayBuffer::Clear()
+    {
+        bytes_.clear();
+        sizes_.clear();
+        head_ = 0;
+        first_ = 0;
+    }
+
+    bool ReplayBuffer::Collect(uint64_t after, uint64_t last, Buffer& out) const
+    {
+        if (after == last) return true;
+        size_t count = sizes_.size() - first_;
+        if (count == 0 || after + 1 < first_seq_ || last != first_seq_ + count - 1) return false;
+
+        size_t offset = head_;
+        size_t index = first_;
+        for (uint64_t seq = first_seq_; seq <= after; ++seq)
+            offset += sizes_[index++];
+        out.insert(out.end(), bytes_.begin() + static_cast<std::ptrdiff_t>(offset), bytes_.end());
+        return true;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "BufferPool.h"
+#include <cstdint>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 세션 재개용: 최근에 다 보낸 프레임을 순번과 함께 capacity 바이트까지 보관
+    // - 순번은 1부터, 보낸 순서(와이어 완료 순서)대로 하나씩 -> 클라이언트가 받은 프레임 수와 같은 축
+    // - 넘치면 오래된 프레임부터 버림 (capacity보다 큰 프레임 하나면 전부 비우고 그 프레임도 보관하지 않음)
+    // - 세션 io 스레드에서만 사용
+    class ReplayBuffer
+    {
+    public:
+        explicit ReplayBuffer(size_t capacity);
+
+        void Push(uint64_t seq, const uint8_t* frame, size_t size, uint32_t nowSec); // seq는 직전 Push + 1
+        void Clear();
+
+        // after 뒤 ~ last까지의 프레임을 out 뒤에 이어붙임 (하나라도 이미 버렸으면 false)
+        bool Collect(uint64_t after, uint64_t last, Buffer& out) const;
+
+        size_t Bytes() const { return bytes_.size() - head_; }
+        uint64_t FirstSeq() const { return first_seq_; } // 보관 중인 가장 오래된 프레임 순번 (Bytes() > 0일 때만 의미 있음)
+        uint32_t LastPushSec() const { return last_push_sec_; }
+
+    private:
+        void PopFront();
+
+        size_t capacity_;
+        Buffer bytes_; // 프레임을 이어붙인 것, bytes_[head_]부터 유효
+        size_t head_ = 0;
+        std::vector<uint32_t> sizes_; // 프레임별 크기, sizes_[first_]부터 유효
+        size_t first_ = 0;
+        uint64_t first_seq_ = 0; // sizes_[first_]의 순번
+        uint32_t last_push_sec_ = 0;
+    };
+}
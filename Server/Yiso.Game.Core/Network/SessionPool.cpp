@@ -0,0 +1,63 @@
+#include "SessionPool.h"
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Network
+{
+    SessionPool::~SessionPool()
+    {
+        std::lock_guard lock(mutex_);
+        if (in_use_ == 0) return;
+
+        // 아직 살아있는 세션이 있으면 (종료 중 남은 핸들러 등) 슬랩을 풀지 않고 둠 -> 해제된 메모리 접근 방지
+        spdlog::warn("[SessionPool] 사용 중인 블록 {}개 남은 채 종료, 슬랩 유지", in_use_);
+        for (auto& slab : slabs_)
+            slab.release();
+    }
+
+    void* SessionPool::Allocate(size_t size)
+    {
+        std::lock_guard lock(mutex_);
+        if (block_size_ == 0)
+            block_size_ = (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        if (size > block_size_)
+            return ::operator new(size); // 다른 타입 요청 -> 풀을 거치지 않음
+
+        if (!free_)
+        {
+            auto slab = std::make_unique<std::byte[]>(block_size_ * SLAB_BLOCKS);
+            for (size_t i = SLAB_BLOCKS; i-- > 0;)
+            {
+                auto* block = reinterpret_cast<FreeBlock*>(slab.get() + i * block_size_);
+                block->next = free_;
+                free_ = block;
+            }
+            slabs_.push_back(std::move(slab));
+        }
+
+        FreeBlock* block = free_;
+        free_ = block->next;
+        ++in_use_;
+        return block;
+    }
+
+    void SessionPool::Free(void* p, size_t size)
+    {
+        std::lock_guard lock(mutex_);
+        if (size > block_size_)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = free_;
+        free_ = block;
+        --in_use_;
+    }
+
+    SessionPool::Stats SessionPool::GetStats() const
+    {
+        std::lock_guard lock(mutex_);
+        return { block_size_, slabs_.size() * SLAB_BLOCKS, in_use_ };
+    }
+}
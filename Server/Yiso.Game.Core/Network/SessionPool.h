@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 세션 객체(+ shared_ptr 제어 블록) 고정 크기 블록 풀
+    // - allocate_shared로 넘기면 세션 하나 = 블록 하나, 해제된 블록은 free list로 재사용
+    // - 블록은 SLAB_BLOCKS개씩 한 번에 잡음 -> 연결/해제가 잦아도 힙 단편화 없음
+    // - 세션 해제는 마지막 참조를 놓은 스레드(로직 스레드일 수도 있음)에서 일어나므로 mutex 보호
+    class SessionPool
+    {
+    public:
+        struct Stats
+        {
+            size_t block_size;
+            size_t blocks; // 잡아둔 전체 블록
+            size_t in_use;
+        };
+
+        static constexpr size_t SLAB_BLOCKS = 256;
+
+        SessionPool() = default;
+        SessionPool(const SessionPool&) = delete;
+        SessionPool& operator=(const SessionPool&) = delete;
+        ~SessionPool();
+
+        void* Allocate(size_t size);
+        void Free(void* p, size_t size);
+
+        Stats GetStats() const;
+
+        template<typename T>
+        class Allocator
+        {
+        public:
+            using value_type = T;
+
+            explicit Allocator(SessionPool& pool) : pool_(&pool) {}
+            template<typename U>
+            Allocator(const Allocator<U>& other) : pool_(other.pool_) {}
+
+            T* allocate(size_t n) { return static_cast<T*>(pool_->Allocate(n * sizeof(T))); }
+            void deallocate(T* p, size_t n) { pool_->Free(p, n * sizeof(T)); }
+
+            template<typename U>
+            bool operator==(const Allocator<U>& other) const { return pool_ == other.pool_; }
+            template<typename U>
+            bool operator!=(const Allocator<U>& other) const { return pool_ != other.pool_; }
+
+        private:
+            template<typename U> friend class Allocator;
+            SessionPool* pool_;
+        };
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        mutable std::mutex mutex_;
+        size_t block_size_ = 0; // 첫 할당 크기로 고정 (allocate_shared는 항상 같은 크기로 요청)
+        FreeBlock* free_ = nullptr;
+        std::vector<std::unique_ptr<std::byte[]>> slabs_;
+        size_t in_use_ = 0;
+    };
+}
@@ -0,0 +1,46 @@
+#include "SimClock.h"
+#include <algorithm>
+
+namespace Yiso::Network
+{
+    void SimClock::Schedule(Duration delay, Task task)
+    {
+        queue_.push_back({ now_ + std::max(delay, Duration::zero()), next_seq_++, std::move(task) });
+        std::push_heap(queue_.begin(), queue_.end(), Later{});
+    }
+
+    bool SimClock::RunOne()
+    {
+        if (queue_.empty()) return false;
+
+        std::pop_heap(queue_.begin(), queue_.end(), Later{});
+        Entry entry = std::move(queue_.back());
+        queue_.pop_back();
+
+        now_ = entry.at;
+        ++executed_;
+        entry.task(); // 작업 안에서 Schedule 해도 됨 (queue_에서 이미 빠진 뒤)
+        return true;
+    }
+
+    uint64_t SimClock::RunUntilIdle()
+    {
+        uint64_t count = 0;
+        while (RunOne())
+            ++count;
+        return count;
+    }
+
+    uint64_t SimClock::RunFor(Duration duration)
+    {
+        Duration end = now_ + duration;
+        uint64_t count = 0;
+        while (!queue_.empty() && queue_.front().at <= end)
+        {
+            RunOne();
+            ++count;
+        }
+        now_ = end;
+        return count;
+    }
+}
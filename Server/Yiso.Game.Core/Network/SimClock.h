@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Yiso::Network
+{
+    // 결정적 단일 스레드 시뮬레이션 시계
+    // - 작업은 (예정 시각, 등록 순서)로 정렬된 힙 하나에서 차례로 실행 -> 같은 입력이면 항상 같은 순서
+    // - 시각은 작업을 꺼낼 때만 앞으로 감 (실제 시간과 무관, 대기 없음)
+    // - 스레드 안전하지 않음: 등록 / 실행 모두 한 스레드에서
+    class SimClock
+    {
+    public:
+        using Duration = std::chrono::microseconds;
+        using Task = std::function<void()>;
+
+        Duration Now() const { return now_; }
+
+        void Post(Task task) { Schedule(Duration::zero(), std::move(task)); } // 같은 시각에 이미 등록된 작업 뒤에 실행
+        void Schedule(Duration delay, Task task);
+
+        bool RunOne(); // 가장 이른 작업 하나 (없으면 false)
+        uint64_t RunUntilIdle(); // 작업이 만든 작업까지 모두 (반환: 실행한 수)
+        uint64_t RunFor(Duration duration); // Now() + duration 까지의 작업만 실행 후 시각을 그 끝으로
+
+        size_t Pending() const { return queue_.size(); }
+        uint64_t Executed() const { return executed_; }
+
+    private:
+        struct Entry
+        {
+            Duration at;
+            uint64_t seq;
+            Task task;
+        };
+
+        // std::priority_queue는 top을 꺼내며 옮길 수 없어 vector + heap 함수로
+        struct Later
+        {
+            bool operator()(const Entry& a, const Entry& b) const
+            {
+                if (a.at != b.at) return a.at > b.at;
+                return a.seq > b.seq;
+            }
+        };
+
+        std::vector<Entry> queue_;
+        Duration now_{ 0 };
+        uint64_t next_seq_ = 0;
+        uint64_t executed_ = 0;
+    };
+}
@@ -0,0 +1,179 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Yiso::Network
+{
+    std::atomic<uint32_t> Tracer::sample_every_{0};
+
+    namespace
+    {
+        using Stage = Tracer::Stage;
+
+        struct Event
+        {
+            uint64_t ts_ns;
+            uint32_t trace_id;
+            uint32_t arg;
+            uint16_t packet_type;
+            Stage stage;
+        };
+
+        // 스레드 하나가 쓰는 링 (스레드가 끝나도 덤프할 수 있게 전역 목록이 소유)
+        struct Ring
+        {
+            uint32_t thread_index = 0;
+            std::atomic<uint64_t> head{0}; // 지금까지 쓴 이벤트 수
+            std::array<Event, Tracer::RING_CAPACITY> events;
+        };
+
+        std::mutex g_rings_mutex; // 링 등록 / 덤프만
+        std::vector<std::unique_ptr<Ring>> g_rings;
+        std::atomic<uint32_t> g_next_trace{1};
+        const auto g_epoch = std::chrono::steady_clock::now();
+
+        Ring& LocalRing()
+        {
+            thread_local Ring* ring = nullptr;
+            if (!ring)
+            {
+                std::lock_guard lock(g_rings_mutex);
+                g_rings.push_back(std::make_unique<Ring>());
+                ring = g_rings.back().get();
+                ring->thread_index = static_cast<uint32_t>(g_rings.size());
+            }
+            return *ring;
+        }
+
+        // 구간 = 시작 단계 ~ 끝 단계 (같은 trace, 같은 arg)
+        struct SpanKind
+        {
+            Stage begin;
+            Stage end;
+            const char* name;
+        };
+
+        constexpr SpanKind SPAN_KINDS[] = {
+            { Stage::HeaderRead, Stage::Recv, "read" },
+            { Stage::Recv, Stage::Dispatch, "logic_queue" },
+            { Stage::Dispatch, Stage::HandlerBegin, "dispatch" },
+            { Stage::HandlerBegin, Stage::HandlerEnd, "handler" },
+            { Stage::LockWait, Stage::LockAcquired, "lock_wait" },
+            { Stage::Enqueue, Stage::WriteBegin, "send_queue" },
+            { Stage::WriteBegin, Stage::WriteDone, "socket_write" },
+        };
+    }
+
+    uint32_t Tracer::SampleSlow(uint32_t every)
+    {
+        thread_local uint32_t counter = 0;
+        if (++counter < every) return 0;
+        counter = 0;
+
+        uint32_t id = g_next_trace.fetch_add(1, std::memory_order_relaxed);
+        return id != 0 ? id : g_next_trace.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Tracer::Record(uint32_t traceId, Stage stage, uint16_t packetType, uint32_t arg)
+    {
+        auto now = std::chrono::steady_clock::now() - g_epoch;
+        Ring& ring = LocalRing();
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        ring.events[head % RING_CAPACITY] = {
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+            traceId, arg, packetType, stage };
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    int64_t Tracer::DumpChrome(const std::filesystem::path& path)
+    {
+        struct Collected
+        {
+            Event event;
+            uint32_t thread_index;
+        };
+        std::vector<Collected> all;
+        size_t threadCount = 0;
+        {
+            std::lock_guard lock(g_rings_mutex);
+            threadCount = g_rings.size();
+            for (const auto& ring : g_rings)
+            {
+                // 복사 중에도 쓰기는 계속됨 -> 복사 후 head를 다시 읽어 덮어써졌을 수 있는 구간은 버림
+                uint64_t before = ring->head.load(std::memory_order_acquire);
+                uint64_t first = before > RING_CAPACITY ? before - RING_CAPACITY : 0;
+                std::vector<Event> copy;
+                copy.reserve(static_cast<size_t>(before - first));
+                for (uint64_t i = first; i < before; ++i)
+                    copy.push_back(ring->events[i % RING_CAPACITY]);
+
+                uint64_t after = ring->head.load(std::memory_order_acquire);
+                uint64_t valid = after + 1 > RING_CAPACITY ? after + 1 - RING_CAPACITY : 0; // 쓰는 중인 슬롯까지 제외
+                for (uint64_t i = std::max(first, valid); i < before; ++i)
+                    all.push_back({ copy[static_cast<size_t>(i - first)], ring->thread_index });
+            }
+        }
+
+        std::sort(all.begin(), all.end(), [](const Collected& a, const Collected& b)
+        {
+            if (a.event.trace_id != b.event.trace_id) return a.event.trace_id < b.event.trace_id;
+            return a.event.ts_ns < b.event.ts_ns;
+        });
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return -1;
+        out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+
+        bool first = true;
+        auto separator = [&out, &first]() { if (!first) out << ",\n"; first = false; };
+        for (size_t i = 1; i <= threadCount; ++i)
+        {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"thread-" << i << "\"}}";
+        }
+
+        int64_t spans = 0;
+        std::map<std::pair<size_t, uint32_t>, const Collected*> open; // (구간 종류, arg) -> 시작 이벤트
+        for (size_t i = 0; i < all.size(); ++i)
+        {
+            if (i == 0 || all[i].event.trace_id != all[i - 1].event.trace_id)
+                open.clear();
+
+            const auto& current = all[i];
+            for (size_t kind = 0; kind < std::size(SPAN_KINDS); ++kind)
+            {
+                const auto& span = SPAN_KINDS[kind];
+                auto key = std::make_pair(kind, current.event.arg);
+                if (current.event.stage == span.end)
+                {
+                    auto it = open.find(key);
+                    if (it != open.end())
+                    {
+                        const auto& begin = *it->second;
+                        separator();
+                        out << "{\"name\":\"" << span.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << current.thread_index
+                            << ",\"ts\":" << begin.event.ts_ns / 1000.0
+                            << ",\"dur\":" << (current.event.ts_ns - begin.event.ts_ns) / 1000.0
+                            << ",\"args\":{\"trace\":" << current.event.trace_id
+                            << ",\"type\":" << std::max(begin.event.packet_type, current.event.packet_type)
+                            << ",\"session\":" << current.event.arg << "}}";
+                        open.erase(it);
+                        ++spans;
+                    }
+                }
+                if (current.event.stage == span.begin)
+                    open[key] = &current;
+            }
+        }
+
+        out << "\n]}\n";
+        return out ? spans : -1;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+namespace Yiso::Network
+{
+    // 샘플링 패킷 지연 추적
+    // - 헤더 수신 시점에 N개 중 1개를 골라 trace id 부여 (끄면 원자 변수 읽기 한 번으로 끝)
+    // - 단계별 시각을 스레드별 고정 크기 링에 기록 (쓰기는 자기 스레드만 -> 락/원자 RMW 없음)
+    // - DumpChrome: 모든 링을 모아 Chrome trace event(JSON)로 저장 -> Perfetto / chrome://tracing 에서 열기
+    // 처리 중인 패킷의 trace id는 스레드별 "현재 trace"로 전달 (io -> 로직 큐 -> 핸들러 -> 송신)
+    class Tracer
+    {
+    public:
+        enum class Stage : uint8_t
+        {
+            HeaderRead,   // 헤더 수신 완료 (샘플 결정)
+            Recv,         // 본문 수신 완료
+            Dispatch,     // 로직 스레드가 큐에서 꺼냄
+            HandlerBegin,
+            HandlerEnd,
+            LockWait,     // 락 획득 시도
+            LockAcquired,
+            Enqueue,      // 응답 프레임이 세션 송신 레인에 들어감 (arg = 세션 id)
+            WriteBegin,   // 그 프레임의 첫 바이트 write 시작
+            WriteDone,    // 마지막 바이트 write 완료
+        };
+
+        static constexpr size_t RING_CAPACITY = 16384; // 스레드당 이벤트 수 (넘치면 오래된 것부터 덮어씀)
+
+        static void SetSampleEvery(uint32_t n) { sample_every_.store(n, std::memory_order_relaxed); } // 0 = 끔
+        static uint32_t SampleEvery() { return sample_every_.load(std::memory_order_relaxed); }
+
+        // 샘플 대상이면 0이 아닌 trace id
+        static uint32_t Sample()
+        {
+            uint32_t every = sample_every_.load(std::memory_order_relaxed);
+            if (every == 0) return 0;
+            return SampleSlow(every);
+        }
+
+        static void Mark(uint32_t traceId, Stage stage, uint16_t packetType = 0, uint32_t arg = 0)
+        {
+            if (traceId == 0) return;
+            Record(traceId, stage, packetType, arg);
+        }
+
+        static uint32_t Current() { return CurrentRef(); }
+
+        // 범위 동안 현재 스레드의 trace id 지정
+        class Scope
+        {
+        public:
+            explicit Scope(uint32_t traceId) : previous_(CurrentRef()) { CurrentRef() = traceId; }
+            ~Scope() { CurrentRef() = previous_; }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            uint32_t previous_;
+        };
+
+        // 지금까지 기록된 이벤트를 파일로 (반환: 기록한 span 수, 실패 시 -1)
+        static int64_t DumpChrome(const std::filesystem::path& path);
+
+    private:
+        static uint32_t SampleSlow(uint32_t every);
+        static void Record(uint32_t traceId, Stage stage, uint16_t packetType, uint32_t arg);
+        static uint32_t& CurrentRef()
+        {
+            thread_local uint32_t current = 0;
+            return current;
+        }
+
+        static std::atomic<uint32_t> sample_every_;
+    };
+
+    // 현재 trace가 있으면 락 대기 시간을 기록하는 lock_guard
+    template<typename Mutex>
+    class TracedLockGuard
+    {
+    public:
+        explicit TracedLockGuard(Mutex& mutex)
+            : mutex_(mutex)
+        {
+            uint32_t traceId = Tracer::Current();
+            Tracer::Mark(traceId, Tracer::Stage::LockWait);
+            mutex_.lock();
+            Tracer::Mark(traceId, Tracer::Stage::LockAcquired);
+        }
+        ~TracedLockGuard() { mutex_.unlock(); }
+
+        TracedLockGuard(const TracedLockGuard&) = delete;
+        TracedLockGuard& operator=(const TracedLockGuard&) = delete;
+
+    private:
+        Mutex& mutex_;
+    };
+}
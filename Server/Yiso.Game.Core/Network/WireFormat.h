@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Yiso::Network::Wire
+{
+    // protobuf 와이어 포맷 최소 헬퍼 (protobuf 객체를 거치지 않고 바이트를 직접 읽고/쓸 때 사용)
+    enum WireType : uint8_t
+    {
+        WIRE_VARINT = 0,
+        WIRE_FIXED64 = 1,
+        WIRE_LEN = 2,
+        WIRE_FIXED32 = 5,
+    };
+
+    constexpr uint32_t MakeTag(uint32_t field, WireType type)
+    {
+        return (field << 3) | type;
+    }
+
+    // 성공 시 읽은 바이트 수, 실패(버퍼 끝 / 10바이트 초과) 시 0
+    inline size_t ReadVarint(const uint8_t* p, const uint8_t* end, uint64_t& out)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 10 && p + i < end; ++i)
+        {
+            value |= static_cast<uint64_t>(p[i] & 0x7F) << (7 * i);
+            if ((p[i] & 0x80) == 0)
+            {
+                out = value;
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    constexpr size_t VarintSize(uint64_t value)
+    {
+        size_t n = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+    // 쓴 바이트 수 반환 (dst에 최소 VarintSize(value) 공간 필요)
+    inline size_t WriteVarint(uint8_t* dst, uint64_t value)
+    {
+        size_t n = 0;
+        while (value >= 0x80)
+        {
+            dst[n++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        dst[n++] = static_cast<uint8_t>(value);
+        return n;
+    }
+}
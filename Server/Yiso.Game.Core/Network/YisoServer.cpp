@@ -1,16 +1,77 @@
 #include "YisoServer.h"
+#include "PacketCodec.h"
+#include "game_packet.pb.h"
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace Yiso::Network
 {
-    YisoServer::YisoServer(boost::asio::io_context& io_context, uint16_t port, OnConnect onConnect, OnRecv onRecv, OnDisconnect onDisconnect)
-        : acceptor_(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+    namespace
+    {
+        boost::asio::ip::tcp::acceptor OpenAcceptor(boost::asio::io_context& io, uint16_t port, int listenFd)
+        {
+            if (listenFd >= 0)
+                return boost::asio::ip::tcp::acceptor(io, boost::asio::ip::tcp::v4(), listenFd); // 이미 bind + listen 된 소켓
+            return boost::asio::ip::tcp::acceptor(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
+        }
+    }
+
+    YisoServer::YisoServer(boost::asio::io_context& io_context, uint16_t port, OnConnect onConnect, OnRecv onRecv, OnDisconnect onDisconnect,
+                           OverloadController::Config overloadConfig, YisoSession::ResumeConfig resumeConfig, int listenFd)
+        : acceptor_(OpenAcceptor(io_context, port, listenFd)),
+          accept_timer_(io_context),
+          sweep_timer_(io_context),
+          hello_timer_(io_context),
+          handoff_timer_(io_context),
           on_connect_(onConnect),
-          on_recv_(onRecv),
-          on_disconnect_(onDisconnect)
+          on_disconnect_(onDisconnect),
+          overload_(io_context, session_manager_, overloadConfig) // 참조만 잡음 (생성자에서 사용하지 않음)
     {
+        handlers_.on_recv = std::move(onRecv);
+        handlers_.overload = &overload_;
+        handlers_.on_disconnect = [this](YisoSession::SessionId sessionId)
+        {
+            parked_.erase(sessionId);
+            session_manager_.RemoveSession(sessionId);
+            on_disconnect_(sessionId);
+        };
+        handlers_.resume = resumeConfig;
+        if (resumeConfig.grace_sec > 0)
+        {
+            handlers_.on_hello = [this](YisoSession& session, PacketType type, const uint8_t* data, uint32_t size)
+            {
+                return OnHello(session, type, data, size);
+            };
+            handlers_.on_park = [this](YisoSession::SessionId sessionId)
+            {
+                parked_[sessionId] = YisoSession::NowSec() + handlers_.resume.grace_sec;
+            };
+        }
+
         next_id_.store(1u);
         DoAccept();
+        ScheduleSweep();
+        overload_.Start();
+    }
+
+    void YisoServer::SetSessionIdSpace(YisoSession::SessionId first, YisoSession::SessionId stride)
+    {
+        next_id_.store(first);
+        id_stride_ = stride;
+    }
+
+    YisoSession::SessionId YisoServer::NextSessionId()
+    {
+        // 살아 있는 세션 수만큼만 건너뛸 수 있으므로 반드시 끝남 (공지 전 세션은 매니저에 없어 따로 확인)
+        while (true)
+        {
+            auto id = next_id_.fetch_add(id_stride_);
+            if (id == 0 || session_manager_.HasSession(id))
+                continue;
+            if (std::any_of(pending_.begin(), pending_.end(), [id](const PendingHello& p) { return p.session->GetId() == id; }))
+                continue;
+            return id;
+        }
     }
 
     void YisoServer::Stop()
@@ -18,6 +79,13 @@ namespace Yiso::Network
         boost::system::error_code ec;
         acceptor_.close(ec); // 새 연결 거부 (DoAccept 콜백이 operation_aborted로 완료됨)
         if (ec) spdlog::warn("[Server] acceptor 닫기 실패: {}", ec.message());
+        accept_timer_.cancel();
+        sweep_timer_.cancel();
+        hello_timer_.cancel();
+        overload_.Stop();
+        for (auto& pending : pending_)
+            pending.session->Disconnect(); // 공지 전 세션은 매니저에 없음
+        pending_.clear();
         session_manager_.DisconnectAll(); // 모든 세션 소켓 닫기 -> 진행 중인 async I/O가 에러로 완료 -> io_context 자연 종료
     }
 
@@ -28,22 +96,47 @@ namespace Yiso::Network
             {
                 if (!ec)
                 {
-                    auto id = next_id_.fetch_add(1);
-
-                    auto onDisconnect = [this](YisoSession::SessionId sessionId)
+                    auto level = overload_.GetLevel();
+                    if (level == OverloadController::Level::Critical)
                     {
-                        session_manager_.RemoveSession(sessionId);
-                        on_disconnect_(sessionId);
-                    };
+                        // 받기는 하되 바로 거절 -> backlog에 쌓여 클라이언트가 타임아웃까지 기다리지 않게
+                        overload_.OnAcceptRejected();
+                        Reject(std::move(socket));
+                        DelayAccept(ACCEPT_DELAY_CRITICAL);
+                        return;
+                    }
+
+                    auto id = NextSessionId();
 
-                    auto session = std::make_shared<YisoSession>(
-                        id, std::move(socket), on_recv_, onDisconnect
+                    // 세션 + 제어 블록을 풀의 블록 하나에 (연결/해제 반복 시 힙 할당 없음)
+                    auto session = std::allocate_shared<YisoSession>(
+                        SessionPool::Allocator<YisoSession>(session_pool_), id, std::move(socket), handlers_
                     );
 
-                    session_manager_.AddSession(session);
-                    on_connect_(id);
+                    if (handoff_)
+                    {
+                        // 인계 시작 직전에 완료된 수락 -> 이 세션도 멈춘 채로 같이 넘김
+                        session->PauseForHandoff();
+                        handoff_sessions_.push_back(session);
+                    }
+                    if (handlers_.resume.grace_sec > 0)
+                    {
+                        // 첫 패킷이 재개 요청일 수 있어 공지는 첫 패킷 또는 HELLO_WAIT 뒤
+                        pending_.push_back({ session, std::chrono::steady_clock::now() + HELLO_WAIT });
+                        if (pending_.size() == 1)
+                            ScheduleHello();
+                    }
+                    else
+                    {
+                        Announce(session);
+                    }
                     session->Start();
-                    DoAccept(); // 다음 연결 대기
+                    if (handoff_)
+                        return;
+                    if (level == OverloadController::Level::Elevated)
+                        DelayAccept(ACCEPT_DELAY_ELEVATED); // 수락 속도 제한
+                    else
+                        DoAccept(); // 다음 연결 대기
                 }
                 else if (ec == boost::asio::error::operation_aborted)
                 {
@@ -58,4 +151,325 @@ namespace Yiso::Network
             }
         );
     }
+
+    void YisoServer::DelayAccept(std::chrono::milliseconds delay)
+    {
+        accept_timer_.expires_after(delay);
+        accept_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec) return; // Stop()에서 cancel됨
+            DoAccept();
+        });
+    }
+
+    void YisoServer::Reject(boost::asio::ip::tcp::socket socket)
+    {
+        static const Buffer busyFrame = [] // 풀 전역 상태는 해제하지 않으므로 정적 파괴 순서 문제 없음
+        {
+            yiso::game::S2C_ServerBusy msg;
+            msg.set_retry_after_ms(BUSY_RETRY_AFTER_MS);
+            return PacketCodec::Encode(PacketType::S2C_SERVER_BUSY, msg);
+        }();
+
+        auto rejected = std::make_shared<boost::asio::ip::tcp::socket>(std::move(socket));
+        boost::asio::async_write(*rejected, boost::asio::buffer(busyFrame), [rejected](boost::system::error_code, size_t)
+        {
+            boost::system::error_code ignored;
+            rejected->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+            rejected->close(ignored);
+        });
+    }
+
+    void YisoServer::ScheduleSweep()
+    {
+        sweep_timer_.expires_after(std::chrono::seconds(SWEEP_INTERVAL_SEC));
+        sweep_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec) return; // Stop()에서 cancel됨
+
+            // 재접속 대기 만료 -> 이제야 로직에 끊김 전달 (on_disconnect가 parked_를 지우므로 모아서)
+            uint32_t now = YisoSession::NowSec();
+            for (const auto& [id, deadline] : parked_)
+            {
+                if (static_cast<int32_t>(deadline - now) > 0) continue;
+                spdlog::info("[Session:{}] 재접속 대기 {}초 초과, 세션 종료", id, handlers_.resume.grace_sec);
+                if (auto session = session_manager_.Find(id))
+                    expired_.push_back(std::move(session));
+            }
+            for (auto& session : expired_)
+                session->Disconnect();
+            expired_.clear();
+
+            session_manager_.SweepIdle(YisoSession::TIMEOUT_SEC, expired_);
+            for (auto& session : expired_)
+            {
+                spdlog::warn("[Session:{}] {}초 타임아웃, 연결 종료", session->GetId(), YisoSession::TIMEOUT_SEC);
+                session->Disconnect();
+            }
+            expired_.clear();
+            ScheduleSweep();
+        });
+    }
+
+    void YisoServer::Announce(const std::shared_ptr<YisoSession>& session)
+    {
+        session->MarkAnnounced();
+        session_manager_.AddSession(session);
+        if (handlers_.resume.grace_sec > 0)
+        {
+            uint64_t token = 0;
+            while (token == 0) // 0은 "토큰 없음"
+                token = (static_cast<uint64_t>(token_source_()) << 32) | token_source_();
+            session->SetResumeToken(token);
+
+            yiso::game::S2C_SessionToken msg;
+            msg.set_session_id(session->GetId());
+            msg.set_token(token);
+            msg.set_grace_sec(handlers_.resume.grace_sec);
+            session->Send(PacketCodec::Encode(PacketType::S2C_SESSION_TOKEN, msg)); // 로직이 보내는 어떤 프레임보다 먼저 큐에
+        }
+        on_connect_(session->GetId());
+    }
+
+    bool YisoServer::OnHello(YisoSession& session, PacketType type, const uint8_t* data, uint32_t size)
+    {
+        auto self = session.shared_from_this();
+        if (type != PacketType::C2S_RESUME_SESSION)
+        {
+            Announce(self);
+            return true;
+        }
+
+        yiso::game::C2S_ResumeSession req;
+        const char* error = "잘못된 요청";
+        if (req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            // 이 서버의 매니저에는 YisoSession만 등록됨
+            auto target = std::static_pointer_cast<YisoSession>(session_manager_.Find(req.session_id()));
+            if (!target)
+            {
+                error = "세션 없음 (대기 시간 초과)";
+            }
+            else if (req.token() == 0 || req.token() != target->GetResumeToken())
+            {
+                error = "토큰 불일치";
+            }
+            else
+            {
+                yiso::game::S2C_ResumeResult ok;
+                ok.set_success(true);
+                ok.set_session_id(req.session_id());
+                if (target->Resume(session, req.received(), PacketCodec::Encode(PacketType::S2C_RESUME_RESULT, ok)))
+                {
+                    parked_.erase(req.session_id());
+                    return false;
+                }
+                error = "놓친 프레임이 재전송 보관 범위를 벗어남";
+            }
+        }
+
+        spdlog::info("[Server] 세션 {} 재개 실패: {} -> 새 세션 {}", req.session_id(), error, session.GetId());
+        yiso::game::S2C_ResumeResult fail;
+        fail.set_success(false);
+        fail.set_session_id(req.session_id());
+        fail.set_error(error);
+        session.Send(PacketCodec::Encode(PacketType::S2C_RESUME_RESULT, fail));
+        Announce(self);
+        return true;
+    }
+
+    void YisoServer::ScheduleHello()
+    {
+        hello_timer_.expires_after(HELLO_WAIT);
+        hello_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec) return; // Stop()에서 cancel됨
+
+            auto now = std::chrono::steady_clock::now();
+            auto done = std::remove_if(pending_.begin(), pending_.end(), [this, now](const PendingHello& pending)
+            {
+                if (pending.session->IsAnnounced() || !pending.session->IsOpen())
+                    return true; // 첫 패킷으로 공지됐거나, 재개로 소켓을 넘겼거나, 그 전에 끊김
+                if (pending.deadline > now)
+                    return false;
+                Announce(pending.session);
+                return true;
+            });
+            pending_.erase(done, pending_.end());
+            if (!pending_.empty())
+                ScheduleHello();
+        });
+    }
+
+    void YisoServer::BeginHandoff(std::function<void()> onQuiet)
+    {
+        handoff_ = true;
+        boost::system::error_code ignored;
+        acceptor_.cancel(ignored); // 새 연결은 커널 backlog에서 새 프로세스를 기다림
+        accept_timer_.cancel();
+        sweep_timer_.cancel();
+        hello_timer_.cancel();
+
+        for (auto& connection : session_manager_.Snapshot())
+            handoff_sessions_.push_back(std::static_pointer_cast<YisoSession>(connection));
+        for (auto& pending : pending_)
+            if (!pending.session->IsAnnounced())
+                handoff_sessions_.push_back(pending.session);
+        for (auto& session : handoff_sessions_)
+            session->PauseForHandoff();
+
+        spdlog::info("[Server] 인계 시작: 세션 {}개 멈춤", handoff_sessions_.size());
+        handoff_deadline_ = std::chrono::steady_clock::now() + HANDOFF_WRITE_WAIT;
+        WaitHandoffQuiet(std::move(onQuiet), false);
+    }
+
+    void YisoServer::WaitHandoffQuiet(std::function<void()> onQuiet, bool cancelled)
+    {
+        if (!cancelled)
+        {
+            bool writing = std::any_of(handoff_sessions_.begin(), handoff_sessions_.end(), [](const auto& session)
+            {
+                return session->IsOpen() && session->IsWriting();
+            });
+            if (!writing || std::chrono::steady_clock::now() >= handoff_deadline_)
+            {
+                // 보내던 것은 (거의) 다 보냄 -> 이제 대기 중인 읽기 / 남은 write 취소
+                for (auto& session : handoff_sessions_)
+                    session->CancelForHandoff();
+                cancelled = true;
+            }
+        }
+        else if (std::all_of(handoff_sessions_.begin(), handoff_sessions_.end(), [](const auto& session) { return session->IsHandoffQuiet(); }))
+        {
+            onQuiet();
+            return;
+        }
+
+        handoff_timer_.expires_after(cancelled ? std::chrono::milliseconds(0) : HANDOFF_POLL);
+        handoff_timer_.async_wait([this, onQuiet = std::move(onQuiet), cancelled](boost::system::error_code ec) mutable
+        {
+            if (ec) return;
+            WaitHandoffQuiet(std::move(onQuiet), cancelled);
+        });
+    }
+
+    void YisoServer::ExportHandoff(HandoffWriter& writer, HotRestart::Package& package)
+    {
+        package.listen_fd = static_cast<int>(acceptor_.native_handle());
+        writer.Put(next_id_.load());
+        writer.Put(id_stride_);
+
+        uint32_t now = YisoSession::NowSec();
+        uint32_t count = 0;
+        for (const auto& session : handoff_sessions_)
+            count += session->IsOpen() || session->IsParked();
+        writer.Put(count);
+        for (const auto& session : handoff_sessions_)
+        {
+            if (!session->IsOpen() && !session->IsParked()) continue; // 멈춘 동안 끊긴 세션 (on_disconnect는 이미 나감)
+            uint32_t parkedFor = 0;
+            if (auto it = parked_.find(session->GetId()); it != parked_.end())
+                parkedFor = std::max<int32_t>(static_cast<int32_t>(it->second - now), 1);
+            writer.Put(session->GetId());
+            writer.Put(parkedFor);
+            HandoffWriter state; // 세션마다 길이를 붙여 하나가 깨져도 나머지는 읽히게
+            session->ExportHandoff(state, package.fds);
+            writer.PutBytes(state.Data().data(), state.Data().size());
+        }
+        spdlog::info("[Server] 인계 상태: 세션 {}개 (소켓 {}개)", count, package.fds.size());
+    }
+
+    void YisoServer::FinishHandoff()
+    {
+        boost::system::error_code ignored;
+        HotRestart::CloseHandle(static_cast<int>(acceptor_.release(ignored)));
+        handoff_timer_.cancel();
+        overload_.Stop();
+        for (auto& session : handoff_sessions_)
+            HotRestart::CloseHandle(session->AbandonForHandoff());
+        handoff_sessions_.clear();
+        pending_.clear();
+        parked_.clear();
+        session_manager_.Clear();
+        spdlog::info("[Server] 인계 완료, 이 프로세스의 세션 정리");
+    }
+
+    void YisoServer::AbortHandoff()
+    {
+        handoff_ = false;
+        for (auto& session : handoff_sessions_)
+            session->ResumeAfterHandoff();
+        handoff_sessions_.clear();
+        DoAccept();
+        ScheduleSweep();
+        if (!pending_.empty())
+            ScheduleHello();
+        spdlog::warn("[Server] 인계 취소, 이 프로세스에서 계속");
+    }
+
+    bool YisoServer::ImportHandoff(HandoffReader& reader, std::vector<int>& fds, std::vector<YisoSession::SessionId>& lost)
+    {
+        auto nextId = reader.Get<YisoSession::SessionId>();
+        auto stride = reader.Get<YisoSession::SessionId>();
+        if (reader.Ok())
+        {
+            next_id_.store(nextId);
+            id_stride_ = stride;
+        }
+
+        uint32_t now = YisoSession::NowSec();
+        auto count = reader.Get<uint32_t>();
+        std::vector<std::shared_ptr<YisoSession>> sessions;
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto id = reader.Get<YisoSession::SessionId>();
+            auto parkedFor = reader.Get<uint32_t>();
+            const uint8_t* state;
+            uint32_t stateSize;
+            if (!reader.GetBytes(state, stateSize))
+            {
+                lost.push_back(id);
+                break; // 목록 자체가 깨짐 -> 이후 세션은 ID도 알 수 없음
+            }
+
+            auto session = std::allocate_shared<YisoSession>(
+                SessionPool::Allocator<YisoSession>(session_pool_), id, boost::asio::ip::tcp::socket(acceptor_.get_executor()), handlers_
+            );
+            HandoffReader sessionReader(state, stateSize);
+            if (!session->ImportHandoff(sessionReader, fds))
+            {
+                spdlog::error("[Server] 세션 {} 인계 상태 오류, 이 세션만 버림", id);
+                lost.push_back(id);
+                continue;
+            }
+
+            if (session->IsAnnounced())
+                session_manager_.AddSession(session);
+            else
+                pending_.push_back({ session, std::chrono::steady_clock::now() + HELLO_WAIT });
+            if (parkedFor > 0)
+                parked_[id] = now + parkedFor;
+            sessions.push_back(std::move(session));
+        }
+
+        // 어느 세션도 가져가지 않은 소켓 (깨진 세션 / 읽지 못한 뒷부분) -> 닫아서 클라이언트가 바로 재접속하게
+        size_t closed = 0;
+        for (int& fd : fds)
+        {
+            if (fd < 0) continue;
+            HotRestart::CloseHandle(fd);
+            fd = -1;
+            ++closed;
+        }
+
+        // 다 등록한 뒤에 읽기 / 쓰기 시작 (첫 패킷의 재개 요청이 다른 인계 세션을 찾을 수 있게)
+        for (auto& session : sessions)
+            session->ResumeAfterHandoff();
+        if (!pending_.empty())
+            ScheduleHello();
+        spdlog::info("[Server] 인계받은 세션 {}개 (재접속 대기 {}개)", sessions.size(), parked_.size());
+        if (!lost.empty() || closed > 0 || !reader.Ok())
+            spdlog::error("[Server] 인계 세션 일부 버림: 상태 오류 {}개, 닫은 소켓 {}개", lost.size(), closed);
+        return reader.Ok() && lost.empty();
+    }
 }
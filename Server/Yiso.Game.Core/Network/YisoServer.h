@@ -1,9 +1,15 @@
 #pragma once
 #include "YisoSession.h"
 #include "YisoSessionManager.h"
+#include "SessionPool.h"
+#include "OverloadController.h"
+#include "HotRestart.h"
 #include <boost/asio.hpp>
 #include <atomic>
 #include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
 
 namespace Yiso::Network
 {
@@ -19,20 +25,85 @@ namespace Yiso::Network
             uint16_t port,
             OnConnect onConnect,
             OnRecv onRecv,
-            OnDisconnect onDisconnect);
+            OnDisconnect onDisconnect,
+            OverloadController::Config overloadConfig = {},
+            YisoSession::ResumeConfig resumeConfig = {},
+            int listenFd = -1); // 무중단 재시작으로 받은 리슨 소켓 (-1이면 port에 새로 bind)
 
         YisoSessionManager& GetSessionManager() { return session_manager_; };
+        OverloadController& GetOverload() { return overload_; }
+        SessionPool::Stats GetPoolStats() const { return session_pool_.GetStats(); }
+        // 세션 ID = first + k * stride (여러 게임 프로세스가 ID를 나눠 쓸 때, 접속 받기 전에 호출)
+        void SetSessionIdSpace(YisoSession::SessionId first, YisoSession::SessionId stride);
         void Stop();
 
+        // 무중단 재시작 (io 스레드)
+        // - BeginHandoff: 수락 / 새 read·write 중지 -> 진행 중인 write가 끝나길 잠깐 기다린 뒤 나머지 취소 -> 조용해지면 onQuiet
+        // - onQuiet 뒤 ExportHandoff로 상태 + fd를 담아 보내고, 성공하면 FinishHandoff (세션은 콜백 없이 놓음 -> io_context 자연 종료)
+        // - 보내기에 실패하면 AbortHandoff로 그대로 계속
+        void BeginHandoff(std::function<void()> onQuiet);
+        void ExportHandoff(HandoffWriter& writer, HotRestart::Package& package);
+        void FinishHandoff();
+        void AbortHandoff();
+        // io.run 전, 세션은 on_connect 없이 이어짐
+        // 상태가 깨진 세션은 건너뛰고 lost에 (로직에 끊김을 알리는 건 호출자), 가져가지 않은 fd는 모두 닫음
+        bool ImportHandoff(HandoffReader& reader, std::vector<int>& fds, std::vector<YisoSession::SessionId>& lost);
+
+        static constexpr int SWEEP_INTERVAL_SEC = 5; // 유휴 타임아웃 정밀도 + 버스트 후 버퍼 반납 주기
+        static constexpr auto ACCEPT_DELAY_ELEVATED = std::chrono::milliseconds(10); // 과부하 시 수락 간격 (초당 100개)
+        static constexpr auto ACCEPT_DELAY_CRITICAL = std::chrono::milliseconds(100); // 거절만 하는 동안의 수락 간격
+        static constexpr uint32_t BUSY_RETRY_AFTER_MS = 5000; // S2C_SERVER_BUSY로 알려주는 재접속 대기
+        static constexpr auto HELLO_WAIT = std::chrono::milliseconds(100); // 재개 모드: 첫 패킷이 없어도 이만큼 뒤엔 새 세션으로 공지
+        static constexpr auto HANDOFF_WRITE_WAIT = std::chrono::milliseconds(100); // 인계: 진행 중인 write를 기다리는 최대 시간 (넘으면 남은 바이트째 넘김)
+        static constexpr auto HANDOFF_POLL = std::chrono::milliseconds(1);
+
     private:
         void DoAccept();
+        void DelayAccept(std::chrono::milliseconds delay);
+        void Reject(boost::asio::ip::tcp::socket socket); // S2C_SERVER_BUSY 보내고 닫기 (세션 만들지 않음)
+        void ScheduleSweep();
+        // 다음 세션 ID: 32비트가 한 바퀴 돌면 (stride 256이면 노드당 약 1,677만 접속) 아직 쓰는 ID / 0은 건너뜀
+        YisoSession::SessionId NextSessionId();
+
+        // 세션 재개 (resume.grace_sec > 0)
+        // - 새 연결은 첫 패킷을 볼 때까지 공지(매니저 등록 + on_connect)를 미룸 -> 재개면 로직은 새 세션을 모름
+        // - 끊겨 대기 중인 세션은 grace_sec 뒤 sweep에서 진짜 종료
+        void Announce(const std::shared_ptr<YisoSession>& session);
+        bool OnHello(YisoSession& session, PacketType type, const uint8_t* data, uint32_t size);
+        void ScheduleHello();
+        void WaitHandoffQuiet(std::function<void()> onQuiet, bool cancelled);
 
         boost::asio::ip::tcp::acceptor acceptor_;
-        YisoSessionManager session_manager_;
-        std::atomic<YisoSession::SessionId> next_id_;
+        boost::asio::steady_timer accept_timer_;
+        boost::asio::steady_timer sweep_timer_; // 세션별 타이머 대신 하나로 모든 세션 유휴 검사
+        boost::asio::steady_timer hello_timer_; // 공지 대기 세션이 있을 때만
+        boost::asio::steady_timer handoff_timer_;
 
+        // 세션이 참조하는 것들은 세션보다 오래 살도록 session_manager_ 앞에 선언 (역순 파괴)
         OnConnect on_connect_;
-        OnRecv on_recv_;
         OnDisconnect on_disconnect_;
+        OverloadController overload_;
+        YisoSession::Handlers handlers_; // 모든 세션이 공유
+        SessionPool session_pool_;
+        YisoSessionManager session_manager_;
+        std::atomic<YisoSession::SessionId> next_id_;
+        YisoSession::SessionId id_stride_ = 1;
+
+        std::vector<std::shared_ptr<Connection>> expired_; // sweep 재사용 버퍼
+
+        // 재개 상태 (io 스레드에서만)
+        struct PendingHello
+        {
+            std::shared_ptr<YisoSession> session;
+            std::chrono::steady_clock::time_point deadline;
+        };
+        std::vector<PendingHello> pending_;
+        std::unordered_map<YisoSession::SessionId, uint32_t> parked_; // 세션ID -> 대기 만료 시각 (NowSec)
+        // 인계 중 (io 스레드에서만)
+        bool handoff_ = false;
+        std::vector<std::shared_ptr<YisoSession>> handoff_sessions_;
+        std::chrono::steady_clock::time_point handoff_deadline_;
+
+        std::random_device token_source_; // 토큰은 의사 난수 엔진 대신 OS 난수로 (발급된 토큰으로 다음 토큰을 추측할 수 없게)
     };
 }
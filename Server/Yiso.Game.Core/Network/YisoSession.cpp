@@ -1,61 +1,142 @@
 #include "YisoSession.h"
+#include "game_packet.pb.h"
+#include <algorithm>
+#include <cstring>
 #include <spdlog/spdlog.h>
 
 namespace Yiso::Network
 {
-    YisoSession::YisoSession(SessionId id, Socket socket, OnRecv onRecv, OnDisconnect onDisconnect)
+    namespace
+    {
+        // 봉투 집계 (GetEnvelopeStats)
+        std::atomic<uint64_t> g_envelope_connections{0};
+        std::atomic<uint64_t> g_envelopes_received{0};
+        std::atomic<uint64_t> g_envelope_items_received{0};
+        std::atomic<uint64_t> g_envelopes_sent{0};
+        std::atomic<uint64_t> g_envelope_items_sent{0};
+        std::atomic<uint64_t> g_envelope_bytes_sent{0};
+        std::atomic<uint64_t> g_envelope_plain_bytes{0};
+
+        // 재접속을 기다릴 만한 끊김 (망 전환 / 순간 단절)
+        // - eof = 클라이언트가 정상 종료 -> 돌아오지 않음, operation_aborted = 서버가 닫음
+        // - 리셋은 포함: 모바일 망 전환 / NAT 만료 때 중간 장비가 RST로 끊는 경우가 흔함
+        bool IsResumableError(const boost::system::error_code& ec)
+        {
+            namespace error = boost::asio::error;
+            return ec == error::timed_out || ec == error::connection_reset || ec == error::connection_aborted ||
+                   ec == error::broken_pipe || ec == error::network_down || ec == error::network_reset ||
+                   ec == error::network_unreachable || ec == error::host_unreachable;
+        }
+    }
+
+    YisoSession::YisoSession(SessionId id, Socket socket, const Handlers& handlers)
         : id_(id),
+          io_(static_cast<boost::asio::io_context&>(socket.get_executor().context())),
           socket_(std::move(socket)),
-          timer_(socket_.get_executor()),
-          on_recv_(onRecv),
-          on_disconnect_(onDisconnect)
+          handlers_(handlers),
+          last_active_(NowSec())
+    {
+    }
+
+    YisoSession::~YisoSession()
+    {
+        if (send_ && send_->queued_bytes != 0 && handlers_.overload)
+            handlers_.overload->AddQueuedBytes(-static_cast<int64_t>(send_->queued_bytes));
+    }
+
+    uint32_t YisoSession::NowSec()
     {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
     }
 
     void YisoSession::Start()
     {
-        ResetTimer();
+        if (auto* capture = PacketCapture::Active())
+            capture->Record(id_, PacketCapture::Direction::Open, nullptr, 0);
         DoReadHeader();
     }
 
-    void YisoSession::ResetTimer()
+    void YisoSession::ReleaseBuffers()
     {
-        timer_.expires_after(std::chrono::seconds(TIMEOUT_SEC));
-        timer_.async_wait([this, self = shared_from_this()](boost::system::error_code ec)
-        {
-            if (ec == boost::asio::error::operation_aborted) return; // Disconnect()에서 cancel됨
-            spdlog::warn("[Session:{}] {}초 타임아웃, 연결 종료", id_, TIMEOUT_SEC);
-            Disconnect();
-        });
+        if (!reading_body_)
+            Buffer().swap(body_buf_);
+        if (send_ && !writing_ && send_->queued == 0)
+            send_.reset();
+        if (assembler_ && assembler_->Idle())
+            assembler_.reset();
+        if (replay_ && state_ == State::Open && !send_ && NowSec() - replay_->LastPushSec() > REPLAY_RETAIN_SEC)
+            replay_.reset(); // 그만큼 지났으면 받았다고 봄 (아니면 재개 실패 -> 새 세션)
     }
 
-    // post로 감싸 항상 io_context 스레드에서 실행 → writing_, send_queue_ 접근이 단일 스레드로 보장
+    // post로 감싸 항상 io_context 스레드에서 실행 → writing_, send_ 접근이 단일 스레드로 보장
     // 추후 멀티 스레드 io_context 전환 시 strand로 교체
-    void YisoSession::Send(std::vector<uint8_t> frame)
+    void YisoSession::Send(Buffer frame)
     {
-        boost::asio::post(socket_.get_executor(),
-            [this, self = shared_from_this(), frame = std::move(frame)]() mutable
+        if (frame.size() < HEADER_SIZE) return;
+
+        PacketHeader header;
+        std::memcpy(&header, frame.data(), HEADER_SIZE);
+        size_t lane = static_cast<size_t>(SendLaneOf(static_cast<PacketType>(header.type)));
+        uint32_t traceId = Tracer::Current();
+        uint16_t type = header.type;
+
+        boost::asio::post(io_,
+            [this, self = shared_from_this(), frame = std::move(frame), lane, traceId, type]() mutable
             {
-                if (send_queue_.size() >= MAX_SEND_QUEUE_SIZE)
+                if (state_ == State::Closed) return;
+                if (!send_)
+                    send_ = std::make_unique<SendState>();
+                if (send_->queued >= MAX_SEND_QUEUE_SIZE)
                 {
-                    spdlog::warn("[Session:{}] send_queue_ 한도 초과 ({}개), 연결 종료", id_, send_queue_.size());
+                    spdlog::warn("[Session:{}] 송신 큐 한도 초과 ({}개), 연결 종료", id_, send_->queued);
                     Disconnect();
                     return;
                 }
-                send_queue_.push_back(std::move(frame));
+                Tracer::Mark(traceId, Tracer::Stage::Enqueue, type, id_);
+                if (auto* capture = PacketCapture::Active())
+                    capture->Record(id_, PacketCapture::Direction::ServerToClient, frame.data(), frame.size());
+                send_->queued_bytes += frame.size();
+                if (handlers_.overload)
+                    handlers_.overload->AddQueuedBytes(static_cast<int64_t>(frame.size()));
+                send_->lanes[lane].queue.push_back({ std::move(frame), traceId });
+                ++send_->queued;
+                if (state_ == State::Parked)
+                {
+                    if (send_->queued_bytes > handlers_.resume.park_bytes)
+                    {
+                        spdlog::warn("[Session:{}] 재접속 대기 중 송신 큐 {} bytes 초과, 세션 종료", id_, handlers_.resume.park_bytes);
+                        Disconnect();
+                    }
+                    return;
+                }
                 if (!writing_)
                     DoWrite();
             });
     }
 
-    void YisoSession::DoReadHeader()
+    void YisoSession::DoReadHeader(size_t have)
     {
+        if (handoff_)
+        {
+            partial_in_.assign(reinterpret_cast<const uint8_t*>(&header_buf_), reinterpret_cast<const uint8_t*>(&header_buf_) + have);
+            return;
+        }
+
         auto self = shared_from_this();
+        reading_ = true;
         boost::asio::async_read(
             socket_,
-            boost::asio::buffer(&header_buf_, HEADER_SIZE),
-            [this, self](boost::system::error_code ec, auto)
+            boost::asio::buffer(reinterpret_cast<uint8_t*>(&header_buf_) + have, HEADER_SIZE - have),
+            [this, self, gen = generation_, have](boost::system::error_code ec, size_t bytes)
             {
+                if (gen != generation_) return; // 닫았거나 재개로 바뀐 소켓
+                reading_ = false;
+                if (ec == boost::asio::error::operation_aborted && handoff_)
+                {
+                    DoReadHeader(have + bytes); // 인계 -> 받은 만큼만 보관
+                    return;
+                }
                 if (ec)
                 {
                     // EOF는 클라이언트가 정상적으로 연결을 끊은 것
@@ -66,38 +147,63 @@ namespace Yiso::Network
                     Disconnect(ec);
                     return;
                 }
+                recv_trace_id_ = Tracer::Sample();
+                Tracer::Mark(recv_trace_id_, Tracer::Stage::HeaderRead, header_buf_.type, id_);
                 DoReadBody();
             }
         );
     }
 
-    void YisoSession::DoReadBody()
+    void YisoSession::DoReadBody(size_t have)
     {
-        if (header_buf_.body_size == 0 || header_buf_.body_size > MAX_PACKET_SIZE)
+        if (handoff_)
         {
-            spdlog::warn("[Session:{}] 잘못된 body_size={}, 연결 종료", id_, header_buf_.body_size);
-            Disconnect();
+            partial_in_.assign(reinterpret_cast<const uint8_t*>(&header_buf_), reinterpret_cast<const uint8_t*>(&header_buf_) + HEADER_SIZE);
+            partial_in_.insert(partial_in_.end(), body_buf_.begin(), body_buf_.begin() + static_cast<std::ptrdiff_t>(have));
             return;
         }
 
-        try
-        {
-            body_buf_.resize(header_buf_.body_size);
-        }
-        catch (const std::bad_alloc&)
+        if (have == 0)
         {
-            spdlog::error("[Session:{}] 메모리 할당 실패 (body_size={}), 연결 종료", id_, header_buf_.body_size);
-            Disconnect();
-            return;
-        }
+            // 빈 본문: 필드 없는 게임 메시지 (C2S_EnterDojo {} 등은 Encode가 0바이트로 씀) / item 없는 봉투 / 기능을 모두 끈 HELLO
+            // 조각 / 재개 요청은 앞에 고정 헤더가 있어야 함
+            auto type = static_cast<PacketType>(header_buf_.type);
+            bool emptyAllowed = IsGameC2SType(type) || type == PacketType::C2S_ENVELOPE || type == PacketType::C2S_HELLO;
+            if ((header_buf_.body_size == 0 && !emptyAllowed) || header_buf_.body_size > MAX_PACKET_SIZE)
+            {
+                spdlog::warn("[Session:{}] 잘못된 body_size={}, 연결 종료", id_, header_buf_.body_size);
+                Disconnect();
+                return;
+            }
 
+            try
+            {
+                body_buf_.resize(header_buf_.body_size);
+                reading_body_ = true;
+            }
+            catch (const std::bad_alloc&)
+            {
+                spdlog::error("[Session:{}] 메모리 할당 실패 (body_size={}), 연결 종료", id_, header_buf_.body_size);
+                Disconnect();
+                return;
+            }
+        }
 
         auto self = shared_from_this();
+        reading_ = true;
         boost::asio::async_read(
             socket_,
-            boost::asio::buffer(body_buf_),
-            [this, self](boost::system::error_code ec, auto)
+            boost::asio::buffer(body_buf_.data() + have, body_buf_.size() - have),
+            [this, self, gen = generation_, have](boost::system::error_code ec, size_t bytes)
             {
+                if (gen != generation_) return;
+                reading_ = false;
+                if (ec == boost::asio::error::operation_aborted && handoff_)
+                {
+                    DoReadBody(have + bytes);
+                    return;
+                }
+                reading_body_ = false;
                 if (ec)
                 {
                     spdlog::error("[Session:{}] 바디 읽기 오류: {}", id_, ec.message());
@@ -110,43 +216,668 @@ namespace Yiso::Network
                     Disconnect();
                     return;
                 }
-                ResetTimer(); // 완전한 패킷 수신 시마다 타임아웃 리셋
-                on_recv_(id_, static_cast<PacketType>(header_buf_.type), body_buf_.data(), static_cast<uint32_t>(body_buf_.size()));
+                last_active_.store(NowSec(), std::memory_order_relaxed); // 완전한 패킷 수신 시마다 타임아웃 리셋
+                Tracer::Mark(recv_trace_id_, Tracer::Stage::Recv, header_buf_.type, id_);
+                if (auto* capture = PacketCapture::Active())
+                    capture->Record(id_, PacketCapture::Direction::ClientToServer, &header_buf_, HEADER_SIZE, body_buf_.data(), body_buf_.size());
+                Tracer::Scope traceScope(recv_trace_id_); // 콜백(로직 큐 투입)에 trace 전달
+
+                if (!announced_ && handlers_.on_hello &&
+                    !handlers_.on_hello(*this, static_cast<PacketType>(header_buf_.type), body_buf_.data(), static_cast<uint32_t>(body_buf_.size())))
+                    return; // 소켓을 재개 대상 세션이 가져감
+
+                if (header_buf_.type == static_cast<uint16_t>(PacketType::C2S_RESUME_SESSION))
+                {
+                    // 첫 패킷이 아니거나 재개 실패 -> 로직으로 보내지 않음
+                }
+                else if (header_buf_.type == static_cast<uint16_t>(PacketType::C2S_HELLO))
+                {
+                    if (!HandleHello(body_buf_.data(), static_cast<uint32_t>(body_buf_.size())))
+                    {
+                        spdlog::warn("[Session:{}] 잘못된 HELLO 패킷, 연결 종료", id_);
+                        Disconnect();
+                        return;
+                    }
+                }
+                else if (header_buf_.type == static_cast<uint16_t>(PacketType::C2S_ENVELOPE))
+                {
+                    if (!DispatchEnvelope(body_buf_.data(), static_cast<uint32_t>(body_buf_.size())))
+                    {
+                        spdlog::warn("[Session:{}] 잘못된 봉투 패킷, 연결 종료", id_);
+                        Disconnect();
+                        return;
+                    }
+                }
+                else if (header_buf_.type == static_cast<uint16_t>(PacketType::C2S_FRAME_CHUNK))
+                {
+                    PacketType type;
+                    const uint8_t* body;
+                    uint32_t bodySize;
+                    if (!assembler_)
+                        assembler_ = std::make_unique<ChunkAssembler>(MaxChunkedC2SSize);
+                    auto result = assembler_->Feed(body_buf_.data(), static_cast<uint32_t>(body_buf_.size()), type, body, bodySize);
+                    if (result == ChunkAssembler::Result::Error ||
+                        (result == ChunkAssembler::Result::Complete && !IsGameC2SType(type)))
+                    {
+                        spdlog::warn("[Session:{}] 잘못된 조각 패킷, 연결 종료", id_);
+                        Disconnect();
+                        return;
+                    }
+                    if (result == ChunkAssembler::Result::Complete)
+                        handlers_.on_recv(id_, type, body, bodySize);
+                }
+                else
+                {
+                    handlers_.on_recv(id_, static_cast<PacketType>(header_buf_.type), body_buf_.data(), static_cast<uint32_t>(body_buf_.size()));
+                }
+                if (body_buf_.capacity() > RECV_RETAIN_BYTES)
+                    Buffer().swap(body_buf_); // 큰 패킷 한 번에 버퍼가 계속 커져 있지 않게
                 DoReadHeader(); // 이렇게 계속 다음 패킷 올떄까지 대기 -> 처리 반복
             }
         );
     }
 
+    bool YisoSession::HandleHello(const uint8_t* body, uint32_t size)
+    {
+        yiso::game::C2S_Hello req;
+        if (!req.ParseFromArray(body, static_cast<int>(size)))
+            return false;
+
+        // 이 연결은 봉투를 읽을 수 있음 -> 다음 write부터 묶어 보냄 (끄는 건 허용하지 않음: 이미 묶어 보낸 프레임이 있을 수 있음)
+        if (req.envelope() && !envelope_)
+        {
+            envelope_ = true;
+            g_envelope_connections.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool YisoSession::DispatchEnvelope(const uint8_t* body, uint32_t size)
+    {
+        // 한 번 훑으면서 바로 넘김 (본문은 봉투 버퍼를 그대로 가리킴, on_recv가 복사)
+        EnvelopeReader reader(body, size);
+        PacketType type;
+        const uint8_t* item;
+        uint32_t itemSize;
+        uint64_t items = 0;
+        EnvelopeReader::Result result;
+        while ((result = reader.Next(type, item, itemSize)) == EnvelopeReader::Result::Item)
+        {
+            if (!IsGameC2SType(type))
+                return false; // S2C / 세션 제어 item -> 봉투 전체를 거부
+            ++items;
+            handlers_.on_recv(id_, type, item, itemSize);
+            if (state_ == State::Closed)
+                break; // 앞 item 처리 중에 끊김 (로그인 실패 등) -> 나머지는 버림
+        }
+        g_envelopes_received.fetch_add(1, std::memory_order_relaxed);
+        g_envelope_items_received.fetch_add(items, std::memory_order_relaxed);
+        return result != EnvelopeReader::Result::Error;
+    }
+
     void YisoSession::DoWrite()
     {
+        if (handoff_)
+        {
+            writing_ = false; // 남은 큐는 인계 상태로
+            return;
+        }
+
+        auto& state = *send_;
+        auto lane = state.lanes.begin() + RESEND_LANE;
+        if (lane->Empty())
+        {
+            lane = std::find_if(state.lanes.begin(), lane, [](const Lane& l) { return !l.Empty(); });
+            if (lane == state.lanes.begin() + RESEND_LANE)
+            {
+                writing_ = false;
+                return;
+            }
+        }
         writing_ = true;
+        state.write_lane = static_cast<size_t>(lane - state.lanes.begin());
+        state.write_packed = false;
+
+        const auto& queued = lane->Front();
+        const auto& buffer = queued.bytes;
+        if (lane->offset == 0 && lane->chunk_sent == 0)
+            Tracer::Mark(queued.trace_id, Tracer::Stage::WriteBegin, 0, id_);
+
+        PacketHeader header;
+        std::memcpy(&header, buffer.data() + lane->offset, HEADER_SIZE);
+        if (lane->offset + HEADER_SIZE + header.body_size > buffer.size())
+        {
+            // 잘린 프레임 -> 버퍼 나머지는 버림 (앞서 보낸 프레임 경계는 유지됨)
+            spdlog::error("[Session:{}] 송신 버퍼 프레임 경계 오류 ({} bytes 버림)", id_, buffer.size() - lane->offset);
+            state.write_chunk = 0;
+            state.write_end = buffer.size();
+            OnWritten();
+            return;
+        }
+
         auto self = shared_from_this();
-        boost::asio::async_write(
-            socket_,
-            boost::asio::buffer(send_queue_.front()),
-            [this, self](boost::system::error_code ec, auto)
+        auto onWritten = [this, self, gen = generation_](boost::system::error_code ec, size_t written)
+        {
+            if (gen != generation_)
             {
-                if (ec)
+                // 닫힌 소켓의 write -> 재개됐으면 이제 새 소켓으로 (보낸 위치는 이 write 전 그대로)
+                writing_ = false;
+                if (state_ == State::Open)
+                    DoWrite();
+                return;
+            }
+            if (ec == boost::asio::error::operation_aborted && handoff_)
+            {
+                // 인계 -> 이번 write의 남은 바이트를 그대로 넘기고 (새 프로세스가 먼저 보냄) 큐는 다 보낸 것처럼 진행
+                auto& state = *send_;
+                auto& lane = state.lanes[state.write_lane];
+                const uint8_t* data = lane.Front().bytes.data() + lane.offset;
+                if (state.write_chunk != 0)
                 {
-                    spdlog::error("[Session:{}] 쓰기 오류: {}", id_, ec.message());
-                    Disconnect(ec);
-                    return;
+                    raw_out_.assign(state.chunk_head.begin(), state.chunk_head.end());
+                    raw_out_.insert(raw_out_.end(), data + HEADER_SIZE + lane.chunk_sent, data + HEADER_SIZE + lane.chunk_sent + state.write_chunk);
+                }
+                else if (state.write_packed)
+                {
+                    raw_out_.assign(state.envelope.begin(), state.envelope.end());
                 }
-                send_queue_.pop_front();
-                if (!send_queue_.empty())
-                    DoWrite();
                 else
-                    writing_ = false;
+                {
+                    raw_out_.assign(data, static_cast<const uint8_t*>(lane.Front().bytes.data()) + state.write_end);
+                }
+                raw_out_.erase(raw_out_.begin(), raw_out_.begin() + static_cast<std::ptrdiff_t>(written));
+                OnWritten();
+                return;
             }
-        );
+            if (ec)
+            {
+                spdlog::error("[Session:{}] 쓰기 오류: {}", id_, ec.message());
+                writing_ = false;
+                Disconnect(ec);
+                return;
+            }
+            OnWritten();
+        };
+
+        if (header.body_size > CHUNK_SIZE)
+        {
+            // 큰 프레임: 본문에서 CHUNK_SIZE만큼 잘라 조각 프레임 하나로 (본문은 복사 없이 원본 버퍼에서 바로 씀)
+            state.write_chunk = std::min(CHUNK_SIZE, header.body_size - lane->chunk_sent);
+
+            PacketHeader chunkFrame;
+            chunkFrame.body_size = CHUNK_HEADER_SIZE + state.write_chunk;
+            chunkFrame.type = static_cast<uint16_t>(PacketType::S2C_FRAME_CHUNK);
+            ChunkHeader chunk;
+            chunk.total_size = header.body_size;
+            chunk.type = header.type;
+            chunk.stream = static_cast<uint8_t>(state.write_lane);
+            chunk.reserved = 0;
+            std::memcpy(state.chunk_head.data(), &chunkFrame, HEADER_SIZE);
+            std::memcpy(state.chunk_head.data() + HEADER_SIZE, &chunk, CHUNK_HEADER_SIZE);
+
+            std::array<boost::asio::const_buffer, 2> buffers = {
+                boost::asio::buffer(state.chunk_head),
+                boost::asio::buffer(buffer.data() + lane->offset + HEADER_SIZE + lane->chunk_sent, state.write_chunk),
+            };
+            boost::asio::async_write(socket_, buffers, onWritten);
+            return;
+        }
+
+        state.write_chunk = 0;
+        if (envelope_ && PackEnvelope())
+        {
+            boost::asio::async_write(socket_, boost::asio::buffer(state.envelope), onWritten);
+            return;
+        }
+
+        // 작은 프레임: 뒤이은 작은 프레임들을 CHUNK_SIZE까지 한 번에
+        size_t end = lane->offset;
+        while (end + HEADER_SIZE <= buffer.size())
+        {
+            std::memcpy(&header, buffer.data() + end, HEADER_SIZE);
+            size_t frameSize = HEADER_SIZE + header.body_size;
+            if (header.body_size > CHUNK_SIZE || end + frameSize > buffer.size()) break;
+            if (end != lane->offset && end + frameSize - lane->offset > CHUNK_SIZE) break;
+            end += frameSize;
+        }
+        state.write_end = end;
+        boost::asio::async_write(socket_, boost::asio::buffer(buffer.data() + lane->offset, end - lane->offset), onWritten);
+    }
+
+    bool YisoSession::PackEnvelope()
+    {
+        // 재전송 레인부터 (RESEND, Control, Chat, Bulk) -> item 순서가 곧 받는 쪽 순번
+        // 레인마다 앞에서부터 작은 프레임만, 큰 프레임 / 조각 전송 중인 레인은 거기서 멈춤 (레인 안 순서 유지)
+        auto& state = *send_;
+        size_t count = 0;
+        size_t bodySize = 0;
+        bool full = false;
+        for (size_t n = 0; n < state.lanes.size(); ++n)
+        {
+            size_t i = (RESEND_LANE + n) % state.lanes.size();
+            auto& lane = state.lanes[i];
+            auto& packed = state.packed[i];
+            packed = {};
+            if (full || lane.chunk_sent != 0) continue;
+
+            for (size_t j = lane.head; j < lane.queue.size(); ++j)
+            {
+                const auto& bytes = lane.queue[j].bytes;
+                size_t offset = j == lane.head ? lane.offset : 0;
+                size_t end = offset;
+                while (end + HEADER_SIZE <= bytes.size())
+                {
+                    PacketHeader header;
+                    std::memcpy(&header, bytes.data() + end, HEADER_SIZE);
+                    if (header.body_size > CHUNK_SIZE || end + HEADER_SIZE + header.body_size > bytes.size())
+                        break;
+                    size_t itemSize = EnvelopeWriter::ItemSize(static_cast<PacketType>(header.type), header.body_size);
+                    if (bodySize + itemSize > CHUNK_SIZE)
+                    {
+                        full = true;
+                        break;
+                    }
+                    bodySize += itemSize;
+                    ++count;
+                    end += HEADER_SIZE + header.body_size;
+                }
+                if (end < bytes.size())
+                {
+                    if (end > offset)
+                        packed.end = end; // 이 버퍼는 여기까지 (나머지는 다음 write)
+                    break;
+                }
+                ++packed.entries;
+            }
+        }
+        if (count < 2) return false; // 하나면 그냥 프레임으로 (봉투 헤더만 늘어남)
+
+        EnvelopeWriter writer(state.envelope);
+        size_t plainBytes = 0;
+        for (size_t n = 0; n < state.lanes.size(); ++n)
+        {
+            size_t i = (RESEND_LANE + n) % state.lanes.size();
+            const auto& lane = state.lanes[i];
+            const auto& packed = state.packed[i];
+            for (size_t k = 0; k <= packed.entries && lane.head + k < lane.queue.size(); ++k)
+            {
+                const auto& queued = lane.queue[lane.head + k];
+                size_t offset = k == 0 ? lane.offset : 0;
+                size_t end = k < packed.entries ? queued.bytes.size() : packed.end;
+                if (end <= offset) break;
+                if (offset == 0 && !(i == state.write_lane && k == 0)) // 고른 레인의 앞 버퍼는 DoWrite에서 기록함
+                    Tracer::Mark(queued.trace_id, Tracer::Stage::WriteBegin, 0, id_);
+                for (size_t at = offset; at < end;)
+                {
+                    PacketHeader header;
+                    std::memcpy(&header, queued.bytes.data() + at, HEADER_SIZE);
+                    writer.AddFrame(queued.bytes.data() + at);
+                    at += HEADER_SIZE + header.body_size;
+                }
+                plainBytes += end - offset;
+            }
+        }
+        writer.Finish(PacketType::S2C_ENVELOPE);
+        state.write_packed = true;
+
+        g_envelopes_sent.fetch_add(1, std::memory_order_relaxed);
+        g_envelope_items_sent.fetch_add(count, std::memory_order_relaxed);
+        g_envelope_bytes_sent.fetch_add(state.envelope.size(), std::memory_order_relaxed);
+        g_envelope_plain_bytes.fetch_add(plainBytes, std::memory_order_relaxed);
+        return true;
+    }
+
+    void YisoSession::OnWritten()
+    {
+        auto& state = *send_;
+        if (state.write_packed)
+        {
+            // 봉투에 담은 순서 그대로 보낸 것으로 (재개 순번도 item 순서)
+            for (size_t n = 0; n < state.lanes.size(); ++n)
+            {
+                size_t i = (RESEND_LANE + n) % state.lanes.size();
+                auto& lane = state.lanes[i];
+                auto& packed = state.packed[i];
+                for (; packed.entries > 0; --packed.entries)
+                    Advance(lane, lane.Front().bytes.size());
+                if (packed.end > 0)
+                    Advance(lane, packed.end);
+                packed.end = 0;
+            }
+            state.write_packed = false;
+            DoWrite();
+            return;
+        }
+
+        auto& lane = state.lanes[state.write_lane];
+        if (state.write_chunk != 0)
+        {
+            PacketHeader header;
+            std::memcpy(&header, lane.Front().bytes.data() + lane.offset, HEADER_SIZE);
+            lane.chunk_sent += state.write_chunk;
+            if (lane.chunk_sent < header.body_size)
+            {
+                DoWrite();
+                return;
+            }
+            lane.chunk_sent = 0;
+            state.write_end = lane.offset + HEADER_SIZE + header.body_size;
+        }
+
+        Advance(lane, state.write_end);
+        DoWrite();
+    }
+
+    void YisoSession::Advance(Lane& lane, size_t end)
+    {
+        auto& state = *send_;
+        if (handlers_.resume.grace_sec > 0)
+            Retain(lane.Front().bytes.data() + lane.offset, end - lane.offset);
+        lane.offset = end;
+        if (lane.offset >= lane.Front().bytes.size())
+        {
+            Tracer::Mark(lane.Front().trace_id, Tracer::Stage::WriteDone, 0, id_);
+            size_t bytes = lane.Front().bytes.size();
+            state.queued_bytes -= bytes;
+            if (handlers_.overload)
+                handlers_.overload->AddQueuedBytes(-static_cast<int64_t>(bytes));
+            lane.PopFront();
+            lane.offset = 0;
+            --state.queued;
+        }
+    }
+
+    void YisoSession::Retain(const uint8_t* data, size_t size)
+    {
+        uint32_t now = NowSec();
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= size)
+        {
+            PacketHeader header;
+            std::memcpy(&header, data + offset, HEADER_SIZE);
+            size_t frameSize = HEADER_SIZE + header.body_size;
+            if (offset + frameSize > size) break;
+            if (IsSequencedType(static_cast<PacketType>(header.type)))
+            {
+                if (!replay_)
+                    replay_ = std::make_unique<ReplayBuffer>(handlers_.resume.replay_bytes);
+                replay_->Push(++sent_seq_, data + offset, frameSize, now);
+            }
+            offset += frameSize;
+        }
+    }
+
+    void YisoSession::CloseSocket()
+    {
+        ++generation_; // 진행 중인 read / write 완료 콜백은 무시
+        boost::system::error_code ignored;
+        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+    }
+
+    void YisoSession::CancelForHandoff()
+    {
+        boost::system::error_code ignored;
+        if (state_ == State::Open)
+            socket_.cancel(ignored); // 완료 콜백이 operation_aborted + 그때까지 옮긴 바이트 수로 옴
+    }
+
+    void YisoSession::ExportHandoff(HandoffWriter& writer, std::vector<int>& fds)
+    {
+        // 인계는 Quiet 상태에서만 -> 진행 중인 read / write 없음, 남은 바이트는 partial_in_ / raw_out_
+        int32_t fd = -1;
+        if (state_ == State::Open)
+        {
+            fd = static_cast<int32_t>(fds.size());
+            fds.push_back(static_cast<int>(socket_.native_handle()));
+        }
+        writer.Put(fd);
+        writer.Put(static_cast<uint8_t>(announced_));
+        writer.Put(static_cast<uint8_t>(envelope_));
+        writer.Put(resume_token_);
+        writer.Put(sent_seq_);
+        writer.Put(last_active_.load(std::memory_order_relaxed));
+        writer.PutBytes(partial_in_.data(), partial_in_.size());
+        writer.PutBytes(raw_out_.data(), raw_out_.size());
+        if (assembler_)
+            assembler_->ExportHandoff(writer);
+        else
+            writer.Put(uint8_t{ 0 }); // 조립 중인 stream 없음
+
+        // 레인: 앞 버퍼는 offset부터 (보낸 프레임은 빼고), 분할 중인 프레임은 보낸 본문 바이트 수까지
+        for (size_t i = 0; i < SEND_LANE_COUNT + 1; ++i)
+        {
+            if (!send_)
+            {
+                writer.Put(uint32_t{ 0 });
+                continue;
+            }
+            const auto& lane = send_->lanes[i];
+            writer.Put(static_cast<uint32_t>(lane.queue.size() - lane.head));
+            if (lane.Empty()) continue;
+            writer.Put(lane.chunk_sent);
+            for (size_t j = lane.head; j < lane.queue.size(); ++j)
+            {
+                size_t offset = j == lane.head ? lane.offset : 0;
+                writer.PutBytes(lane.queue[j].bytes.data() + offset, lane.queue[j].bytes.size() - offset);
+            }
+        }
+
+        // 재전송 보관: 첫 순번 + 이어붙인 프레임
+        Buffer frames;
+        uint64_t firstSeq = 0;
+        if (replay_ && replay_->Bytes() > 0 && replay_->Collect(replay_->FirstSeq() - 1, sent_seq_, frames))
+            firstSeq = replay_->FirstSeq();
+        writer.Put(firstSeq);
+        writer.PutBytes(frames.data(), frames.size());
+    }
+
+    bool YisoSession::ImportHandoff(HandoffReader& reader, std::vector<int>& fds)
+    {
+        auto fd = reader.Get<int32_t>();
+        announced_ = reader.Get<uint8_t>() != 0;
+        envelope_ = reader.Get<uint8_t>() != 0;
+        resume_token_ = reader.Get<uint64_t>();
+        sent_seq_ = reader.Get<uint64_t>();
+        last_active_.store(reader.Get<uint32_t>(), std::memory_order_relaxed);
+        partial_in_ = reader.GetBuffer();
+        raw_out_ = reader.GetBuffer();
+        assembler_ = std::make_unique<ChunkAssembler>(MaxChunkedC2SSize);
+        if (!assembler_->ImportHandoff(reader))
+            return false;
+        if (assembler_->Idle())
+            assembler_.reset();
+
+        for (size_t i = 0; i < SEND_LANE_COUNT + 1; ++i)
+        {
+            auto count = reader.Get<uint32_t>();
+            if (count == 0) continue;
+            if (!send_)
+                send_ = std::make_unique<SendState>();
+            auto& lane = send_->lanes[i];
+            lane.chunk_sent = reader.Get<uint32_t>();
+            for (uint32_t j = 0; j < count && reader.Ok(); ++j)
+            {
+                Buffer bytes = reader.GetBuffer();
+                send_->queued_bytes += bytes.size();
+                if (handlers_.overload)
+                    handlers_.overload->AddQueuedBytes(static_cast<int64_t>(bytes.size()));
+                lane.queue.push_back({ std::move(bytes), 0 });
+                ++send_->queued;
+            }
+        }
+
+        auto firstSeq = reader.Get<uint64_t>();
+        const uint8_t* frames;
+        uint32_t framesSize;
+        if (reader.GetBytes(frames, framesSize) && framesSize > 0)
+        {
+            replay_ = std::make_unique<ReplayBuffer>(handlers_.resume.replay_bytes);
+            uint32_t now = NowSec();
+            size_t offset = 0;
+            for (uint64_t seq = firstSeq; offset + HEADER_SIZE <= framesSize; ++seq)
+            {
+                PacketHeader header;
+                std::memcpy(&header, frames + offset, HEADER_SIZE);
+                size_t frameSize = HEADER_SIZE + header.body_size;
+                if (offset + frameSize > framesSize) break;
+                replay_->Push(seq, frames + offset, frameSize, now);
+                offset += frameSize;
+            }
+        }
+
+        if (!reader.Ok() || fd >= static_cast<int32_t>(fds.size()))
+            return false;
+        if (fd < 0)
+        {
+            state_ = State::Parked; // 재접속 대기 중이던 세션 (소켓 없음)
+            return true;
+        }
+        int& handle = fds[static_cast<size_t>(fd)];
+        if (handle < 0)
+            return false; // 다른 세션이 이미 가져간 인덱스 (깨진 상태)
+        boost::system::error_code ec;
+        socket_.assign(boost::asio::ip::tcp::v4(), handle, ec);
+        if (ec)
+        {
+            spdlog::error("[Session:{}] 인계받은 소켓 등록 실패: {}", id_, ec.message());
+            return false;
+        }
+        handle = -1;
+        return true;
+    }
+
+    void YisoSession::ResumeAfterHandoff()
+    {
+        handoff_ = false;
+        if (state_ != State::Open) return;
+
+        // 받다 만 패킷부터 이어서
+        Buffer in = std::move(partial_in_);
+        if (in.size() < HEADER_SIZE)
+        {
+            std::memcpy(&header_buf_, in.data(), in.size());
+            DoReadHeader(in.size());
+        }
+        else
+        {
+            std::memcpy(&header_buf_, in.data(), HEADER_SIZE);
+            size_t have = in.size() - HEADER_SIZE;
+            if (have > 0)
+            {
+                body_buf_.assign(in.begin() + HEADER_SIZE, in.end());
+                body_buf_.resize(header_buf_.body_size); // 보낸 쪽에서 검사를 통과한 크기
+                reading_body_ = true;
+            }
+            DoReadBody(have);
+        }
+
+        if (!raw_out_.empty())
+            WriteHandoffRemainder();
+        else if (send_ && !writing_)
+            DoWrite();
+    }
+
+    void YisoSession::WriteHandoffRemainder()
+    {
+        writing_ = true;
+        auto self = shared_from_this();
+        boost::asio::async_write(socket_, boost::asio::buffer(raw_out_), [this, self, gen = generation_](boost::system::error_code ec, size_t written)
+        {
+            writing_ = false;
+            if (gen != generation_)
+            {
+                Buffer().swap(raw_out_); // 재개로 바뀐 연결에는 의미 없음 (빠진 프레임은 재전송으로)
+                if (state_ == State::Open && send_)
+                    DoWrite();
+                return;
+            }
+            if (ec == boost::asio::error::operation_aborted && handoff_)
+            {
+                raw_out_.erase(raw_out_.begin(), raw_out_.begin() + static_cast<std::ptrdiff_t>(written)); // 다음 프로세스로 다시 넘김
+                return;
+            }
+            if (ec)
+            {
+                spdlog::error("[Session:{}] 쓰기 오류: {}", id_, ec.message());
+                Disconnect(ec);
+                return;
+            }
+            Buffer().swap(raw_out_);
+            if (send_)
+                DoWrite();
+        });
+    }
+
+    int YisoSession::AbandonForHandoff()
+    {
+        bool wasOpen = state_ == State::Open;
+        state_ = State::Closed; // 콜백 없이 끝 (로직의 세션은 새 프로세스에서 계속)
+        ++generation_;
+        if (!wasOpen) return -1;
+        boost::system::error_code ignored;
+        return static_cast<int>(socket_.release(ignored)); // 이 프로세스 이벤트 루프에서만 빼고 연결은 그대로
+    }
+
+    bool YisoSession::Resume(YisoSession& from, uint64_t received, Buffer resultFrame)
+    {
+        if (state_ == State::Closed) return false;
+        if (received > sent_seq_) return false;
+        if (received != sent_seq_ && !(replay_ && replay_->Collect(received, sent_seq_, resultFrame))) return false;
+        uint64_t replayed = sent_seq_ - received;
+
+        if (state_ == State::Open)
+            CloseSocket(); // 예전 소켓이 아직 끊긴 줄 모르는 경우 (모바일 망 전환 등)
+        else
+            ++generation_;
+        socket_ = std::move(from.socket_);
+        from.state_ = State::Closed; // 넘겨준 쪽은 콜백 없이 끝
+        state_ = State::Open;
+        reading_body_ = false;
+        assembler_.reset(); // 새 연결에서는 조각을 처음부터
+        envelope_ = false; // 봉투는 연결마다 다시 협상 (재전송은 낱개 프레임으로)
+        last_active_.store(NowSec(), std::memory_order_relaxed);
+
+        // 다시 보낼 프레임은 결과 프레임 뒤에 이어붙여 전용 레인으로 (다 보내면 다시 순번을 받음)
+        sent_seq_ = received;
+        if (replay_)
+            replay_->Clear();
+        if (!send_)
+            send_ = std::make_unique<SendState>();
+        for (auto& lane : send_->lanes)
+            lane.chunk_sent = 0; // 보내다 만 조각 프레임은 처음부터
+        send_->queued_bytes += resultFrame.size();
+        if (handlers_.overload)
+            handlers_.overload->AddQueuedBytes(static_cast<int64_t>(resultFrame.size()));
+        send_->lanes[RESEND_LANE].queue.push_back({ std::move(resultFrame), 0 });
+        ++send_->queued;
+
+        spdlog::info("[Session:{}] 세션 재개 ({}개 프레임 재전송, 대기 중 {}개 버퍼)", id_, replayed, send_->queued - 1);
+        DoReadHeader();
+        if (!writing_)
+            DoWrite(); // 아니면 이전 소켓의 write가 끝날 때 이어서
+        return true;
     }
 
     void YisoSession::Disconnect(boost::system::error_code ec)
     {
-        if (disconnected_) return;
-        disconnected_ = true;
+        if (state_ == State::Closed) return;
+
+        // 네트워크 오류로 끊긴 공지된 세션 -> 재접속 대기 (서버가 끊은 경우는 ec 없음, 클라이언트 정상 종료는 바로 종료)
+        if (state_ == State::Open && announced_ && handlers_.resume.grace_sec > 0 && IsResumableError(ec))
+        {
+            state_ = State::Parked;
+            CloseSocket();
+            spdlog::info("[Session:{}] 연결 끊김 ({}), {}초 재접속 대기", id_, ec.message(), handlers_.resume.grace_sec);
+            handlers_.on_park(id_);
+            return;
+        }
 
-        timer_.cancel(); // 타임아웃 타이머 취소 (operation_aborted로 콜백 완료됨)
+        bool wasOpen = state_ == State::Open;
+        state_ = State::Closed;
+
+        if (auto* capture = PacketCapture::Active())
+            capture->Record(id_, PacketCapture::Direction::Close, nullptr, 0);
 
         // ec가 없거나 EOF면 정상 종료, 그 외는 비정상
         if (!ec || ec == boost::asio::error::eof)
@@ -154,10 +885,23 @@ namespace Yiso::Network
         else
             spdlog::warn("[Session:{}] 비정상 세션 종료: {}", id_, ec.message());
 
-        boost::system::error_code ignored;
-        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
-        socket_.close(ignored);
-        on_disconnect_(id_);
+        if (wasOpen)
+            CloseSocket();
+        if (announced_)
+            handlers_.on_disconnect(id_);
+    }
+
+    YisoSession::EnvelopeStats YisoSession::GetEnvelopeStats()
+    {
+        EnvelopeStats stats;
+        stats.connections = g_envelope_connections.load(std::memory_order_relaxed);
+        stats.received = g_envelopes_received.load(std::memory_order_relaxed);
+        stats.received_items = g_envelope_items_received.load(std::memory_order_relaxed);
+        stats.sent = g_envelopes_sent.load(std::memory_order_relaxed);
+        stats.sent_items = g_envelope_items_sent.load(std::memory_order_relaxed);
+        stats.sent_bytes = g_envelope_bytes_sent.load(std::memory_order_relaxed);
+        stats.plain_bytes = g_envelope_plain_bytes.load(std::memory_order_relaxed);
+        return stats;
     }
 
 }
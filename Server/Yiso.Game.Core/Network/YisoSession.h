@@ -1,7 +1,17 @@
 #pragma once
 #include "PacketHeader.h"
+#include "Connection.h"
+#include "ChunkAssembler.h"
+#include "Envelope.h"
+#include "PacketCapture.h"
+#include "Tracer.h"
+#include "OverloadController.h"
+#include "BufferPool.h"
+#include "ReplayBuffer.h"
+#include "HotRestart.h"
 #include <boost/asio.hpp>
-#include <deque>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -9,43 +19,210 @@
 
 namespace Yiso::Network
 {
-    class YisoSession : public std::enable_shared_from_this<YisoSession>
+    class YisoSession : public Connection, public std::enable_shared_from_this<YisoSession>
     {
     public:
-        using SessionId = uint32_t;
         using Socket = boost::asio::ip::tcp::socket;
         using OnRecv = std::function<void(SessionId, PacketType, const uint8_t*, uint32_t)>; // 패킷 수신 콜백: (세션ID, 패킷타입, 페이로드 포인터, 페이로드 크기)
         using OnDisconnect = std::function<void(SessionId)>; // 연결 해제 콜백: (세션ID)
 
-        YisoSession(SessionId id, Socket socket, OnRecv onRecv, OnDisconnect onDisconnect);
+        // 세션 재개: 네트워크 오류로 끊기면 grace_sec 동안 세션을 세워 둠 (로직은 끊김을 모름, EOF = 정상 종료는 제외)
+        // - 그동안 보내는 프레임은 송신 큐에 쌓음 (park_bytes 넘으면 그때 진짜 종료)
+        // - 다 보낸 프레임은 replay_bytes까지 보관 -> 재접속하면 클라이언트가 못 받은 것만 다시 보냄
+        struct ResumeConfig
+        {
+            uint32_t grace_sec = 0; // 0이면 재개 없음 (끊기면 바로 종료)
+            size_t replay_bytes = 64 * 1024;
+            size_t park_bytes = 256 * 1024;
+        };
+
+        // 재개 모드에서 공지 전 첫 프레임을 서버가 먼저 봄 (false면 소켓을 다른 세션으로 넘겨 이 세션은 끝)
+        using OnHello = std::function<bool(YisoSession&, PacketType, const uint8_t*, uint32_t)>;
+
+        // 콜백은 서버가 하나만 들고 세션은 참조만 (세션마다 std::function 복사본을 두지 않음)
+        struct Handlers
+        {
+            OnRecv on_recv;
+            OnDisconnect on_disconnect; // 공지된 세션만
+            OverloadController* overload = nullptr; // 송신 큐 바이트 집계 (없으면 생략)
+            ResumeConfig resume;
+            OnHello on_hello;
+            OnDisconnect on_park; // 재접속 대기 시작
+        };
+
+        YisoSession(SessionId id, Socket socket, const Handlers& handlers);
+        ~YisoSession();
 
         void Start();
-        void Send(std::vector<uint8_t> frame);
-        void Disconnect(boost::system::error_code ec={});
+        void Send(Buffer frame) override; // 레인은 첫 프레임의 PacketType으로 결정 (SendLaneOf)
+        void Disconnect() override { Disconnect({}); }
+        void Disconnect(boost::system::error_code ec);
+
+        SessionId GetId() const override { return id_; }
+
+        // 세션 매니저 등록 + on_connect 뒤 (그 전에 끊기면 on_disconnect 없음)
+        void MarkAnnounced() { announced_ = true; }
+        bool IsAnnounced() const { return announced_; }
+        bool IsOpen() const { return state_ == State::Open; }
+        void SetResumeToken(uint64_t token) { resume_token_ = token; }
+        uint64_t GetResumeToken() const { return resume_token_; }
+
+        // from의 소켓을 이어받아 재개 (io 스레드, from의 on_hello 안에서)
+        // received 뒤 프레임을 resultFrame 다음에 다시 보냄, 이미 버린 프레임이 있으면 false (아무것도 바꾸지 않음)
+        bool Resume(YisoSession& from, uint64_t received, Buffer resultFrame);
 
-        SessionId GetId() const { return id_; }
+        // 유휴 관리 (세션별 타이머 대신 서버가 주기적으로 훑음, io 스레드에서 호출)
+        static uint32_t NowSec(); // 단조 시계 초 단위
+        uint32_t IdleSeconds(uint32_t now) const override { return now - last_active_.load(std::memory_order_relaxed); }
+        void ReleaseBuffers() override; // 지금 쓰지 않는 송수신 버퍼 반납
+
+        // 무중단 재시작 인계 (io 스레드)
+        // - Pause: 새 write를 시작하지 않고, 읽던 패킷을 다 받으면 다음 읽기를 멈춤
+        // - Cancel: 진행 중인 read / write 취소 -> 받다 만 바이트 / 보내다 만 바이트를 그대로 보관
+        // - Quiet가 되면 Export (소켓 fd는 fds에 추가, 상태에는 그 인덱스) -> 새 프로세스에서 Import 후 Resume
+        //   (Import가 가져간 fd는 fds에서 -1로 바꿈 -> 남은 fd는 호출자가 닫음)
+        // - 인계가 끝나면 Abandon: shutdown 없이 이 프로세스의 소켓만 놓음 (반환한 fd는 호출자가 닫음)
+        void PauseForHandoff() { handoff_ = true; }
+        void CancelForHandoff();
+        bool IsHandoffQuiet() const { return state_ != State::Open || (!reading_ && !writing_); }
+        bool IsWriting() const { return writing_; }
+        bool IsParked() const { return state_ == State::Parked; }
+        void ExportHandoff(HandoffWriter& writer, std::vector<int>& fds);
+        bool ImportHandoff(HandoffReader& reader, std::vector<int>& fds);
+        void ResumeAfterHandoff(); // Import 뒤, 또는 인계가 실패해 이 프로세스에서 계속할 때
+        int AbandonForHandoff();
+
+        // 봉투 집계 (프로세스 전체, 아무 스레드에서나 읽음)
+        struct EnvelopeStats
+        {
+            uint64_t connections; // 봉투를 켠 연결
+            uint64_t received;
+            uint64_t received_items;
+            uint64_t sent;
+            uint64_t sent_items;
+            uint64_t sent_bytes; // 봉투 프레임 바이트
+            uint64_t plain_bytes; // 같은 메시지를 낱개 프레임으로 보냈다면
+        };
+        static EnvelopeStats GetEnvelopeStats();
+
+        static constexpr int TIMEOUT_SEC = 300;
+        static constexpr size_t RECV_RETAIN_BYTES = 1024; // 이보다 큰 수신 버퍼는 패킷 처리 직후 반납
 
     private:
-        void DoReadHeader();
-        void DoReadBody();
+        enum class State : uint8_t
+        {
+            Open,
+            Parked, // 소켓은 닫혔고 재접속 대기 중
+            Closed,
+        };
+
+        void DoReadHeader(size_t have = 0); // have: header_buf_ / body_buf_에 이미 받은 바이트 (인계 후 이어 받기)
+        void DoReadBody(size_t have = 0);
+        void WriteHandoffRemainder(); // 인계받은 보내다 만 바이트를 먼저 보낸 뒤 DoWrite
+        bool DispatchEnvelope(const uint8_t* body, uint32_t size); // false면 잘못된 봉투 (게임 메시지가 아닌 item 포함)
+        bool HandleHello(const uint8_t* body, uint32_t size); // C2S_HELLO -> 연결 기능 협상, false면 잘못된 요청
         void DoWrite();
-        void ResetTimer();
+        bool PackEnvelope(); // 레인 앞쪽의 작은 프레임들을 봉투 하나로 (2개 이상일 때만)
+        void OnWritten();
+        void Retain(const uint8_t* data, size_t size); // 다 보낸 프레임들에 순번 + 재전송용 보관
+        void CloseSocket();
 
         SessionId id_;
+        boost::asio::io_context& io_; // Send의 post 대상 (socket_은 Resume에서 바뀔 수 있어 다른 스레드에서 보지 않음)
         Socket socket_;
-        boost::asio::steady_timer timer_; // socket_ 이후 선언하기 (초기화 순서 보장)
+        const Handlers& handlers_;
+        std::atomic<uint32_t> last_active_; // 마지막으로 완전한 패킷을 받은 시각 (NowSec)
 
         PacketHeader header_buf_{};
-        std::vector<uint8_t> body_buf_;
+        bool reading_body_ = false;
+        bool reading_ = false; // 현재 소켓에 async_read 진행 중
+        bool writing_ = false; // 이전 소켓의 write가 아직 안 끝났어도 true
+        bool announced_ = false;
+        bool envelope_ = false; // C2S_Hello.envelope -> 송신을 봉투로 묶음 (재개로 소켓이 바뀌면 다시 꺼짐)
+        State state_ = State::Open;
+        uint32_t generation_ = 0; // 소켓을 닫거나 바꿀 때마다 증가 -> 이전 소켓의 완료 콜백은 무시
+        Buffer body_buf_; // 패킷 크기만큼 필요할 때 할당
+        uint32_t recv_trace_id_ = 0; // 수신 중인 패킷의 trace (샘플 아니면 0)
 
-        std::deque<std::vector<uint8_t>> send_queue_;
-        bool writing_ = false;
-        bool disconnected_ = false;
+        // 송신 레인: 한 번의 write는 최대 CHUNK_SIZE 정도 -> 매 write마다 높은 우선순위 레인부터 다시 고름
+        // 여러 프레임이 이어붙은 버퍼(채팅 기록 등)는 프레임 경계에서 끊어 보냄
+        // 본문이 CHUNK_SIZE보다 큰 프레임은 FRAME_CHUNK 조각으로 나눠 보냄 (stream = 레인 번호)
+        struct Queued
+        {
+            Buffer bytes;
+            uint32_t trace_id; // 샘플된 패킷 처리 중 보낸 프레임이면 그 trace (아니면 0)
+        };
 
-        OnRecv on_recv_;
-        OnDisconnect on_disconnect_;
+        // 레인 큐: 비우면 clear -> capacity만 남음 (deque는 비어 있어도 블록을 잡고 있어 세션마다 3개씩 두기엔 큼)
+        struct Lane
+        {
+            std::vector<Queued> queue;
+            size_t head = 0; // queue[head]가 front
+            size_t offset = 0; // front 버퍼에서 다음에 보낼 위치 (프레임 경계)
+            uint32_t chunk_sent = 0; // 분할 중인 프레임 본문 중 보낸 바이트
+
+            bool Empty() const { return head == queue.size(); }
+            Queued& Front() { return queue[head]; }
+            void PopFront()
+            {
+                queue[head].bytes = {};
+                if (++head == queue.size())
+                {
+                    queue.clear();
+                    head = 0;
+                }
+                else if (head >= 32 && head * 2 >= queue.size())
+                {
+                    // 계속 밀려 비지 않는 레인 -> 앞쪽 빈 칸 정리 (vector가 끝없이 자라지 않게)
+                    queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(head));
+                    head = 0;
+                }
+            }
+        };
+
+        // 송신 상태: 첫 Send에서 할당, 다 보내고 유휴 sweep 때 반납 -> 조용한 세션은 포인터 하나만 차지
+        // 마지막 레인은 재개 때 다시 보내는 프레임 전용 (다른 레인보다 먼저, 보낸 순서 그대로)
+        static constexpr size_t RESEND_LANE = SEND_LANE_COUNT;
+
+        struct SendState
+        {
+            std::array<Lane, SEND_LANE_COUNT + 1> lanes;
+            size_t queued = 0; // 모든 레인의 버퍼 수
+            size_t queued_bytes = 0;
+
+            // 진행 중인 write 정보 (io 스레드에서만 접근)
+            size_t write_lane = 0;
+            size_t write_end = 0; // 프레임 단위 write: 완료 후 offset
+            uint32_t write_chunk = 0; // 조각 write: 이번 조각 본문 크기 (0 = 프레임 단위 write)
+            std::array<uint8_t, HEADER_SIZE + CHUNK_HEADER_SIZE> chunk_head{};
+
+            // 봉투 write: 레인마다 앞에서부터 entries개 버퍼를 다 보내고, 그다음 버퍼는 end까지 (0이면 없음)
+            struct Packed
+            {
+                size_t entries = 0;
+                size_t end = 0;
+            };
+            bool write_packed = false;
+            std::array<Packed, SEND_LANE_COUNT + 1> packed{};
+            Buffer envelope; // 봉투 프레임 (write 동안 유지, 다음 봉투에 capacity 재사용)
+        };
+
+        void Advance(Lane& lane, size_t end); // 레인 앞 버퍼를 end까지 보낸 것으로 (다 보냈으면 꺼냄)
+
+        std::unique_ptr<SendState> send_;
+        std::unique_ptr<ChunkAssembler> assembler_; // 첫 FRAME_CHUNK 수신 때 할당 (type별 상한 MaxChunkedC2SSize)
+
+        // 세션 재개 (재개 모드에서만)
+        uint64_t resume_token_ = 0;
+        uint64_t sent_seq_ = 0; // 다 보낸 순번 프레임 수
+        std::unique_ptr<ReplayBuffer> replay_; // 첫 순번 프레임 때 할당, 오래 조용하면 반납
+
+        // 인계 (io 스레드에서만)
+        bool handoff_ = false;
+        Buffer partial_in_; // 받다 만 패킷 (헤더 + 본문 일부)
+        Buffer raw_out_; // 보내다 만 write의 남은 바이트 (프레임 경계 아님)
 
         static constexpr size_t MAX_SEND_QUEUE_SIZE = 256;
-        static constexpr int TIMEOUT_SEC = 300;
+        static constexpr uint32_t REPLAY_RETAIN_SEC = 30; // 연결이 살아 있는데 이보다 오래된 보관 프레임은 반납
     };
 }
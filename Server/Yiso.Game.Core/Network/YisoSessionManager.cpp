@@ -3,10 +3,12 @@
 
 namespace Yiso::Network
 {
-    void YisoSessionManager::AddSession(std::shared_ptr<YisoSession> session)
+    void YisoSessionManager::AddSession(std::shared_ptr<Connection> session)
     {
         std::lock_guard lock(mutex_);
         spdlog::info("[SessionManager] 세션 추가 id={}", session->GetId());
+        if (hold_broadcasts_)
+            held_.insert(session->GetId());
         sessions_[session->GetId()] = std::move(session);
     }
 
@@ -15,24 +17,26 @@ namespace Yiso::Network
         std::lock_guard lock(mutex_);
         spdlog::info("[SessionManager] 세션 제거 id={}", id);
         sessions_.erase(id);
+        held_.erase(id);
     }
 
-    void YisoSessionManager::Broadcast(std::vector<uint8_t> frame)
+    void YisoSessionManager::Broadcast(Buffer frame)
     {
-        std::vector<std::shared_ptr<YisoSession>> snapshot;
+        std::vector<std::shared_ptr<Connection>> snapshot;
         {
             std::lock_guard lock(mutex_);
             for (auto& [id, session] : sessions_)
-                snapshot.push_back(session);
+                if (held_.empty() || !held_.count(id))
+                    snapshot.push_back(session);
         }
         spdlog::debug("[SessionManager] Broadcast {} 세션", snapshot.size());
         for (auto& session : snapshot)
             session->Send(frame);
     }
 
-    void YisoSessionManager::Send(SessionId id, std::vector<uint8_t> frame)
+    void YisoSessionManager::Send(SessionId id, Buffer frame)
     {
-        std::shared_ptr<YisoSession> target;
+        std::shared_ptr<Connection> target;
         {
             std::lock_guard lock(mutex_);
             auto it = sessions_.find(id);
@@ -45,23 +49,93 @@ namespace Yiso::Network
             spdlog::warn("[SessionManager] 존재하지 않는 세션 id={} 에 전송 시도", id);
     }
 
-    void YisoSessionManager::DisconnectAll()
+    void YisoSessionManager::Multicast(const SessionId* ids, size_t count, const Buffer& frame)
     {
-        std::vector<std::shared_ptr<YisoSession>> snapshot;
+        // 호출마다 할당하지 않도록 스레드별 버퍼 재사용
+        thread_local std::vector<std::shared_ptr<Connection>> targets;
+        targets.clear();
         {
             std::lock_guard lock(mutex_);
-            for (auto& [id, session] : sessions_)
-                snapshot.push_back(session);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto it = sessions_.find(ids[i]);
+                if (it != sessions_.end())
+                    targets.push_back(it->second);
+            }
         }
+        for (auto& session : targets)
+            session->Send(frame);
+        targets.clear(); // 세션 참조를 잡아두지 않음
+    }
 
+    void YisoSessionManager::DisconnectAll()
+    {
+        auto snapshot = Snapshot();
         spdlog::info("[SessionManager] 전체 세션 종료 ({}개)", snapshot.size());
         for (auto& session : snapshot)
             session->Disconnect();
     }
 
+    std::vector<std::shared_ptr<Connection>> YisoSessionManager::Snapshot()
+    {
+        std::vector<std::shared_ptr<Connection>> snapshot;
+        std::lock_guard lock(mutex_);
+        snapshot.reserve(sessions_.size());
+        for (auto& [id, session] : sessions_)
+            snapshot.push_back(session);
+        return snapshot;
+    }
+
+    void YisoSessionManager::Clear()
+    {
+        std::lock_guard lock(mutex_);
+        spdlog::info("[SessionManager] 세션 목록 비움 ({}개 인계)", sessions_.size());
+        sessions_.clear();
+        held_.clear();
+    }
+
+    void YisoSessionManager::HoldBroadcasts(bool hold)
+    {
+        std::lock_guard lock(mutex_);
+        hold_broadcasts_ = hold;
+        if (!hold)
+            held_.clear();
+    }
+
+    void YisoSessionManager::Admit(SessionId id)
+    {
+        std::lock_guard lock(mutex_);
+        held_.erase(id);
+    }
+
     bool YisoSessionManager::HasSession(SessionId id)
     {
         std::lock_guard lock(mutex_);
         return sessions_.find(id) != sessions_.end();
     }
+
+    std::shared_ptr<Connection> YisoSessionManager::Find(SessionId id)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = sessions_.find(id);
+        return it != sessions_.end() ? it->second : nullptr;
+    }
+
+    size_t YisoSessionManager::Count()
+    {
+        std::lock_guard lock(mutex_);
+        return sessions_.size();
+    }
+
+    void YisoSessionManager::SweepIdle(uint32_t timeoutSec, std::vector<std::shared_ptr<Connection>>& expired)
+    {
+        uint32_t now = YisoSession::NowSec();
+        std::lock_guard lock(mutex_);
+        for (auto& [id, session] : sessions_)
+        {
+            session->ReleaseBuffers();
+            if (session->IdleSeconds(now) > timeoutSec)
+                expired.push_back(session); // Disconnect는 RemoveSession으로 다시 락을 잡으므로 밖에서
+        }
+    }
 }
@@ -1,8 +1,9 @@
 #pragma once
 #include "YisoSession.h"
-#include <map>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Yiso::Network
@@ -10,17 +11,31 @@ namespace Yiso::Network
     class YisoSessionManager
     {
     public:
-        using SessionId = YisoSession::SessionId;
+        using SessionId = Connection::SessionId;
 
-        void AddSession(std::shared_ptr<YisoSession> session);
+        void AddSession(std::shared_ptr<Connection> session); // TCP 세션 / 루프백 연결 모두
         void RemoveSession(SessionId id);
-        void Broadcast(std::vector<uint8_t> frame); // 모든 세션에 전송
-        void Send(SessionId id, std::vector<uint8_t> frame); // 특정 세션에만 전송
+        void Broadcast(Buffer frame); // 모든 세션에 전송
+        void Send(SessionId id, Buffer frame); // 특정 세션에만 전송
+        void Multicast(const SessionId* ids, size_t count, const Buffer& frame); // 지정한 세션들에만 전송
         void DisconnectAll();
+        std::vector<std::shared_ptr<Connection>> Snapshot();
+        void Clear(); // 끊지 않고 목록만 비움 (무중단 재시작으로 세션을 넘긴 뒤)
         bool HasSession(SessionId id);
+        std::shared_ptr<Connection> Find(SessionId id);
+        size_t Count();
+
+        // 로그인 관문: 켜면 새로 추가된 세션은 Admit 전까지 Broadcast에서 빠짐 (Send / Multicast는 그대로)
+        void HoldBroadcasts(bool hold);
+        void Admit(SessionId id);
+
+        // 모든 세션의 유휴 버퍼 반납 + timeoutSec 넘게 조용한 세션 수집 (io 스레드에서 호출)
+        void SweepIdle(uint32_t timeoutSec, std::vector<std::shared_ptr<Connection>>& expired);
 
     private:
         std::mutex mutex_;
-        std::map<SessionId, std::shared_ptr<YisoSession>> sessions_;
+        std::unordered_map<SessionId, std::shared_ptr<Connection>> sessions_;
+        bool hold_broadcasts_ = false;
+        std::unordered_set<SessionId> held_; // 아직 방송을 받지 않는 세션
     };
 }
@@ -0,0 +1,221 @@
+#include "LoginGate.h"
+#include "Network/PacketCodec.h"
+#include "game_packet.pb.h"
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    LoginGate::LoginGate(boost::asio::io_context& io, Network::YisoSessionManager& sessionManager, TokenValidator& validator, Handlers handlers)
+        : session_manager_(sessionManager),
+          validator_(validator),
+          handlers_(std::move(handlers)),
+          sweep_timer_(io)
+    {
+        session_manager_.HoldBroadcasts(true); // 로그인 전 세션에는 전체 채팅 / 입장 알림도 보내지 않음
+    }
+
+    void LoginGate::Start()
+    {
+        ScheduleSweep();
+    }
+
+    void LoginGate::Stop()
+    {
+        sweep_timer_.cancel();
+    }
+
+    void LoginGate::OnConnect(SessionId id)
+    {
+        Waiting waiting;
+        waiting.deadline = std::chrono::steady_clock::now() + LOGIN_TIMEOUT;
+        waiting_[id] = std::move(waiting);
+    }
+
+    void LoginGate::OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        if (admitted_.count(id))
+        {
+            handlers_.on_recv(id, type, data, size);
+            return;
+        }
+
+        auto it = waiting_.find(id);
+        if (it == waiting_.end() || type != Network::PacketType::C2S_LOGIN || !it->second.token.empty())
+        {
+            ++stats_.dropped_packets; // 로그인 전 패킷 / 검증 중에 다시 온 로그인
+            return;
+        }
+
+        yiso::game::C2S_Login req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)) || req.session_id().empty())
+        {
+            spdlog::warn("[Auth] Login ParseFromArray failed (session={})", id);
+            SendResult(id, false, "잘못된 요청");
+            return;
+        }
+        it->second.token = req.session_id();
+        ++it->second.attempts;
+        BeginValidate(id, it->second);
+    }
+
+    void LoginGate::OnDisconnect(SessionId id)
+    {
+        if (admitted_.erase(id))
+        {
+            handlers_.on_disconnect(id);
+            return;
+        }
+        waiting_.erase(id); // 로직은 접속도 몰랐음
+    }
+
+    void LoginGate::BeginValidate(SessionId id, Waiting& waiting)
+    {
+        validator_.Validate(waiting.token, [this, id](TokenValidator::Status status, const std::string& userId) { OnValidated(id, status, userId); });
+    }
+
+    void LoginGate::OnValidated(SessionId id, TokenValidator::Status status, const std::string& userId)
+    {
+        auto it = waiting_.find(id);
+        if (it == waiting_.end()) return; // 검증 중에 끊김
+        it->second.token.clear();
+
+        switch (status)
+        {
+        case TokenValidator::Status::Valid:
+            waiting_.erase(it);
+            admitted_.insert(id);
+            session_manager_.Admit(id);
+            ++stats_.succeeded;
+            SendResult(id, true, "");
+            handlers_.on_connect(id, userId); // 로직이 보내는 입장 프레임보다 결과가 먼저 큐에
+            return;
+        case TokenValidator::Status::Invalid:
+            ++stats_.failed;
+            SendResult(id, false, "유효하지 않거나 만료된 세션");
+            break;
+        case TokenValidator::Status::Unavailable:
+            ++stats_.unavailable;
+            --it->second.attempts; // 클라이언트 잘못이 아님 -> 횟수에 세지 않음 (시간 초과는 그대로)
+            SendResult(id, false, "인증 서버 응답 없음, 잠시 후 다시 시도");
+            break;
+        }
+
+        if (it->second.attempts >= MAX_ATTEMPTS)
+        {
+            spdlog::warn("[Auth] 세션 {} 로그인 {}회 실패, 연결 종료", id, MAX_ATTEMPTS);
+            Kick(id);
+        }
+    }
+
+    void LoginGate::SendResult(SessionId id, bool success, const char* error)
+    {
+        yiso::game::S2C_LoginResult msg;
+        msg.set_success(success);
+        msg.set_error(error);
+        session_manager_.Send(id, Network::PacketCodec::Encode(Network::PacketType::S2C_LOGIN_RESULT, msg));
+    }
+
+    void LoginGate::Kick(SessionId id)
+    {
+        ++stats_.kicked;
+        if (auto session = session_manager_.Find(id))
+            session->Disconnect(); // -> OnDisconnect에서 정리 (보내던 결과는 못 갈 수 있음)
+        else
+            waiting_.erase(id);
+    }
+
+    void LoginGate::ScheduleSweep()
+    {
+        sweep_timer_.expires_after(SWEEP_INTERVAL);
+        sweep_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec) return; // Stop()에서 cancel됨
+
+            auto now = std::chrono::steady_clock::now();
+            std::vector<SessionId> expired;
+            for (const auto& [id, waiting] : waiting_)
+                if (waiting.deadline <= now)
+                    expired.push_back(id);
+            for (SessionId id : expired)
+            {
+                spdlog::info("[Auth] 세션 {} 로그인 시간 초과, 연결 종료", id);
+                Kick(id);
+            }
+            ScheduleSweep();
+        });
+    }
+
+    void LoginGate::ExportHandoff(Network::HandoffWriter& writer) const
+    {
+        writer.Put(static_cast<uint32_t>(admitted_.size()));
+        for (SessionId id : admitted_)
+            writer.Put(id);
+        writer.Put(static_cast<uint32_t>(waiting_.size()));
+        for (const auto& [id, waiting] : waiting_)
+        {
+            writer.Put(id);
+            writer.Put(waiting.attempts);
+            writer.PutString(waiting.token);
+        }
+    }
+
+    bool LoginGate::ImportHandoff(Network::HandoffReader& reader)
+    {
+        auto admitted = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < admitted && reader.Ok(); ++i)
+        {
+            auto id = reader.Get<SessionId>();
+            admitted_.insert(id);
+            session_manager_.Admit(id);
+        }
+
+        // 시한은 새로 (멈춘 시간만큼 손해 보지 않게), 검증 중이던 토큰은 다시 조회
+        auto count = reader.Get<uint32_t>();
+        auto deadline = std::chrono::steady_clock::now() + LOGIN_TIMEOUT;
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto id = reader.Get<SessionId>();
+            auto& waiting = waiting_[id];
+            waiting.deadline = deadline;
+            waiting.attempts = reader.Get<uint8_t>();
+            waiting.token = reader.GetString();
+            if (!waiting.token.empty())
+                BeginValidate(id, waiting);
+        }
+        return reader.Ok();
+    }
+
+    void LoginGate::AdmitAll()
+    {
+        for (const auto& session : session_manager_.Snapshot())
+        {
+            admitted_.insert(session->GetId());
+            session_manager_.Admit(session->GetId());
+        }
+        waiting_.clear();
+    }
+
+    std::vector<LoginGate::SessionId> LoginGate::WaitingInHandoff(Network::HandoffReader& reader)
+    {
+        auto admitted = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < admitted && reader.Ok(); ++i)
+            reader.Get<SessionId>();
+
+        std::vector<SessionId> ids;
+        auto count = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            ids.push_back(reader.Get<SessionId>());
+            reader.Get<uint8_t>();
+            reader.GetString();
+        }
+        return reader.Ok() ? ids : std::vector<SessionId>{};
+    }
+
+    LoginGate::Stats LoginGate::GetStats() const
+    {
+        Stats stats = stats_;
+        stats.waiting = waiting_.size();
+        return stats;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "TokenValidator.h"
+#include "Network/YisoSessionManager.h"
+#include "Network/HotRestart.h"
+#include <unordered_set>
+
+namespace Yiso::Game
+{
+    // 로그인 관문 (io 스레드): 서버 콜백과 로직 루프 사이
+    // - 공지된 세션은 로그인 성공 전까지 로직에 접속을 알리지 않고, C2S_LOGIN 외 패킷은 버림 (세션 매니저 방송에서도 빠짐)
+    // - 성공하면 S2C_LOGIN_RESULT 뒤 on_connect(유저 ID와 함께) -> 이후 패킷은 그대로 로직으로 (재개된 연결도 같은 세션 ID라 그대로)
+    // - 실패는 MAX_ATTEMPTS번까지 다시 받고, 그 뒤나 LOGIN_TIMEOUT 안에 성공하지 못하면 연결 종료
+    class LoginGate
+    {
+    public:
+        using SessionId = Network::YisoSession::SessionId;
+
+        struct Handlers
+        {
+            std::function<void(SessionId, const std::string& userId)> on_connect;
+            Network::YisoSession::OnRecv on_recv;
+            std::function<void(SessionId)> on_disconnect;
+        };
+
+        struct Stats
+        {
+            uint64_t succeeded;
+            uint64_t failed;
+            uint64_t unavailable; // 저장소 응답 없음으로 실패
+            uint64_t dropped_packets; // 로그인 전 패킷
+            uint64_t kicked; // 시도 횟수 / 시간 초과
+            size_t waiting; // 로그인 전 세션
+        };
+
+        static constexpr uint8_t MAX_ATTEMPTS = 3;
+        static constexpr auto LOGIN_TIMEOUT = std::chrono::seconds(10);
+        static constexpr auto SWEEP_INTERVAL = std::chrono::seconds(1);
+
+        LoginGate(boost::asio::io_context& io, Network::YisoSessionManager& sessionManager, TokenValidator& validator, Handlers handlers);
+
+        void Start(); // 시간 초과 검사
+        void Stop();
+
+        // 서버 콜백 (io 스레드)
+        void OnConnect(SessionId id);
+        void OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size);
+        void OnDisconnect(SessionId id);
+
+        // 무중단 재시작: 로그인한 세션 / 기다리던 세션 (검증 중이던 토큰은 새 프로세스에서 다시 조회)
+        void ExportHandoff(Network::HandoffWriter& writer) const;
+        bool ImportHandoff(Network::HandoffReader& reader);
+        void AdmitAll(); // 인증 없이 돌던 프로세스에게서 넘겨받은 세션은 모두 로그인한 것으로
+        static std::vector<SessionId> WaitingInHandoff(Network::HandoffReader& reader); // 인증을 끈 새 프로세스: 로직에 아직 알리지 않은 세션
+
+        Stats GetStats() const;
+
+    private:
+        struct Waiting
+        {
+            std::chrono::steady_clock::time_point deadline;
+            uint8_t attempts = 0;
+            std::string token; // 검증 중이면 비어 있지 않음
+        };
+
+        void BeginValidate(SessionId id, Waiting& waiting);
+        void OnValidated(SessionId id, TokenValidator::Status status, const std::string& userId);
+        void SendResult(SessionId id, bool success, const char* error);
+        void Kick(SessionId id);
+        void ScheduleSweep();
+
+        Network::YisoSessionManager& session_manager_;
+        TokenValidator& validator_;
+        Handlers handlers_;
+        boost::asio::steady_timer sweep_timer_;
+
+        std::unordered_map<SessionId, Waiting> waiting_;
+        std::unordered_set<SessionId> admitted_;
+
+        Stats stats_{};
+    };
+}
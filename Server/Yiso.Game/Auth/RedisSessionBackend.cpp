@@ -0,0 +1,317 @@
+#include "RedisSessionBackend.h"
+#include "Chat/RedisChatBus.h"
+#include <charconv>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    RedisSessionBackend::RedisSessionBackend(boost::asio::io_context& io, std::string host, uint16_t port)
+        : io_(io),
+          host_(std::move(host)),
+          port_(port),
+          socket_(io),
+          retry_timer_(io),
+          timeout_timer_(io)
+    {
+    }
+
+    RedisSessionBackend::~RedisSessionBackend()
+    {
+        boost::system::error_code ignored;
+        socket_.close(ignored);
+    }
+
+    bool RedisSessionBackend::Start()
+    {
+        boost::system::error_code ec;
+        boost::asio::ip::tcp::resolver resolver(io_);
+        auto results = resolver.resolve(host_, std::to_string(port_), ec);
+        if (ec)
+        {
+            spdlog::error("[Auth] Redis {}:{} 주소 해석 실패: {}", host_, port_, ec.message());
+            return false;
+        }
+        for (const auto& entry : results)
+            endpoints_.push_back(entry.endpoint());
+
+        Connect();
+        ScheduleTimeoutCheck();
+        spdlog::info("[Auth] Redis {}:{} 세션 조회 시작", host_, port_);
+        return true;
+    }
+
+    void RedisSessionBackend::Stop()
+    {
+        boost::asio::post(io_, [this]()
+        {
+            stopping_ = true;
+            boost::system::error_code ignored;
+            retry_timer_.cancel();
+            timeout_timer_.cancel();
+            socket_.close(ignored);
+            connected_ = false;
+        });
+    }
+
+    void RedisSessionBackend::Lookup(std::vector<std::string> tokens, OnResults done)
+    {
+        Batch batch;
+        batch.results.resize(tokens.size());
+        batch.done = std::move(done);
+        if (!connected_ || stopping_ || tokens.empty())
+        {
+            // 결과는 기본값 Unavailable -> 호출자 스택을 벗어나서 알림
+            ++stats_.unavailable;
+            boost::asio::post(io_, [batch = std::move(batch)]() mutable { batch.done(std::move(batch.results)); });
+            return;
+        }
+
+        std::string key;
+        for (const auto& token : tokens)
+        {
+            key.assign(KEY_PREFIX).append(token);
+            RedisChatBus::AppendCommand(out_, { "GET", key });
+            RedisChatBus::AppendCommand(out_, { "PTTL", key });
+        }
+        batch.sent = std::chrono::steady_clock::now();
+        batches_.push_back(std::move(batch));
+        ++stats_.batches;
+        stats_.keys += tokens.size();
+        if (!writing_)
+            DoWrite();
+    }
+
+    void RedisSessionBackend::Connect()
+    {
+        boost::asio::async_connect(socket_, endpoints_, [this](boost::system::error_code ec, const auto&)
+        {
+            if (stopping_) return;
+            if (ec)
+            {
+                Fail("접속", ec);
+                return;
+            }
+            connected_ = true;
+            in_size_ = 0;
+            socket_.set_option(boost::asio::ip::tcp::no_delay(true));
+            spdlog::info("[Auth] Redis 연결 완료");
+            DoRead();
+        });
+    }
+
+    void RedisSessionBackend::Fail(const char* what, const boost::system::error_code& ec)
+    {
+        if (stopping_) return;
+        spdlog::warn("[Auth] Redis 연결 {} 실패: {} ({}초 뒤 재접속)", what, ec.message(),
+            std::chrono::duration_cast<std::chrono::seconds>(RECONNECT_DELAY).count());
+
+        boost::system::error_code ignored;
+        socket_.close(ignored);
+        connected_ = false;
+        writing_ = false;
+        out_.clear();
+        sending_.clear();
+        ++stats_.reconnects;
+
+        // 응답을 못 받은 배치는 모두 Unavailable (다음 로그인 시도에서 다시 조회)
+        auto failed = std::move(batches_);
+        batches_.clear();
+        for (auto& batch : failed)
+        {
+            ++stats_.unavailable;
+            for (size_t i = batch.replies / 2; i < batch.results.size(); ++i)
+                batch.results[i] = Result{};
+            batch.done(std::move(batch.results));
+        }
+
+        retry_timer_.expires_after(RECONNECT_DELAY);
+        retry_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec || stopping_) return;
+            Connect();
+        });
+    }
+
+    void RedisSessionBackend::DoRead()
+    {
+        if (in_.size() < in_size_ + READ_CHUNK)
+            in_.resize(in_size_ + READ_CHUNK);
+
+        socket_.async_read_some(boost::asio::buffer(in_.data() + in_size_, in_.size() - in_size_),
+            [this](boost::system::error_code ec, size_t bytes)
+            {
+                if (stopping_ || !connected_) return;
+                if (ec)
+                {
+                    Fail("읽기", ec);
+                    return;
+                }
+                in_size_ += bytes;
+
+                thread_local std::vector<std::string_view> parts;
+                size_t consumed = 0;
+                while (consumed < in_size_)
+                {
+                    bool error;
+                    long used = RedisChatBus::ParseReply(in_.data() + consumed, in_size_ - consumed, parts, error);
+                    if (used == 0) break;
+                    if (used < 0 || parts.size() != 1)
+                    {
+                        Fail("응답 파싱", boost::asio::error::invalid_argument);
+                        return;
+                    }
+                    consumed += static_cast<size_t>(used);
+                    OnReply(parts[0], error);
+                    if (!connected_) return; // 응답 수가 맞지 않아 끊음
+                }
+                if (consumed > 0)
+                {
+                    std::memmove(in_.data(), in_.data() + consumed, in_size_ - consumed);
+                    in_size_ -= consumed;
+                }
+                DoRead();
+            });
+    }
+
+    void RedisSessionBackend::OnReply(const std::string_view& value, bool error)
+    {
+        if (batches_.empty())
+        {
+            Fail("응답 순서", boost::asio::error::invalid_argument);
+            return;
+        }
+
+        auto& batch = batches_.front();
+        bool ttlReply = batch.replies % 2 == 1;
+        auto& result = batch.results[batch.replies / 2];
+        ++batch.replies;
+
+        if (!ttlReply)
+        {
+            // GET: 결과를 정함 (PTTL은 Valid일 때 수명만 채움)
+            if (error)
+            {
+                ++stats_.errors;
+                spdlog::warn("[Auth] Redis 오류 응답: {}", value);
+                result = Result{}; // Unavailable
+            }
+            else if (value.empty())
+            {
+                result.status = Status::Invalid; // nil
+            }
+            else if (DecodeUserId(value, result.user_id))
+            {
+                result.status = Status::Valid;
+            }
+            else
+            {
+                ++stats_.errors;
+                spdlog::warn("[Auth] SessionData 해석 실패 ({}바이트)", value.size());
+                result.status = Status::Invalid;
+            }
+        }
+        else if (result.status == Status::Valid)
+        {
+            long ttl = 0;
+            auto parsed = std::from_chars(value.data(), value.data() + value.size(), ttl);
+            if (error || parsed.ec != std::errc())
+            {
+                ++stats_.errors;
+                spdlog::warn("[Auth] Redis 오류 응답: {}", value);
+                result = Result{}; // Unavailable
+            }
+            else if (ttl == -2)
+            {
+                result = Result{};
+                result.status = Status::Invalid; // GET과 PTTL 사이에 만료
+            }
+            else
+            {
+                result.ttl_ms = ttl; // -1 = 만료 없음
+            }
+        }
+
+        if (batch.replies < batch.results.size() * 2) return;
+        auto done = std::move(batch.done);
+        auto results = std::move(batch.results);
+        batches_.pop_front();
+        done(std::move(results));
+    }
+
+    bool RedisSessionBackend::DecodeUserId(std::string_view value, std::string& userId)
+    {
+        auto readInt32 = [&value](size_t offset, int32_t& out)
+        {
+            if (value.size() < offset + sizeof(int32_t)) return false;
+            std::memcpy(&out, value.data() + offset, sizeof(int32_t)); // 리틀 엔디언
+            return true;
+        };
+
+        // 멤버 수 (255 = null 객체)
+        auto members = static_cast<uint8_t>(value.empty() ? 0 : value[0]);
+        if (members == 0 || members == 255) return false;
+
+        int32_t length = 0;
+        if (!readInt32(1, length) || length == 0 || length == -1) return false; // 빈 / null 유저 ID
+
+        userId.clear();
+        if (length > 0)
+        {
+            // UTF-16
+            size_t bytes = static_cast<size_t>(length) * 2;
+            if (value.size() < 5 + bytes) return false;
+            for (size_t i = 0; i < bytes; i += 2)
+            {
+                auto low = static_cast<uint8_t>(value[5 + i]);
+                auto high = static_cast<uint8_t>(value[5 + i + 1]);
+                if (high != 0 || low >= 0x80) return false;
+                userId.push_back(static_cast<char>(low));
+            }
+            return true;
+        }
+
+        // UTF-8: ~바이트 수 다음에 UTF-16 길이
+        size_t bytes = static_cast<size_t>(~length);
+        if (value.size() < 9 + bytes) return false;
+        userId.assign(value.data() + 9, bytes);
+        for (char c : userId)
+            if (static_cast<uint8_t>(c) >= 0x80) return false;
+        return true;
+    }
+
+    void RedisSessionBackend::DoWrite()
+    {
+        if (!connected_ || out_.empty()) return; // 접속되면 Lookup이 다시 시작 (끊긴 동안의 배치는 Fail에서 정리됨)
+
+        sending_.swap(out_);
+        out_.clear();
+        writing_ = true;
+        boost::asio::async_write(socket_, boost::asio::buffer(sending_), [this](boost::system::error_code ec, size_t)
+        {
+            writing_ = false;
+            if (stopping_ || !connected_) return;
+            if (ec)
+            {
+                Fail("쓰기", ec);
+                return;
+            }
+            sending_.clear();
+            if (!out_.empty())
+                DoWrite();
+        });
+    }
+
+    void RedisSessionBackend::ScheduleTimeoutCheck()
+    {
+        timeout_timer_.expires_after(std::chrono::milliseconds(500));
+        timeout_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec || stopping_) return;
+            // 가장 먼저 보낸 배치가 제한을 넘김 -> 연결을 끊어 기다리는 배치를 모두 정리
+            if (connected_ && !batches_.empty() && std::chrono::steady_clock::now() - batches_.front().sent > LOOKUP_TIMEOUT)
+                Fail("응답 대기", boost::asio::error::timed_out);
+            ScheduleTimeoutCheck();
+        });
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "SessionBackend.h"
+#include "Network/BufferPool.h"
+#include <deque>
+
+namespace Yiso::Game
+{
+    // Yiso.Web RedisSessionRepository의 세션 키 조회 (session:{sessionId}, 값은 MemoryPack SessionData)
+    // - 배치 하나 = 토큰마다 GET + PTTL 명령을 이어붙여 한 번에 write (파이프라인) -> 응답도 순서대로 토큰당 2개
+    //   GET: nil = 키 없음 (만료 / 로그아웃), 값에서 SessionData.UserId를 꺼내 로직에 넘김
+    //   PTTL: -2 = 그 사이 만료, -1 = 만료 없음, 그 외 남은 ms
+    // - 연결 1개, io 스레드 전용 (RedisChatBus와 같은 RESP 파서 / 명령 인코더)
+    // - 끊기거나 LOOKUP_TIMEOUT 안에 응답이 없으면 기다리던 배치는 모두 Unavailable, RECONNECT_DELAY 뒤 재접속
+    class RedisSessionBackend : public SessionBackend
+    {
+    public:
+        struct Stats
+        {
+            uint64_t batches;
+            uint64_t keys;
+            uint64_t unavailable; // 연결이 없거나 끊겨 Unavailable로 끝난 배치
+            uint64_t reconnects;
+            uint64_t errors; // Redis 오류 응답
+        };
+
+        static constexpr const char* KEY_PREFIX = "session:"; // RedisSessionRepository.SessionKeyPrefix
+        static constexpr auto RECONNECT_DELAY = std::chrono::seconds(1);
+        static constexpr auto LOOKUP_TIMEOUT = std::chrono::seconds(2);
+        static constexpr size_t READ_CHUNK = 4 * 1024;
+
+        RedisSessionBackend(boost::asio::io_context& io, std::string host, uint16_t port);
+        ~RedisSessionBackend() override;
+
+        bool Start();
+        void Stop();
+        void Lookup(std::vector<std::string> tokens, OnResults done) override;
+
+        // MemoryPack SessionData에서 UserId (첫 멤버, 문자열) 꺼내기
+        // - [멤버 수 1바이트][문자열...]: 문자열은 [int32 길이][UTF-16] 또는 UTF-8 형식 [int32 ~바이트 수][int32 UTF-16 길이][UTF-8]
+        // - 유저 ID는 GUID라 ASCII만 받음 (아니면 false)
+        static bool DecodeUserId(std::string_view value, std::string& userId);
+
+        Stats GetStats() const { return stats_; } // io 스레드에서
+
+    private:
+        struct Batch
+        {
+            std::vector<Result> results;
+            size_t replies = 0; // 토큰당 2개 (GET, PTTL)
+            OnResults done;
+            std::chrono::steady_clock::time_point sent;
+        };
+
+        void Connect();
+        void Fail(const char* what, const boost::system::error_code& ec);
+        void DoRead();
+        void DoWrite();
+        void OnReply(const std::string_view& value, bool error);
+        void ScheduleTimeoutCheck();
+
+        boost::asio::io_context& io_;
+        std::string host_;
+        uint16_t port_;
+        std::vector<boost::asio::ip::tcp::endpoint> endpoints_;
+        boost::asio::ip::tcp::socket socket_;
+        boost::asio::steady_timer retry_timer_;
+        boost::asio::steady_timer timeout_timer_;
+        bool connected_ = false;
+        bool writing_ = false;
+        bool stopping_ = false;
+
+        Network::Buffer in_; // in_[0..in_size_)가 유효
+        size_t in_size_ = 0;
+        Network::Buffer out_;
+        Network::Buffer sending_;
+        std::deque<Batch> batches_; // 보낸 순서 = 응답 순서
+
+        Stats stats_{};
+    };
+}
@@ -0,0 +1,93 @@
+#include "SessionBackend.h"
+#include <fstream>
+#include <memory>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    LocalSessionBackend::LocalSessionBackend(boost::asio::io_context& io, std::chrono::milliseconds latency)
+        : io_(io),
+          latency_(latency)
+    {
+    }
+
+    void LocalSessionBackend::Add(const std::string& token, std::chrono::milliseconds ttl, std::string userId)
+    {
+        std::lock_guard lock(mutex_);
+        sessions_[token] = Session{ std::chrono::steady_clock::now() + ttl, std::move(userId) };
+    }
+
+    void LocalSessionBackend::Remove(const std::string& token)
+    {
+        std::lock_guard lock(mutex_);
+        sessions_.erase(token);
+    }
+
+    size_t LocalSessionBackend::LoadFile(const std::filesystem::path& path, std::chrono::milliseconds ttl)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            spdlog::warn("[Auth] 로컬 세션 파일 열기 실패: {}", path.string());
+            return 0;
+        }
+
+        size_t count = 0;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            auto begin = line.find_first_not_of(" \t\r");
+            if (begin == std::string::npos || line[begin] == '#') continue;
+            auto end = line.find_last_not_of(" \t\r");
+            auto split = line.find_first_of(" \t", begin);
+            if (split == std::string::npos || split > end)
+            {
+                Add(line.substr(begin, end - begin + 1), ttl);
+            }
+            else
+            {
+                auto user = line.find_first_not_of(" \t", split);
+                Add(line.substr(begin, split - begin), ttl, line.substr(user, end - user + 1));
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    void LocalSessionBackend::Lookup(std::vector<std::string> tokens, OnResults done)
+    {
+        lookups_.fetch_add(1, std::memory_order_relaxed);
+        keys_.fetch_add(tokens.size(), std::memory_order_relaxed);
+
+        // 응답 시점의 표로 답함 (그 사이 Remove된 세션은 Invalid)
+        auto answer = [this, tokens = std::move(tokens), done = std::move(done)]()
+        {
+            std::vector<Result> results(tokens.size());
+            auto now = std::chrono::steady_clock::now();
+            {
+                std::lock_guard lock(mutex_);
+                for (size_t i = 0; i < tokens.size(); ++i)
+                {
+                    auto it = sessions_.find(tokens[i]);
+                    if (it == sessions_.end() || it->second.expires <= now)
+                    {
+                        results[i].status = Status::Invalid;
+                        continue;
+                    }
+                    results[i].status = Status::Valid;
+                    results[i].ttl_ms = std::chrono::duration_cast<std::chrono::milliseconds>(it->second.expires - now).count();
+                    results[i].user_id = it->second.user_id;
+                }
+            }
+            done(std::move(results));
+        };
+
+        if (latency_.count() == 0)
+        {
+            boost::asio::post(io_, std::move(answer));
+            return;
+        }
+        auto timer = std::make_shared<boost::asio::steady_timer>(io_, latency_);
+        timer->async_wait([timer, answer = std::move(answer)](boost::system::error_code) mutable { answer(); });
+    }
+}
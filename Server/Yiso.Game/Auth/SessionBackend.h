@@ -0,0 +1,72 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 로그인 세션 저장소 조회 (Yiso.Web이 발급한 세션 ID가 아직 살아 있는지)
+    // - Lookup은 io 스레드에서 호출, done도 io 스레드에서 tokens와 같은 순서의 결과로 호출
+    // - 저장소에 닿지 못하면 Unavailable (검증기가 캐시하지 않음)
+    class SessionBackend
+    {
+    public:
+        enum class Status : uint8_t
+        {
+            Valid,
+            Invalid,
+            Unavailable,
+        };
+
+        struct Result
+        {
+            Status status = Status::Unavailable;
+            int64_t ttl_ms = -1; // Valid일 때 세션 남은 수명 (-1 = 만료 없음)
+            std::string user_id; // Valid일 때 Yiso.Web 유저 ID (SessionData.UserId, 비어 있으면 모름)
+        };
+
+        using OnResults = std::function<void(std::vector<Result>)>;
+
+        virtual ~SessionBackend() = default;
+        virtual void Lookup(std::vector<std::string> tokens, OnResults done) = 0;
+    };
+
+    // 로컬 대역 (테스트 / Redis 없이 띄울 때): 메모리 표 + 고정 응답 지연
+    class LocalSessionBackend : public SessionBackend
+    {
+    public:
+        LocalSessionBackend(boost::asio::io_context& io, std::chrono::milliseconds latency);
+
+        // 아무 스레드에서나
+        void Add(const std::string& token, std::chrono::milliseconds ttl, std::string userId = {});
+        void Remove(const std::string& token);
+        size_t LoadFile(const std::filesystem::path& path, std::chrono::milliseconds ttl); // 한 줄에 "세션 ID [유저 ID]" ('#' 주석)
+
+        void Lookup(std::vector<std::string> tokens, OnResults done) override;
+
+        uint64_t Lookups() const { return lookups_.load(std::memory_order_relaxed); } // 받은 배치 수
+        uint64_t Keys() const { return keys_.load(std::memory_order_relaxed); } // 조회한 토큰 수 합
+
+    private:
+        boost::asio::io_context& io_;
+        std::chrono::milliseconds latency_;
+
+        std::mutex mutex_;
+        struct Session
+        {
+            std::chrono::steady_clock::time_point expires;
+            std::string user_id;
+        };
+        std::unordered_map<std::string, Session> sessions_; // 세션 ID -> 만료 시각 / 유저
+
+        std::atomic<uint64_t> lookups_{0};
+        std::atomic<uint64_t> keys_{0};
+    };
+}
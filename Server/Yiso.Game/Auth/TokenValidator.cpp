@@ -0,0 +1,146 @@
+#include "TokenValidator.h"
+#include <algorithm>
+
+namespace Yiso::Game
+{
+    TokenValidator::TokenValidator(boost::asio::io_context& io, SessionBackend& backend)
+        : io_(io),
+          backend_(backend),
+          batch_timer_(io)
+    {
+    }
+
+    void TokenValidator::Validate(const std::string& token, OnResult done)
+    {
+        ++stats_.requests;
+        if (token.empty() || token.size() > MAX_TOKEN_SIZE)
+        {
+            boost::asio::post(io_, [done = std::move(done)]() { done(Status::Invalid, std::string()); });
+            return;
+        }
+
+        auto it = cache_.find(token);
+        if (it != cache_.end())
+        {
+            if (it->second.expires > std::chrono::steady_clock::now())
+            {
+                ++stats_.cache_hits;
+                boost::asio::post(io_, [done = std::move(done), status = it->second.status, userId = it->second.user_id]() { done(status, userId); });
+                return;
+            }
+            Erase(it);
+        }
+
+        auto [waiting, added] = waiting_.try_emplace(token);
+        waiting->second.push_back(std::move(done));
+        if (!added)
+        {
+            ++stats_.coalesced;
+            return;
+        }
+
+        batch_.push_back(token);
+        if (batch_.size() >= BATCH_SIZE)
+        {
+            Flush();
+            return;
+        }
+        if (!batch_armed_)
+        {
+            batch_armed_ = true;
+            batch_timer_.expires_after(BATCH_DELAY);
+            batch_timer_.async_wait([this](boost::system::error_code ec)
+            {
+                batch_armed_ = false;
+                if (ec) return;
+                Flush();
+            });
+        }
+    }
+
+    void TokenValidator::Forget(const std::string& token)
+    {
+        auto it = cache_.find(token);
+        if (it != cache_.end())
+            Erase(it);
+    }
+
+    TokenValidator::Stats TokenValidator::GetStats() const
+    {
+        Stats stats = stats_;
+        stats.cache_size = cache_.size();
+        stats.in_flight = waiting_.size();
+        return stats;
+    }
+
+    void TokenValidator::Flush()
+    {
+        if (batch_.empty()) return; // 크기로 먼저 보낸 뒤 늦게 도착한 타이머 (그 사이 모인 것만 보냄)
+
+        std::vector<std::string> tokens;
+        tokens.swap(batch_);
+        ++stats_.backend_batches;
+        stats_.backend_keys += tokens.size();
+
+        // 응답의 i번째 = tokens[i] -> 토큰 목록은 콜백이 들고 있음 (백엔드에는 복사본)
+        auto copy = tokens;
+        backend_.Lookup(std::move(copy), [this, tokens = std::move(tokens)](std::vector<SessionBackend::Result> results) mutable
+        {
+            OnResults(std::move(tokens), std::move(results));
+        });
+    }
+
+    void TokenValidator::OnResults(std::vector<std::string> tokens, std::vector<SessionBackend::Result> results)
+    {
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            SessionBackend::Result result = i < results.size() ? results[i] : SessionBackend::Result{};
+            switch (result.status)
+            {
+            case Status::Valid:
+            {
+                std::chrono::steady_clock::duration ttl = VALID_TTL;
+                if (result.ttl_ms >= 0)
+                    ttl = std::min(ttl, std::chrono::steady_clock::duration(std::chrono::milliseconds(result.ttl_ms)));
+                Store(tokens[i], Status::Valid, result.user_id, ttl);
+                break;
+            }
+            case Status::Invalid:
+                Store(tokens[i], Status::Invalid, {}, INVALID_TTL);
+                break;
+            case Status::Unavailable:
+                break;
+            }
+
+            // 콜백 안에서 같은 토큰으로 다시 Validate해도 되도록 목록을 먼저 떼어냄
+            auto waiting = waiting_.find(tokens[i]);
+            if (waiting == waiting_.end()) continue;
+            auto callbacks = std::move(waiting->second);
+            waiting_.erase(waiting);
+            if (result.status == Status::Unavailable)
+                stats_.unavailable += callbacks.size();
+            for (auto& callback : callbacks)
+                callback(result.status, result.user_id);
+        }
+    }
+
+    void TokenValidator::Store(const std::string& token, Status status, std::string userId, std::chrono::steady_clock::duration ttl)
+    {
+        if (ttl <= std::chrono::steady_clock::duration::zero()) return;
+
+        auto it = cache_.find(token);
+        if (it != cache_.end())
+            Erase(it);
+        while (cache_.size() >= MAX_ENTRIES)
+            Erase(cache_.find(order_.front()));
+
+        order_.push_back(token);
+        cache_.emplace(token, Entry{ status, std::move(userId), std::chrono::steady_clock::now() + ttl, std::prev(order_.end()) });
+    }
+
+    void TokenValidator::Erase(std::unordered_map<std::string, Entry>::iterator it)
+    {
+        order_.erase(it->second.order);
+        cache_.erase(it);
+    }
+}
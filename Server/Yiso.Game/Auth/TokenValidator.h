@@ -0,0 +1,73 @@
+#pragma once
+#include "SessionBackend.h"
+#include <list>
+
+namespace Yiso::Game
+{
+    // 로그인 토큰(Yiso.Web 세션 ID) 검증 (io 스레드 전용)
+    // - 캐시: 결과를 짧게 보관 (성공 VALID_TTL, 실패 INVALID_TTL, 성공은 세션 남은 수명보다 오래 두지 않음)
+    //   MAX_ENTRIES를 넘으면 오래 넣은 것부터 버림 -> 로그아웃이 게임 서버에 닿는 데 최대 VALID_TTL 늦음
+    // - 합치기: 같은 토큰을 조회 중이면 백엔드에 다시 묻지 않고 그 결과를 같이 받음
+    // - 배치: 새 조회는 BATCH_SIZE개가 모이거나 BATCH_DELAY가 지나면 백엔드에 한 번에
+    // - 백엔드 Unavailable은 캐시하지 않음 (기다리던 요청에만 그대로 전달)
+    // - Valid면 유저 ID도 같이 (캐시 적중도 같은 값)
+    class TokenValidator
+    {
+    public:
+        using Status = SessionBackend::Status;
+        using OnResult = std::function<void(Status, const std::string& userId)>;
+
+        struct Stats
+        {
+            uint64_t requests;
+            uint64_t cache_hits;
+            uint64_t coalesced; // 이미 조회 중인 토큰에 붙은 요청
+            uint64_t backend_batches;
+            uint64_t backend_keys;
+            uint64_t unavailable; // 백엔드에 닿지 못해 실패한 요청
+            size_t cache_size;
+            size_t in_flight; // 백엔드 응답을 기다리는 토큰 수 (모으는 중 포함)
+        };
+
+        static constexpr auto VALID_TTL = std::chrono::seconds(30);
+        static constexpr auto INVALID_TTL = std::chrono::seconds(5);
+        static constexpr size_t MAX_ENTRIES = 100000;
+        static constexpr size_t BATCH_SIZE = 128;
+        static constexpr auto BATCH_DELAY = std::chrono::milliseconds(2);
+        static constexpr size_t MAX_TOKEN_SIZE = 128; // Yiso.Web은 GUID 문자열 (36자)
+
+        TokenValidator(boost::asio::io_context& io, SessionBackend& backend);
+
+        // done은 항상 나중에 (캐시 적중이어도 호출자 스택을 벗어나서) 호출
+        void Validate(const std::string& token, OnResult done);
+        void Forget(const std::string& token); // 캐시에서 제거 (다음 요청은 백엔드 조회)
+
+        Stats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            Status status;
+            std::string user_id;
+            std::chrono::steady_clock::time_point expires;
+            std::list<std::string>::iterator order;
+        };
+
+        void Flush();
+        void OnResults(std::vector<std::string> tokens, std::vector<SessionBackend::Result> results);
+        void Store(const std::string& token, Status status, std::string userId, std::chrono::steady_clock::duration ttl);
+        void Erase(std::unordered_map<std::string, Entry>::iterator it);
+
+        boost::asio::io_context& io_;
+        SessionBackend& backend_;
+
+        std::unordered_map<std::string, Entry> cache_;
+        std::list<std::string> order_; // 넣은 순서 (앞이 오래된 것)
+        std::unordered_map<std::string, std::vector<OnResult>> waiting_; // 조회 중인 토큰 -> 결과를 기다리는 요청
+        std::vector<std::string> batch_; // 아직 보내지 않은 토큰
+        boost::asio::steady_timer batch_timer_;
+        bool batch_armed_ = false;
+
+        Stats stats_{};
+    };
+}
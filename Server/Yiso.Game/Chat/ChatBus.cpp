@@ -0,0 +1,129 @@
+#include "ChatBus.h"
+#include <algorithm>
+
+namespace Yiso::Game
+{
+    LoopbackChatHub::~LoopbackChatHub()
+    {
+        Stop();
+    }
+
+    void LoopbackChatHub::Start()
+    {
+        std::lock_guard lock(mutex_);
+        if (running_) return;
+        running_ = true;
+        thread_ = std::thread([this]()
+        {
+            std::vector<Message> batch;
+            std::unique_lock lock(mutex_);
+            while (true)
+            {
+                cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+                if (queue_.empty()) return; // Stop + 남은 메시지 없음
+                batch.swap(queue_);
+                lock.unlock();
+                for (auto& message : batch)
+                    Deliver(message);
+                batch.clear();
+                lock.lock();
+            }
+        });
+    }
+
+    void LoopbackChatHub::Stop()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    size_t LoopbackChatHub::Pump()
+    {
+        size_t delivered = 0;
+        std::vector<Message> batch;
+        while (true)
+        {
+            {
+                std::lock_guard lock(mutex_);
+                if (queue_.empty()) return delivered;
+                batch.swap(queue_);
+            }
+            for (auto& message : batch)
+                Deliver(message);
+            delivered += batch.size();
+            batch.clear();
+        }
+    }
+
+    void LoopbackChatHub::Subscribe(const void* owner, std::vector<std::string> channels, ChatBus::OnMessage onMessage)
+    {
+        auto subscriber = std::make_shared<Subscriber>();
+        subscriber->channels = std::move(channels);
+        subscriber->on_message = std::move(onMessage);
+        std::lock_guard lock(mutex_);
+        subscribers_.emplace_back(owner, std::move(subscriber));
+    }
+
+    void LoopbackChatHub::Unsubscribe(const void* owner)
+    {
+        std::lock_guard lock(mutex_);
+        subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+            [owner](const auto& entry) { return entry.first == owner; }), subscribers_.end());
+    }
+
+    void LoopbackChatHub::Publish(const std::string& channel, Network::Buffer payload)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back({ channel, std::move(payload) });
+        }
+        cv_.notify_one();
+    }
+
+    void LoopbackChatHub::Deliver(Message& message)
+    {
+        // 콜백 중 구독 변경이 있어도 되도록 대상만 복사해 두고 락 밖에서 호출
+        thread_local std::vector<std::shared_ptr<Subscriber>> targets;
+        targets.clear();
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& [owner, subscriber] : subscribers_)
+                if (std::find(subscriber->channels.begin(), subscriber->channels.end(), message.channel) != subscriber->channels.end())
+                    targets.push_back(subscriber);
+        }
+        for (size_t i = 0; i < targets.size(); ++i)
+            targets[i]->on_message(message.channel, i + 1 == targets.size() ? std::move(message.payload) : message.payload);
+        targets.clear();
+    }
+
+    LoopbackChatBus::LoopbackChatBus(LoopbackChatHub& hub)
+        : hub_(hub)
+    {
+    }
+
+    LoopbackChatBus::~LoopbackChatBus()
+    {
+        Stop();
+    }
+
+    bool LoopbackChatBus::Start(const std::vector<std::string>& channels, OnMessage onMessage)
+    {
+        hub_.Subscribe(this, channels, std::move(onMessage));
+        return true;
+    }
+
+    void LoopbackChatBus::Stop()
+    {
+        hub_.Unsubscribe(this);
+    }
+
+    void LoopbackChatBus::Publish(const std::string& channel, Network::Buffer payload)
+    {
+        hub_.Publish(channel, std::move(payload));
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "Network/BufferPool.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 게임 프로세스 사이 채팅 메시지 전달 (pub/sub)
+    // - 채널 이름 단위로 구독 / 발행, 같은 채널 메시지는 발행 순서대로 도착
+    // - 자기가 발행한 메시지도 구독 중이면 돌아옴 (걸러내기는 ChatCluster가)
+    // - on_message는 버스 내부 스레드에서 호출 -> 받는 쪽이 로직 스레드로 넘김
+    class ChatBus
+    {
+    public:
+        using OnMessage = std::function<void(const std::string& channel, Network::Buffer payload)>;
+
+        virtual ~ChatBus() = default;
+        virtual bool Start(const std::vector<std::string>& channels, OnMessage onMessage) = 0;
+        virtual void Stop() = 0;
+        virtual void Publish(const std::string& channel, Network::Buffer payload) = 0; // 아무 스레드에서나
+    };
+
+    // 같은 프로세스 안의 여러 버스 끝점을 잇는 허브 (테스트 / 한 프로세스에 노드 여러 개 띄울 때)
+    // - Publish는 큐에 넣기만, 허브 스레드(Start) 또는 Pump 호출이 구독자에게 전달
+    class LoopbackChatHub
+    {
+    public:
+        ~LoopbackChatHub();
+
+        void Start(); // 전달 스레드
+        void Stop();
+        size_t Pump(); // 스레드 없이 쓸 때: 쌓인 메시지를 지금 스레드에서 모두 전달 (전달 중 발행된 것까지)
+
+    private:
+        friend class LoopbackChatBus;
+
+        struct Subscriber
+        {
+            std::vector<std::string> channels;
+            ChatBus::OnMessage on_message;
+        };
+
+        struct Message
+        {
+            std::string channel;
+            Network::Buffer payload;
+        };
+
+        void Subscribe(const void* owner, std::vector<std::string> channels, ChatBus::OnMessage onMessage);
+        void Unsubscribe(const void* owner);
+        void Publish(const std::string& channel, Network::Buffer payload);
+        void Deliver(Message& message);
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<Message> queue_;
+        std::vector<std::pair<const void*, std::shared_ptr<Subscriber>>> subscribers_;
+        std::thread thread_;
+        bool running_ = false;
+    };
+
+    class LoopbackChatBus : public ChatBus
+    {
+    public:
+        explicit LoopbackChatBus(LoopbackChatHub& hub);
+        ~LoopbackChatBus() override;
+
+        bool Start(const std::vector<std::string>& channels, OnMessage onMessage) override;
+        void Stop() override;
+        void Publish(const std::string& channel, Network::Buffer payload) override;
+
+    private:
+        LoopbackChatHub& hub_;
+    };
+}
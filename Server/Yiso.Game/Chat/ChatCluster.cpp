@@ -0,0 +1,440 @@
+#include "ChatCluster.h"
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        uint64_t SplitMix64(uint64_t x)
+        {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        template <typename T>
+        T Read(const uint8_t* p)
+        {
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            return value;
+        }
+    }
+
+    ChatCluster::ChatCluster(boost::asio::io_context& io, ChatBus& bus, Config config)
+        : io_(io),
+          bus_(bus),
+          config_(std::move(config)),
+          flush_timer_(io),
+          heartbeat_timer_(io)
+    {
+    }
+
+    std::string ChatCluster::NodeChannel(NodeId node)
+    {
+        return "chat:node:" + std::to_string(node);
+    }
+
+    bool ChatCluster::Start(std::function<void(Network::Buffer)> post)
+    {
+        NodeId self = config_.node_id;
+        if (self == 0 || self > MAX_NODES || std::find(config_.nodes.begin(), config_.nodes.end(), self) == config_.nodes.end())
+        {
+            spdlog::error("[Cluster] 잘못된 노드 설정: node_id={} (노드 목록 {}개)", self, config_.nodes.size());
+            return false;
+        }
+
+        // 일관 해시 링: 노드마다 VIRTUAL_NODES개 지점 -> 노드가 늘거나 줄어도 나머지 방의 소유 노드는 그대로
+        ring_.clear();
+        for (NodeId node : config_.nodes)
+            for (size_t v = 0; v < VIRTUAL_NODES; ++v)
+                ring_.emplace_back(SplitMix64((static_cast<uint64_t>(node) << 32) | v), node);
+        std::sort(ring_.begin(), ring_.end());
+
+        post_ = std::move(post);
+        if (!bus_.Start({ GLOBAL_CHANNEL, NodeChannel(self) }, [this](const std::string& channel, Network::Buffer payload)
+            {
+                OnBusMessage(channel, std::move(payload));
+            }))
+        {
+            spdlog::error("[Cluster] 채팅 버스 시작 실패");
+            return false;
+        }
+
+        // 이미 떠 있는 노드들의 세션 목록 요청 (응답은 이 노드 채널로 SessionUp)
+        Append(0, RecordKind::DirectoryRequest, {});
+        ScheduleHeartbeat();
+        spdlog::info("[Cluster] 노드 {} 시작 (노드 {}개)", self, config_.nodes.size());
+        return true;
+    }
+
+    void ChatCluster::Stop()
+    {
+        flush_timer_.cancel();
+        heartbeat_timer_.cancel();
+        FlushAll();
+        bus_.Stop();
+    }
+
+    ChatCluster::NodeId ChatCluster::OwnerOf(RoomId room) const
+    {
+        if (ring_.empty()) return config_.node_id;
+        uint64_t hash = SplitMix64(room);
+        auto it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(hash, NodeId{0}));
+        return it != ring_.end() ? it->second : ring_.front().second;
+    }
+
+    ChatCluster::NodeId ChatCluster::NodeOf(SessionId session) const
+    {
+        std::lock_guard lock(directory_mutex_);
+        auto it = directory_.find(session);
+        return it != directory_.end() ? it->second : 0;
+    }
+
+    void ChatCluster::SessionUp(SessionId session)
+    {
+        {
+            std::lock_guard lock(directory_mutex_);
+            directory_[session] = config_.node_id;
+        }
+        Append(0, RecordKind::SessionUp, { { &session, sizeof(session) } });
+    }
+
+    void ChatCluster::SessionDown(SessionId session)
+    {
+        {
+            std::lock_guard lock(directory_mutex_);
+            directory_.erase(session);
+        }
+        Append(0, RecordKind::SessionDown, { { &session, sizeof(session) } });
+    }
+
+    void ChatCluster::Broadcast(const Network::Buffer& frame, bool history)
+    {
+        uint8_t flag = history ? 1 : 0;
+        Append(0, RecordKind::Broadcast, { { &flag, sizeof(flag) }, { frame.data(), frame.size() } });
+    }
+
+    void ChatCluster::Deliver(NodeId node, const SessionId* ids, uint32_t count, const Network::Buffer& frame)
+    {
+        Append(node, RecordKind::Deliver, { { &count, sizeof(count) }, { ids, count * sizeof(SessionId) }, { frame.data(), frame.size() } });
+    }
+
+    void ChatCluster::SendRoomOp(NodeId owner, Network::PacketType type, RoomId room, SessionId session, const uint8_t* body, uint32_t size)
+    {
+        uint16_t head[2] = { static_cast<uint16_t>(type), 0 };
+        Append(owner, RecordKind::RoomOp, { { head, sizeof(head) }, { &room, sizeof(room) }, { &session, sizeof(session) }, { body, size } });
+    }
+
+    void ChatCluster::Append(NodeId target, RecordKind kind, std::initializer_list<std::pair<const void*, size_t>> parts)
+    {
+        RecordHeader record{};
+        record.kind = static_cast<uint16_t>(kind);
+        for (const auto& part : parts)
+            record.size += static_cast<uint32_t>(part.second);
+
+        bool arm = false;
+        {
+            std::lock_guard lock(out_mutex_);
+            Outbox& box = outboxes_[target];
+            if (box.data.empty())
+                box.data.resize(sizeof(BatchHeader));
+            const auto* head = reinterpret_cast<const uint8_t*>(&record);
+            box.data.insert(box.data.end(), head, head + sizeof(record));
+            for (const auto& part : parts)
+            {
+                const auto* bytes = static_cast<const uint8_t*>(part.first);
+                box.data.insert(box.data.end(), bytes, bytes + part.second);
+            }
+            ++box.count;
+
+            // 락 안에서 발행 -> 타이머 flush와 크기 flush가 엇갈려도 채널 안 순서 유지 (버스 Publish는 큐에 넣기만)
+            if (box.data.size() >= FLUSH_BYTES)
+                Publish(target, box);
+            else if (!flush_armed_)
+                flush_armed_ = arm = true;
+        }
+
+        if (arm)
+        {
+            boost::asio::post(io_, [this]()
+            {
+                flush_timer_.expires_after(FLUSH_DELAY);
+                flush_timer_.async_wait([this](boost::system::error_code ec)
+                {
+                    if (ec) return;
+                    FlushAll();
+                });
+            });
+        }
+    }
+
+    void ChatCluster::FlushAll()
+    {
+        std::lock_guard lock(out_mutex_);
+        flush_armed_ = false;
+        for (auto& [target, box] : outboxes_)
+            if (box.count > 0)
+                Publish(target, box);
+    }
+
+    void ChatCluster::Publish(NodeId target, Outbox& outbox)
+    {
+        BatchHeader header{};
+        header.origin = static_cast<uint16_t>(config_.node_id);
+        header.count = outbox.count;
+        std::memcpy(outbox.data.data(), &header, sizeof(header));
+
+        batches_out_.fetch_add(1, std::memory_order_relaxed);
+        records_out_.fetch_add(outbox.count, std::memory_order_relaxed);
+        bytes_out_.fetch_add(outbox.data.size(), std::memory_order_relaxed);
+        bus_.Publish(target == 0 ? std::string(GLOBAL_CHANNEL) : NodeChannel(target), std::move(outbox.data));
+        outbox.data = {};
+        outbox.count = 0;
+    }
+
+    void ChatCluster::OnBusMessage(const std::string& channel, Network::Buffer payload)
+    {
+        if (payload.size() < sizeof(BatchHeader)) return;
+        auto header = Read<BatchHeader>(payload.data());
+        if (header.origin == config_.node_id && channel == GLOBAL_CHANNEL)
+            return; // 자기가 방송한 것 (로컬 처리는 보낼 때 이미 함)
+        post_(std::move(payload));
+    }
+
+    void ChatCluster::HandleBatch(const uint8_t* data, uint32_t size)
+    {
+        if (size < sizeof(BatchHeader)) return;
+        auto header = Read<BatchHeader>(data);
+        NodeId origin = header.origin;
+        bool returned = false;
+        if (header.reserved != BATCH_LOCAL)
+        {
+            std::lock_guard lock(directory_mutex_);
+            last_seen_[origin] = std::chrono::steady_clock::now();
+            returned = lost_.erase(origin) > 0;
+        }
+        batches_in_.fetch_add(1, std::memory_order_relaxed);
+
+        if (returned)
+        {
+            // 끊겼던 노드가 다시 보임 (재시작이면 DirectoryRequest가 따로 옴)
+            // 이쪽은 그 노드 세션을 지웠고 그쪽도 이쪽 세션을 지웠을 수 있음 -> 자기 세션을 다시 알리고 그쪽 목록을 받음
+            spdlog::info("[Cluster] 노드 {} 복귀 -> 디렉터리 다시 알림", origin);
+            AnnounceTo(origin);
+            Append(origin, RecordKind::DirectorySync, {});
+        }
+
+        const uint8_t* p = data + sizeof(BatchHeader);
+        const uint8_t* end = data + size;
+        for (uint32_t i = 0; i < header.count; ++i)
+        {
+            if (static_cast<size_t>(end - p) < sizeof(RecordHeader)) break;
+            auto record = Read<RecordHeader>(p);
+            p += sizeof(RecordHeader);
+            if (record.size > static_cast<size_t>(end - p)) break; // 잘린 배치 -> 나머지 버림
+            const uint8_t* body = p;
+            uint32_t bodySize = record.size;
+            p += record.size;
+            records_in_.fetch_add(1, std::memory_order_relaxed);
+
+            switch (static_cast<RecordKind>(record.kind))
+            {
+            case RecordKind::Broadcast:
+                if (bodySize >= 1 && handlers_.on_broadcast)
+                    handlers_.on_broadcast(body + 1, bodySize - 1, body[0] != 0);
+                break;
+            case RecordKind::Deliver:
+            {
+                if (bodySize < sizeof(uint32_t)) break;
+                auto count = Read<uint32_t>(body);
+                size_t idsSize = static_cast<size_t>(count) * sizeof(SessionId);
+                if (idsSize > bodySize - sizeof(uint32_t)) break;
+                thread_local std::vector<SessionId> ids; // 본문은 정렬 보장이 없어 복사
+                ids.resize(count);
+                std::memcpy(ids.data(), body + sizeof(uint32_t), idsSize);
+                const uint8_t* frame = body + sizeof(uint32_t) + idsSize;
+                if (handlers_.on_deliver)
+                    handlers_.on_deliver(ids.data(), count, frame, static_cast<uint32_t>(bodySize - sizeof(uint32_t) - idsSize));
+                break;
+            }
+            case RecordKind::SessionUp:
+            {
+                std::lock_guard lock(directory_mutex_);
+                for (uint32_t offset = 0; offset + sizeof(SessionId) <= bodySize; offset += sizeof(SessionId))
+                    directory_[Read<SessionId>(body + offset)] = origin;
+                break;
+            }
+            case RecordKind::SessionDown:
+                for (uint32_t offset = 0; offset + sizeof(SessionId) <= bodySize; offset += sizeof(SessionId))
+                {
+                    auto session = Read<SessionId>(body + offset);
+                    {
+                        std::lock_guard lock(directory_mutex_);
+                        auto it = directory_.find(session);
+                        if (it == directory_.end() || it->second != origin) continue; // 이미 다른 노드로 옮겨감
+                        directory_.erase(it);
+                    }
+                    if (handlers_.on_remote_session_down)
+                        handlers_.on_remote_session_down(session);
+                }
+                break;
+            case RecordKind::DirectorySync:
+                AnnounceTo(origin);
+                break;
+            case RecordKind::DirectoryRequest:
+            {
+                // 요청 노드가 (재)시작함 -> 그 노드에 있다고 알던 세션은 모두 사라진 것
+                std::vector<SessionId> stale;
+                std::vector<SessionId> local;
+                {
+                    std::lock_guard lock(directory_mutex_);
+                    for (auto it = directory_.begin(); it != directory_.end();)
+                    {
+                        if (it->second == origin)
+                        {
+                            stale.push_back(it->first);
+                            it = directory_.erase(it);
+                            continue;
+                        }
+                        if (it->second == config_.node_id)
+                            local.push_back(it->first);
+                        ++it;
+                    }
+                }
+                for (auto session : stale)
+                    if (handlers_.on_remote_session_down)
+                        handlers_.on_remote_session_down(session);
+                if (!local.empty())
+                    Append(origin, RecordKind::SessionUp, { { local.data(), local.size() * sizeof(SessionId) } });
+                break;
+            }
+            case RecordKind::Heartbeat:
+                break; // last_seen_ 갱신만
+            case RecordKind::RoomOp:
+            {
+                constexpr size_t ROOM_OP_HEAD = 2 * sizeof(uint16_t) + sizeof(RoomId) + sizeof(SessionId);
+                if (bodySize < ROOM_OP_HEAD) break;
+                auto type = static_cast<Network::PacketType>(Read<uint16_t>(body));
+                auto room = Read<RoomId>(body + 2 * sizeof(uint16_t));
+                auto session = Read<SessionId>(body + 2 * sizeof(uint16_t) + sizeof(RoomId));
+                if (handlers_.on_room_op)
+                    handlers_.on_room_op(type, room, session, body + ROOM_OP_HEAD, static_cast<uint32_t>(bodySize - ROOM_OP_HEAD));
+                break;
+            }
+            }
+        }
+    }
+
+    void ChatCluster::AnnounceTo(NodeId target)
+    {
+        std::vector<SessionId> local;
+        {
+            std::lock_guard lock(directory_mutex_);
+            for (const auto& [session, node] : directory_)
+                if (node == config_.node_id)
+                    local.push_back(session);
+        }
+        if (!local.empty())
+            Append(target, RecordKind::SessionUp, { { local.data(), local.size() * sizeof(SessionId) } });
+    }
+
+    void ChatCluster::ScheduleHeartbeat()
+    {
+        heartbeat_timer_.expires_after(HEARTBEAT_INTERVAL);
+        heartbeat_timer_.async_wait([this](boost::system::error_code ec)
+        {
+            if (ec) return;
+            Append(0, RecordKind::Heartbeat, {});
+            DetectLostNodes();
+            ScheduleHeartbeat();
+        });
+    }
+
+    void ChatCluster::DetectLostNodes()
+    {
+        // 하트비트가 끊긴 노드 -> 그 노드가 보낸 것처럼 SessionDown 배치를 만들어 로직 스레드로 (정리 경로를 하나로)
+        auto now = std::chrono::steady_clock::now();
+        std::vector<std::pair<NodeId, Network::Buffer>> lost;
+        {
+            std::lock_guard lock(directory_mutex_);
+            for (auto it = last_seen_.begin(); it != last_seen_.end();)
+            {
+                if (it->first == config_.node_id || now - it->second < NODE_TIMEOUT)
+                {
+                    ++it;
+                    continue;
+                }
+
+                std::vector<SessionId> sessions;
+                for (const auto& [session, node] : directory_)
+                    if (node == it->first)
+                        sessions.push_back(session);
+
+                BatchHeader header{};
+                header.origin = static_cast<uint16_t>(it->first);
+                header.reserved = BATCH_LOCAL; // 처리하면서 last_seen_을 되살리지 않게
+                header.count = 1;
+                RecordHeader record{};
+                record.kind = static_cast<uint16_t>(RecordKind::SessionDown);
+                record.size = static_cast<uint32_t>(sessions.size() * sizeof(SessionId));
+
+                Network::Buffer batch(sizeof(header) + sizeof(record) + record.size);
+                std::memcpy(batch.data(), &header, sizeof(header));
+                std::memcpy(batch.data() + sizeof(header), &record, sizeof(record));
+                if (!sessions.empty())
+                    std::memcpy(batch.data() + sizeof(header) + sizeof(record), sessions.data(), record.size);
+                lost.emplace_back(it->first, std::move(batch));
+                lost_.insert(it->first);
+                it = last_seen_.erase(it);
+            }
+        }
+
+        for (auto& [node, batch] : lost)
+        {
+            spdlog::warn("[Cluster] 노드 {} 응답 없음 -> 세션 정리", node);
+            nodes_lost_.fetch_add(1, std::memory_order_relaxed);
+            post_(std::move(batch));
+        }
+    }
+
+    ChatCluster::Stats ChatCluster::GetStats() const
+    {
+        Stats stats{};
+        stats.batches_out = batches_out_.load(std::memory_order_relaxed);
+        stats.records_out = records_out_.load(std::memory_order_relaxed);
+        stats.bytes_out = bytes_out_.load(std::memory_order_relaxed);
+        stats.batches_in = batches_in_.load(std::memory_order_relaxed);
+        stats.records_in = records_in_.load(std::memory_order_relaxed);
+        stats.nodes_lost = nodes_lost_.load(std::memory_order_relaxed);
+        std::lock_guard lock(directory_mutex_);
+        stats.directory_size = directory_.size();
+        return stats;
+    }
+
+    void ChatCluster::ExportHandoff(Network::HandoffWriter& writer) const
+    {
+        std::lock_guard lock(directory_mutex_);
+        writer.Put(static_cast<uint32_t>(directory_.size()));
+        for (const auto& [session, node] : directory_)
+        {
+            writer.Put(session);
+            writer.Put(node);
+        }
+    }
+
+    bool ChatCluster::ImportHandoff(Network::HandoffReader& reader)
+    {
+        std::lock_guard lock(directory_mutex_);
+        auto count = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto session = reader.Get<SessionId>();
+            directory_[session] = reader.Get<NodeId>();
+        }
+        return reader.Ok();
+    }
+}
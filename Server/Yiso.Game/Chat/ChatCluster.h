@@ -0,0 +1,158 @@
+#pragma once
+#include "ChatBus.h"
+#include "Network/YisoSession.h"
+#include "Network/HotRestart.h"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Yiso::Game
+{
+    // 여러 게임 프로세스(노드)가 채팅을 나눠 맡기 위한 중계 계층 (ChatHandler <-> ChatBus)
+    // - 세션은 접속한 노드에, 방은 방 ID의 일관 해시로 정해지는 소유 노드에 있음
+    // - 세션 디렉터리: 세션 ID -> 노드 (SessionUp/Down 방송으로 모든 노드가 같은 표를 가짐)
+    // - 노드 사이 메시지는 채널별로 모아서 (FLUSH_BYTES 또는 FLUSH_DELAY) 한 번에 발행
+    // - 받은 배치는 post 함수로 로직 스레드에 넘기고, 로직 스레드에서 HandleBatch -> 핸들러 호출
+    // 채널: "chat:global" (글로벌 채팅 / 접속 알림 / 디렉터리 / 하트비트), "chat:node:{id}" (그 노드로 가는 전달 / 방 요청)
+    class ChatCluster
+    {
+    public:
+        using NodeId = uint32_t;
+        using RoomId = uint32_t;
+        using SessionId = Network::YisoSession::SessionId;
+
+        struct Config
+        {
+            NodeId node_id = 1; // 1..MAX_NODES
+            std::vector<NodeId> nodes; // 전체 노드 (자기 포함, 모든 노드가 같은 목록이어야 방 소유 노드가 일치)
+        };
+
+        struct Handlers
+        {
+            std::function<void(const uint8_t* frame, uint32_t size, bool history)> on_broadcast; // 다른 노드의 글로벌 프레임
+            std::function<void(const SessionId* ids, uint32_t count, const uint8_t* frame, uint32_t size)> on_deliver; // 이 노드 세션에게 전달
+            std::function<void(Network::PacketType type, RoomId room, SessionId session, const uint8_t* body, uint32_t size)> on_room_op; // 이 노드 소유 방 요청
+            std::function<void(SessionId)> on_remote_session_down; // 다른 노드 세션 종료 (소유 방에서 정리)
+        };
+
+        struct Stats
+        {
+            uint64_t batches_out;
+            uint64_t records_out;
+            uint64_t bytes_out;
+            uint64_t batches_in;
+            uint64_t records_in;
+            uint64_t nodes_lost; // 하트비트가 끊겨 세션을 정리한 횟수
+            size_t directory_size;
+        };
+
+        static constexpr NodeId MAX_NODES = 255;
+        static constexpr uint32_t ID_STRIDE = 256; // 세션 / 방 ID = node_id + k * ID_STRIDE -> 노드끼리 겹치지 않음
+        static constexpr size_t VIRTUAL_NODES = 64; // 노드당 해시 링 지점 수
+        static constexpr size_t FLUSH_BYTES = 16 * 1024;
+        static constexpr auto FLUSH_DELAY = std::chrono::milliseconds(2);
+        static constexpr auto HEARTBEAT_INTERVAL = std::chrono::seconds(5);
+        static constexpr auto NODE_TIMEOUT = std::chrono::seconds(15);
+
+        ChatCluster(boost::asio::io_context& io, ChatBus& bus, Config config);
+
+        // post: 받은 배치를 로직 스레드로 넘기는 함수 (거기서 HandleBatch 호출)
+        bool Start(std::function<void(Network::Buffer)> post);
+        void Stop();
+        void SetHandlers(Handlers handlers) { handlers_ = std::move(handlers); } // Start 전에
+
+        NodeId Self() const { return config_.node_id; }
+        NodeId OwnerOf(RoomId room) const;
+        NodeId NodeOf(SessionId session) const; // 디렉터리에 없으면 0
+
+        // 로직 스레드에서 호출
+        void SessionUp(SessionId session);
+        void SessionDown(SessionId session);
+        void Broadcast(const Network::Buffer& frame, bool history);
+        void Deliver(NodeId node, const SessionId* ids, uint32_t count, const Network::Buffer& frame);
+        void SendRoomOp(NodeId owner, Network::PacketType type, RoomId room, SessionId session, const uint8_t* body, uint32_t size);
+        void HandleBatch(const uint8_t* data, uint32_t size);
+
+        Stats GetStats() const;
+
+        // 무중단 재시작: 세션 디렉터리 (같은 노드 번호로 이어받음, 다른 노드는 바뀐 줄 모름)
+        void ExportHandoff(Network::HandoffWriter& writer) const;
+        bool ImportHandoff(Network::HandoffReader& reader);
+
+        static std::string NodeChannel(NodeId node);
+        static constexpr const char* GLOBAL_CHANNEL = "chat:global";
+
+    private:
+        enum class RecordKind : uint16_t
+        {
+            Broadcast = 1, // [u8 history][프레임]
+            Deliver = 2, // [u32 count][u32 ids...][프레임]
+            SessionUp = 3, // [u32 ids...]
+            SessionDown = 4, // [u32 ids...]
+            DirectoryRequest = 5, // (빈 본문) -> 받은 노드는 자기 세션 목록을 요청 노드 채널로 SessionUp
+            Heartbeat = 6,
+            RoomOp = 7, // [u16 type][u16 0][u32 room][u32 session][C2S 본문]
+            DirectorySync = 8, // (빈 본문) -> 받은 노드는 자기 세션 목록을 요청 노드 채널로 SessionUp (DirectoryRequest와 달리 요청 노드 세션을 지우지 않음)
+        };
+
+        static constexpr uint16_t BATCH_LOCAL = 1; // BatchHeader.reserved: 이 노드가 만든 배치 (하트비트로 치지 않음)
+
+#pragma pack(push, 1)
+        struct BatchHeader
+        {
+            uint16_t origin; // 보낸 노드
+            uint16_t reserved; // 버스로 오는 배치는 0, BATCH_LOCAL = 이 노드가 만든 배치
+            uint32_t count; // 레코드 수
+        };
+
+        struct RecordHeader
+        {
+            uint16_t kind; // RecordKind
+            uint16_t reserved;
+            uint32_t size; // 본문 크기
+        };
+#pragma pack(pop)
+
+        struct Outbox
+        {
+            Network::Buffer data; // BatchHeader + 레코드들
+            uint32_t count = 0;
+        };
+
+        // 채널 하나에 레코드 추가: parts를 이어붙인 것이 본문
+        void Append(NodeId target, RecordKind kind, std::initializer_list<std::pair<const void*, size_t>> parts);
+        void FlushAll();
+        void Publish(NodeId target, Outbox& outbox);
+        void OnBusMessage(const std::string& channel, Network::Buffer payload);
+        void AnnounceTo(NodeId target); // 이 노드 세션 목록을 target 채널로 SessionUp
+        void ScheduleHeartbeat();
+        void DetectLostNodes();
+
+        boost::asio::io_context& io_;
+        ChatBus& bus_;
+        Config config_;
+        Handlers handlers_;
+        std::function<void(Network::Buffer)> post_;
+        std::vector<std::pair<uint64_t, NodeId>> ring_; // (해시, 노드) 정렬
+
+        std::mutex out_mutex_;
+        std::unordered_map<NodeId, Outbox> outboxes_; // 0 = 글로벌 채널
+        bool flush_armed_ = false;
+        boost::asio::steady_timer flush_timer_;
+        boost::asio::steady_timer heartbeat_timer_;
+
+        mutable std::mutex directory_mutex_;
+        std::unordered_map<SessionId, NodeId> directory_;
+        std::unordered_map<NodeId, std::chrono::steady_clock::time_point> last_seen_;
+        std::unordered_set<NodeId> lost_; // 응답 없음으로 정리한 노드 -> 다시 보이면 서로 디렉터리를 다시 알림
+
+        std::atomic<uint64_t> batches_out_{0};
+        std::atomic<uint64_t> records_out_{0};
+        std::atomic<uint64_t> bytes_out_{0};
+        std::atomic<uint64_t> batches_in_{0};
+        std::atomic<uint64_t> records_in_{0};
+        std::atomic<uint64_t> nodes_lost_{0};
+    };
+}
@@ -0,0 +1,298 @@
+#include "ChatFilter.h"
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YISO_CHAT_FILTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        inline uint8_t FoldAscii(uint8_t c)
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c | 0x20) : c;
+        }
+    }
+
+    bool ChatFilter::FoldAndValidateUtf8(const uint8_t* src, uint8_t* dst, size_t size)
+    {
+        size_t i = 0;
+#ifdef YISO_CHAT_FILTER_SSE2
+        // 16바이트 단위: 대문자만 소문자로 바꿔 통째로 복사 (0x80 이상 바이트는 그대로)
+        // UTF-8 검증은 바이트 종류별 비트마스크로 (한글 같은 멀티바이트 문자도 스칼라로 빠지지 않음)
+        // - lead 바이트가 요구하는 continuation 위치 == 실제 continuation 위치여야 함
+        // - E0 / ED / F0 / F4 다음 바이트는 범위가 더 좁음 (overlong / surrogate / U+10FFFF 초과)
+        // - 블록 끝을 넘는 요구는 carry로 다음 블록에
+        const __m128i upperA = _mm_set1_epi8('A' - 1);
+        const __m128i upperZ = _mm_set1_epi8('Z' + 1);
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        // 부호 없는 범위 비교: 0x80을 뒤집으면 부호 있는 비교 순서와 같아짐
+        auto inRange = [](__m128i flipped, uint8_t lo, uint8_t hi)
+        {
+            __m128i gtLo = _mm_cmpgt_epi8(flipped, _mm_set1_epi8(static_cast<char>((lo - 1) ^ 0x80)));
+            __m128i ltHi = _mm_cmplt_epi8(flipped, _mm_set1_epi8(static_cast<char>((hi + 1) ^ 0x80)));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(gtLo, ltHi)));
+        };
+        auto equals = [](__m128i v, uint8_t c)
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(c)))));
+        };
+
+        uint32_t carryCont = 0; // 이전 블록 lead가 이번 블록에 요구하는 continuation
+        uint32_t carryE0 = 0, carryED = 0, carryF0 = 0, carryF4 = 0; // 이전 블록 마지막 바이트가 그 lead였음
+        while (i + 16 <= size)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            // 부호 있는 비교라 0x80 이상 바이트는 음수 -> 대문자 범위에 절대 안 걸림
+            __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(v, upperA), _mm_cmplt_epi8(v, upperZ));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(v, _mm_and_si128(isUpper, caseBit)));
+
+            uint32_t nonAscii = static_cast<uint32_t>(_mm_movemask_epi8(v));
+            if ((nonAscii | carryCont) == 0)
+            {
+                i += 16;
+                continue;
+            }
+
+            __m128i flipped = _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0x80)));
+            uint32_t cont = inRange(flipped, 0x80, 0xBF);
+            uint32_t lead2 = inRange(flipped, 0xC2, 0xDF);
+            uint32_t lead3 = inRange(flipped, 0xE0, 0xEF);
+            uint32_t lead4 = inRange(flipped, 0xF0, 0xF4);
+            if ((cont | lead2 | lead3 | lead4) != nonAscii)
+                return false; // C0 / C1 / F5~FF
+
+            uint32_t required = carryCont | (lead2 << 1) | (lead3 << 1) | (lead3 << 2) | (lead4 << 1) | (lead4 << 2) | (lead4 << 3);
+            if ((required & 0xFFFF) != cont)
+                return false;
+
+            uint32_t e0 = equals(v, 0xE0), ed = equals(v, 0xED), f0 = equals(v, 0xF0), f4 = equals(v, 0xF4);
+            uint32_t bad = (((e0 << 1) | carryE0) & inRange(flipped, 0x80, 0x9F)) |
+                           (((ed << 1) | carryED) & inRange(flipped, 0xA0, 0xBF)) |
+                           (((f0 << 1) | carryF0) & inRange(flipped, 0x80, 0x8F)) |
+                           (((f4 << 1) | carryF4) & inRange(flipped, 0x90, 0xBF));
+            if ((bad & 0xFFFF) != 0)
+                return false;
+
+            carryCont = required >> 16;
+            carryE0 = e0 >> 15;
+            carryED = ed >> 15;
+            carryF0 = f0 >> 15;
+            carryF4 = f4 >> 15;
+            i += 16;
+        }
+
+        if (carryCont != 0)
+        {
+            // 마지막 블록 끝에 걸친 문자 -> 그 lead부터 아래 스칼라 경로로 다시 검사
+            while (src[i - 1] < 0xC0)
+                --i;
+            --i;
+        }
+#endif
+        while (i < size)
+        {
+            uint8_t c = src[i];
+            if (c < 0x80)
+            {
+                dst[i++] = FoldAscii(c);
+                continue;
+            }
+
+            // 멀티바이트 시퀀스: overlong / surrogate / U+10FFFF 초과 거부
+            size_t len;
+            uint8_t lo = 0x80, hi = 0xBF; // 두 번째 바이트 허용 범위
+            if (c >= 0xC2 && c <= 0xDF) len = 2;
+            else if (c == 0xE0) { len = 3; lo = 0xA0; }
+            else if (c == 0xED) { len = 3; hi = 0x9F; }
+            else if (c >= 0xE1 && c <= 0xEF) len = 3;
+            else if (c == 0xF0) { len = 4; lo = 0x90; }
+            else if (c == 0xF4) { len = 4; hi = 0x8F; }
+            else if (c >= 0xF1 && c <= 0xF3) len = 4;
+            else return false;
+
+            if (i + len > size) return false;
+            if (src[i + 1] < lo || src[i + 1] > hi) return false;
+            for (size_t k = 2; k < len; ++k)
+            {
+                if ((src[i + k] & 0xC0) != 0x80) return false;
+            }
+            for (size_t k = 0; k < len; ++k)
+                dst[i + k] = src[i + k];
+            i += len;
+        }
+        return true;
+    }
+
+    std::shared_ptr<const ChatFilter::Automaton> ChatFilter::Compile(const std::vector<std::string>& words)
+    {
+        auto automaton = std::make_shared<Automaton>();
+        Automaton& a = *automaton;
+
+        // 1. 금칙어를 접은(소문자) 형태로 정리 + 등장하는 바이트만 클래스 부여 -> 테이블 폭 축소
+        std::vector<std::string> folded;
+        bool used[256] = {};
+        for (const auto& word : words)
+        {
+            if (word.empty() || word.size() > UINT16_MAX) continue;
+            std::string f(word.size(), '\0');
+            if (!FoldAndValidateUtf8(reinterpret_cast<const uint8_t*>(word.data()), reinterpret_cast<uint8_t*>(f.data()), word.size()))
+            {
+                spdlog::warn("[ChatFilter] UTF-8이 아닌 금칙어 무시");
+                continue;
+            }
+            for (unsigned char c : f) used[c] = true;
+            folded.push_back(std::move(f));
+        }
+
+        a.num_classes = 1;
+        for (int c = 0; c < 256; ++c)
+            a.byte_class[c] = used[c] ? static_cast<uint8_t>(a.num_classes++) : 0;
+
+        // 2. 트라이 구성 (없는 전이 = UINT32_MAX)
+        const uint32_t nc = a.num_classes;
+        a.next.assign(nc, UINT32_MAX);
+        a.match_len.assign(1, 0);
+        for (const auto& word : folded)
+        {
+            uint32_t state = 0;
+            for (unsigned char c : word)
+            {
+                uint32_t& slot = a.next[state * nc + a.byte_class[c]];
+                if (slot == UINT32_MAX)
+                {
+                    slot = static_cast<uint32_t>(a.match_len.size());
+                    a.match_len.push_back(0);
+                    a.next.resize(a.next.size() + nc, UINT32_MAX);
+                }
+                state = a.next[state * nc + a.byte_class[c]]; // resize로 slot 참조가 무효화될 수 있어 다시 읽음
+            }
+            a.match_len[state] = std::max<uint16_t>(a.match_len[state], static_cast<uint16_t>(word.size()));
+        }
+
+        // 3. BFS로 실패 링크를 따라가며 전이 테이블을 완전한 DFA로 채움
+        std::vector<uint32_t> fail(a.match_len.size(), 0);
+        std::deque<uint32_t> queue;
+        for (uint32_t c = 0; c < nc; ++c)
+        {
+            uint32_t& slot = a.next[c];
+            if (slot == UINT32_MAX)
+                slot = 0;
+            else
+                queue.push_back(slot);
+        }
+        while (!queue.empty())
+        {
+            uint32_t state = queue.front();
+            queue.pop_front();
+            a.match_len[state] = std::max(a.match_len[state], a.match_len[fail[state]]);
+
+            for (uint32_t c = 0; c < nc; ++c)
+            {
+                uint32_t& slot = a.next[state * nc + c];
+                uint32_t viaFail = a.next[fail[state] * nc + c];
+                if (slot == UINT32_MAX)
+                {
+                    slot = viaFail;
+                }
+                else
+                {
+                    fail[slot] = viaFail;
+                    queue.push_back(slot);
+                }
+            }
+        }
+
+        spdlog::info("[ChatFilter] 금칙어 {}개 컴파일 (상태 {}, 바이트 클래스 {})", folded.size(), a.match_len.size(), nc);
+        return automaton;
+    }
+
+    void ChatFilter::SetWords(const std::vector<std::string>& words)
+    {
+        std::atomic_store(&automaton_, Compile(words));
+    }
+
+    bool ChatFilter::LoadWordList(const std::filesystem::path& path)
+    {
+        // 경로는 먼저 기억 -> 시작 때 파일이 없어도 나중에 생기면 ReloadIfChanged가 읽음 (그때까지는 금칙어 없음)
+        path_ = path;
+        std::error_code ec;
+        last_write_ = std::filesystem::last_write_time(path, ec); // 읽기 전에 -> 읽는 동안 바뀌면 다음 확인에서 다시 로드
+        if (ec) last_write_ = {};
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            spdlog::warn("[ChatFilter] 금칙어 파일 열기 실패, 생길 때까지 금칙어 없음: {}", path.string());
+            return false;
+        }
+
+        std::vector<std::string> words;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            auto begin = line.find_first_not_of(" \t\r");
+            if (begin == std::string::npos || line[begin] == '#') continue;
+            auto end = line.find_last_not_of(" \t\r");
+            words.push_back(line.substr(begin, end - begin + 1));
+        }
+
+        SetWords(words);
+        return true;
+    }
+
+    bool ChatFilter::ReloadIfChanged()
+    {
+        if (path_.empty()) return false;
+
+        std::error_code ec;
+        auto writeTime = std::filesystem::last_write_time(path_, ec);
+        if (ec || writeTime == last_write_) return false; // 아직 없음 / 그대로
+
+        spdlog::info("[ChatFilter] 금칙어 파일 변경 감지, 리로드: {}", path_.string());
+        return LoadWordList(path_);
+    }
+
+    ChatFilter::Result ChatFilter::Apply(char* data, size_t size) const
+    {
+        // 접은 사본은 스레드마다 재사용 (메시지마다 할당하지 않도록)
+        thread_local std::vector<uint8_t> folded;
+        if (folded.size() < size)
+            folded.resize(size);
+
+        auto* bytes = reinterpret_cast<uint8_t*>(data);
+        if (!FoldAndValidateUtf8(bytes, folded.data(), size))
+            return { false, 0 };
+
+        auto automaton = std::atomic_load(&automaton_);
+        if (!automaton) return { true, 0 };
+
+        const Automaton& a = *automaton;
+        const uint32_t nc = a.num_classes;
+        const uint32_t* next = a.next.data();
+        const uint16_t* matchLen = a.match_len.data();
+
+        uint32_t state = 0;
+        uint32_t masked = 0;
+        size_t maskedUpTo = 0; // 이미 가린 구간의 끝 (겹치는 매치 중복 집계 방지)
+        for (size_t i = 0; i < size; ++i)
+        {
+            state = next[state * nc + a.byte_class[folded[i]]];
+            uint16_t len = matchLen[state];
+            if (len == 0) continue;
+
+            // 금칙어도 유효한 UTF-8이므로 매치 구간은 항상 문자 경계에 맞음 -> 가려도 UTF-8 유지
+            size_t from = std::max(i + 1 - len, maskedUpTo);
+            for (size_t k = from; k <= i; ++k)
+                bytes[k] = '*';
+            masked += static_cast<uint32_t>(i + 1 - from);
+            maskedUpTo = i + 1;
+        }
+        return { true, masked };
+    }
+}
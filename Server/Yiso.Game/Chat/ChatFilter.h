@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 채팅 금칙어 필터
+    // - 금칙어 목록을 Aho-Corasick 오토마톤(전이 테이블)으로 컴파일 -> 메시지 길이에 비례하는 한 번의 스캔으로 전부 검사
+    // - 스캔 전에 UTF-8 검증 + ASCII 대소문자 접기를 한 패스로 처리 (SSE2로 16바이트씩)
+    // - 목록 리로드 시 새 오토마톤을 만들어 포인터만 원자적으로 교체 -> 검사 중인 스레드는 이전 오토마톤을 끝까지 사용
+    class ChatFilter
+    {
+    public:
+        struct Result
+        {
+            bool valid_utf8;
+            uint32_t masked; // '*'로 가린 바이트 수
+        };
+
+        // 파일 한 줄에 금칙어 하나 (UTF-8, '#'으로 시작하면 주석)
+        // 파일이 없으면 false지만 경로는 기억 -> 나중에 만들어지면 ReloadIfChanged에서 로드
+        bool LoadWordList(const std::filesystem::path& path);
+        bool ReloadIfChanged(); // 파일 수정 시각이 바뀐 경우에만 다시 로드
+        void SetWords(const std::vector<std::string>& words);
+
+        // data를 그 자리에서 검사 -> 금칙어 구간을 '*'로 덮어씀 (길이 유지)
+        // UTF-8이 깨진 메시지는 valid_utf8=false 로 반환하고 내용을 건드리지 않음
+        Result Apply(char* data, size_t size) const;
+
+        // ASCII 대문자 -> 소문자 복사 + UTF-8 검증
+        static bool FoldAndValidateUtf8(const uint8_t* src, uint8_t* dst, size_t size);
+
+    private:
+        struct Automaton
+        {
+            uint8_t byte_class[256]; // 금칙어에 등장하지 않는 바이트는 모두 0번 클래스
+            uint32_t num_classes;
+            std::vector<uint32_t> next; // state * num_classes + class -> state
+            std::vector<uint16_t> match_len; // 이 상태에서 끝나는 가장 긴 금칙어 길이 (0 = 없음)
+        };
+
+        static std::shared_ptr<const Automaton> Compile(const std::vector<std::string>& words);
+
+        std::shared_ptr<const Automaton> automaton_; // std::atomic_load / atomic_store 로만 접근
+        std::filesystem::path path_;
+        std::filesystem::file_time_type last_write_{};
+    };
+}
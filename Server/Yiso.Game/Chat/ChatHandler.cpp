@@ -1,45 +1,114 @@
 #include "ChatHandler.h"
+#include "ChatRelay.h"
 #include "Network/PacketCodec.h"
 #include "game_packet.pb.h"
+#include <map>
 #include <spdlog/spdlog.h>
 
 namespace Yiso::Game
 {
-    ChatHandler::ChatHandler(Network::YisoSessionManager& manager)
-        : session_manager_(manager)
+    namespace
     {
+        constexpr const char* BANNED_WORDS_FILE = "banned_words.txt";
+        constexpr const char* SERVER_BUSY_ERROR = "서버가 혼잡합니다. 잠시 후 다시 시도하세요.";
+    }
+
+    ChatHandler::ChatHandler(Network::YisoSessionManager& manager, Network::OverloadController& overload, ChatCluster* cluster)
+        : session_manager_(manager),
+          overload_(overload),
+          cluster_(cluster)
+    {
+        filter_.LoadWordList(BANNED_WORDS_FILE);
+        if (!cluster_)
+            return;
+
+        // 방 ID를 노드별로 나눠 씀 -> 어느 노드에서 만들어도 겹치지 않음
+        room_manager_.SetIdSpace(cluster_->Self(), ChatCluster::ID_STRIDE);
+
+        // 다른 노드에서 온 것 (로직 스레드에서 호출)
+        ChatCluster::Handlers handlers;
+        handlers.on_broadcast = [this](const uint8_t* frame, uint32_t size, bool history)
+        {
+            if (!overload_.Admit(history ? Network::OverloadController::Work::GlobalChat : Network::OverloadController::Work::Presence))
+                return;
+            Network::Buffer buffer(frame, frame + size);
+            if (history)
+                history_.AppendGlobal(buffer);
+            session_manager_.Broadcast(std::move(buffer));
+        };
+        handlers.on_deliver = [this](const SessionId* ids, uint32_t count, const uint8_t* frame, uint32_t size)
+        {
+            Network::Buffer buffer(frame, frame + size);
+            for (uint32_t i = 0; i + 1 < count; ++i)
+                session_manager_.Send(ids[i], buffer);
+            if (count > 0)
+                session_manager_.Send(ids[count - 1], std::move(buffer));
+        };
+        handlers.on_room_op = [this](Network::PacketType type, ChatRoomManager::RoomId roomId, SessionId session, const uint8_t* body, uint32_t size)
+        {
+            ExecuteRoomOp(session, type, roomId, body, size);
+        };
+        handlers.on_remote_session_down = [this](SessionId session)
+        {
+            RemoveFromRooms(session);
+        };
+        cluster_->SetHandlers(std::move(handlers));
     }
 
     void ChatHandler::OnConnected(Network::YisoSession::SessionId id)
     {
         spdlog::info("[Chat] Session {} connected", id);
+        if (cluster_)
+            cluster_->SessionUp(id);
+
+        // 과부하: 접속 알림 / 기록 재전송은 모든 세션에 퍼지는 저우선 작업 -> 생략
+        if (!overload_.Admit(Network::OverloadController::Work::Presence))
+            return;
 
         yiso::game::S2C_Chat msg;
         msg.set_session_id(0);
         msg.set_message("Session " + std::to_string(id) + " joined.");
-        session_manager_.Broadcast(Network::PacketCodec::Encode(Network::PacketType::S2C_CHAT, msg));
+        BroadcastGlobal(Network::PacketCodec::Encode(Network::PacketType::S2C_CHAT, msg), false);
+
+        // 접속 직후 최근 글로벌 채팅을 한 번의 write로 재전송
+        auto backlog = history_.SnapshotGlobal();
+        if (!backlog.empty())
+            session_manager_.Send(id, std::move(backlog));
     }
 
     void ChatHandler::OnDisconnected(Network::YisoSession::SessionId id)
     {
         spdlog::info("[Chat] Session {} disconnected", id);
+        if (cluster_)
+            cluster_->SessionDown(id); // 다른 노드도 자기가 소유한 방에서 정리
+        RemoveFromRooms(id);
+
+        if (!overload_.Admit(Network::OverloadController::Work::Presence))
+            return;
 
+        yiso::game::S2C_Chat msg;
+        msg.set_session_id(0);
+        msg.set_message("Session " + std::to_string(id) + " left.");
+        BroadcastGlobal(Network::PacketCodec::Encode(Network::PacketType::S2C_CHAT, msg), false);
+    }
+
+    void ChatHandler::RemoveFromRooms(Network::YisoSession::SessionId id)
+    {
         auto changes = room_manager_.RemoveSession(id);
         for (auto& change : changes)
         {
+            if (change.room_removed)
+            {
+                history_.RemoveRoom(change.room_id);
+                continue;
+            }
+
             yiso::game::S2C_LeaveRoom resp;
             resp.set_room_id(change.room_id);
             resp.set_left_session(id);
             resp.set_new_owner(change.new_owner);
-            auto frame = Network::PacketCodec::Encode(Network::PacketType::S2C_LEAVE_ROOM, resp);
-            for (auto memberId : change.members)
-                session_manager_.Send(memberId, frame);
+            RouteMany(change.members, Network::PacketCodec::Encode(Network::PacketType::S2C_LEAVE_ROOM, resp));
         }
-
-        yiso::game::S2C_Chat msg;
-        msg.set_session_id(0);
-        msg.set_message("Session " + std::to_string(id) + " left.");
-        session_manager_.Broadcast(Network::PacketCodec::Encode(Network::PacketType::S2C_CHAT, msg));
     }
 
     void ChatHandler::OnRecv(Network::YisoSession::SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
@@ -53,7 +122,44 @@ namespace Yiso::Game
             HandleWhisper(id, data, size);
             break;
         case Network::PacketType::C2S_CREATE_ROOM:
-            HandleCreateRoom(id, data, size);
+        case Network::PacketType::C2S_DELETE_ROOM:
+        case Network::PacketType::C2S_JOIN_ROOM:
+        case Network::PacketType::C2S_LEAVE_ROOM:
+        case Network::PacketType::C2S_ROOM_CHAT:
+            RouteRoomOp(id, type, data, size);
+            break;
+        }
+    }
+
+    void ChatHandler::RouteRoomOp(Network::YisoSession::SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        // 방 생성은 이 노드에서 ID를 정한 뒤 그 ID의 소유 노드로
+        ChatRoomManager::RoomId roomId = 0;
+        bool routable = true;
+        if (type == Network::PacketType::C2S_CREATE_ROOM)
+            roomId = room_manager_.NextId();
+        else
+            routable = ChatRelay::TryParseRoomId(data, size, roomId);
+
+        if (cluster_ && routable)
+        {
+            auto owner = cluster_->OwnerOf(roomId);
+            if (owner != cluster_->Self())
+            {
+                cluster_->SendRoomOp(owner, type, roomId, id, data, size);
+                return;
+            }
+        }
+        ExecuteRoomOp(id, type, roomId, data, size); // 파싱 실패는 각 핸들러가 기록
+    }
+
+    void ChatHandler::ExecuteRoomOp(Network::YisoSession::SessionId id, Network::PacketType type, ChatRoomManager::RoomId roomId,
+                                    const uint8_t* data, uint32_t size)
+    {
+        switch (type)
+        {
+        case Network::PacketType::C2S_CREATE_ROOM:
+            HandleCreateRoom(id, roomId, data, size);
             break;
         case Network::PacketType::C2S_DELETE_ROOM:
             HandleDeleteRoom(id, data, size);
@@ -67,24 +173,46 @@ namespace Yiso::Game
         case Network::PacketType::C2S_ROOM_CHAT:
             HandleRoomChat(id, data, size);
             break;
+        default:
+            spdlog::warn("[Chat] unexpected room op type={} (session={})", static_cast<uint16_t>(type), id);
+            break;
         }
     }
 
     void ChatHandler::HandleChat(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
     {
-        yiso::game::C2S_Chat req;
-        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        // 세션 수만큼 퍼지는 방송 -> 과부하 시 방 채팅/제어보다 먼저 버림
+        if (!overload_.Admit(Network::OverloadController::Work::GlobalChat))
+            return;
+
+        // 빠른 경로: 와이어 포맷만 검증 -> message 바이트를 S2C 프레임에 바로 복사
+        // 알 수 없는 필드가 섞여 있으면 protobuf 파싱으로 폴백 (결과 프레임은 동일)
+        ChatRelay::RelayFrame relay;
+        std::string_view message;
+        if (ChatRelay::TryParseChat(data, size, message))
+        {
+            relay = ChatRelay::MakeChatFrame(id, message);
+        }
+        else
         {
-            spdlog::warn("[Chat] ParseFromArray failed (session={})", id);
+            yiso::game::C2S_Chat req;
+            if (!req.ParseFromArray(data, static_cast<int>(size)))
+            {
+                spdlog::warn("[Chat] ParseFromArray failed (session={})", id);
+                return;
+            }
+            relay = ChatRelay::MakeChatFrame(id, req.message());
+        }
+
+        if (!filter_.Apply(relay.MessageData(), relay.message_size).valid_utf8)
+        {
+            spdlog::warn("[Chat] invalid UTF-8 message (session={})", id);
             return;
         }
 
-        spdlog::info("[Chat] {} : {}", id, req.message());
+        spdlog::info("[Chat] {} : {}", id, relay.Message());
 
-        yiso::game::S2C_Chat resp;
-        resp.set_session_id(id);
-        resp.set_message(req.message());
-        session_manager_.Broadcast(Network::PacketCodec::Encode(Network::PacketType::S2C_CHAT, resp));
+        BroadcastGlobal(std::move(relay.frame), true);
     }
 
     void ChatHandler::HandleWhisper(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
@@ -99,19 +227,26 @@ namespace Yiso::Game
         yiso::game::S2C_Whisper resp;
         resp.set_from_session_id(id);
 
-        if (!session_manager_.HasSession(req.target_session_id()))
+        if (!IsOnline(req.target_session_id()))
         {
             spdlog::warn("[Chat] target session={} is not found", req.target_session_id());
             resp.set_message("해당 유저가 없습니다.");
             session_manager_.Send(id, Network::PacketCodec::Encode(Network::PacketType::S2C_WHISPER, resp));
             return;
         }
-        
-        resp.set_message(req.message());   
-        session_manager_.Send(req.target_session_id(), Network::PacketCodec::Encode(Network::PacketType::S2C_WHISPER, resp));
+
+        std::string* message = req.mutable_message();
+        if (!filter_.Apply(message->data(), message->size()).valid_utf8)
+        {
+            spdlog::warn("[Chat] Whisper invalid UTF-8 message (session={})", id);
+            return;
+        }
+
+        resp.set_message(std::move(*message));
+        Route(req.target_session_id(), Network::PacketCodec::Encode(Network::PacketType::S2C_WHISPER, resp));
     }
 
-    void ChatHandler::HandleCreateRoom(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
+    void ChatHandler::HandleCreateRoom(Network::YisoSession::SessionId id, ChatRoomManager::RoomId roomId, const uint8_t* data, uint32_t size)
     {
         yiso::game::C2S_CreateRoom req;
         if (!req.ParseFromArray(data, static_cast<int>(size)))
@@ -120,15 +255,35 @@ namespace Yiso::Game
             return;
         }
 
-        ChatRoomManager::RoomId roomId = room_manager_.CreateRoom(id, req.room_name());
+        if (!overload_.Admit(Network::OverloadController::Work::Join))
+        {
+            yiso::game::S2C_CreateRoom resp;
+            resp.set_room_name(req.room_name());
+            resp.set_success(false);
+            resp.set_error(SERVER_BUSY_ERROR);
+            Route(id, Network::PacketCodec::Encode(Network::PacketType::S2C_CREATE_ROOM, resp));
+            return;
+        }
+
+        if (!room_manager_.CreateRoom(roomId, id, req.room_name()))
+        {
+            spdlog::warn("[Chat] Room {} already exists (session={})", roomId, id);
+            yiso::game::S2C_CreateRoom resp;
+            resp.set_room_name(req.room_name());
+            resp.set_success(false);
+            resp.set_error("방을 만들 수 없습니다.");
+            Route(id, Network::PacketCodec::Encode(Network::PacketType::S2C_CREATE_ROOM, resp));
+            return;
+        }
 
         spdlog::info("[Chat] Room {} ('{}') created by session {}", roomId, req.room_name(), id);
+        history_.OpenRoom(roomId);
 
         yiso::game::S2C_CreateRoom resp;
         resp.set_room_id(roomId);
         resp.set_room_name(req.room_name());
         resp.set_success(true);
-        session_manager_.Send(id, Network::PacketCodec::Encode(Network::PacketType::S2C_CREATE_ROOM, resp));
+        Route(id, Network::PacketCodec::Encode(Network::PacketType::S2C_CREATE_ROOM, resp));
     }
 
     void ChatHandler::HandleDeleteRoom(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
@@ -149,18 +304,17 @@ namespace Yiso::Game
             resp.set_room_id(roomId);
             resp.set_success(false);
             resp.set_error(result.error);
-            session_manager_.Send(id, Network::PacketCodec::Encode(Network::PacketType::S2C_DELETE_ROOM, resp));
+            Route(id, Network::PacketCodec::Encode(Network::PacketType::S2C_DELETE_ROOM, resp));
             return;
         }
 
         spdlog::info("[Chat] Room {} deleted by session {}", roomId, id);
+        history_.RemoveRoom(roomId);
 
         yiso::game::S2C_DeleteRoom resp;
         resp.set_room_id(roomId);
         resp.set_success(true);
-        auto frame = Network::PacketCodec::Encode(Network::PacketType::S2C_DELETE_ROOM, resp);
-        for (auto memberId : result.members)
-            session_manager_.Send(memberId, frame);
+        RouteMany(result.members, Network::PacketCodec::Encode(Network::PacketType::S2C_DELETE_ROOM, resp));
     }
 
     void ChatHandler::HandleJoinRoom(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
@@ -173,6 +327,16 @@ namespace Yiso::Game
         }
 
         ChatRoomManager::RoomId roomId = req.room_id();
+        if (!overload_.Admit(Network::OverloadController::Work::Join))
+        {
+            yiso::game::S2C_JoinRoom resp;
+            resp.set_room_id(roomId);
+            resp.set_success(false);
+            resp.set_error(SERVER_BUSY_ERROR);
+            Route(id, Network::PacketCodec::Encode(Network::PacketType::S2C_JOIN_ROOM, resp));
+            return;
+        }
+
         auto result = room_manager_.TryJoinRoom(roomId, id);
 
         if (!result.success)
@@ -181,7 +345,7 @@ namespace Yiso::Game
             resp.set_room_id(roomId);
             resp.set_success(false);
             resp.set_error(result.error);
-            session_manager_.Send(id, Network::PacketCodec::Encode(Network::PacketType::S2C_JOIN_ROOM, resp));
+            Route(id, Network::PacketCodec::Encode(Network::PacketType::S2C_JOIN_ROOM, resp));
             return;
         }
 
@@ -191,9 +355,12 @@ namespace Yiso::Game
         resp.set_room_id(roomId);
         resp.set_joined_session(id);
         resp.set_success(true);
-        auto frame = Network::PacketCodec::Encode(Network::PacketType::S2C_JOIN_ROOM, resp);
-        for (auto memberId : result.members)
-            session_manager_.Send(memberId, frame);
+        RouteMany(result.members, Network::PacketCodec::Encode(Network::PacketType::S2C_JOIN_ROOM, resp));
+
+        // 입장 전 대화 기록을 한 번의 write로 재전송 (입장 알림 다음에 도착)
+        auto backlog = history_.SnapshotRoom(roomId);
+        if (!backlog.empty())
+            Route(id, std::move(backlog));
     }
 
     void ChatHandler::HandleLeaveRoom(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
@@ -215,26 +382,32 @@ namespace Yiso::Game
         }
 
         spdlog::info("[Chat] Session {} left room {}", id, roomId);
+        if (result.room_removed)
+            history_.RemoveRoom(roomId);
 
         yiso::game::S2C_LeaveRoom resp;
         resp.set_room_id(roomId);
         resp.set_left_session(id);
         resp.set_new_owner(result.new_owner);
-        auto frame = Network::PacketCodec::Encode(Network::PacketType::S2C_LEAVE_ROOM, resp);
-        for (auto memberId : result.members)
-            session_manager_.Send(memberId, frame);
+        RouteMany(result.members, Network::PacketCodec::Encode(Network::PacketType::S2C_LEAVE_ROOM, resp));
     }
 
     void ChatHandler::HandleRoomChat(Network::YisoSession::SessionId id, const uint8_t* data, uint32_t size)
     {
-        yiso::game::C2S_RoomChat req;
-        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        ChatRoomManager::RoomId roomId;
+        std::string_view message;
+        yiso::game::C2S_RoomChat req; // 폴백 경로에서만 사용 (message가 req를 가리킴)
+        if (!ChatRelay::TryParseRoomChat(data, size, roomId, message))
         {
-            spdlog::warn("[Chat] RoomChat ParseFromArray failed (session={})", id);
-            return;
+            if (!req.ParseFromArray(data, static_cast<int>(size)))
+            {
+                spdlog::warn("[Chat] RoomChat ParseFromArray failed (session={})", id);
+                return;
+            }
+            roomId = req.room_id();
+            message = req.message();
         }
 
-        ChatRoomManager::RoomId roomId = req.room_id();
         auto members = room_manager_.GetMembers(roomId);
 
         if (members.empty())
@@ -249,14 +422,82 @@ namespace Yiso::Game
             return;
         }
 
-        spdlog::info("[Chat] Room {} | {} : {}", roomId, id, req.message());
+        auto relay = ChatRelay::MakeRoomChatFrame(roomId, id, message);
+        if (!filter_.Apply(relay.MessageData(), relay.message_size).valid_utf8)
+        {
+            spdlog::warn("[Chat] RoomChat invalid UTF-8 message (session={})", id);
+            return;
+        }
 
-        yiso::game::S2C_RoomChat resp;
-        resp.set_room_id(roomId);
-        resp.set_from_session_id(id);
-        resp.set_message(req.message());
-        auto frame = Network::PacketCodec::Encode(Network::PacketType::S2C_ROOM_CHAT, resp);
-        for (auto memberId : members)
-            session_manager_.Send(memberId, frame);
+        spdlog::info("[Chat] Room {} | {} : {}", roomId, id, relay.Message());
+
+        history_.AppendRoom(roomId, relay.frame);
+        RouteMany(members, relay.frame);
+    }
+
+    void ChatHandler::Route(Network::YisoSession::SessionId target, Network::Buffer frame)
+    {
+        if (cluster_)
+        {
+            auto node = cluster_->NodeOf(target);
+            if (node != 0 && node != cluster_->Self())
+            {
+                cluster_->Deliver(node, &target, 1, frame);
+                return;
+            }
+        }
+        session_manager_.Send(target, std::move(frame));
+    }
+
+    void ChatHandler::RouteMany(const std::vector<SessionId>& targets, const Network::Buffer& frame)
+    {
+        if (!cluster_)
+        {
+            for (auto target : targets)
+                session_manager_.Send(target, frame);
+            return;
+        }
+
+        // 다른 노드 멤버는 노드별로 묶어 레코드 1개 (프레임은 노드당 한 번만 실림)
+        std::map<ChatCluster::NodeId, std::vector<SessionId>> remote;
+        for (auto target : targets)
+        {
+            auto node = cluster_->NodeOf(target);
+            if (node != 0 && node != cluster_->Self())
+                remote[node].push_back(target);
+            else
+                session_manager_.Send(target, frame);
+        }
+        for (const auto& [node, ids] : remote)
+            cluster_->Deliver(node, ids.data(), static_cast<uint32_t>(ids.size()), frame);
+    }
+
+    void ChatHandler::BroadcastGlobal(Network::Buffer frame, bool history)
+    {
+        if (cluster_)
+            cluster_->Broadcast(frame, history);
+        if (history)
+            history_.AppendGlobal(frame);
+        session_manager_.Broadcast(std::move(frame));
+    }
+
+    bool ChatHandler::IsOnline(Network::YisoSession::SessionId id)
+    {
+        return session_manager_.HasSession(id) || (cluster_ && cluster_->NodeOf(id) != 0);
+    }
+
+    void ChatHandler::ExportHandoff(Network::HandoffWriter& writer) const
+    {
+        room_manager_.ExportHandoff(writer);
+        history_.ExportHandoff(writer);
+    }
+
+    bool ChatHandler::ImportHandoff(Network::HandoffReader& reader)
+    {
+        if (!room_manager_.ImportHandoff(reader))
+            return false;
+        for (auto roomId : room_manager_.GetRoomIds())
+            history_.OpenRoom(roomId);
+        return history_.ImportHandoff(reader);
     }
 }
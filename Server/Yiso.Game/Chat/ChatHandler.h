@@ -1,6 +1,10 @@
 #pragma once
 #include "Network/YisoSession.h"
 #include "Network/YisoSessionManager.h"
+#include "Network/OverloadController.h"
+#include "ChatCluster.h"
+#include "ChatFilter.h"
+#include "ChatHistory.h"
 #include "ChatRoomManager.h"
 
 namespace Yiso::Game
@@ -9,22 +13,42 @@ namespace Yiso::Game
     {
     public:
         using SessionId = Network::YisoSession::SessionId;
-        explicit ChatHandler(Network::YisoSessionManager& manager);
+        // cluster가 있으면 여러 노드가 채팅을 나눠 맡음 (방은 소유 노드에서 처리, 다른 노드 세션에게는 cluster로 전달)
+        ChatHandler(Network::YisoSessionManager& manager, Network::OverloadController& overload, ChatCluster* cluster = nullptr);
 
         void OnConnected(SessionId id);
         void OnDisconnected(SessionId id);
         void OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size);
 
+        ChatFilter& GetFilter() { return filter_; }
+
+        // 무중단 재시작: 방 + 채팅 기록 (금칙어는 새 프로세스가 파일에서 다시 읽음)
+        void ExportHandoff(Network::HandoffWriter& writer) const;
+        bool ImportHandoff(Network::HandoffReader& reader);
+
     private:
         void HandleChat(SessionId id, const uint8_t* data, uint32_t size);
         void HandleWhisper(SessionId id, const uint8_t* data, uint32_t size);
-        void HandleCreateRoom(SessionId id, const uint8_t* data, uint32_t size);
+        void RouteRoomOp(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size); // 소유 노드로 보내거나 바로 실행
+        void ExecuteRoomOp(SessionId id, Network::PacketType type, ChatRoomManager::RoomId roomId, const uint8_t* data, uint32_t size);
+        void HandleCreateRoom(SessionId id, ChatRoomManager::RoomId roomId, const uint8_t* data, uint32_t size);
         void HandleDeleteRoom(SessionId id, const uint8_t* data, uint32_t size);
         void HandleJoinRoom(SessionId id, const uint8_t* data, uint32_t size);
         void HandleLeaveRoom(SessionId id, const uint8_t* data, uint32_t size);
         void HandleRoomChat(SessionId id, const uint8_t* data, uint32_t size);
 
+        // 세션이 어느 노드에 있든 전달 (클러스터 없으면 session_manager_.Send와 같음)
+        void Route(SessionId target, Network::Buffer frame);
+        void RouteMany(const std::vector<SessionId>& targets, const Network::Buffer& frame);
+        void BroadcastGlobal(Network::Buffer frame, bool history); // 이 노드 전체 + 다른 노드로 방송
+        void RemoveFromRooms(SessionId id); // 이 노드가 소유한 방에서 세션 정리 + 남은 멤버에게 알림
+        bool IsOnline(SessionId id);
+
         Network::YisoSessionManager& session_manager_;
+        Network::OverloadController& overload_; // 과부하 단계에 따라 알림/글로벌 채팅 버림, 방 입장 거절
+        ChatCluster* cluster_;
         ChatRoomManager room_manager_;
+        ChatHistory history_;
+        ChatFilter filter_;
     };
 }
@@ -0,0 +1,213 @@
+#include "ChatHistory.h"
+#include "Network/PacketHeader.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    ChatHistory::FrameRing::FrameRing(uint8_t* data, size_t capacity, Entry* entries, size_t maxEntries)
+        : data_(data), capacity_(capacity), entries_(entries), max_entries_(maxEntries)
+    {
+    }
+
+    void ChatHistory::FrameRing::PopFront()
+    {
+        first_ = (first_ + 1) % max_entries_;
+        --count_;
+    }
+
+    void ChatHistory::FrameRing::Clear()
+    {
+        first_ = 0;
+        count_ = 0;
+        write_ = 0;
+    }
+
+    void ChatHistory::FrameRing::Push(const uint8_t* frame, size_t size)
+    {
+        if (size == 0 || size > capacity_)
+            return; // 링 전체보다 큰 프레임은 기록하지 않음
+
+        if (count_ == max_entries_)
+            PopFront();
+
+        size_t pos = write_;
+        if (pos + size > capacity_)
+        {
+            // 끝부분(pos 이후)에 남은 프레임은 전부 가장 오래된 것들 -> 먼저 버리고 0으로 되감기
+            while (count_ > 0 && entries_[first_].offset >= pos)
+                PopFront();
+            pos = 0;
+        }
+
+        // 새로 쓸 구간과 겹치는 오래된 프레임 제거
+        while (count_ > 0)
+        {
+            const Entry& oldest = entries_[first_];
+            bool overlaps = oldest.offset < pos + size && pos < oldest.offset + oldest.size;
+            if (!overlaps) break;
+            PopFront();
+        }
+
+        std::memcpy(data_ + pos, frame, size);
+        entries_[(first_ + count_) % max_entries_] = { static_cast<uint32_t>(pos), static_cast<uint32_t>(size) };
+        ++count_;
+        write_ = pos + size;
+    }
+
+    void ChatHistory::FrameRing::AppendTo(Network::Buffer& out) const
+    {
+        for (size_t i = 0; i < count_; ++i)
+        {
+            const Entry& e = entries_[(first_ + i) % max_entries_];
+            out.insert(out.end(), data_ + e.offset, data_ + e.offset + e.size);
+        }
+    }
+
+    ChatHistory::ChatHistory()
+        // make_unique는 0으로 초기화하면서 페이지를 전부 건드림 -> new[]로 잡아서 실제로 쓰는 세그먼트만 커밋되게
+        : global_data_(new uint8_t[GLOBAL_HISTORY_BYTES]),
+          global_entries_(new FrameRing::Entry[GLOBAL_HISTORY_FRAMES]),
+          global_(global_data_.get(), GLOBAL_HISTORY_BYTES, global_entries_.get(), GLOBAL_HISTORY_FRAMES),
+          arena_(new uint8_t[ARENA_BYTES]),
+          arena_entries_(new FrameRing::Entry[ARENA_SEGMENTS * ROOM_HISTORY_FRAMES])
+    {
+        free_segments_.reserve(ARENA_SEGMENTS);
+        for (size_t i = ARENA_SEGMENTS; i > 0; --i)
+            free_segments_.push_back(i - 1); // 앞쪽 세그먼트부터 꺼내 쓰도록 역순
+    }
+
+    ChatHistory::RoomHistory* ChatHistory::AcquireRoom(RoomId id)
+    {
+        auto it = rooms_.find(id);
+        if (it != rooms_.end())
+        {
+            lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+            return &it->second;
+        }
+
+        size_t segment;
+        if (!free_segments_.empty())
+        {
+            segment = free_segments_.back();
+            free_segments_.pop_back();
+        }
+        else
+        {
+            // 아레나가 가득 참 -> 가장 오래 조용했던 방의 기록을 버리고 세그먼트 회수
+            RoomId victim = lru_.back();
+            auto victimIt = rooms_.find(victim);
+            segment = victimIt->second.segment;
+            lru_.pop_back();
+            rooms_.erase(victimIt);
+            spdlog::debug("[ChatHistory] 아레나 가득 참, room {} 기록 제거", victim);
+        }
+
+        lru_.push_front(id);
+        RoomHistory history{
+            segment,
+            FrameRing(arena_.get() + segment * ROOM_HISTORY_BYTES, ROOM_HISTORY_BYTES,
+                      arena_entries_.get() + segment * ROOM_HISTORY_FRAMES, ROOM_HISTORY_FRAMES),
+            lru_.begin()
+        };
+        return &rooms_.emplace(id, history).first->second;
+    }
+
+    void ChatHistory::AppendGlobal(const Network::Buffer& frame)
+    {
+        std::lock_guard lock(mutex_);
+        global_.Push(frame.data(), frame.size());
+    }
+
+    void ChatHistory::OpenRoom(RoomId id)
+    {
+        std::lock_guard lock(mutex_);
+        open_rooms_.insert(id);
+    }
+
+    void ChatHistory::AppendRoom(RoomId id, const Network::Buffer& frame)
+    {
+        std::lock_guard lock(mutex_);
+        if (open_rooms_.count(id) == 0)
+            return;
+        AcquireRoom(id)->ring.Push(frame.data(), frame.size());
+    }
+
+    void ChatHistory::RemoveRoom(RoomId id)
+    {
+        std::lock_guard lock(mutex_);
+        open_rooms_.erase(id);
+        auto it = rooms_.find(id);
+        if (it == rooms_.end()) return;
+
+        free_segments_.push_back(it->second.segment);
+        lru_.erase(it->second.lru_it);
+        rooms_.erase(it);
+    }
+
+    Network::Buffer ChatHistory::SnapshotGlobal() const
+    {
+        Network::Buffer out;
+        std::lock_guard lock(mutex_);
+        global_.AppendTo(out);
+        return out;
+    }
+
+    Network::Buffer ChatHistory::SnapshotRoom(RoomId id) const
+    {
+        Network::Buffer out;
+        std::lock_guard lock(mutex_);
+        auto it = rooms_.find(id);
+        if (it != rooms_.end())
+            it->second.ring.AppendTo(out);
+        return out;
+    }
+
+    void ChatHistory::ExportHandoff(Network::HandoffWriter& writer) const
+    {
+        std::lock_guard lock(mutex_);
+        Network::Buffer frames;
+        global_.AppendTo(frames);
+        writer.PutBytes(frames.data(), frames.size());
+
+        writer.Put(static_cast<uint32_t>(lru_.size()));
+        for (auto it = lru_.rbegin(); it != lru_.rend(); ++it)
+        {
+            frames.clear();
+            rooms_.at(*it).ring.AppendTo(frames);
+            writer.Put(*it);
+            writer.PutBytes(frames.data(), frames.size());
+        }
+    }
+
+    bool ChatHistory::ImportHandoff(Network::HandoffReader& reader)
+    {
+        // 이어붙인 프레임을 하나씩 다시 Append (링 크기 / 아레나 상한은 이쪽 설정대로)
+        auto appendEach = [&reader](auto append)
+        {
+            const uint8_t* data;
+            uint32_t size;
+            if (!reader.GetBytes(data, size)) return;
+            uint32_t offset = 0;
+            while (offset + Network::HEADER_SIZE <= size)
+            {
+                Network::PacketHeader header;
+                std::memcpy(&header, data + offset, Network::HEADER_SIZE);
+                uint32_t frameSize = Network::HEADER_SIZE + header.body_size;
+                if (offset + frameSize > size) break;
+                append(Network::Buffer(data + offset, data + offset + frameSize));
+                offset += frameSize;
+            }
+        };
+
+        appendEach([this](const Network::Buffer& frame) { AppendGlobal(frame); });
+        auto count = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto id = reader.Get<RoomId>();
+            OpenRoom(id); // 보내는 쪽에서 기록이 있던 방 = 그때 존재하던 방
+            appendEach([this, id](const Network::Buffer& frame) { AppendRoom(id, frame); });
+        }
+        return reader.Ok();
+    }
+}
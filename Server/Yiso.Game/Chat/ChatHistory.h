@@ -0,0 +1,103 @@
+#pragma once
+#include "Network/BufferPool.h"
+#include "Network/HotRestart.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 최근 채팅 기록 (인코딩 끝난 S2C 프레임 그대로 보관)
+    // - 방마다 고정 크기 링 버퍼 1개, 글로벌 채팅용 링 버퍼 1개
+    // - 방 링 버퍼는 서버 시작 시 잡아둔 아레나를 세그먼트 단위로 잘라서 씀 -> 방 생성/삭제 시 malloc 없음
+    // - 아레나가 다 차면 가장 오래 안 쓴 방의 기록을 버리고 세그먼트 재사용 -> 서버 전체 메모리 상한 보장
+    class ChatHistory
+    {
+    public:
+        using RoomId = uint32_t;
+
+        ChatHistory();
+
+        void AppendGlobal(const Network::Buffer& frame);
+        // 방 기록은 OpenRoom ~ RemoveRoom 사이에만 쌓임 (삭제 뒤 늦게 온 채팅이 기록을 되살리지 않게)
+        void OpenRoom(RoomId id);
+        void AppendRoom(RoomId id, const Network::Buffer& frame); // 열린 방이 아니면 무시
+        void RemoveRoom(RoomId id);
+
+        // 보관 중인 프레임을 오래된 순서로 이어붙인 버퍼 (그대로 한 번에 write 하면 됨)
+        Network::Buffer SnapshotGlobal() const;
+        Network::Buffer SnapshotRoom(RoomId id) const;
+
+        // 무중단 재시작: 글로벌 + 방 기록 (방은 오래 조용했던 순서로 -> Import 뒤에도 LRU 순서 유지)
+        void ExportHandoff(Network::HandoffWriter& writer) const;
+        bool ImportHandoff(Network::HandoffReader& reader);
+
+        static constexpr size_t ROOM_HISTORY_BYTES = 16 * 1024; // 방 1개당 최대 16kb
+        static constexpr size_t ROOM_HISTORY_FRAMES = 50;
+        static constexpr size_t GLOBAL_HISTORY_BYTES = 64 * 1024;
+        static constexpr size_t GLOBAL_HISTORY_FRAMES = 100;
+        static constexpr size_t ARENA_BYTES = 16 * 1024 * 1024; // 방 기록 전체 상한 16mb
+        static constexpr size_t ARENA_SEGMENTS = ARENA_BYTES / ROOM_HISTORY_BYTES;
+
+    private:
+        // 외부 메모리(data, capacity) 위에서 동작하는 프레임 링 버퍼
+        // 공간이 모자라면 가장 오래된 프레임부터 밀어냄
+        class FrameRing
+        {
+        public:
+            struct Entry
+            {
+                uint32_t offset;
+                uint32_t size;
+            };
+
+            FrameRing() = default;
+            FrameRing(uint8_t* data, size_t capacity, Entry* entries, size_t maxEntries);
+
+            void Push(const uint8_t* frame, size_t size);
+            void Clear();
+            void AppendTo(Network::Buffer& out) const;
+            bool Empty() const { return count_ == 0; }
+
+        private:
+            void PopFront();
+
+            uint8_t* data_ = nullptr;
+            size_t capacity_ = 0;
+            Entry* entries_ = nullptr;
+            size_t max_entries_ = 0;
+
+            size_t first_ = 0; // 가장 오래된 entry 인덱스
+            size_t count_ = 0;
+            size_t write_ = 0; // 다음 프레임 기록 위치 (byte offset)
+        };
+
+        struct RoomHistory
+        {
+            size_t segment;
+            FrameRing ring;
+            std::list<RoomId>::iterator lru_it;
+        };
+
+        RoomHistory* AcquireRoom(RoomId id);
+
+        mutable std::mutex mutex_;
+
+        std::unique_ptr<uint8_t[]> global_data_;
+        std::unique_ptr<FrameRing::Entry[]> global_entries_;
+        FrameRing global_;
+
+        std::unique_ptr<uint8_t[]> arena_; // ARENA_SEGMENTS * ROOM_HISTORY_BYTES
+        std::unique_ptr<FrameRing::Entry[]> arena_entries_; // ARENA_SEGMENTS * ROOM_HISTORY_FRAMES
+        std::vector<size_t> free_segments_;
+
+        std::unordered_set<RoomId> open_rooms_; // 존재하는 방 (기록은 아레나가 차면 밀려나도 방은 남음)
+        std::unordered_map<RoomId, RoomHistory> rooms_;
+        std::list<RoomId> lru_; // front = 가장 최근에 채팅이 있었던 방
+    };
+}
@@ -0,0 +1,178 @@
+#include "ChatRelay.h"
+#include "Network/PacketHeader.h"
+#include "Network/WireFormat.h"
+#include <cstring>
+
+namespace Yiso::Game::ChatRelay
+{
+    namespace
+    {
+        using namespace Network::Wire;
+
+        // LEN 필드 본문(길이 varint 이후)을 읽음 -> 범위 검사 포함
+        bool ReadLengthDelimited(const uint8_t*& p, const uint8_t* end, std::string_view& out)
+        {
+            uint64_t len;
+            size_t n = ReadVarint(p, end, len);
+            if (n == 0) return false;
+            p += n;
+            if (len > static_cast<uint64_t>(end - p)) return false;
+            out = { reinterpret_cast<const char*>(p), static_cast<size_t>(len) };
+            p += len;
+            return true;
+        }
+
+        // [헤더][payload] 프레임 공간 확보 후 payload 시작 포인터 반환
+        uint8_t* BeginFrame(RelayFrame& relay, Network::PacketType type, size_t payloadSize)
+        {
+            Network::PacketHeader header;
+            header.body_size = static_cast<uint32_t>(payloadSize);
+            header.type = static_cast<uint16_t>(type);
+
+            relay.frame.resize(Network::HEADER_SIZE + payloadSize);
+            std::memcpy(relay.frame.data(), &header, Network::HEADER_SIZE);
+            return relay.frame.data() + Network::HEADER_SIZE;
+        }
+
+        // proto3 기본값(0)은 직렬화하지 않음 -> protobuf 직렬화 결과와 바이트 단위로 동일
+        size_t VarintFieldSize(uint32_t value)
+        {
+            return value != 0 ? 1 + VarintSize(value) : 0;
+        }
+
+        size_t StringFieldSize(std::string_view value)
+        {
+            return !value.empty() ? 1 + VarintSize(value.size()) + value.size() : 0;
+        }
+
+        uint8_t* WriteVarintField(uint8_t* p, uint32_t field, uint32_t value)
+        {
+            if (value == 0) return p;
+            *p++ = static_cast<uint8_t>(MakeTag(field, WIRE_VARINT));
+            return p + WriteVarint(p, value);
+        }
+
+        uint8_t* WriteStringField(uint8_t* p, uint32_t field, std::string_view value, RelayFrame& relay)
+        {
+            relay.message_size = static_cast<uint32_t>(value.size());
+            if (value.empty())
+            {
+                relay.message_offset = static_cast<uint32_t>(p - relay.frame.data());
+                return p;
+            }
+            *p++ = static_cast<uint8_t>(MakeTag(field, WIRE_LEN));
+            p += WriteVarint(p, value.size());
+            relay.message_offset = static_cast<uint32_t>(p - relay.frame.data());
+            std::memcpy(p, value.data(), value.size());
+            return p + value.size();
+        }
+    }
+
+    bool TryParseChat(const uint8_t* data, uint32_t size, std::string_view& message)
+    {
+        // C2S_Chat { string message = 1; }
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        message = {};
+        while (p < end)
+        {
+            uint64_t tag;
+            size_t n = ReadVarint(p, end, tag);
+            if (n == 0) return false;
+            p += n;
+
+            if (tag != MakeTag(1, WIRE_LEN)) return false;
+            if (!ReadLengthDelimited(p, end, message)) return false; // 같은 필드가 반복되면 마지막 값 (proto3 규칙)
+        }
+        return true;
+    }
+
+    bool TryParseRoomChat(const uint8_t* data, uint32_t size, uint32_t& roomId, std::string_view& message)
+    {
+        // C2S_RoomChat { uint32 room_id = 1; string message = 2; }
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        roomId = 0;
+        message = {};
+        while (p < end)
+        {
+            uint64_t tag;
+            size_t n = ReadVarint(p, end, tag);
+            if (n == 0) return false;
+            p += n;
+
+            if (tag == MakeTag(1, WIRE_VARINT))
+            {
+                uint64_t value;
+                n = ReadVarint(p, end, value);
+                if (n == 0) return false;
+                p += n;
+                roomId = static_cast<uint32_t>(value); // uint32 필드는 하위 32비트만 사용 (protobuf와 동일)
+            }
+            else if (tag == MakeTag(2, WIRE_LEN))
+            {
+                if (!ReadLengthDelimited(p, end, message)) return false;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool TryParseRoomId(const uint8_t* data, uint32_t size, uint32_t& roomId)
+    {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        roomId = 0;
+        while (p < end)
+        {
+            uint64_t tag;
+            size_t n = ReadVarint(p, end, tag);
+            if (n == 0) return false;
+            p += n;
+
+            if (tag == MakeTag(1, WIRE_VARINT))
+            {
+                uint64_t value;
+                n = ReadVarint(p, end, value);
+                if (n == 0) return false;
+                p += n;
+                roomId = static_cast<uint32_t>(value);
+            }
+            else if ((tag & 0x7) == WIRE_LEN)
+            {
+                std::string_view skipped;
+                if (!ReadLengthDelimited(p, end, skipped)) return false;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    RelayFrame MakeChatFrame(uint32_t sessionId, std::string_view message)
+    {
+        // S2C_Chat { uint32 session_id = 1; string message = 2; }
+        RelayFrame relay;
+        uint8_t* p = BeginFrame(relay, Network::PacketType::S2C_CHAT, VarintFieldSize(sessionId) + StringFieldSize(message));
+        p = WriteVarintField(p, 1, sessionId);
+        WriteStringField(p, 2, message, relay);
+        return relay;
+    }
+
+    RelayFrame MakeRoomChatFrame(uint32_t roomId, uint32_t fromSessionId, std::string_view message)
+    {
+        // S2C_RoomChat { uint32 room_id = 1; uint32 from_session_id = 2; string message = 3; }
+        RelayFrame relay;
+        uint8_t* p = BeginFrame(relay, Network::PacketType::S2C_ROOM_CHAT,
+                                VarintFieldSize(roomId) + VarintFieldSize(fromSessionId) + StringFieldSize(message));
+        p = WriteVarintField(p, 1, roomId);
+        p = WriteVarintField(p, 2, fromSessionId);
+        WriteStringField(p, 3, message, relay);
+        return relay;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Network/BufferPool.h"
+#include <cstdint>
+#include <string_view>
+
+namespace Yiso::Game
+{
+    // 채팅 중계 빠른 경로
+    // C2S -> S2C 변환은 세션/방 ID 필드 추가뿐이라 protobuf 객체를 만들지 않고
+    // 와이어 포맷만 검증한 뒤 새 varint 필드 + 원본 message 바이트를 그대로 이어붙여 S2C 프레임을 만든다.
+    namespace ChatRelay
+    {
+        struct RelayFrame
+        {
+            Network::Buffer frame; // 헤더 포함 S2C 프레임
+            uint32_t message_offset = 0; // frame 안에서 message 바이트 시작 위치 (필터가 그 자리에서 가림)
+            uint32_t message_size = 0;
+
+            char* MessageData() { return reinterpret_cast<char*>(frame.data() + message_offset); }
+            std::string_view Message() const
+            {
+                return { reinterpret_cast<const char*>(frame.data() + message_offset), message_size };
+            }
+        };
+
+        // 알려진 필드만 있는 정상 와이어 포맷이면 true
+        // (알 수 없는 필드 / 잘린 버퍼 등은 false -> 호출자가 protobuf 파싱으로 처리)
+        bool TryParseChat(const uint8_t* data, uint32_t size, std::string_view& message);
+        bool TryParseRoomChat(const uint8_t* data, uint32_t size, uint32_t& roomId, std::string_view& message);
+        // 방 요청(C2S_DeleteRoom / JoinRoom / LeaveRoom / RoomChat) 공통 room_id = 1만 꺼냄 (다른 LEN 필드는 건너뜀)
+        bool TryParseRoomId(const uint8_t* data, uint32_t size, uint32_t& roomId);
+
+        RelayFrame MakeChatFrame(uint32_t sessionId, std::string_view message); // S2C_Chat
+        RelayFrame MakeRoomChatFrame(uint32_t roomId, uint32_t fromSessionId, std::string_view message); // S2C_RoomChat
+    }
+}
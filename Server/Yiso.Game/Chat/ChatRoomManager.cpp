@@ -1,4 +1,5 @@
 #include "ChatRoomManager.h"
+#include "Network/Tracer.h"
 
 namespace Yiso::Game
 {
@@ -15,11 +16,23 @@ namespace Yiso::Game
         return it != rooms_.end() ? &it->second : nullptr;
     }
 
-    ChatRoomManager::RoomId ChatRoomManager::CreateRoom(SessionId creator, const std::string& name)
+    void ChatRoomManager::SetIdSpace(RoomId first, RoomId stride)
     {
-        std::lock_guard lock(mutex_);
+        next_id_.store(first);
+        id_stride_ = stride;
+    }
+
+    ChatRoomManager::RoomId ChatRoomManager::NextId()
+    {
+        return next_id_.fetch_add(id_stride_);
+    }
+
+    bool ChatRoomManager::CreateRoom(RoomId id, SessionId creator, const std::string& name)
+    {
+        Network::TracedLockGuard lock(mutex_);
 
-        RoomId id = next_id_++;
+        if (rooms_.count(id) > 0)
+            return false;
 
         Room newRoom;
         newRoom.owner = creator;
@@ -29,12 +42,12 @@ namespace Yiso::Game
 
         rooms_.insert(std::make_pair(id, std::move(newRoom)));
 
-        return id;
+        return true;
     }
 
     ChatRoomManager::RoomOperatorResult ChatRoomManager::TryRemoveRoom(RoomId id, SessionId requester)
     {
-        std::lock_guard lock(mutex_);
+        Network::TracedLockGuard lock(mutex_);
 
         const Room* room = FindRoom(id);
         if (!room)
@@ -52,7 +65,7 @@ namespace Yiso::Game
 
     ChatRoomManager::RoomOperatorResult ChatRoomManager::TryJoinRoom(RoomId id, SessionId session)
     {
-        std::lock_guard lock(mutex_);
+        Network::TracedLockGuard lock(mutex_);
 
         Room* room = FindRoom(id);
         if (!room)
@@ -70,7 +83,7 @@ namespace Yiso::Game
 
     ChatRoomManager::RoomOperatorResult ChatRoomManager::TryLeaveRoom(RoomId id, SessionId session)
     {
-        std::lock_guard lock(mutex_);
+        Network::TracedLockGuard lock(mutex_);
 
         Room* room = FindRoom(id);
         if (!room)
@@ -84,7 +97,7 @@ namespace Yiso::Game
             SessionId owner = room->owner;
             rooms_.erase(id);
 
-            return { true, {}, std::move(members), owner };
+            return { true, {}, std::move(members), owner, true };
         }
 
         // 퇴장 전 스냅샷
@@ -112,7 +125,7 @@ namespace Yiso::Game
 
     std::vector<ChatRoomManager::RoomChangeInfo> ChatRoomManager::RemoveSession(SessionId session)
     {
-        std::lock_guard lock(mutex_);
+        Network::TracedLockGuard lock(mutex_);
         std::vector<RoomChangeInfo> changes;
         std::vector<RoomId> emptyRooms;
 
@@ -141,18 +154,73 @@ namespace Yiso::Game
         }
 
         for (auto roomId : emptyRooms)
+        {
             rooms_.erase(roomId);
+            changes.push_back({ roomId, 0, {}, true });
+        }
 
         return changes;
     }
 
     std::vector<ChatRoomManager::SessionId> ChatRoomManager::GetMembers(RoomId id) const
     {
-        std::lock_guard lock(mutex_);
+        Network::TracedLockGuard lock(mutex_);
 
         const Room* room = FindRoom(id);
         if (!room) return {};
 
         return std::vector<SessionId>(room->members.begin(), room->members.end());
     }
+
+    std::vector<ChatRoomManager::RoomId> ChatRoomManager::GetRoomIds() const
+    {
+        Network::TracedLockGuard lock(mutex_);
+
+        std::vector<RoomId> ids;
+        ids.reserve(rooms_.size());
+        for (const auto& [id, room] : rooms_)
+            ids.push_back(id);
+        return ids;
+    }
+
+    void ChatRoomManager::ExportHandoff(Network::HandoffWriter& writer) const
+    {
+        Network::TracedLockGuard lock(mutex_);
+        writer.Put(next_id_.load());
+        writer.Put(id_stride_);
+        writer.Put(static_cast<uint32_t>(rooms_.size()));
+        for (const auto& [id, room] : rooms_)
+        {
+            writer.Put(id);
+            writer.PutString(room.name);
+            writer.Put(room.owner);
+            writer.Put(static_cast<uint32_t>(room.join_order.size()));
+            for (SessionId member : room.join_order)
+                writer.Put(member);
+        }
+    }
+
+    bool ChatRoomManager::ImportHandoff(Network::HandoffReader& reader)
+    {
+        Network::TracedLockGuard lock(mutex_);
+        next_id_.store(reader.Get<uint32_t>());
+        id_stride_ = reader.Get<RoomId>();
+        auto count = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto id = reader.Get<RoomId>();
+            Room room;
+            room.name = reader.GetString();
+            room.owner = reader.Get<SessionId>();
+            auto members = reader.Get<uint32_t>();
+            for (uint32_t j = 0; j < members && reader.Ok(); ++j)
+            {
+                auto member = reader.Get<SessionId>();
+                room.members.insert(member);
+                room.join_order.push_back(member);
+            }
+            rooms_[id] = std::move(room);
+        }
+        return reader.Ok();
+    }
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include "Network/YisoSession.h"
+#include "Network/HotRestart.h"
 #include <atomic>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <string>
@@ -21,6 +23,7 @@ namespace Yiso::Game
             std::string error;
             std::vector<SessionId> members;
             SessionId new_owner;
+            bool room_removed = false; // 마지막 멤버가 나가서 방이 삭제됨
         };
 
         struct RoomChangeInfo
@@ -28,14 +31,24 @@ namespace Yiso::Game
             RoomId room_id;
             SessionId new_owner;
             std::vector<SessionId> members; // 남은 멤버 (알림 대상)
+            bool room_removed = false; // 남은 멤버가 없어 방이 삭제됨 (members 비어 있음)
         };
 
-        RoomId CreateRoom(SessionId creator, const std::string& name);
+        // 방 ID = first + k * stride (여러 노드가 방을 만들 때 ID가 겹치지 않게, 기본은 1, 2, 3, ...)
+        void SetIdSpace(RoomId first, RoomId stride);
+        RoomId NextId();
+
+        bool CreateRoom(RoomId id, SessionId creator, const std::string& name); // 이미 있는 ID면 false
         RoomOperatorResult TryRemoveRoom(RoomId id, SessionId requester);
         RoomOperatorResult TryJoinRoom(RoomId id, SessionId session);
         RoomOperatorResult TryLeaveRoom(RoomId id, SessionId session);
         std::vector<RoomChangeInfo> RemoveSession(SessionId session); // disconnect 시 모든 방에서 제거
         std::vector<SessionId> GetMembers(RoomId id) const;
+        std::vector<RoomId> GetRoomIds() const;
+
+        // 무중단 재시작: 방 목록 + 다음 방 ID (Import는 빈 매니저에)
+        void ExportHandoff(Network::HandoffWriter& writer) const;
+        bool ImportHandoff(Network::HandoffReader& reader);
 
     private:
         struct Room
@@ -52,5 +65,6 @@ namespace Yiso::Game
         mutable std::mutex mutex_;
         std::map<RoomId, Room> rooms_;
         std::atomic<uint32_t> next_id_{1};
+        RoomId id_stride_ = 1;
     };
 }
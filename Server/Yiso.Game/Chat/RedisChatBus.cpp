@@ -0,0 +1,325 @@
+#include "RedisChatBus.h"
+#include <charconv>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        // data[pos..]에서 "\r\n" 위치 (없으면 -1)
+        long FindLineEnd(const uint8_t* data, size_t size, size_t pos)
+        {
+            for (size_t i = pos; i + 1 < size; ++i)
+                if (data[i] == '\r' && data[i + 1] == '\n')
+                    return static_cast<long>(i);
+            return -1;
+        }
+
+        bool ParseInt(const uint8_t* begin, const uint8_t* end, long& out)
+        {
+            auto result = std::from_chars(reinterpret_cast<const char*>(begin), reinterpret_cast<const char*>(end), out);
+            return result.ec == std::errc() && result.ptr == reinterpret_cast<const char*>(end);
+        }
+
+        // 값 하나 (배열 제외): 다음 위치 반환 (0 = 덜 옴, -1 = 잘못된 형식)
+        long ParseElement(const uint8_t* data, size_t size, size_t pos, std::string_view& out, bool& error)
+        {
+            if (pos >= size) return 0;
+            long lineEnd = FindLineEnd(data, size, pos + 1);
+            if (lineEnd < 0) return 0;
+
+            const char* text = reinterpret_cast<const char*>(data);
+            switch (data[pos])
+            {
+            case '-':
+                error = true;
+                [[fallthrough]];
+            case '+':
+            case ':':
+                out = std::string_view(text + pos + 1, static_cast<size_t>(lineEnd) - pos - 1);
+                return lineEnd + 2;
+            case '$':
+            {
+                long length;
+                if (!ParseInt(data + pos + 1, data + lineEnd, length)) return -1;
+                if (length < 0)
+                {
+                    out = {}; // null bulk
+                    return lineEnd + 2;
+                }
+                size_t begin = static_cast<size_t>(lineEnd) + 2;
+                if (begin + static_cast<size_t>(length) + 2 > size) return 0;
+                out = std::string_view(text + begin, static_cast<size_t>(length));
+                return static_cast<long>(begin + static_cast<size_t>(length) + 2);
+            }
+            default:
+                return -1;
+            }
+        }
+    }
+
+    long RedisChatBus::ParseReply(const uint8_t* data, size_t size, std::vector<std::string_view>& parts, bool& error)
+    {
+        parts.clear();
+        error = false;
+        if (size == 0) return 0;
+
+        if (data[0] != '*')
+        {
+            std::string_view value;
+            long next = ParseElement(data, size, 0, value, error);
+            if (next > 0)
+                parts.push_back(value);
+            return next;
+        }
+
+        long lineEnd = FindLineEnd(data, size, 1);
+        if (lineEnd < 0) return 0;
+        long count;
+        if (!ParseInt(data + 1, data + lineEnd, count)) return -1;
+
+        long pos = lineEnd + 2;
+        for (long i = 0; i < count; ++i)
+        {
+            std::string_view value;
+            pos = ParseElement(data, size, static_cast<size_t>(pos), value, error);
+            if (pos <= 0) return pos;
+            parts.push_back(value);
+        }
+        return pos;
+    }
+
+    RedisChatBus::RedisChatBus(boost::asio::io_context& io, std::string host, uint16_t port)
+        : io_(io),
+          host_(std::move(host)),
+          port_(port),
+          sub_(io),
+          pub_(io)
+    {
+    }
+
+    RedisChatBus::~RedisChatBus()
+    {
+        boost::system::error_code ignored;
+        sub_.socket.close(ignored);
+        pub_.socket.close(ignored);
+    }
+
+    bool RedisChatBus::Start(const std::vector<std::string>& channels, OnMessage onMessage)
+    {
+        boost::system::error_code ec;
+        boost::asio::ip::tcp::resolver resolver(io_);
+        auto results = resolver.resolve(host_, std::to_string(port_), ec);
+        if (ec)
+        {
+            spdlog::error("[Redis] {}:{} 주소 해석 실패: {}", host_, port_, ec.message());
+            return false;
+        }
+        for (const auto& entry : results)
+            endpoints_.push_back(entry.endpoint());
+
+        channels_ = channels;
+        on_message_ = std::move(onMessage);
+        Connect(sub_);
+        Connect(pub_);
+        spdlog::info("[Redis] {}:{} 채팅 버스 시작 (채널 {}개)", host_, port_, channels_.size());
+        return true;
+    }
+
+    void RedisChatBus::Stop()
+    {
+        boost::asio::post(io_, [this]()
+        {
+            stopping_ = true;
+            for (Link* link : { &sub_, &pub_ })
+            {
+                boost::system::error_code ignored;
+                link->retry_timer.cancel();
+                link->socket.close(ignored);
+                link->connected = false;
+            }
+        });
+    }
+
+    void RedisChatBus::Publish(const std::string& channel, Network::Buffer payload)
+    {
+        Network::Buffer command;
+        AppendCommand(command, { "PUBLISH", channel, std::string_view(reinterpret_cast<const char*>(payload.data()), payload.size()) });
+        size_t payloadSize = payload.size();
+
+        boost::asio::post(io_, [this, command = std::move(command), payloadSize]()
+        {
+            if (stopping_) return;
+            if (!pub_.connected && pub_.out.size() + command.size() > MAX_PENDING_BYTES)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            pub_.out.insert(pub_.out.end(), command.begin(), command.end());
+            published_.fetch_add(1, std::memory_order_relaxed);
+            published_bytes_.fetch_add(payloadSize, std::memory_order_relaxed);
+            if (pub_.connected && !pub_.writing)
+                DoWrite(pub_);
+        });
+    }
+
+    RedisChatBus::Stats RedisChatBus::GetStats() const
+    {
+        Stats stats{};
+        stats.published = published_.load(std::memory_order_relaxed);
+        stats.published_bytes = published_bytes_.load(std::memory_order_relaxed);
+        stats.received = received_.load(std::memory_order_relaxed);
+        stats.received_bytes = received_bytes_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.reconnects = reconnects_.load(std::memory_order_relaxed);
+        stats.errors = errors_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void RedisChatBus::AppendCommand(Network::Buffer& out, const std::vector<std::string_view>& args)
+    {
+        auto append = [&out](std::string_view text) { out.insert(out.end(), text.begin(), text.end()); };
+        append("*" + std::to_string(args.size()) + "\r\n");
+        for (auto arg : args)
+        {
+            append("$" + std::to_string(arg.size()) + "\r\n");
+            append(arg);
+            append("\r\n");
+        }
+    }
+
+    void RedisChatBus::Connect(Link& link)
+    {
+        boost::asio::async_connect(link.socket, endpoints_, [this, &link](boost::system::error_code ec, const auto&)
+        {
+            if (stopping_) return;
+            if (ec)
+            {
+                Fail(link, "접속", ec);
+                return;
+            }
+            OnConnected(link);
+        });
+    }
+
+    void RedisChatBus::OnConnected(Link& link)
+    {
+        link.connected = true;
+        link.in_size = 0;
+        link.socket.set_option(boost::asio::ip::tcp::no_delay(true));
+
+        if (&link == &sub_)
+        {
+            // 구독 연결: 채널 전부 한 번에 SUBSCRIBE (재접속 때도 다시)
+            std::vector<std::string_view> args = { "SUBSCRIBE" };
+            args.insert(args.end(), channels_.begin(), channels_.end());
+            link.out.clear();
+            AppendCommand(link.out, args);
+        }
+        spdlog::info("[Redis] {} 연결 완료", &link == &sub_ ? "구독" : "발행");
+
+        DoRead(link);
+        if (!link.out.empty())
+            DoWrite(link);
+    }
+
+    void RedisChatBus::Fail(Link& link, const char* what, const boost::system::error_code& ec)
+    {
+        if (stopping_) return;
+        spdlog::warn("[Redis] {} 연결 {} 실패: {} ({}초 뒤 재접속)", &link == &sub_ ? "구독" : "발행", what, ec.message(),
+            std::chrono::duration_cast<std::chrono::seconds>(RECONNECT_DELAY).count());
+
+        boost::system::error_code ignored;
+        link.socket.close(ignored);
+        link.connected = false;
+        link.writing = false;
+        link.sending.clear(); // 보내던 명령은 잃음 (Redis pub/sub은 어차피 최대 한 번 전달)
+        reconnects_.fetch_add(1, std::memory_order_relaxed);
+
+        link.retry_timer.expires_after(RECONNECT_DELAY);
+        link.retry_timer.async_wait([this, &link](boost::system::error_code ec)
+        {
+            if (ec || stopping_) return;
+            Connect(link);
+        });
+    }
+
+    void RedisChatBus::DoRead(Link& link)
+    {
+        if (link.in.size() < link.in_size + READ_CHUNK)
+            link.in.resize(link.in_size + READ_CHUNK);
+
+        link.socket.async_read_some(boost::asio::buffer(link.in.data() + link.in_size, link.in.size() - link.in_size),
+            [this, &link](boost::system::error_code ec, size_t bytes)
+            {
+                if (stopping_ || !link.connected) return;
+                if (ec)
+                {
+                    Fail(link, "읽기", ec);
+                    return;
+                }
+                link.in_size += bytes;
+
+                // 완성된 응답을 모두 처리 -> 남은 조각은 앞으로 당김
+                thread_local std::vector<std::string_view> parts;
+                size_t consumed = 0;
+                while (consumed < link.in_size)
+                {
+                    bool error;
+                    long used = ParseReply(link.in.data() + consumed, link.in_size - consumed, parts, error);
+                    if (used == 0) break;
+                    if (used < 0)
+                    {
+                        Fail(link, "응답 파싱", boost::asio::error::invalid_argument);
+                        return;
+                    }
+                    OnReply(link, parts, error);
+                    consumed += static_cast<size_t>(used);
+                }
+                if (consumed > 0)
+                {
+                    std::memmove(link.in.data(), link.in.data() + consumed, link.in_size - consumed);
+                    link.in_size -= consumed;
+                }
+                DoRead(link);
+            });
+    }
+
+    void RedisChatBus::OnReply(Link& link, const std::vector<std::string_view>& parts, bool error)
+    {
+        if (error)
+        {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            spdlog::warn("[Redis] 오류 응답: {}", parts.empty() ? std::string_view() : parts.back());
+            return;
+        }
+        if (&link != &sub_ || parts.size() != 3 || parts[0] != "message")
+            return; // PUBLISH 응답(구독자 수) / SUBSCRIBE 확인
+
+        Network::Buffer payload(parts[2].begin(), parts[2].end());
+        received_.fetch_add(1, std::memory_order_relaxed);
+        received_bytes_.fetch_add(payload.size(), std::memory_order_relaxed);
+        on_message_(std::string(parts[1]), std::move(payload));
+    }
+
+    void RedisChatBus::DoWrite(Link& link)
+    {
+        link.sending.swap(link.out); // 쓰는 동안 들어온 발행은 out에 -> 다음 write 한 번에
+        link.out.clear();
+        link.writing = true;
+        boost::asio::async_write(link.socket, boost::asio::buffer(link.sending), [this, &link](boost::system::error_code ec, size_t)
+        {
+            link.writing = false;
+            if (stopping_ || !link.connected) return;
+            if (ec)
+            {
+                Fail(link, "쓰기", ec);
+                return;
+            }
+            link.sending.clear();
+            if (!link.out.empty())
+                DoWrite(link);
+        });
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "ChatBus.h"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <string_view>
+
+namespace Yiso::Game
+{
+    // Redis pub/sub 위의 ChatBus (RESP2 직접 구현, 외부 클라이언트 라이브러리 없음)
+    // - 구독 연결 1개 (SUBSCRIBE 후 push 메시지만 받음) + 발행 연결 1개 (PUBLISH를 파이프라인으로)
+    // - 두 연결 모두 io 스레드에서만 동작, Publish는 post로 넘김
+    // - 끊기면 RECONNECT_DELAY 뒤 재접속 (구독 채널은 다시 SUBSCRIBE), 끊긴 동안 발행은 MAX_PENDING_BYTES까지 보관 후 버림
+    class RedisChatBus : public ChatBus
+    {
+    public:
+        struct Stats
+        {
+            uint64_t published; // PUBLISH 명령 수
+            uint64_t published_bytes; // payload 합
+            uint64_t received;
+            uint64_t received_bytes;
+            uint64_t dropped; // 연결이 없고 보관 한도도 넘어 버린 발행
+            uint64_t reconnects;
+            uint64_t errors; // Redis 오류 응답
+        };
+
+        RedisChatBus(boost::asio::io_context& io, std::string host, uint16_t port);
+        ~RedisChatBus() override;
+
+        bool Start(const std::vector<std::string>& channels, OnMessage onMessage) override;
+        void Stop() override;
+        void Publish(const std::string& channel, Network::Buffer payload) override;
+
+        Stats GetStats() const;
+
+        static constexpr auto RECONNECT_DELAY = std::chrono::seconds(1);
+        static constexpr size_t MAX_PENDING_BYTES = 4 * 1024 * 1024;
+        static constexpr size_t READ_CHUNK = 16 * 1024;
+
+        // RESP 응답 하나 파싱: 단순 문자열 / 오류 / 정수 / bulk 문자열 / (그것들의) 배열 한 단계
+        // 반환: 소비한 바이트 (0 = 아직 덜 옴, -1 = 잘못된 형식), parts에 값들 (오류면 error = true)
+        static long ParseReply(const uint8_t* data, size_t size, std::vector<std::string_view>& parts, bool& error);
+        static void AppendCommand(Network::Buffer& out, const std::vector<std::string_view>& args); // RESP 배열로 명령 하나 추가
+
+    private:
+        // 연결 하나 (구독 / 발행 공용)
+        struct Link
+        {
+            explicit Link(boost::asio::io_context& io) : socket(io), retry_timer(io) {}
+
+            boost::asio::ip::tcp::socket socket;
+            boost::asio::steady_timer retry_timer;
+            bool connected = false;
+            bool writing = false;
+            Network::Buffer in; // 받은 바이트 (in[0..in_size)가 유효)
+            size_t in_size = 0;
+            Network::Buffer out; // 보낼 명령 (write 중이면 그 뒤에 쌓이는 것)
+            Network::Buffer sending;
+        };
+
+        void Connect(Link& link);
+        void OnConnected(Link& link);
+        void Fail(Link& link, const char* what, const boost::system::error_code& ec);
+        void DoRead(Link& link);
+        void DoWrite(Link& link);
+        void OnReply(Link& link, const std::vector<std::string_view>& parts, bool error);
+
+        boost::asio::io_context& io_;
+        std::string host_;
+        uint16_t port_;
+        std::vector<boost::asio::ip::tcp::endpoint> endpoints_;
+        std::vector<std::string> channels_;
+        OnMessage on_message_;
+        bool stopping_ = false;
+
+        Link sub_;
+        Link pub_;
+
+        std::atomic<uint64_t> published_{0};
+        std::atomic<uint64_t> published_bytes_{0};
+        std::atomic<uint64_t> received_{0};
+        std::atomic<uint64_t> received_bytes_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> reconnects_{0};
+        std::atomic<uint64_t> errors_{0};
+    };
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <cstdint>
+
+namespace Yiso::Game::Content
+{
+    // 맵/챕터 콘텐츠 바이너리 포맷 (Yiso.ContentPacker가 생성, 서버가 mmap으로 읽기 전용 매핑)
+    //
+    // [FileHeader][섹션들 ...]
+    // - 모든 정수는 리틀 엔디언, 모든 섹션은 4바이트 정렬
+    // - 레코드 배열은 id 오름차순 정렬 (이진 탐색)
+    // - 문자열(template_key / addressable_key / chapter_name)은 문자열 테이블에 한 번만 저장하고 인덱스로 참조
+    // - 레코드는 POD라 파일 위의 바이트를 그대로 구조체로 읽음 -> 로드 시 힙 복사 없음
+    constexpr uint32_t CONTENT_MAGIC = 0x544E4359; // "YCNT"
+    constexpr uint32_t CONTENT_VERSION = 1;
+    constexpr uint32_t NO_STRING = UINT32_MAX;
+
+    enum Section : uint32_t
+    {
+        SECTION_STRING_REFS = 0, // StringRef[]
+        SECTION_STRING_DATA,     // char[] (UTF-8, NUL 없음)
+        SECTION_MAPS,            // MapRecord[]
+        SECTION_NPCS,            // NpcRecord[]
+        SECTION_REACTORS,        // ReactorRecord[]
+        SECTION_SPAWNERS,        // SpawnerRecord[]
+        SECTION_SPAWNER_ENEMY_IDS, // uint32_t[]
+        SECTION_ENEMIES,         // EnemyRecord[]
+        SECTION_PORTALS,         // PortalRecord[]
+        SECTION_CHAPTERS,        // ChapterRecord[]
+        SECTION_FIELD_MAP_IDS,   // uint32_t[]
+        SECTION_COUNT
+    };
+
+#pragma pack(push, 4)
+    struct SectionEntry
+    {
+        uint32_t offset; // 파일 시작 기준
+        uint32_t count;  // 원소 개수 (STRING_DATA는 바이트 수)
+    };
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t file_size;
+        uint32_t reserved;
+        SectionEntry sections[SECTION_COUNT];
+    };
+
+    struct StringRef
+    {
+        uint32_t offset; // STRING_DATA 기준
+        uint32_t length;
+    };
+
+    struct Range
+    {
+        uint32_t begin;
+        uint32_t count;
+    };
+
+    struct MapRecord
+    {
+        uint32_t map_id;
+        uint32_t addressable_key; // string index
+        uint32_t map_type;        // yiso::game::MapType
+        float spawn_x;
+        float spawn_y;
+        Range npcs;
+        Range reactors;
+        Range spawners;
+        Range enemies;
+        Range portals;
+    };
+
+    struct NpcRecord
+    {
+        uint32_t npc_id;
+        uint32_t template_key;
+        float x;
+        float y;
+        uint32_t active;
+    };
+
+    struct ReactorRecord
+    {
+        uint32_t object_id;
+        uint32_t reactor_id;
+        uint32_t template_key;
+        float x;
+        float y;
+        uint32_t active;
+    };
+
+    struct SpawnerRecord
+    {
+        uint32_t spawner_id;
+        uint32_t template_key;
+        float x;
+        float y;
+        uint32_t active;
+        Range enemy_ids; // SPAWNER_ENEMY_IDS 기준
+    };
+
+    struct EnemyRecord
+    {
+        uint32_t enemy_id;
+        uint32_t template_key;
+        float x;
+        float y;
+        uint32_t active;
+    };
+
+    struct PortalRecord
+    {
+        uint32_t connect_map_id;
+        uint32_t template_key;
+        float x;
+        float y;
+        uint32_t state; // yiso::game::PortalState
+    };
+
+    struct ChapterRecord
+    {
+        uint32_t chapter_id;
+        uint32_t chapter_name; // string index
+        uint32_t recommended_stat;
+        uint32_t town_map_id;
+        Range field_map_ids; // FIELD_MAP_IDS 기준
+        uint32_t boss_area_map_id;
+        uint32_t boss_reward_skill_id;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(FileHeader) == 16 + 8 * SECTION_COUNT, "FileHeader layout");
+    static_assert(sizeof(MapRecord) == 60, "MapRecord layout");
+    static_assert(sizeof(SpawnerRecord) == 28, "SpawnerRecord layout");
+    static_assert(sizeof(ChapterRecord) == 32, "ChapterRecord layout");
+}
@@ -0,0 +1,231 @@
+#include "ContentStore.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    using namespace Content;
+
+    namespace
+    {
+        constexpr size_t SECTION_ELEMENT_SIZE[SECTION_COUNT] = {
+            sizeof(StringRef),
+            1,
+            sizeof(MapRecord),
+            sizeof(NpcRecord),
+            sizeof(ReactorRecord),
+            sizeof(SpawnerRecord),
+            sizeof(uint32_t),
+            sizeof(EnemyRecord),
+            sizeof(PortalRecord),
+            sizeof(ChapterRecord),
+            sizeof(uint32_t),
+        };
+
+        template<typename T>
+        const T* FindById(const T* records, uint32_t count, uint32_t id, uint32_t T::* key)
+        {
+            const T* end = records + count;
+            const T* it = std::lower_bound(records, end, id, [key](const T& r, uint32_t v) { return r.*key < v; });
+            return (it != end && (*it).*key == id) ? it : nullptr;
+        }
+
+        void SetPosition(yiso::common::Vector2* position, float x, float y)
+        {
+            position->set_x(x);
+            position->set_y(y);
+        }
+    }
+
+    bool ContentStore::Open(const std::filesystem::path& path)
+    {
+        namespace bip = boost::interprocess;
+        try
+        {
+            file_ = bip::file_mapping(path.string().c_str(), bip::read_only);
+            region_ = bip::mapped_region(file_, bip::read_only);
+        }
+        catch (const bip::interprocess_exception& e)
+        {
+            spdlog::warn("[Content] 콘텐츠 파일 매핑 실패: {} ({})", path.string(), e.what());
+            return false;
+        }
+
+        const auto* base = static_cast<const uint8_t*>(region_.get_address());
+        const size_t size = region_.get_size();
+        const auto* header = reinterpret_cast<const FileHeader*>(base);
+
+        if (size < sizeof(FileHeader) || header->magic != CONTENT_MAGIC)
+        {
+            spdlog::error("[Content] 콘텐츠 파일 형식 아님: {}", path.string());
+            return false;
+        }
+        if (header->version != CONTENT_VERSION)
+        {
+            spdlog::error("[Content] 콘텐츠 버전 불일치: file={} server={} ({})", header->version, CONTENT_VERSION, path.string());
+            return false;
+        }
+        if (header->file_size != size)
+        {
+            spdlog::error("[Content] 콘텐츠 파일 크기 불일치 (잘린 파일?): header={} actual={}", header->file_size, size);
+            return false;
+        }
+        for (uint32_t s = 0; s < SECTION_COUNT; ++s)
+        {
+            const auto& entry = header->sections[s];
+            uint64_t end = static_cast<uint64_t>(entry.offset) + static_cast<uint64_t>(entry.count) * SECTION_ELEMENT_SIZE[s];
+            if (entry.offset % 4 != 0 || end > size)
+            {
+                spdlog::error("[Content] 섹션 {} 범위 오류 (offset={}, count={})", s, entry.offset, entry.count);
+                return false;
+            }
+        }
+
+        base_ = base;
+        header_ = header;
+        spdlog::info("[Content] {} 매핑 완료 (maps={}, chapters={}, strings={}, {} bytes)", path.string(),
+            header->sections[SECTION_MAPS].count, header->sections[SECTION_CHAPTERS].count,
+            header->sections[SECTION_STRING_REFS].count, size);
+        return true;
+    }
+
+    std::string_view ContentStore::GetString(uint32_t index) const
+    {
+        uint32_t refCount, dataSize;
+        const auto* refs = Records<StringRef>(SECTION_STRING_REFS, refCount);
+        const auto* data = Records<char>(SECTION_STRING_DATA, dataSize);
+        if (index >= refCount) return {};
+
+        const StringRef& ref = refs[index];
+        if (ref.offset > dataSize || ref.length > dataSize - ref.offset) return {};
+        return { data + ref.offset, ref.length };
+    }
+
+    const MapRecord* ContentStore::FindMap(uint32_t mapId) const
+    {
+        if (!IsOpen()) return nullptr;
+        uint32_t count;
+        const auto* maps = Records<MapRecord>(SECTION_MAPS, count);
+        return FindById(maps, count, mapId, &MapRecord::map_id);
+    }
+
+    const ChapterRecord* ContentStore::FindChapter(uint32_t chapterId) const
+    {
+        if (!IsOpen()) return nullptr;
+        uint32_t count;
+        const auto* chapters = Records<ChapterRecord>(SECTION_CHAPTERS, count);
+        return FindById(chapters, count, chapterId, &ChapterRecord::chapter_id);
+    }
+
+    bool ContentStore::LoadMap(uint32_t mapId, yiso::game::S2C_MapData& out)
+    {
+        const MapRecord* map = FindMap(mapId);
+        if (!map) return false;
+
+        const auto* npcs = Slice<NpcRecord>(SECTION_NPCS, map->npcs);
+        const auto* reactors = Slice<ReactorRecord>(SECTION_REACTORS, map->reactors);
+        const auto* spawners = Slice<SpawnerRecord>(SECTION_SPAWNERS, map->spawners);
+        const auto* enemies = Slice<EnemyRecord>(SECTION_ENEMIES, map->enemies);
+        const auto* portals = Slice<PortalRecord>(SECTION_PORTALS, map->portals);
+        if (!npcs || !reactors || !spawners || !enemies || !portals)
+        {
+            spdlog::error("[Content] map {} 레코드 범위 오류", mapId);
+            return false;
+        }
+
+        out.set_map_id(map->map_id);
+        out.set_addressable_key(std::string(GetString(map->addressable_key)));
+        out.set_map_type(static_cast<yiso::game::MapType>(map->map_type));
+        SetPosition(out.mutable_spawn_position(), map->spawn_x, map->spawn_y);
+
+        for (uint32_t i = 0; i < map->npcs.count; ++i)
+        {
+            const auto& r = npcs[i];
+            auto* npc = out.add_npcs();
+            npc->set_npc_id(r.npc_id);
+            npc->set_template_key(std::string(GetString(r.template_key)));
+            SetPosition(npc->mutable_position(), r.x, r.y);
+            npc->set_active(r.active != 0);
+        }
+        for (uint32_t i = 0; i < map->reactors.count; ++i)
+        {
+            const auto& r = reactors[i];
+            auto* reactor = out.add_reactors();
+            reactor->set_object_id(r.object_id);
+            reactor->set_reactor_id(r.reactor_id);
+            reactor->set_template_key(std::string(GetString(r.template_key)));
+            SetPosition(reactor->mutable_position(), r.x, r.y);
+            reactor->set_active(r.active != 0);
+        }
+        for (uint32_t i = 0; i < map->spawners.count; ++i)
+        {
+            const auto& r = spawners[i];
+            const auto* enemyIds = Slice<uint32_t>(SECTION_SPAWNER_ENEMY_IDS, r.enemy_ids);
+            if (!enemyIds)
+            {
+                spdlog::error("[Content] map {} spawner {} enemy_ids 범위 오류", mapId, r.spawner_id);
+                return false;
+            }
+            auto* spawner = out.add_spawners();
+            spawner->set_spawner_id(r.spawner_id);
+            spawner->set_template_key(std::string(GetString(r.template_key)));
+            SetPosition(spawner->mutable_position(), r.x, r.y);
+            spawner->set_active(r.active != 0);
+            spawner->mutable_enemy_ids()->Add(enemyIds, enemyIds + r.enemy_ids.count);
+        }
+        for (uint32_t i = 0; i < map->enemies.count; ++i)
+        {
+            const auto& r = enemies[i];
+            auto* enemy = out.add_enemies();
+            enemy->set_enemy_id(r.enemy_id);
+            enemy->set_template_key(std::string(GetString(r.template_key)));
+            SetPosition(enemy->mutable_position(), r.x, r.y);
+            enemy->set_active(r.active != 0);
+        }
+        for (uint32_t i = 0; i < map->portals.count; ++i)
+        {
+            const auto& r = portals[i];
+            auto* portal = out.add_portals();
+            portal->set_connect_map_id(r.connect_map_id);
+            portal->set_template_key(std::string(GetString(r.template_key)));
+            SetPosition(portal->mutable_position(), r.x, r.y);
+            portal->set_state(static_cast<yiso::game::PortalState>(r.state));
+        }
+        return true;
+    }
+
+    bool ContentStore::LoadChapter(uint32_t chapterId, yiso::game::S2C_ChapterInfo& out) const
+    {
+        const ChapterRecord* chapter = FindChapter(chapterId);
+        if (!chapter) return false;
+
+        const auto* fieldMapIds = Slice<uint32_t>(SECTION_FIELD_MAP_IDS, chapter->field_map_ids);
+        if (!fieldMapIds)
+        {
+            spdlog::error("[Content] chapter {} field_map_ids 범위 오류", chapterId);
+            return false;
+        }
+
+        out.set_chapter_id(chapter->chapter_id);
+        out.set_chapter_name(std::string(GetString(chapter->chapter_name)));
+        out.set_recommended_stat(chapter->recommended_stat);
+        out.set_town_map_id(chapter->town_map_id);
+        out.mutable_field_map_ids()->Add(fieldMapIds, fieldMapIds + chapter->field_map_ids.count);
+        out.set_boss_area_map_id(chapter->boss_area_map_id);
+        out.set_boss_reward_skill_id(chapter->boss_reward_skill_id);
+        return true;
+    }
+
+    void ContentStore::LoadChapters(std::vector<yiso::game::S2C_ChapterInfo>& out)
+    {
+        if (!IsOpen()) return;
+        uint32_t count;
+        const auto* chapters = Records<ChapterRecord>(SECTION_CHAPTERS, count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            yiso::game::S2C_ChapterInfo chapter;
+            if (LoadChapter(chapters[i].chapter_id, chapter))
+                out.push_back(std::move(chapter));
+        }
+    }
+}
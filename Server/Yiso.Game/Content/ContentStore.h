@@ -0,0 +1,53 @@
+#pragma once
+#include "ContentFormat.h"
+#include "Map/MapContentSource.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace Yiso::Game
+{
+    // Yiso.ContentPacker가 만든 콘텐츠 파일을 읽기 전용 mmap으로 열고 레코드를 제자리에서 읽음
+    // - Open은 헤더/섹션 경계만 검사 -> 콘텐츠 크기와 무관하게 시작 시간 일정, 실제로 읽은 페이지만 RSS에 올라감
+    // - 레코드 안의 인덱스/범위는 읽는 시점에 검사
+    class ContentStore : public MapContentSource
+    {
+    public:
+        bool Open(const std::filesystem::path& path);
+        bool IsOpen() const { return base_ != nullptr; }
+
+        bool LoadMap(uint32_t mapId, yiso::game::S2C_MapData& out) override;
+        bool LoadChapter(uint32_t chapterId, yiso::game::S2C_ChapterInfo& out) const;
+        void LoadChapters(std::vector<yiso::game::S2C_ChapterInfo>& out) override;
+
+        const Content::MapRecord* FindMap(uint32_t mapId) const;
+        const Content::ChapterRecord* FindChapter(uint32_t chapterId) const;
+        std::string_view GetString(uint32_t index) const;
+
+        template<typename T>
+        const T* Records(Content::Section section, uint32_t& count) const
+        {
+            const auto& entry = header_->sections[section];
+            count = entry.count;
+            return reinterpret_cast<const T*>(base_ + entry.offset);
+        }
+
+    private:
+        // 섹션 안의 [range.begin, range.begin + range.count) 구간 (범위 밖이면 nullptr)
+        template<typename T>
+        const T* Slice(Content::Section section, const Content::Range& range) const
+        {
+            uint32_t count;
+            const T* records = Records<T>(section, count);
+            if (range.begin > count || range.count > count - range.begin) return nullptr;
+            return records + range.begin;
+        }
+
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+        const uint8_t* base_ = nullptr;
+        const Content::FileHeader* header_ = nullptr;
+    };
+}
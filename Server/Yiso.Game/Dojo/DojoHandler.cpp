@@ -0,0 +1,101 @@
+#include "DojoHandler.h"
+#include "game_packet.pb.h"
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    DojoHandler::DojoHandler(DojoManager& dojo, MapHandler& map)
+        : dojo_(dojo),
+          map_(map)
+    {
+    }
+
+    void DojoHandler::OnDisconnected(SessionId id)
+    {
+        dojo_.Exit(id); // 도장 안에서 끊기면 인스턴스 반납
+    }
+
+    void DojoHandler::OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        switch (type)
+        {
+        case Network::PacketType::C2S_ENTER_DOJO:
+            HandleEnterDojo(id, data, size);
+            break;
+        case Network::PacketType::C2S_EXIT_DOJO:
+            HandleExitDojo(id, data, size);
+            break;
+        case Network::PacketType::C2S_PLAYER_MOVE:
+            HandlePlayerMove(id, data, size);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void DojoHandler::ReturnAfterHandoff()
+    {
+        auto players = map_.GetPlayersOn(DOJO_MAP_ID);
+        for (SessionId id : players)
+            map_.Warp(id, MapHandler::BASE_CAMP_MAP_ID, false);
+        if (!players.empty())
+            spdlog::info("[Dojo] 인계로 도장 인스턴스가 사라져 {}명을 거점으로 이동", players.size());
+    }
+
+    void DojoHandler::HandleEnterDojo(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_EnterDojo req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Dojo] EnterDojo ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        // 무한 도장은 거점에서만 입장
+        if (map_.GetCurrentMap(id) != MapHandler::BASE_CAMP_MAP_ID)
+        {
+            spdlog::warn("[Dojo] Session {} tried to enter dojo outside base camp", id);
+            return;
+        }
+        // 인스턴스의 첫 웨이브는 도장 맵 스폰 위치 주변에 (Warp도 같은 위치로 보냄)
+        float x = 0.0f, y = 0.0f;
+        map_.GetSpawnPosition(DOJO_MAP_ID, x, y);
+        if (!dojo_.Enter(id, x, y))
+        {
+            spdlog::warn("[Dojo] Session {} enter rejected (already inside or pool exhausted)", id);
+            return;
+        }
+        if (!map_.Warp(id, DOJO_MAP_ID, false))
+        {
+            dojo_.Exit(id);
+            return;
+        }
+        spdlog::info("[Dojo] Session {} entered dojo", id);
+    }
+
+    void DojoHandler::HandleExitDojo(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_ExitDojo req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Dojo] ExitDojo ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        if (!dojo_.Exit(id))
+        {
+            spdlog::warn("[Dojo] Session {} is not in dojo", id);
+            return;
+        }
+        map_.Warp(id, MapHandler::BASE_CAMP_MAP_ID, false);
+    }
+
+    void DojoHandler::HandlePlayerMove(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_PlayerMove req;
+        if (!req.ParseFromArray(data, static_cast<int>(size))) return; // 경고는 MapHandler에서
+
+        // 도장 밖이면 아무것도 하지 않음 (적 추적 기준은 다음 틱 전에 반영)
+        dojo_.Move(id, req.position().x(), req.position().y());
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "Network/YisoSession.h"
+#include "Network/PacketHeader.h"
+#include "Map/MapHandler.h"
+#include "DojoManager.h"
+
+namespace Yiso::Game
+{
+    class DojoHandler
+    {
+    public:
+        using SessionId = Network::YisoSession::SessionId;
+        DojoHandler(DojoManager& dojo, MapHandler& map);
+
+        static constexpr uint32_t DOJO_MAP_ID = 2; // 무한 도장 인스턴스 맵 (콘텐츠 규약)
+
+        void OnDisconnected(SessionId id);
+        void OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size);
+
+        // 무중단 재시작: 인스턴스(적 상태)는 넘기지 않으므로 도장 맵에 있던 플레이어는 거점으로 돌려보냄 (맵 인계 뒤)
+        void ReturnAfterHandoff();
+
+    private:
+        void HandleEnterDojo(SessionId id, const uint8_t* data, uint32_t size);
+        void HandleExitDojo(SessionId id, const uint8_t* data, uint32_t size);
+        void HandlePlayerMove(SessionId id, const uint8_t* data, uint32_t size); // 도장 안이면 인스턴스에 위치 전달
+
+        DojoManager& dojo_;
+        MapHandler& map_;
+    };
+}
@@ -0,0 +1,57 @@
+#include "DojoInstance.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Yiso::Game
+{
+    DojoInstance::DojoInstance()
+        : enemies_(ENEMY_CAPACITY)
+    {
+    }
+
+    void DojoInstance::Reset(uint32_t ownerSessionId, float playerX, float playerY)
+    {
+        owner_ = ownerSessionId;
+        wave_ = 1;
+        ticks_ = 0;
+        elapsed_ = 0.0f;
+        cpu_ns_ = 0;
+        budget_overruns_ = 0;
+        player_x_ = playerX;
+        player_y_ = playerY;
+        enemies_.Clear();
+        SpawnWave();
+    }
+
+    void DojoInstance::Tick(float dt)
+    {
+        ++ticks_;
+        elapsed_ += dt;
+        enemies_.Update(dt, &player_x_, &player_y_, 1);
+        if (ticks_ % WAVE_INTERVAL_TICKS == 0)
+        {
+            ++wave_;
+            SpawnWave();
+        }
+    }
+
+    void DojoInstance::SpawnWave()
+    {
+        // 웨이브마다 2마리씩 늘어남, 플레이어 주변 원형 배치 / 체력 10%씩 증가
+        uint32_t count = std::min(4 + 2 * wave_, ENEMY_CAPACITY - enemies_.UsedCount());
+        float hp = 100.0f * (1.0f + 0.1f * static_cast<float>(wave_ - 1));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(count);
+            enemies_.Spawn(DOJO_ENEMY_ID, EnemyWorld::NO_SPAWNER,
+                           player_x_ + SPAWN_RADIUS * std::cos(angle), player_y_ + SPAWN_RADIUS * std::sin(angle), hp, 0.0f);
+        }
+    }
+
+    void DojoInstance::AccountTick(uint64_t ns, uint64_t budgetNs)
+    {
+        cpu_ns_ += ns;
+        if (ns > budgetNs)
+            ++budget_overruns_;
+    }
+}
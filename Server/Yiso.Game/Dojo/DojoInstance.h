@@ -0,0 +1,50 @@
+#pragma once
+#include "Enemy/EnemyWorld.h"
+#include <cstdint>
+
+namespace Yiso::Game
+{
+    // 무한 도장 세션 하나 (플레이어 1명 전용)
+    // 풀에서 재사용 -> Reset으로 이전 세션 흔적을 모두 지움
+    // Tick은 담당 워커 스레드에서만 호출
+    class DojoInstance
+    {
+    public:
+        static constexpr uint32_t WAVE_INTERVAL_TICKS = 20 * 30; // 30초마다 다음 웨이브 (20Hz 기준)
+        static constexpr uint32_t ENEMY_CAPACITY = 64; // 인스턴스당 동시 적 수 (풀 생성 시 미리 확보)
+        static constexpr uint32_t DOJO_ENEMY_ID = 1; // 도장 적 템플릿
+        static constexpr float SPAWN_RADIUS = 8.0f;
+
+        DojoInstance();
+
+        void Reset(uint32_t ownerSessionId, float playerX, float playerY); // 첫 웨이브는 플레이어 주변에
+        void SetPlayerPosition(float x, float y) { player_x_ = x; player_y_ = y; } // Tick 전에 (적 추적 / 웨이브 배치 기준)
+        void Tick(float dt);
+
+        uint32_t Owner() const { return owner_; }
+        uint32_t Wave() const { return wave_; }
+        uint32_t Ticks() const { return ticks_; }
+        float ElapsedSeconds() const { return elapsed_; }
+        const EnemyWorld& Enemies() const { return enemies_; }
+
+        // CPU 사용량 (스케줄러가 Tick 전후로 측정해서 기록)
+        void AccountTick(uint64_t ns, uint64_t budgetNs);
+        uint64_t CpuNs() const { return cpu_ns_; }
+        uint32_t BudgetOverruns() const { return budget_overruns_; }
+
+    private:
+        void SpawnWave();
+
+        EnemyWorld enemies_;
+        float player_x_ = 0.0f; // 도장 맵 좌표 (이동 패킷으로 갱신)
+        float player_y_ = 0.0f;
+
+        uint32_t owner_ = 0;
+        uint32_t wave_ = 0;
+        uint32_t ticks_ = 0;
+        float elapsed_ = 0.0f;
+
+        uint64_t cpu_ns_ = 0;
+        uint32_t budget_overruns_ = 0;
+    };
+}
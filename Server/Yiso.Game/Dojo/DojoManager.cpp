@@ -0,0 +1,292 @@
+#include "DojoManager.h"
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        void StoreMax(std::atomic<uint64_t>& target, uint64_t value)
+        {
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        uint64_t PackPosition(float x, float y)
+        {
+            uint32_t bits[2];
+            std::memcpy(&bits[0], &x, sizeof(float));
+            std::memcpy(&bits[1], &y, sizeof(float));
+            return (static_cast<uint64_t>(bits[0]) << 32) | bits[1];
+        }
+
+        void UnpackPosition(uint64_t packed, float& x, float& y)
+        {
+            auto bitsX = static_cast<uint32_t>(packed >> 32);
+            auto bitsY = static_cast<uint32_t>(packed);
+            std::memcpy(&x, &bitsX, sizeof(float));
+            std::memcpy(&y, &bitsY, sizeof(float));
+        }
+    }
+
+    DojoManager::DojoManager(size_t capacity, size_t workerCount)
+        : slots_(capacity),
+          shard_load_(std::max<size_t>(workerCount, 1), 0)
+    {
+        free_.reserve(capacity);
+        for (size_t i = capacity; i > 0; --i)
+            free_.push_back(static_cast<uint32_t>(i - 1)); // 앞 슬롯부터 사용
+        owners_.reserve(capacity);
+
+        for (size_t i = 0; i < shard_load_.size(); ++i)
+        {
+            shards_.push_back(std::make_unique<Shard>());
+            shards_.back()->slots.reserve(capacity / shard_load_.size() + 1);
+        }
+    }
+
+    DojoManager::~DojoManager()
+    {
+        Stop();
+    }
+
+    void DojoManager::Start()
+    {
+        if (running_.exchange(true)) return;
+        for (auto& shard : shards_)
+            shard->thread = std::thread([this, s = shard.get(), i = static_cast<uint32_t>(&shard - shards_.data())] { WorkerLoop(*s, i); });
+        spdlog::info("[Dojo] 인스턴스 풀 {}개, 워커 {}개, {}ms 틱", slots_.size(), shards_.size(), TICK_INTERVAL.count());
+    }
+
+    void DojoManager::Stop()
+    {
+        if (!running_.exchange(false)) return;
+        for (auto& shard : shards_)
+        {
+            if (shard->thread.joinable())
+                shard->thread.join();
+        }
+    }
+
+    bool DojoManager::Enter(SessionId id, float x, float y)
+    {
+        std::lock_guard lock(mutex_);
+        if (owners_.count(id) != 0)
+            return false;
+        if (free_.empty())
+            return Reclaim(id, x, y);
+
+        uint32_t slotIndex = free_.back();
+        free_.pop_back();
+        owners_.emplace(id, slotIndex);
+
+        auto shardIndex = static_cast<uint32_t>(std::min_element(shard_load_.begin(), shard_load_.end()) - shard_load_.begin());
+        ++shard_load_[shardIndex];
+
+        // 반납된 슬롯 = 어느 샤드에도 없음 -> 초기화는 배정된 워커가
+        auto& slot = slots_[slotIndex];
+        slot.owner = id;
+        slot.shard = shardIndex;
+        slot.player_position.store(PackPosition(x, y), std::memory_order_relaxed);
+
+        auto& shard = *shards_[shardIndex];
+        std::lock_guard shardLock(shard.mutex);
+        shard.pending_add.push_back(slotIndex);
+        return true;
+    }
+
+    bool DojoManager::Reclaim(SessionId id, float x, float y)
+    {
+        for (uint32_t shardIndex = 0; shardIndex < shards_.size(); ++shardIndex)
+        {
+            auto& shard = *shards_[shardIndex];
+            std::lock_guard shardLock(shard.mutex);
+            if (shard.pending_remove.empty()) continue;
+
+            // 워커가 아직 못 본 퇴장 -> 빼는 대신 새 주인으로 초기화 (슬롯은 같은 샤드에 그대로, owner는 워커가 바꿈)
+            uint32_t slotIndex = shard.pending_remove.back();
+            shard.pending_remove.pop_back();
+            shard.pending_reset.push_back({ slotIndex, id });
+            slots_[slotIndex].player_position.store(PackPosition(x, y), std::memory_order_relaxed);
+            owners_.emplace(id, slotIndex);
+            ++shard_load_[shardIndex];
+            return true;
+        }
+        return false;
+    }
+
+    bool DojoManager::Exit(SessionId id)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = owners_.find(id);
+        if (it == owners_.end())
+            return false;
+
+        uint32_t slotIndex = it->second;
+        owners_.erase(it);
+
+        auto& slot = slots_[slotIndex];
+        --shard_load_[slot.shard];
+
+        auto& shard = *shards_[slot.shard];
+        std::lock_guard shardLock(shard.mutex);
+        shard.pending_remove.push_back(slotIndex);
+        return true;
+    }
+
+    bool DojoManager::Move(SessionId id, float x, float y)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = owners_.find(id);
+        if (it == owners_.end())
+            return false;
+        slots_[it->second].player_position.store(PackPosition(x, y), std::memory_order_relaxed);
+        return true;
+    }
+
+    void DojoManager::ApplyPending(Shard& shard, uint32_t shardIndex)
+    {
+        thread_local std::vector<uint32_t> added;
+        thread_local std::vector<Shard::Reset> reset;
+        thread_local std::vector<uint32_t> removed;
+        {
+            std::lock_guard lock(shard.mutex);
+            if (shard.pending_add.empty() && shard.pending_reset.empty() && shard.pending_remove.empty()) return;
+            added.swap(shard.pending_add);
+            reset.swap(shard.pending_reset);
+            removed.swap(shard.pending_remove);
+        }
+
+        // 같은 틱 사이에 입장 후 바로 퇴장해도 입장을 먼저 반영하므로 슬롯 위치가 있음
+        for (uint32_t slotIndex : added)
+        {
+            auto& slot = slots_[slotIndex];
+            float x, y;
+            UnpackPosition(slot.player_position.load(std::memory_order_relaxed), x, y);
+            slot.instance.Reset(slot.owner, x, y); // owner는 입장 때 기록된 뒤 반납 / 이어 받기 전까지 바뀌지 않음
+            slot.shard_pos = static_cast<uint32_t>(shard.slots.size());
+            shard.slots.push_back(slotIndex);
+        }
+        // 반납 전에 다른 세션이 이어 받은 슬롯 (같은 슬롯이 여러 번이면 넣은 순서대로 주인이 바뀜)
+        for (const auto& [slotIndex, owner] : reset)
+        {
+            auto& slot = slots_[slotIndex];
+            LogExit(slot, shardIndex);
+            slot.owner = owner;
+            float x, y;
+            UnpackPosition(slot.player_position.load(std::memory_order_relaxed), x, y);
+            slot.instance.Reset(slot.owner, x, y);
+        }
+        for (uint32_t slotIndex : removed)
+        {
+            auto& slot = slots_[slotIndex];
+            uint32_t moved = shard.slots.back();
+            shard.slots[slot.shard_pos] = moved;
+            slots_[moved].shard_pos = slot.shard_pos;
+            shard.slots.pop_back();
+            LogExit(slot, shardIndex);
+        }
+
+        // 샤드에서 빠진 뒤에야 반납 -> 다음 입장이 워커가 아직 돌리는 인스턴스를 받지 않음
+        if (!removed.empty())
+        {
+            std::lock_guard lock(mutex_);
+            free_.insert(free_.end(), removed.begin(), removed.end());
+        }
+        added.clear();
+        reset.clear();
+        removed.clear();
+    }
+
+    void DojoManager::LogExit(const Slot& slot, uint32_t shardIndex)
+    {
+        spdlog::info("[Dojo] Session {} 퇴장 (shard={}, wave={}, {:.1f}s, cpu={}us, overruns={})", slot.owner, shardIndex,
+            slot.instance.Wave(), slot.instance.ElapsedSeconds(), slot.instance.CpuNs() / 1000, slot.instance.BudgetOverruns());
+    }
+
+    bool DojoManager::IsInDojo(SessionId id)
+    {
+        std::lock_guard lock(mutex_);
+        return owners_.count(id) != 0;
+    }
+
+    void DojoManager::WorkerLoop(Shard& shard, uint32_t shardIndex)
+    {
+        using Clock = std::chrono::steady_clock;
+        constexpr float dt = std::chrono::duration<float>(TICK_INTERVAL).count();
+
+        auto next = Clock::now() + TICK_INTERVAL;
+        while (running_.load(std::memory_order_relaxed))
+        {
+            std::this_thread::sleep_until(next);
+            auto woke = Clock::now();
+            auto jitterUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(woke - next).count());
+            shard.jitter_sum_us.fetch_add(jitterUs, std::memory_order_relaxed);
+            StoreMax(shard.jitter_max_us, jitterUs);
+
+            ApplyPending(shard, shardIndex);
+
+            // 인스턴스 소요 시간은 대기 목록 반영 뒤부터 (락 대기 / 초기화는 틱 예산에 넣지 않음)
+            uint64_t cpuNs = 0;
+            uint64_t overruns = 0;
+            size_t count = shard.slots.size();
+            auto start = Clock::now();
+            for (uint32_t slotIndex : shard.slots)
+            {
+                auto& slot = slots_[slotIndex];
+                auto& instance = slot.instance;
+                float x, y;
+                UnpackPosition(slot.player_position.load(std::memory_order_relaxed), x, y);
+                instance.SetPlayerPosition(x, y);
+                instance.Tick(dt);
+
+                auto end = Clock::now();
+                auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                instance.AccountTick(ns, TICK_BUDGET_NS);
+                cpuNs += ns;
+                overruns += ns > TICK_BUDGET_NS ? 1 : 0;
+                start = end;
+            }
+
+            shard.ticks.fetch_add(1, std::memory_order_relaxed);
+            shard.instance_ticks.fetch_add(count, std::memory_order_relaxed);
+            shard.instance_cpu_ns.fetch_add(cpuNs, std::memory_order_relaxed);
+            shard.budget_overruns.fetch_add(overruns, std::memory_order_relaxed);
+
+            // 고정 간격 유지: 한 틱 넘게 밀렸으면 밀린 틱은 건너뜀 (따라잡으려고 연속 실행하지 않음)
+            next += TICK_INTERVAL;
+            auto now = Clock::now();
+            while (next <= now)
+            {
+                next += TICK_INTERVAL;
+                shard.skipped_ticks.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    DojoManager::Stats DojoManager::GetStats()
+    {
+        Stats stats{};
+        stats.capacity = slots_.size();
+        stats.workers = shards_.size();
+        {
+            std::lock_guard lock(mutex_);
+            stats.active = owners_.size();
+        }
+
+        uint64_t jitterSum = 0;
+        for (const auto& shard : shards_)
+        {
+            stats.ticks += shard->ticks.load(std::memory_order_relaxed);
+            stats.instance_ticks += shard->instance_ticks.load(std::memory_order_relaxed);
+            stats.instance_cpu_ns += shard->instance_cpu_ns.load(std::memory_order_relaxed);
+            stats.budget_overruns += shard->budget_overruns.load(std::memory_order_relaxed);
+            stats.skipped_ticks += shard->skipped_ticks.load(std::memory_order_relaxed);
+            jitterSum += shard->jitter_sum_us.load(std::memory_order_relaxed);
+            stats.jitter_max_us = std::max(stats.jitter_max_us, shard->jitter_max_us.load(std::memory_order_relaxed));
+        }
+        stats.jitter_avg_us = stats.ticks > 0 ? jitterSum / stats.ticks : 0;
+        return stats;
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "DojoInstance.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 무한 도장 인스턴스 관리
+    // - 인스턴스는 시작 시 capacity만큼 미리 만들어 두고 free list로 재사용 (진입마다 할당 없음)
+    // - 워커 스레드마다 샤드 하나 -> 새 인스턴스는 가장 적게 가진 샤드에 배정
+    // - 워커는 고정 간격(TICK_INTERVAL)으로 깨어나 자기 샤드 인스턴스를 모두 Tick
+    //   -> 인스턴스별 소요 시간을 재서 예산(TICK_BUDGET_NS) 초과 횟수 기록
+    // - 입장 / 퇴장은 샤드의 대기 목록에만 넣고 워커가 틱 사이에 반영 -> 로직 스레드는 틱이 끝나길 기다리지 않음
+    //   (인스턴스 초기화 / 퇴장 기록 / 슬롯 반납도 워커에서 -> 인스턴스는 워커만 만짐)
+    // - 풀이 비어도 워커가 아직 반납하지 않은 퇴장이 있으면 그 슬롯을 이어 받음 -> 퇴장 직후 재입장이 가득 참으로 거절되지 않음
+    class DojoManager
+    {
+    public:
+        using SessionId = uint32_t;
+
+        struct Stats
+        {
+            size_t active;
+            size_t capacity;
+            size_t workers;
+            uint64_t ticks; // 워커 틱 횟수 (전체 워커 합)
+            uint64_t instance_ticks;
+            uint64_t instance_cpu_ns;
+            uint64_t budget_overruns; // 인스턴스 Tick이 예산 초과한 횟수
+            uint64_t skipped_ticks; // 워커가 한 틱 이상 밀려서 건너뛴 횟수
+            uint64_t jitter_avg_us; // 예정 시각 대비 실제 깨어난 시각
+            uint64_t jitter_max_us;
+        };
+
+        static constexpr auto TICK_INTERVAL = std::chrono::milliseconds(50); // 20Hz
+        static constexpr uint64_t TICK_BUDGET_NS = 50'000; // 인스턴스당 틱 예산 (50us)
+
+        DojoManager(size_t capacity, size_t workerCount);
+        ~DojoManager();
+
+        void Start();
+        void Stop();
+
+        bool Enter(SessionId id, float x, float y); // 풀 소진 (반납 대기 포함) / 이미 입장 중이면 false (인스턴스는 다음 틱부터, x/y = 입장 위치)
+        bool Move(SessionId id, float x, float y); // 플레이어 위치 -> 다음 틱 전에 인스턴스에 반영 (입장 중이 아니면 false)
+        bool Exit(SessionId id); // 입장 중이 아니면 false (슬롯은 워커가 샤드에서 뺀 뒤 재사용)
+        bool IsInDojo(SessionId id);
+
+        Stats GetStats();
+
+    private:
+        struct Slot
+        {
+            DojoInstance instance;
+            std::atomic<uint64_t> player_position{0}; // 최신 플레이어 위치 (float x, y를 묶음 -> 워커가 틱 전에 읽음)
+            SessionId owner = 0;
+            uint32_t shard = 0;
+            uint32_t shard_pos = 0; // shard.slots 안 위치 (swap-remove용)
+        };
+
+        struct Shard
+        {
+            struct Reset
+            {
+                uint32_t slot;
+                SessionId owner; // 새 주인 (slot.owner는 워커만 바꿈 -> 틱 중인 인스턴스와 경합 없음)
+            };
+
+            std::mutex mutex; // pending_* 보호 (워커는 틱 사이에 꺼낼 때만 잡음)
+            std::vector<uint32_t> pending_add;
+            std::vector<Reset> pending_reset; // 퇴장 대기 중에 새 주인이 이어 받은 슬롯
+            std::vector<uint32_t> pending_remove;
+
+            std::vector<uint32_t> slots; // 워커 전용
+            std::thread thread;
+
+            std::atomic<uint64_t> ticks{0};
+            std::atomic<uint64_t> instance_ticks{0};
+            std::atomic<uint64_t> instance_cpu_ns{0};
+            std::atomic<uint64_t> budget_overruns{0};
+            std::atomic<uint64_t> skipped_ticks{0};
+            std::atomic<uint64_t> jitter_sum_us{0};
+            std::atomic<uint64_t> jitter_max_us{0};
+        };
+
+        void WorkerLoop(Shard& shard, uint32_t shardIndex);
+        void ApplyPending(Shard& shard, uint32_t shardIndex); // 워커에서, 입장 -> 이어 받기 -> 퇴장 순
+        bool Reclaim(SessionId id, float x, float y); // mutex_ 잡은 채로, 퇴장 대기 슬롯을 새 세션에
+        void LogExit(const Slot& slot, uint32_t shardIndex);
+
+        std::vector<Slot> slots_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+
+        std::mutex mutex_; // free_ / owners_ / shard_load_ / 반납된 Slot의 owner·shard 보호 (락 순서: mutex_ -> shard.mutex)
+        std::vector<uint32_t> free_;
+        std::unordered_map<SessionId, uint32_t> owners_; // session -> slot
+        std::vector<uint32_t> shard_load_; // 샤드별 인스턴스 수 (배정 시 워커 락을 잡지 않도록 따로 관리)
+
+        std::atomic<bool> running_{false};
+    };
+}
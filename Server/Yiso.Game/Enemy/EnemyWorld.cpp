@@ -0,0 +1,237 @@
+#include "EnemyWorld.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YISO_ENEMY_WORLD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        constexpr uint32_t LANES = 4;
+        constexpr float MIN_MOVE_DIST = 1e-4f;
+
+        uint32_t PadToLanes(uint32_t count)
+        {
+            return (count + LANES - 1) & ~(LANES - 1);
+        }
+
+#ifdef YISO_ENEMY_WORLD_SSE2
+        // mask ? b : a
+        inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+        }
+
+        inline __m128i Select(__m128i mask, __m128i a, __m128i b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, b), _mm_andnot_si128(mask, a));
+        }
+#endif
+    }
+
+    EnemyWorld::EnemyWorld(uint32_t capacity)
+        : pos_x_(PadToLanes(capacity)), pos_y_(PadToLanes(capacity)),
+          home_x_(PadToLanes(capacity)), home_y_(PadToLanes(capacity)),
+          hp_(PadToLanes(capacity)), max_hp_(PadToLanes(capacity)),
+          respawn_delay_(PadToLanes(capacity)), respawn_timer_(PadToLanes(capacity)),
+          state_(PadToLanes(capacity), STATE_FREE), spawner_id_(PadToLanes(capacity)), enemy_id_(PadToLanes(capacity)),
+          capacity_(capacity)
+    {
+        free_.reserve(capacity);
+        Clear();
+    }
+
+    void EnemyWorld::Clear()
+    {
+        std::fill(state_.begin(), state_.end(), static_cast<uint32_t>(STATE_FREE));
+        free_.clear();
+        for (uint32_t i = capacity_; i > 0; --i)
+            free_.push_back(i - 1); // 앞 슬롯부터 사용 -> 루프 범위(high_water_) 최소화
+        high_water_ = 0;
+    }
+
+    uint32_t EnemyWorld::Spawn(uint32_t enemyId, uint32_t spawnerId, float x, float y, float maxHp, float respawnDelay)
+    {
+        if (free_.empty())
+            return INVALID_INDEX;
+
+        uint32_t i = free_.back();
+        free_.pop_back();
+        high_water_ = std::max(high_water_, i + 1);
+
+        pos_x_[i] = home_x_[i] = x;
+        pos_y_[i] = home_y_[i] = y;
+        hp_[i] = max_hp_[i] = maxHp;
+        respawn_delay_[i] = respawnDelay;
+        respawn_timer_[i] = 0.0f;
+        state_[i] = STATE_IDLE;
+        spawner_id_[i] = spawnerId;
+        enemy_id_[i] = enemyId;
+        return i;
+    }
+
+    void EnemyWorld::Despawn(uint32_t index)
+    {
+        if (index >= capacity_ || state_[index] == STATE_FREE)
+            return;
+        state_[index] = STATE_FREE;
+        free_.push_back(index);
+    }
+
+    bool EnemyWorld::Damage(uint32_t index, float amount)
+    {
+        if (index >= capacity_ || state_[index] < STATE_IDLE)
+            return false;
+
+        hp_[index] -= amount;
+        if (hp_[index] > 0.0f)
+            return false;
+
+        if (respawn_delay_[index] > 0.0f)
+        {
+            state_[index] = STATE_DEAD;
+            respawn_timer_[index] = respawn_delay_[index];
+        }
+        else
+        {
+            Despawn(index);
+        }
+        return true;
+    }
+
+    uint32_t EnemyWorld::AliveCount() const
+    {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < high_water_; ++i)
+            count += state_[i] >= STATE_IDLE ? 1 : 0;
+        return count;
+    }
+
+    void EnemyWorld::Update(float dt, const float* targetX, const float* targetY, uint32_t targetCount)
+    {
+        // 한 번만 훑음: 4마리 묶음마다 모든 대상과의 거리를 레지스터에서 비교 -> 상태 / 이동 / 리스폰까지 처리 후 저장
+        // 패딩 슬롯은 항상 STATE_FREE -> 4의 배수까지 돌려도 결과에 영향 없음
+        const uint32_t n = PadToLanes(high_water_);
+        float* px = pos_x_.data();
+        float* py = pos_y_.data();
+        const float* hx = home_x_.data();
+        const float* hy = home_y_.data();
+        float* hp = hp_.data();
+        const float* maxHp = max_hp_.data();
+        float* timer = respawn_timer_.data();
+        uint32_t* state = state_.data();
+
+        constexpr float aggroSq = AGGRO_RANGE * AGGRO_RANGE;
+        const float maxStep = MOVE_SPEED * dt;
+
+#ifdef YISO_ENEMY_WORLD_SSE2
+        const __m128 vDt = _mm_set1_ps(dt);
+        const __m128 vZero = _mm_setzero_ps();
+        const __m128 vAggroSq = _mm_set1_ps(aggroSq);
+        const __m128 vMaxStep = _mm_set1_ps(maxStep);
+        const __m128 vMinDist = _mm_set1_ps(MIN_MOVE_DIST);
+        const __m128i vDead = _mm_set1_epi32(STATE_DEAD);
+        const __m128i vIdle = _mm_set1_epi32(STATE_IDLE);
+        const __m128i vOne = _mm_set1_epi32(1);
+
+        for (uint32_t i = 0; i < n; i += LANES)
+        {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + i));
+            __m128 x = _mm_loadu_ps(px + i);
+            __m128 y = _mm_loadu_ps(py + i);
+            __m128 homeX = _mm_loadu_ps(hx + i);
+            __m128 homeY = _mm_loadu_ps(hy + i);
+
+            // 어그로: 범위 안 가장 가까운 대상, 없으면 스폰 위치로 복귀
+            __m128 best = vAggroSq;
+            __m128 goalX = homeX;
+            __m128 goalY = homeY;
+            for (uint32_t t = 0; t < targetCount; ++t)
+            {
+                __m128 tx = _mm_set1_ps(targetX[t]);
+                __m128 ty = _mm_set1_ps(targetY[t]);
+                __m128 dx = _mm_sub_ps(tx, x);
+                __m128 dy = _mm_sub_ps(ty, y);
+                __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+                __m128 closer = _mm_cmplt_ps(d2, best);
+                best = _mm_min_ps(d2, best);
+                goalX = Select(closer, goalX, tx);
+                goalY = Select(closer, goalY, ty);
+            }
+
+            // 살아 있는 적: 상태 갱신 + 목표 방향으로 최대 MOVE_SPEED * dt
+            __m128i alive = _mm_cmpgt_epi32(s, vDead); // IDLE / CHASE
+            __m128i chase = _mm_castps_si128(_mm_cmplt_ps(best, vAggroSq));
+            s = Select(alive, s, _mm_add_epi32(vIdle, _mm_and_si128(chase, vOne)));
+
+            __m128 dx = _mm_sub_ps(goalX, x);
+            __m128 dy = _mm_sub_ps(goalY, y);
+            __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            __m128 scale = _mm_div_ps(_mm_min_ps(vMaxStep, len), _mm_max_ps(len, vMinDist));
+            scale = _mm_and_ps(scale, _mm_and_ps(_mm_castsi128_ps(alive), _mm_cmpgt_ps(len, vMinDist)));
+            x = _mm_add_ps(x, _mm_mul_ps(dx, scale));
+            y = _mm_add_ps(y, _mm_mul_ps(dy, scale));
+
+            // 죽은 적: 리스폰 타이머 감소, 0 이하가 되면 스폰 위치에서 부활 (이동은 다음 틱부터)
+            __m128 dead = _mm_castsi128_ps(_mm_cmpeq_epi32(s, vDead));
+            __m128 t = _mm_sub_ps(_mm_loadu_ps(timer + i), _mm_and_ps(dead, vDt));
+            __m128 revive = _mm_and_ps(dead, _mm_cmple_ps(t, vZero));
+            s = Select(_mm_castps_si128(revive), s, vIdle);
+            x = Select(revive, x, homeX);
+            y = Select(revive, y, homeY);
+
+            _mm_storeu_ps(timer + i, t);
+            _mm_storeu_ps(hp + i, Select(revive, _mm_loadu_ps(hp + i), _mm_loadu_ps(maxHp + i)));
+            _mm_storeu_ps(px + i, x);
+            _mm_storeu_ps(py + i, y);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state + i), s);
+        }
+#else
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            if (state[i] == STATE_DEAD)
+            {
+                timer[i] -= dt;
+                if (timer[i] <= 0.0f)
+                {
+                    hp[i] = maxHp[i];
+                    px[i] = hx[i];
+                    py[i] = hy[i];
+                    state[i] = STATE_IDLE;
+                }
+                continue;
+            }
+            if (state[i] < STATE_IDLE) continue;
+
+            float best = aggroSq;
+            float goalX = hx[i];
+            float goalY = hy[i];
+            for (uint32_t t = 0; t < targetCount; ++t)
+            {
+                const float dx = targetX[t] - px[i];
+                const float dy = targetY[t] - py[i];
+                const float d2 = dx * dx + dy * dy;
+                if (d2 < best)
+                {
+                    best = d2;
+                    goalX = targetX[t];
+                    goalY = targetY[t];
+                }
+            }
+            state[i] = best < aggroSq ? STATE_CHASE : STATE_IDLE;
+
+            const float dx = goalX - px[i];
+            const float dy = goalY - py[i];
+            const float len = std::sqrt(dx * dx + dy * dy);
+            if (len <= MIN_MOVE_DIST) continue;
+            const float scale = std::min(maxStep, len) / len;
+            px[i] += dx * scale;
+            py[i] += dy * scale;
+        }
+#endif
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 적 시뮬레이션 저장소 (필드 / 무한 도장 공용)
+    // 필드별 배열(SoA) -> 틱 루프는 같은 종류 값만 연속으로 읽고 분기 없이 마스크로 계산 (SSE2: 4마리씩)
+    // 슬롯은 생성 시 capacity만큼 확보 (4의 배수로 패딩), 스폰/디스폰은 free list로만 처리 (힙 할당 없음)
+    class EnemyWorld
+    {
+    public:
+        enum State : uint8_t
+        {
+            STATE_FREE = 0, // 빈 슬롯
+            STATE_DEAD = 1, // 스포너 소속 -> 리스폰 대기
+            STATE_IDLE = 2, // 스폰 위치로 복귀 / 대기
+            STATE_CHASE = 3, // 어그로 범위 안 대상 추적
+        };
+
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+        static constexpr uint32_t NO_SPAWNER = 0;
+        static constexpr float AGGRO_RANGE = 6.0f;
+        static constexpr float MOVE_SPEED = 2.5f; // 초당 이동 거리
+
+        explicit EnemyWorld(uint32_t capacity);
+
+        // respawnDelay > 0 이면 죽은 뒤 그 시간 후 스폰 위치에서 부활 (스포너 소속), 0이면 죽으면 바로 슬롯 반환
+        uint32_t Spawn(uint32_t enemyId, uint32_t spawnerId, float x, float y, float maxHp, float respawnDelay);
+        void Despawn(uint32_t index);
+        void Clear();
+
+        bool Damage(uint32_t index, float amount); // 이번 공격으로 죽었으면 true
+
+        // 한 틱: 리스폰 타이머 -> 어그로(가장 가까운 대상) -> 이동
+        void Update(float dt, const float* targetX, const float* targetY, uint32_t targetCount);
+
+        uint32_t Capacity() const { return capacity_; }
+        uint32_t AliveCount() const; // IDLE + CHASE
+        uint32_t UsedCount() const { return Capacity() - static_cast<uint32_t>(free_.size()); }
+
+        State GetState(uint32_t index) const { return static_cast<State>(state_[index]); }
+        float GetX(uint32_t index) const { return pos_x_[index]; }
+        float GetY(uint32_t index) const { return pos_y_[index]; }
+        float GetHp(uint32_t index) const { return hp_[index]; }
+        uint32_t GetEnemyId(uint32_t index) const { return enemy_id_[index]; }
+        uint32_t GetSpawnerId(uint32_t index) const { return spawner_id_[index]; }
+
+    private:
+        // 위치 (Vector2 -> x / y 분리)
+        std::vector<float> pos_x_;
+        std::vector<float> pos_y_;
+        std::vector<float> home_x_;
+        std::vector<float> home_y_;
+
+        std::vector<float> hp_;
+        std::vector<float> max_hp_;
+        std::vector<float> respawn_delay_;
+        std::vector<float> respawn_timer_;
+        std::vector<uint32_t> state_; // float와 같은 폭 -> SIMD 레인 정렬
+        std::vector<uint32_t> spawner_id_;
+        std::vector<uint32_t> enemy_id_;
+
+        uint32_t capacity_;
+        std::vector<uint32_t> free_; // 빈 슬롯 스택
+        uint32_t high_water_ = 0; // 한 번이라도 쓴 슬롯 수 -> 루프 범위
+    };
+}
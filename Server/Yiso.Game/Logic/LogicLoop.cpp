@@ -0,0 +1,255 @@
+#include "LogicLoop.h"
+#include "Network/AllocAccounting.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        void StoreMax(std::atomic<uint64_t>& target, uint64_t value)
+        {
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+    }
+
+    LogicLoop::LogicLoop(size_t partitions, Handlers handlers)
+        : handlers_(std::move(handlers))
+    {
+        partitions = std::max<size_t>(partitions, 1);
+        for (size_t i = 0; i < partitions; ++i)
+            partitions_.push_back(std::make_unique<Partition>());
+    }
+
+    LogicLoop::~LogicLoop()
+    {
+        Stop();
+    }
+
+    void LogicLoop::Start()
+    {
+        for (auto& partition : partitions_)
+            partition->thread = std::thread([this, p = partition.get()]() { Run(*p); });
+        spdlog::info("[Logic] 로직 스레드 {}개 시작", partitions_.size());
+    }
+
+    void LogicLoop::Stop()
+    {
+        if (stopping_.exchange(true)) return;
+        for (auto& partition : partitions_)
+        {
+            {
+                std::lock_guard lock(partition->wake_mutex);
+                partition->sleeping.store(false);
+            }
+            partition->wake_cv.notify_one();
+            if (partition->thread.joinable())
+                partition->thread.join();
+        }
+    }
+
+    void LogicLoop::Drain()
+    {
+        // 파티션마다 Barrier 하나 (파티션 = id % 파티션 수)
+        std::vector<std::promise<void>> done(partitions_.size());
+        for (size_t i = 0; i < partitions_.size(); ++i)
+        {
+            Job job;
+            job.kind = Job::Kind::Barrier;
+            job.id = static_cast<SessionId>(i);
+            job.barrier = &done[i];
+            Post(std::move(job));
+        }
+        for (auto& barrier : done)
+            barrier.get_future().wait();
+    }
+
+    void LogicLoop::PostConnect(SessionId id, const std::string& userId)
+    {
+        Job job;
+        job.kind = Job::Kind::Connect;
+        job.id = id;
+        job.body.assign(userId.begin(), userId.end());
+        Post(std::move(job));
+    }
+
+    bool LogicLoop::PostRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        Job job;
+        job.kind = Job::Kind::Recv;
+        job.id = id;
+        job.type = type;
+        job.body.assign(data, data + size); // 세션의 수신 버퍼는 다음 읽기에 재사용됨
+        job.trace_id = Network::Tracer::Current();
+        return Post(std::move(job), true);
+    }
+
+    void LogicLoop::PostDisconnect(SessionId id)
+    {
+        Job job;
+        job.kind = Job::Kind::Disconnect;
+        job.id = id;
+        Post(std::move(job));
+    }
+
+    void LogicLoop::PostRemote(Network::Buffer batch)
+    {
+        Job job;
+        job.kind = Job::Kind::Remote;
+        job.body = std::move(batch);
+        Post(std::move(job), true); // 채팅 배치 -> 못 따라가면 버려도 세션 상태는 깨지지 않음
+    }
+
+    void LogicLoop::PostTask(SessionId id, std::function<void()> task)
+    {
+        Job job;
+        job.kind = Job::Kind::Task;
+        job.id = id;
+        job.task = std::move(task);
+        Post(std::move(job));
+    }
+
+    bool LogicLoop::Post(Job job, bool bounded)
+    {
+        auto& partition = *partitions_[job.id % partitions_.size()];
+        if (bounded && partition.depth.load(std::memory_order_relaxed) >= MAX_QUEUE_DEPTH)
+        {
+            partition.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        job.posted = std::chrono::steady_clock::now();
+        partition.depth.fetch_add(1, std::memory_order_relaxed);
+        partition.queue.Push(std::move(job));
+
+        // 소비자가 잠들려는 중일 때만 락을 잡음 (평소 경로는 무잠금)
+        if (partition.sleeping.load())
+        {
+            {
+                std::lock_guard lock(partition.wake_mutex);
+                partition.sleeping.store(false);
+            }
+            partition.wake_cv.notify_one();
+        }
+        return true;
+    }
+
+    void LogicLoop::Run(Partition& partition)
+    {
+        Job job;
+        while (true)
+        {
+            size_t count = 0;
+            while (count < MAX_BATCH && partition.queue.Pop(job))
+            {
+                partition.depth.fetch_sub(1, std::memory_order_relaxed);
+                partition.front_posted_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(job.posted.time_since_epoch()).count(), std::memory_order_relaxed);
+                Network::Tracer::Mark(job.trace_id, Network::Tracer::Stage::Dispatch, static_cast<uint16_t>(job.type), job.id);
+                auto waited = std::chrono::steady_clock::now() - job.posted;
+                uint64_t waitedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+                partition.wait_total_ns.fetch_add(waitedNs, std::memory_order_relaxed);
+                StoreMax(partition.wait_max_ns, waitedNs);
+
+                Dispatch(job);
+                ++count;
+            }
+
+            if (count > 0)
+            {
+                partition.jobs.fetch_add(count, std::memory_order_relaxed);
+                partition.batches.fetch_add(1, std::memory_order_relaxed);
+                StoreMax(partition.max_batch, count);
+                continue;
+            }
+            partition.front_posted_ns.store(0, std::memory_order_relaxed);
+
+            if (stopping_.load() && partition.queue.Empty())
+                return;
+
+            // 잠들기: sleeping 표시 후 큐를 다시 확인 -> Post의 push 후 sleeping 확인과 엇갈려도 깨우기 누락 없음
+            partition.sleeping.store(true);
+            if (!partition.queue.Empty() || stopping_.load())
+            {
+                partition.sleeping.store(false);
+                continue;
+            }
+            std::unique_lock lock(partition.wake_mutex);
+            partition.wake_cv.wait_for(lock, IDLE_WAIT, [&partition]() { return !partition.sleeping.load(); });
+            partition.sleeping.store(false);
+        }
+    }
+
+    void LogicLoop::Dispatch(Job& job)
+    {
+        switch (job.kind)
+        {
+        case Job::Kind::Connect:
+        {
+            Network::AllocAccounting::Scope allocScope(Network::AllocAccounting::Event::Connect);
+            handlers_.on_connect(job.id, std::string(job.body.begin(), job.body.end()));
+            break;
+        }
+        case Job::Kind::Recv:
+        {
+            // 핸들러 안에서 보낸 프레임 / 락 대기가 같은 trace로 기록됨
+            Network::Tracer::Scope traceScope(job.trace_id);
+            Network::AllocAccounting::Scope allocScope(job.type); // 계측 빌드에서만 동작
+            auto type = static_cast<uint16_t>(job.type);
+            Network::Tracer::Mark(job.trace_id, Network::Tracer::Stage::HandlerBegin, type, job.id);
+            handlers_.on_recv(job.id, job.type, job.body.data(), static_cast<uint32_t>(job.body.size()));
+            Network::Tracer::Mark(job.trace_id, Network::Tracer::Stage::HandlerEnd, type, job.id);
+            break;
+        }
+        case Job::Kind::Disconnect:
+        {
+            Network::AllocAccounting::Scope allocScope(Network::AllocAccounting::Event::Disconnect);
+            handlers_.on_disconnect(job.id);
+            break;
+        }
+        case Job::Kind::Remote:
+            if (handlers_.on_remote)
+                handlers_.on_remote(job.body.data(), static_cast<uint32_t>(job.body.size()));
+            break;
+        case Job::Kind::Task:
+            job.task();
+            job.task = nullptr; // 잡고 있던 캡처를 바로 해제 (job은 다음 Pop에 재사용)
+            break;
+        case Job::Kind::Barrier:
+            job.barrier->set_value();
+            break;
+        }
+    }
+
+    LogicLoop::Stats LogicLoop::GetStats() const
+    {
+        Stats stats{};
+        stats.partitions = partitions_.size();
+        uint64_t waitTotal = 0;
+        for (const auto& partition : partitions_)
+        {
+            stats.jobs += partition->jobs.load(std::memory_order_relaxed);
+            stats.batches += partition->batches.load(std::memory_order_relaxed);
+            stats.max_batch = std::max(stats.max_batch, partition->max_batch.load(std::memory_order_relaxed));
+            waitTotal += partition->wait_total_ns.load(std::memory_order_relaxed);
+            stats.queue_wait_max_us = std::max(stats.queue_wait_max_us, partition->wait_max_ns.load(std::memory_order_relaxed) / 1000);
+        }
+        stats.queue_wait_avg_us = stats.jobs > 0 ? waitTotal / stats.jobs / 1000 : 0;
+        for (const auto& partition : partitions_)
+            stats.rejected += partition->rejected.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    LogicLoop::Load LogicLoop::GetLoad() const
+    {
+        Load load{};
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        for (const auto& partition : partitions_)
+        {
+            load.queue_depth += static_cast<uint64_t>(std::max<int64_t>(0, partition->depth.load(std::memory_order_relaxed)));
+            int64_t front = partition->front_posted_ns.load(std::memory_order_relaxed);
+            if (front > 0 && now > front)
+                load.oldest_wait_us = std::max(load.oldest_wait_us, static_cast<uint64_t>(now - front) / 1000);
+        }
+        return load;
+    }
+}
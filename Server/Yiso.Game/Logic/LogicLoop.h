@@ -0,0 +1,125 @@
+#pragma once
+#include "MpscQueue.h"
+#include "Network/YisoSession.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 게임 로직 스레드
+    // - io 스레드는 프레임 조립/디코딩까지만 하고 작업을 무잠금 큐에 넣음
+    // - 로직 스레드가 큐를 최대 MAX_BATCH개씩 꺼내 핸들러 호출 -> 핸들러는 io 완료 처리와 경합하지 않음
+    // - 파티션: 세션 ID 기준으로 고정 -> 한 세션의 패킷 순서 유지 (파티션 1개면 모든 로직이 단일 스레드)
+    // - 큐 길이 / 가장 오래 기다린 작업은 GetLoad로 과부하 판정에 (OverloadController::SetLogicProbe)
+    // - 파티션마다 MAX_QUEUE_DEPTH까지: 넘으면 수신 / 원격 배치는 거절 (접속·끊김·작업은 항상 받음 -> 정리가 빠지지 않게)
+    class LogicLoop
+    {
+    public:
+        using SessionId = Network::YisoSession::SessionId;
+
+        struct Handlers
+        {
+            std::function<void(SessionId, const std::string& userId)> on_connect; // 유저 ID: 로그인한 계정 (인증을 끄면 빈 문자열)
+            Network::YisoSession::OnRecv on_recv;
+            std::function<void(SessionId)> on_disconnect;
+            std::function<void(const uint8_t*, uint32_t)> on_remote; // 다른 노드에서 온 채팅 배치 (ChatCluster)
+        };
+
+        struct Stats
+        {
+            size_t partitions;
+            uint64_t jobs;
+            uint64_t batches;
+            uint64_t max_batch;
+            uint64_t queue_wait_avg_us; // Post -> 핸들러 호출까지
+            uint64_t queue_wait_max_us;
+            uint64_t rejected; // 큐가 가득 차 거절한 수신 / 원격 배치
+        };
+
+        struct Load
+        {
+            uint64_t queue_depth; // 모든 파티션 합
+            uint64_t oldest_wait_us; // 처리 중이거나 다음에 꺼낼 작업 중 가장 오래 기다린 것 (Post부터)
+        };
+
+        static constexpr size_t MAX_BATCH = 256;
+        static constexpr auto IDLE_WAIT = std::chrono::milliseconds(10); // 깨우기 누락 대비 안전망
+        static constexpr int64_t MAX_QUEUE_DEPTH = 100000; // 파티션당 (과부하 Critical 기본 임계값보다 위)
+
+        LogicLoop(size_t partitions, Handlers handlers);
+        ~LogicLoop();
+
+        void Start();
+        void Stop(); // 이미 들어온 작업은 모두 처리한 뒤 종료
+        void Drain(); // 지금까지 넣은 작업을 모든 파티션이 처리할 때까지 대기 (Start 뒤, 로직 스레드가 아닌 곳에서)
+
+        // io 스레드에서 호출 (data는 복사됨)
+        void PostConnect(SessionId id, const std::string& userId = {});
+        bool PostRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size); // false = 큐가 가득 참 (호출자가 세션을 끊음)
+        void PostDisconnect(SessionId id);
+        void PostRemote(Network::Buffer batch); // 버스 스레드에서 호출, 항상 파티션 0 (큐가 가득 차면 버림)
+        void PostTask(SessionId id, std::function<void()> task); // 아무 스레드에서나, 그 세션의 파티션에서 실행 (비동기 조회 완료 등)
+
+        Stats GetStats() const;
+        Load GetLoad() const; // 아무 스레드에서나
+
+    private:
+        struct Job
+        {
+            enum class Kind : uint8_t
+            {
+                Connect,
+                Recv,
+                Disconnect,
+                Remote,
+                Task,
+                Barrier, // Drain: 여기까지 처리했음을 알림
+            };
+
+            Kind kind = Kind::Recv;
+            SessionId id = 0;
+            Network::PacketType type = Network::PacketType::UNKNOWN;
+            Network::Buffer body; // 수신 본문 복사본 / 접속이면 유저 ID (io 스레드에서 할당, 로직 스레드에서 해제)
+            std::chrono::steady_clock::time_point posted;
+            uint32_t trace_id = 0; // 샘플된 패킷이면 io 스레드에서 받은 trace
+            std::promise<void>* barrier = nullptr;
+            std::function<void()> task;
+        };
+
+        struct Partition
+        {
+            MpscQueue<Job> queue;
+            std::thread thread;
+
+            std::atomic<bool> sleeping{false};
+            std::mutex wake_mutex;
+            std::condition_variable wake_cv;
+
+            std::atomic<uint64_t> jobs{0};
+            std::atomic<uint64_t> batches{0};
+            std::atomic<uint64_t> max_batch{0};
+            std::atomic<uint64_t> wait_total_ns{0};
+            std::atomic<uint64_t> wait_max_ns{0};
+            std::atomic<uint64_t> rejected{0};
+
+            std::atomic<int64_t> depth{0}; // Post에서 +1, Pop에서 -1
+            std::atomic<int64_t> front_posted_ns{0}; // 처리 중인 작업의 Post 시각 (steady_clock, 0 = 쉬는 중)
+        };
+
+        bool Post(Job job, bool bounded = false); // bounded = 큐가 가득 차면 거절
+        void Run(Partition& partition);
+        void Dispatch(Job& job);
+
+        Handlers handlers_;
+        std::vector<std::unique_ptr<Partition>> partitions_;
+        std::atomic<bool> stopping_{false};
+    };
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <utility>
+
+namespace Yiso::Game
+{
+    // 다중 생산자 / 단일 소비자 무잠금 큐 (Vyukov 방식, 노드 연결 리스트)
+    // - Push: 원자적 exchange 한 번 + store 한 번 -> 생산자끼리 대기 없음
+    // - Pop / Empty: 소비자 스레드 하나에서만 호출
+    // - 생산자가 exchange와 next 연결 사이에 있으면 Pop은 잠깐 false (다음 Pop에서 보임)
+    template<typename T>
+    class MpscQueue
+    {
+    public:
+        MpscQueue()
+            : head_(&stub_),
+              tail_(&stub_)
+        {
+        }
+
+        ~MpscQueue()
+        {
+            T discard;
+            while (Pop(discard)) {}
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        void Push(T value)
+        {
+            PushNode(new Node(std::move(value)));
+        }
+
+        bool Pop(T& out)
+        {
+            Node* tail = tail_;
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &stub_)
+            {
+                if (!next) return false;
+                tail_ = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                tail_ = next;
+                return Take(tail, out);
+            }
+
+            if (tail != head_.load(std::memory_order_acquire))
+                return false; // 생산자가 연결 중
+
+            // 마지막 노드 -> stub을 뒤에 붙여 tail을 넘길 수 있게 함
+            PushNode(&stub_);
+            next = tail->next.load(std::memory_order_acquire);
+            if (!next) return false;
+            tail_ = next;
+            return Take(tail, out);
+        }
+
+        // 소비자 전용. 생산자가 연결 중인 항목도 "비어 있지 않음"으로 봄
+        bool Empty() const
+        {
+            return tail_ == &stub_ && head_.load() == &stub_;
+        }
+
+    private:
+        struct Node
+        {
+            Node() = default;
+            explicit Node(T v) : value(std::move(v)) {}
+
+            std::atomic<Node*> next{nullptr};
+            T value{};
+        };
+
+        void PushNode(Node* node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            Node* prev = head_.exchange(node); // seq_cst -> 소비자의 잠들기 판단과 순서 보장
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        static bool Take(Node* node, T& out)
+        {
+            out = std::move(node->value);
+            delete node;
+            return true;
+        }
+
+        alignas(64) std::atomic<Node*> head_; // 생산자 쪽 (가장 최근 노드)
+        alignas(64) Node* tail_; // 소비자 쪽 (다음에 꺼낼 노드)
+        Node stub_;
+    };
+}
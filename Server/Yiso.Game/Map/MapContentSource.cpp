@@ -0,0 +1,31 @@
+#include "MapContentSource.h"
+#include <google/protobuf/text_format.h>
+#include <fstream>
+#include <sstream>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    TextMapContentSource::TextMapContentSource(std::filesystem::path dir)
+        : dir_(std::move(dir))
+    {
+    }
+
+    bool TextMapContentSource::LoadMap(uint32_t mapId, yiso::game::S2C_MapData& out)
+    {
+        auto path = dir_ / (std::to_string(mapId) + ".txt");
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::stringstream ss;
+        ss << file.rdbuf();
+        if (!google::protobuf::TextFormat::ParseFromString(ss.str(), &out))
+        {
+            spdlog::error("[MapContent] 맵 파일 파싱 실패: {}", path.string());
+            return false;
+        }
+        out.set_map_id(mapId);
+        return true;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "game_packet.pb.h"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 맵 정적 콘텐츠(오브젝트 배치, 기본 활성 상태) 공급자
+    // MapDataService가 캐시 미스 때만 호출 -> 맵당 한 번
+    class MapContentSource
+    {
+    public:
+        virtual ~MapContentSource() = default;
+        virtual bool LoadMap(uint32_t mapId, yiso::game::S2C_MapData& out) = 0;
+        virtual void LoadChapters(std::vector<yiso::game::S2C_ChapterInfo>& out) {} // 챕터 정보가 없는 소스는 비워 둠
+    };
+
+    // <dir>/<map_id>.txt (protobuf text format S2C_MapData) 를 요청 시점에 읽음
+    class TextMapContentSource : public MapContentSource
+    {
+    public:
+        explicit TextMapContentSource(std::filesystem::path dir);
+        bool LoadMap(uint32_t mapId, yiso::game::S2C_MapData& out) override;
+
+    private:
+        std::filesystem::path dir_;
+    };
+}
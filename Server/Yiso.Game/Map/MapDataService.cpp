@@ -0,0 +1,272 @@
+#include "MapDataService.h"
+#include "Network/PacketHeader.h"
+#include "Network/WireFormat.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        using namespace Network::Wire;
+
+        // repeated 메시지 필드 원소 하나 = [태그][길이][본문] -> 그대로 이어붙이면 protobuf 직렬화와 동일
+        void AppendField(std::vector<uint8_t>& out, uint32_t field, const google::protobuf::Message& msg)
+        {
+            std::string body = msg.SerializeAsString();
+            uint8_t head[16];
+            size_t n = WriteVarint(head, MakeTag(field, WIRE_LEN));
+            n += WriteVarint(head + n, body.size());
+            out.insert(out.end(), head, head + n);
+            out.insert(out.end(), body.begin(), body.end());
+        }
+
+        void WriteHeader(uint8_t* dst, size_t payloadSize)
+        {
+            Network::PacketHeader header;
+            header.body_size = static_cast<uint32_t>(payloadSize);
+            header.type = static_cast<uint16_t>(Network::PacketType::S2C_MAP_DATA);
+            std::memcpy(dst, &header, Network::HEADER_SIZE);
+        }
+    }
+
+    MapDataService::MapDataService(MapContentSource& source)
+        : source_(source)
+    {
+    }
+
+    std::shared_ptr<const MapDataService::CachedMap> MapDataService::Build(const yiso::game::S2C_MapData& data)
+    {
+        auto map = std::make_shared<CachedMap>();
+        map->map_type = data.map_type();
+        map->spawn_x = data.spawn_position().x();
+        map->spawn_y = data.spawn_position().y();
+        for (const auto& portal : data.portals())
+            map->portals.push_back({ portal.connect_map_id(), portal.position().x(), portal.position().y() });
+
+        yiso::game::S2C_MapData header = data;
+        header.clear_npcs();
+        header.clear_reactors();
+        header.clear_spawners();
+        header.clear_enemies();
+        header.clear_portals();
+        std::string prefix = header.SerializeAsString();
+        map->prefix.assign(prefix.begin(), prefix.end());
+
+        auto add = [&map](MapObjectKind kind, uint32_t id, uint32_t field, auto object, bool defaultActive, auto setActive)
+        {
+            CachedObject cached{};
+            cached.key = MapObjectStates::MakeKey(kind, id);
+            cached.default_active = defaultActive;
+            for (int active = 0; active < 2; ++active)
+            {
+                setActive(object, active != 0);
+                cached.offset[active] = static_cast<uint32_t>(map->blob.size());
+                AppendField(map->blob, field, object);
+                cached.size[active] = static_cast<uint32_t>(map->blob.size()) - cached.offset[active];
+            }
+            map->index[cached.key] = static_cast<uint32_t>(map->objects.size());
+            map->objects.push_back(cached);
+        };
+
+        for (const auto& npc : data.npcs())
+            add(MapObjectKind::Npc, npc.npc_id(), 5, npc, npc.active(),
+                [](auto& o, bool on) { o.set_active(on); });
+        for (const auto& reactor : data.reactors())
+            add(MapObjectKind::Reactor, reactor.object_id(), 6, reactor, reactor.active(),
+                [](auto& o, bool on) { o.set_active(on); });
+        for (const auto& spawner : data.spawners())
+            add(MapObjectKind::Spawner, spawner.spawner_id(), 7, spawner, spawner.active(),
+                [](auto& o, bool on) { o.set_active(on); });
+        for (const auto& enemy : data.enemies())
+            add(MapObjectKind::Enemy, enemy.enemy_id(), 8, enemy, enemy.active(),
+                [](auto& o, bool on) { o.set_active(on); });
+        for (const auto& portal : data.portals())
+            add(MapObjectKind::Portal, portal.connect_map_id(), 9, portal, portal.state() == yiso::game::PORTAL_STATE_ACTIVE,
+                [](auto& o, bool on) { o.set_state(on ? yiso::game::PORTAL_STATE_ACTIVE : yiso::game::PORTAL_STATE_LOCKED); });
+
+        // 기본 상태 프레임 미리 완성
+        size_t payloadSize = map->prefix.size();
+        for (const auto& object : map->objects)
+            payloadSize += object.size[object.default_active];
+
+        map->default_frame.resize(Network::HEADER_SIZE + payloadSize);
+        uint8_t* p = map->default_frame.data();
+        WriteHeader(p, payloadSize);
+        p += Network::HEADER_SIZE;
+        std::memcpy(p, map->prefix.data(), map->prefix.size());
+        p += map->prefix.size();
+        for (const auto& object : map->objects)
+        {
+            bool active = object.default_active;
+            std::memcpy(p, map->blob.data() + object.offset[active], object.size[active]);
+            p += object.size[active];
+        }
+
+        return map;
+    }
+
+    std::shared_ptr<const MapDataService::CachedMap> MapDataService::Acquire(uint32_t mapId)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            auto it = cache_.find(mapId);
+            if (it != cache_.end())
+            {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
+            }
+            auto missing = missing_.find(mapId);
+            if (missing != missing_.end())
+            {
+                if (missing->second > std::chrono::steady_clock::now())
+                {
+                    negative_hits_.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                missing_.erase(missing);
+            }
+        }
+
+        // 미스: 로드/조립은 락 밖에서 (느린 I/O 동안 다른 맵 조회를 막지 않도록)
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        yiso::game::S2C_MapData data;
+        if (!source_.LoadMap(mapId, data))
+        {
+            load_failures_.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard lock(mutex_);
+            if (missing_.size() >= MAX_MISSING)
+                missing_.clear();
+            missing_[mapId] = std::chrono::steady_clock::now() + MISSING_TTL;
+            return nullptr;
+        }
+        auto built = Build(data);
+
+        std::lock_guard lock(mutex_);
+        auto [it, inserted] = cache_.emplace(mapId, std::move(built)); // 동시에 조립된 경우 먼저 들어간 쪽 사용
+        if (inserted)
+            spdlog::info("[MapData] map {} 캐시 ({} objects, {} bytes)", mapId, it->second->objects.size(), it->second->default_frame.size());
+        return it->second;
+    }
+
+    bool MapDataService::IsActive(const CachedObject& object, const MapObjectStates* states)
+    {
+        if (states)
+        {
+            auto it = states->Entries().find(object.key);
+            if (it != states->Entries().end())
+                return it->second;
+        }
+        return object.default_active;
+    }
+
+    Network::Buffer MapDataService::BuildFrame(uint32_t mapId, const MapObjectStates* states, uint32_t stateVersion, bool prefetch)
+    {
+        auto map = Acquire(mapId);
+        if (!map) return {};
+
+        // state_version(10) / prefetch(11)는 마지막 필드 -> 캐시된 바이트 뒤에 붙이기만 하면 됨
+        size_t trailerSize = (stateVersion != 0 ? 1 + VarintSize(stateVersion) : 0) + (prefetch ? 2 : 0);
+        auto appendTrailer = [stateVersion, prefetch](uint8_t* p)
+        {
+            if (stateVersion != 0)
+            {
+                *p++ = static_cast<uint8_t>(MakeTag(10, WIRE_VARINT));
+                p += WriteVarint(p, stateVersion);
+            }
+            if (prefetch)
+            {
+                *p++ = static_cast<uint8_t>(MakeTag(11, WIRE_VARINT));
+                *p++ = 1;
+            }
+        };
+
+        if (!states || states->Empty())
+        {
+            if (trailerSize == 0)
+                return Network::Buffer(map->default_frame.begin(), map->default_frame.end());
+
+            Network::Buffer frame(map->default_frame.size() + trailerSize);
+            std::memcpy(frame.data(), map->default_frame.data(), map->default_frame.size());
+            WriteHeader(frame.data(), frame.size() - Network::HEADER_SIZE);
+            appendTrailer(frame.data() + map->default_frame.size());
+            return frame;
+        }
+
+        size_t payloadSize = map->prefix.size() + trailerSize;
+        for (const auto& object : map->objects)
+            payloadSize += object.size[IsActive(object, states)];
+
+        Network::Buffer frame(Network::HEADER_SIZE + payloadSize);
+        uint8_t* p = frame.data();
+        WriteHeader(p, payloadSize);
+        p += Network::HEADER_SIZE;
+        std::memcpy(p, map->prefix.data(), map->prefix.size());
+        p += map->prefix.size();
+        for (const auto& object : map->objects)
+        {
+            bool active = IsActive(object, states);
+            std::memcpy(p, map->blob.data() + object.offset[active], object.size[active]);
+            p += object.size[active];
+        }
+        appendTrailer(p);
+        return frame;
+    }
+
+    bool MapDataService::GetMapType(uint32_t mapId, yiso::game::MapType& out)
+    {
+        auto map = Acquire(mapId);
+        if (!map) return false;
+        out = map->map_type;
+        return true;
+    }
+
+    bool MapDataService::GetSpawnPosition(uint32_t mapId, float& x, float& y)
+    {
+        auto map = Acquire(mapId);
+        if (!map) return false;
+        x = map->spawn_x;
+        y = map->spawn_y;
+        return true;
+    }
+
+    bool MapDataService::GetPortals(uint32_t mapId, std::vector<PortalInfo>& out)
+    {
+        auto map = Acquire(mapId);
+        if (!map) return false;
+        out = map->portals;
+        return true;
+    }
+
+    bool MapDataService::IsPortalOpen(uint32_t fromMapId, uint32_t toMapId, const MapObjectStates* states)
+    {
+        auto map = Acquire(fromMapId);
+        if (!map) return false;
+
+        auto it = map->index.find(MapObjectStates::MakeKey(MapObjectKind::Portal, toMapId));
+        if (it == map->index.end()) return false;
+        return IsActive(map->objects[it->second], states);
+    }
+
+    void MapDataService::Invalidate(uint32_t mapId)
+    {
+        std::lock_guard lock(mutex_);
+        cache_.erase(mapId);
+        missing_.erase(mapId);
+    }
+
+    MapDataService::Stats MapDataService::GetStats() const
+    {
+        Stats stats{};
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.load_failures = load_failures_.load(std::memory_order_relaxed);
+        stats.negative_hits = negative_hits_.load(std::memory_order_relaxed);
+
+        std::lock_guard lock(mutex_);
+        stats.cached_maps = cache_.size();
+        for (const auto& [id, map] : cache_)
+            stats.cached_bytes += map->prefix.size() + map->blob.size() + map->default_frame.size();
+        return stats;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "MapContentSource.h"
+#include "Network/BufferPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Yiso::Game
+{
+    enum class MapObjectKind : uint8_t
+    {
+        Npc = 0,
+        Reactor = 1,
+        Spawner = 2,
+        Enemy = 3,
+        Portal = 4,
+    };
+
+    // 플레이어별 맵 오브젝트 상태 (정적 기본값과 다른 것만 보관)
+    // Npc/Reactor/Spawner/Enemy -> active, Portal -> state == PORTAL_STATE_ACTIVE
+    class MapObjectStates
+    {
+    public:
+        static uint64_t MakeKey(MapObjectKind kind, uint32_t id)
+        {
+            return (static_cast<uint64_t>(kind) << 32) | id;
+        }
+
+        void Set(MapObjectKind kind, uint32_t id, bool active) { entries_[MakeKey(kind, id)] = active; }
+        bool Empty() const { return entries_.empty(); }
+        const std::unordered_map<uint64_t, bool>& Entries() const { return entries_; }
+
+    private:
+        std::unordered_map<uint64_t, bool> entries_;
+    };
+
+    // S2C_MapData 캐시
+    // 맵의 정적 콘텐츠는 처음 요청될 때 한 번만 조립 -> 오브젝트마다 활성/비활성 두 가지 인코딩을 미리 만들어 둠
+    // 요청 시에는 플레이어 상태에 맞는 쪽 바이트만 골라 이어붙임 (protobuf 객체 생성 / 직렬화 없음)
+    class MapDataService
+    {
+    public:
+        struct Stats
+        {
+            uint64_t hits;
+            uint64_t misses;
+            uint64_t load_failures;
+            uint64_t negative_hits; // 없는 맵으로 기억해 둔 ID 재조회 (소스를 다시 읽지 않음)
+            size_t cached_maps;
+            size_t cached_bytes;
+        };
+
+        struct PortalInfo
+        {
+            uint32_t connect_map_id;
+            float x;
+            float y;
+        };
+
+        static constexpr auto MISSING_TTL = std::chrono::seconds(30); // 없는 맵 기억 시간 (그 뒤 추가된 콘텐츠는 다시 찾음)
+        static constexpr size_t MAX_MISSING = 4096; // 넘으면 통째로 비움 (임의 ID 폭주 대비)
+
+        explicit MapDataService(MapContentSource& source);
+
+        // 헤더 포함 S2C_MAP_DATA 프레임 (맵이 없으면 빈 vector)
+        // stateVersion != 0 이면 state_version, prefetch면 prefetch 필드를 끝에 덧붙임
+        Network::Buffer BuildFrame(uint32_t mapId, const MapObjectStates* states, uint32_t stateVersion = 0, bool prefetch = false);
+
+        bool GetMapType(uint32_t mapId, yiso::game::MapType& out);
+        bool GetSpawnPosition(uint32_t mapId, float& x, float& y);
+        bool GetPortals(uint32_t mapId, std::vector<PortalInfo>& out); // 포탈 배치 (기본 상태 무관)
+        bool IsPortalOpen(uint32_t fromMapId, uint32_t toMapId, const MapObjectStates* states); // from 맵에 to로 가는 활성 포탈이 있는지
+        void Invalidate(uint32_t mapId); // 콘텐츠 갱신 시 캐시 제거
+        Stats GetStats() const;
+
+    private:
+        struct CachedObject
+        {
+            uint64_t key;
+            uint32_t offset[2]; // [0]=비활성, [1]=활성 인코딩의 blob 내 위치 (필드 태그 + 길이 포함)
+            uint32_t size[2];
+            bool default_active;
+        };
+
+        struct CachedMap
+        {
+            yiso::game::MapType map_type;
+            float spawn_x;
+            float spawn_y;
+            std::vector<PortalInfo> portals;
+            std::vector<uint8_t> prefix; // map_id / addressable_key / map_type / spawn_position 필드
+            std::vector<uint8_t> blob;
+            std::vector<CachedObject> objects; // 필드 순서 유지 (npcs -> reactors -> spawners -> enemies -> portals)
+            std::unordered_map<uint64_t, uint32_t> index; // key -> objects 인덱스
+            std::vector<uint8_t> default_frame; // 상태 변경이 하나도 없는 플레이어용 완성 프레임
+        };
+
+        std::shared_ptr<const CachedMap> Acquire(uint32_t mapId);
+        static std::shared_ptr<const CachedMap> Build(const yiso::game::S2C_MapData& data);
+        static bool IsActive(const CachedObject& object, const MapObjectStates* states);
+
+        MapContentSource& source_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<uint32_t, std::shared_ptr<const CachedMap>> cache_;
+        std::unordered_map<uint32_t, std::chrono::steady_clock::time_point> missing_; // 로드 실패한 맵 ID -> 기억 만료 시각
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> load_failures_{0};
+        std::atomic<uint64_t> negative_hits_{0};
+    };
+}
@@ -0,0 +1,74 @@
+#include "MapGraph.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    MapGraph::MapGraph(MapDataService& map_data)
+        : map_data_(map_data)
+    {
+    }
+
+    void MapGraph::LoadChapters(MapContentSource& source)
+    {
+        std::vector<yiso::game::S2C_ChapterInfo> chapters;
+        source.LoadChapters(chapters);
+
+        std::lock_guard lock(mutex_);
+        for (const auto& chapter : chapters)
+        {
+            // 마을 -> 필드[0] -> 필드[1] ... -> 보스 구역
+            uint32_t previous = chapter.town_map_id();
+            for (uint32_t field : chapter.field_map_ids())
+            {
+                if (previous != 0) forward_.insert(PairKey(previous, field));
+                previous = field;
+            }
+            if (previous != 0 && chapter.boss_area_map_id() != 0)
+                forward_.insert(PairKey(previous, chapter.boss_area_map_id()));
+        }
+        edges_.clear(); // 이미 구성된 간선의 forward 표시 갱신
+        spdlog::info("[MapGraph] chapters={} forward_edges={}", chapters.size(), forward_.size());
+    }
+
+    const std::vector<MapGraph::Edge>* MapGraph::EdgesOf(uint32_t mapId)
+    {
+        auto it = edges_.find(mapId);
+        if (it != edges_.end()) return &it->second;
+
+        // 맵 캐시에 이미 있는 포탈 목록으로 구성 (맵 데이터 전송 경로에서 로드되었으므로 보통 캐시 히트)
+        std::vector<MapDataService::PortalInfo> portals;
+        if (!map_data_.GetPortals(mapId, portals)) return nullptr; // 로드 실패는 기억하지 않음 -> 다음 조회 때 재시도
+
+        std::vector<Edge> edges;
+        edges.reserve(portals.size());
+        for (const auto& portal : portals)
+            edges.push_back({ portal.connect_map_id, portal.x, portal.y, forward_.count(PairKey(mapId, portal.connect_map_id)) != 0 });
+        return &edges_.emplace(mapId, std::move(edges)).first->second;
+    }
+
+    size_t MapGraph::PortalsNear(uint32_t mapId, float x, float y, float radius, std::vector<Edge>& out)
+    {
+        out.clear();
+        std::lock_guard lock(mutex_);
+        const auto* edges = EdgesOf(mapId);
+        if (!edges) return 0;
+
+        const float radiusSq = radius * radius;
+        for (const auto& edge : *edges)
+        {
+            float dx = edge.x - x;
+            float dy = edge.y - y;
+            if (dx * dx + dy * dy <= radiusSq)
+                out.push_back(edge);
+        }
+
+        auto distSq = [x, y](const Edge& e) { return (e.x - x) * (e.x - x) + (e.y - y) * (e.y - y); };
+        std::sort(out.begin(), out.end(), [&distSq](const Edge& a, const Edge& b)
+        {
+            if (a.forward != b.forward) return a.forward;
+            return distSq(a) < distSq(b);
+        });
+        return out.size();
+    }
+}
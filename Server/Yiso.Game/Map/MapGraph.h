@@ -0,0 +1,43 @@
+#pragma once
+#include "MapContentSource.h"
+#include "MapDataService.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 맵 인접 그래프 (프리페치 대상 예측용)
+    // - 간선: 맵의 포탈 (PortalObjectData.connect_map_id + 포탈 위치), 맵이 처음 조회될 때 구성
+    // - 챕터 진행 방향(거점/마을 -> 필드 순서 -> 보스)은 시작 시 챕터 정보에서 읽어 간선에 표시
+    class MapGraph
+    {
+    public:
+        struct Edge
+        {
+            uint32_t to_map_id;
+            float x; // 포탈 위치
+            float y;
+            bool forward; // 챕터 진행 방향 간선
+        };
+
+        explicit MapGraph(MapDataService& map_data);
+
+        void LoadChapters(MapContentSource& source);
+
+        // (x, y) 반경 안 포탈을 진행 방향 우선, 가까운 순으로 out에 채움 (out은 재사용)
+        size_t PortalsNear(uint32_t mapId, float x, float y, float radius, std::vector<Edge>& out);
+
+    private:
+        static uint64_t PairKey(uint32_t from, uint32_t to) { return (static_cast<uint64_t>(from) << 32) | to; }
+        const std::vector<Edge>* EdgesOf(uint32_t mapId); // mutex_ 보유 상태에서 호출, 맵이 없으면 nullptr
+
+        MapDataService& map_data_;
+
+        std::mutex mutex_;
+        std::unordered_map<uint32_t, std::vector<Edge>> edges_;
+        std::unordered_set<uint64_t> forward_;
+    };
+}
@@ -0,0 +1,625 @@
+#include "MapHandler.h"
+#include "Network/PacketCodec.h"
+#include "game_packet.pb.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    MapHandler::MapHandler(Network::YisoSessionManager& manager, MapDataService& map_data, MapGraph& map_graph, PlayerStateStore& player_states, Poster post)
+        : session_manager_(manager),
+          map_data_(map_data),
+          map_graph_(map_graph),
+          player_states_(player_states),
+          post_(std::move(post)),
+          interest_(manager, map_data)
+    {
+    }
+
+    void MapHandler::OnConnected(SessionId id, const std::string& userId)
+    {
+        auto playerId = PlayerId::FromUserId(userId);
+        {
+            std::lock_guard lock(mutex_);
+            auto& context = players_[id];
+            context.player_id = playerId;
+            context.saved.player_id = playerId;
+            context.loading = !playerId.Empty();
+        }
+        if (!playerId.Empty())
+            StartLoad(id, playerId);
+    }
+
+    void MapHandler::StartLoad(SessionId id, const PlayerId& playerId)
+    {
+        // 잠금 밖에서 (캐시 적중이면 done이 바로 불림) -> 결과는 그 세션의 로직 스레드로
+        player_states_.Load(playerId, [this, id](bool found, const PlayerState& state)
+        {
+            post_(id, [this, id, found, state]() { OnPlayerLoaded(id, found, state); });
+        });
+    }
+
+    void MapHandler::OnPlayerLoaded(SessionId id, bool found, const PlayerState& state)
+    {
+        std::vector<std::pair<Network::PacketType, std::vector<uint8_t>>> deferred;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = players_.find(id);
+            if (it == players_.end() || !it->second.loading) return; // 조회 중에 끊김
+            auto& context = it->second;
+            if (found)
+                context.saved = state;
+            context.loading = false;
+            deferred.swap(context.deferred);
+        }
+        for (const auto& [type, body] : deferred)
+            Dispatch(id, type, body.data(), static_cast<uint32_t>(body.size()));
+    }
+
+    void MapHandler::OnDisconnected(SessionId id)
+    {
+        interest_.Leave(id);
+        PlayerState state{};
+        PlayerId playerId{};
+        bool save = false;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = players_.find(id);
+            if (it == players_.end()) return;
+            playerId = it->second.player_id;
+            save = it->second.position_dirty && !playerId.Empty();
+            state = it->second.saved;
+            players_.erase(it);
+        }
+        if (save)
+            player_states_.Update(state); // 마지막 실제 위치
+        if (!playerId.Empty())
+            player_states_.Release(playerId); // 저장이 끝나면 캐시에서 빠짐
+    }
+
+    void MapHandler::OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        switch (type)
+        {
+        case Network::PacketType::C2S_REQUEST_MAP_DATA:
+        case Network::PacketType::C2S_CHANGE_MAP:
+        case Network::PacketType::C2S_ACK_MAP_STATE:
+        case Network::PacketType::C2S_PLAYER_INFO:
+        case Network::PacketType::C2S_RETREAT_TO_BASE_CAMP:
+        case Network::PacketType::C2S_PLAYER_MOVE:
+            break;
+        default:
+            return; // 맵 패킷이 아님 (잠금 없이)
+        }
+        if (Defer(id, type, data, size)) return;
+        Dispatch(id, type, data, size);
+    }
+
+    bool MapHandler::Defer(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = players_.find(id);
+        if (it == players_.end() || !it->second.loading) return false;
+
+        auto& deferred = it->second.deferred;
+        if (deferred.size() >= MAX_DEFERRED_PACKETS)
+        {
+            spdlog::warn("[Map] Session {} sent too many packets while loading, dropped type {}", id, static_cast<uint16_t>(type));
+            return true;
+        }
+        deferred.emplace_back(type, std::vector<uint8_t>(data, data + size));
+        return true;
+    }
+
+    void MapHandler::Dispatch(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size)
+    {
+        switch (type)
+        {
+        case Network::PacketType::C2S_REQUEST_MAP_DATA:
+            HandleRequestMapData(id, data, size);
+            break;
+        case Network::PacketType::C2S_CHANGE_MAP:
+            HandleChangeMap(id, data, size);
+            break;
+        case Network::PacketType::C2S_ACK_MAP_STATE:
+            HandleAckMapState(id, data, size);
+            break;
+        case Network::PacketType::C2S_PLAYER_INFO:
+            HandlePlayerInfo(id, data, size);
+            break;
+        case Network::PacketType::C2S_RETREAT_TO_BASE_CAMP:
+            HandleRetreatToBaseCamp(id, data, size);
+            break;
+        case Network::PacketType::C2S_PLAYER_MOVE:
+            HandlePlayerMove(id, data, size);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void MapHandler::HandleRequestMapData(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_RequestMapData req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Map] RequestMapData ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        // 맵 데이터 로드(캐시 미스면 파일 I/O)는 잠금 밖에서 먼저 -> 잠금 안에서는 캐시 적중만
+        yiso::game::MapType mapType;
+        if (!map_data_.GetMapType(req.map_id(), mapType))
+        {
+            spdlog::warn("[Map] Session {} requested unknown map {}", id, req.map_id());
+            return;
+        }
+
+        // 프리로드: 플레이어 위치는 바꾸지 않고 데이터만 내려줌
+        // 들어간 적 없는 맵은 기본 상태 그대로 (요청만으로 상태 로그를 만들지 않음)
+        Network::Buffer frame;
+        {
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end()) return;
+            auto& states = player->second.states;
+            if (auto it = states.find(req.map_id()); it != states.end())
+                frame = BuildSnapshot(req.map_id(), it->second);
+            else
+                frame = map_data_.BuildFrame(req.map_id(), nullptr);
+        }
+
+        if (frame.empty()) return; // 그 사이 Invalidate
+        session_manager_.Send(id, std::move(frame));
+    }
+
+    void MapHandler::HandleChangeMap(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_ChangeMap req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Map] ChangeMap ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        // 대상 맵 로드는 잠금 밖에서 (현재 맵은 들어갈 때 이미 캐시됨)
+        yiso::game::MapType targetType;
+        if (!map_data_.GetMapType(req.map_id(), targetType))
+        {
+            spdlog::warn("[Map] Session {} tried to change to unknown map {}", id, req.map_id());
+            return;
+        }
+
+        Network::Buffer frame;
+        {
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end()) return;
+            auto& context = player->second;
+            const MapObjectStates* currentStates = nullptr;
+            if (auto it = context.states.find(context.map_id); it != context.states.end())
+                currentStates = &it->second.States();
+
+            // 전환 유효성 검사
+            // - 도보/포탈: 현재 맵에 대상 맵으로 가는 활성 포탈이 있어야 함
+            //   첫 진입은 저장된 마지막 맵(접속 때 읽어 둔 상태)이나 마을 / 거점으로만 (보스 맵 등으로 바로 들어가지 못하게)
+            // - 귀환 주문서/메뉴: 마을 또는 거점으로만 이동 가능
+            bool townOrCamp = targetType == yiso::game::MAP_TYPE_BASE_CAMP || targetType == yiso::game::MAP_TYPE_CHAPTER_TOWN;
+            switch (req.transition_type())
+            {
+            case yiso::game::MAP_TRANSITION_WALK:
+            case yiso::game::MAP_TRANSITION_PORTAL:
+                if (context.map_id == 0)
+                {
+                    if (req.map_id() != context.saved.map_id && !townOrCamp)
+                    {
+                        spdlog::warn("[Map] Session {} cannot enter map {} first (saved={})", id, req.map_id(), context.saved.map_id);
+                        return;
+                    }
+                }
+                else if (!map_data_.IsPortalOpen(context.map_id, req.map_id(), currentStates))
+                {
+                    spdlog::warn("[Map] Session {} has no open portal {} -> {}", id, context.map_id, req.map_id());
+                    return;
+                }
+                break;
+            case yiso::game::MAP_TRANSITION_SCROLL:
+            case yiso::game::MAP_TRANSITION_MENU:
+                if (!townOrCamp)
+                {
+                    spdlog::warn("[Map] Session {} cannot warp to map {} (type={})", id, req.map_id(), static_cast<int>(targetType));
+                    return;
+                }
+                break;
+            default:
+                spdlog::warn("[Map] Session {} sent unknown transition type {}", id, static_cast<int>(req.transition_type()));
+                return;
+            }
+
+            // 검사를 통과해 실제로 들어갈 때만 상태 로그 생성
+            context.map_id = req.map_id();
+            frame = BuildSnapshot(context.map_id, context.states[context.map_id]);
+        }
+
+        spdlog::info("[Map] Session {} moved to map {}", id, req.map_id());
+        session_manager_.Send(id, std::move(frame));
+        SavePosition(id, req.map_id());
+    }
+
+    void MapHandler::HandlePlayerInfo(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_RequestPlayerData req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Map] RequestPlayerData ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        // 접속 때 읽어 둔 상태 (신규 플레이어 / 로그인 없이 접속이면 아직 맵 없음)
+        PlayerState state{};
+        bool resumed = false;
+        {
+            // 마지막 저장 위치에서 이어서 -> 이후 포탈 검사의 출발 맵
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end()) return;
+            auto& context = player->second;
+            state = context.saved;
+            if (context.map_id == 0 && state.map_id != 0)
+            {
+                context.map_id = state.map_id;
+                resumed = true;
+            }
+        }
+        if (resumed)
+            interest_.Enter(id, state.map_id, state.position_x, state.position_y);
+
+        yiso::game::S2C_PlayerData resp;
+        resp.set_player_id(id); // 게임 안에서 쓰는 ID는 세션 ID (계정 ID는 내려주지 않음)
+        resp.set_chapter_id(state.chapter_id);
+        resp.set_map_id(state.map_id);
+        resp.mutable_position()->set_x(state.position_x);
+        resp.mutable_position()->set_y(state.position_y);
+        session_manager_.Send(id, Network::PacketCodec::Encode(Network::PacketType::S2C_PLAYER_INFO, resp));
+    }
+
+    void MapHandler::HandleRetreatToBaseCamp(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_RetreatToBaseCamp req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Map] RetreatToBaseCamp ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        if (Warp(id, BASE_CAMP_MAP_ID, true))
+            spdlog::info("[Map] Session {} retreated to base camp", id);
+    }
+
+    bool MapHandler::Warp(SessionId id, uint32_t mapId, bool resetProgress)
+    {
+        // 대상 맵 로드는 잠금 밖에서
+        yiso::game::MapType type;
+        if (!map_data_.GetMapType(mapId, type))
+        {
+            spdlog::error("[Map] Warp target map {} is missing (session={})", mapId, id);
+            return false;
+        }
+
+        Network::Buffer frame;
+        {
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end()) return false;
+            auto& context = player->second;
+            if (resetProgress)
+            {
+                context.states.clear();
+                context.prefetched.clear(); // 상태 버전이 처음부터 다시 시작
+            }
+            frame = BuildSnapshot(mapId, context.states[mapId]);
+            if (frame.empty())
+            {
+                spdlog::error("[Map] Warp target map {} is missing (session={})", mapId, id);
+                return false;
+            }
+            context.map_id = mapId;
+        }
+
+        session_manager_.Send(id, std::move(frame));
+        SavePosition(id, mapId);
+        return true;
+    }
+
+    uint32_t MapHandler::GetCurrentMap(SessionId id)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = players_.find(id);
+        return it != players_.end() ? it->second.map_id : 0;
+    }
+
+    std::vector<MapHandler::SessionId> MapHandler::GetPlayersOn(uint32_t mapId)
+    {
+        std::vector<SessionId> ids;
+        std::lock_guard lock(mutex_);
+        for (const auto& [id, context] : players_)
+            if (context.map_id == mapId)
+                ids.push_back(id);
+        return ids;
+    }
+
+    void MapHandler::SavePosition(SessionId id, uint32_t mapId)
+    {
+        PlayerState state{};
+        bool persistent = false;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = players_.find(id);
+            if (it == players_.end()) return;
+            auto& context = it->second;
+            context.saved.map_id = mapId;
+            map_data_.GetSpawnPosition(mapId, context.saved.position_x, context.saved.position_y);
+            context.position_dirty = false;
+            context.position_saved = std::chrono::steady_clock::now();
+            state = context.saved;
+            persistent = !context.player_id.Empty();
+        }
+        if (persistent)
+            player_states_.Update(state);
+        interest_.Enter(id, mapId, state.position_x, state.position_y);
+    }
+
+    void MapHandler::UpdatePosition(SessionId id, float x, float y)
+    {
+        PlayerState state{};
+        {
+            std::lock_guard lock(mutex_);
+            auto it = players_.find(id);
+            if (it == players_.end() || it->second.map_id == 0) return;
+            auto& context = it->second;
+            context.saved.map_id = context.map_id;
+            context.saved.position_x = x;
+            context.saved.position_y = y;
+            context.position_dirty = true;
+
+            auto now = std::chrono::steady_clock::now();
+            if (context.player_id.Empty() || now - context.position_saved < POSITION_SAVE_INTERVAL) return;
+            context.position_dirty = false;
+            context.position_saved = now;
+            state = context.saved;
+        }
+        player_states_.Update(state);
+    }
+
+    void MapHandler::HandlePlayerMove(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_PlayerMove req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Map] PlayerMove ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        // 격자 위치 + 실제 위치 갱신 (맵에 들어가기 전이면 무시)
+        // 저장은 POSITION_SAVE_INTERVAL마다 / 접속 종료 때 -> 이동 패킷마다 WAL에 쓰지 않음
+        interest_.Move(id, req.position().x(), req.position().y());
+        UpdatePosition(id, req.position().x(), req.position().y());
+        Prefetch(id, req.position().x(), req.position().y());
+    }
+
+    void MapHandler::Prefetch(SessionId id, float x, float y)
+    {
+        // 포탈에 다가가면 넘어갈 맵 데이터를 미리 보냄 -> 클라이언트가 C2S_ChangeMap 전에 리소스 로드 시작
+        // 포탈 조회(그래프 구성) / 프레임 조립은 잠금 밖에서, 예산 검사는 그보다 먼저
+        thread_local std::vector<MapGraph::Edge> nearby;
+
+        uint32_t mapId = 0;
+        {
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end() || player->second.map_id == 0) return;
+            auto& context = player->second;
+
+            // 세션별 토큰 버킷 -> 포탈 사이를 오가도 프리페치가 대역폭을 잡아먹지 않음
+            // 보낸 뒤 실제 크기만큼 차감 (음수 = 빚, 다 갚을 때까지 조립도 하지 않음)
+            auto now = std::chrono::steady_clock::now();
+            double elapsed = std::chrono::duration<double>(now - context.prefetch_refilled).count();
+            context.prefetch_tokens = std::min(PREFETCH_BURST_BYTES, context.prefetch_tokens + elapsed * PREFETCH_BYTES_PER_SEC);
+            context.prefetch_refilled = now;
+            if (context.prefetch_tokens <= 0.0)
+            {
+                prefetch_throttled_.fetch_add(1, std::memory_order_relaxed); // 기록하지 않음 -> 예산이 차면 다음 이동 때 재시도
+                return;
+            }
+            mapId = context.map_id;
+        }
+
+        if (map_graph_.PortalsNear(mapId, x, y, PREFETCH_RADIUS, nearby) == 0) return;
+
+        uint32_t target = 0;
+        uint32_t version = 0;
+        MapObjectStates states; // 조립용 복사본 (들어간 적 없는 맵이면 비어 있음 = 기본 상태)
+        {
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end() || player->second.map_id != mapId) return;
+            auto& context = player->second;
+
+            // 진행 방향 우선, 가까운 순 -> 실제로 열린 첫 포탈의 맵 (현재 맵은 이미 캐시됨)
+            const MapObjectStates* currentStates = nullptr;
+            if (auto it = context.states.find(mapId); it != context.states.end())
+                currentStates = &it->second.States();
+            for (const auto& edge : nearby)
+            {
+                if (map_data_.IsPortalOpen(mapId, edge.to_map_id, currentStates))
+                {
+                    target = edge.to_map_id;
+                    break;
+                }
+            }
+            if (target == 0) return;
+
+            // 상태 로그는 실제로 들어갈 때 생성 (없으면 버전 0)
+            if (auto it = context.states.find(target); it != context.states.end())
+            {
+                version = it->second.Version();
+                states = it->second.States();
+            }
+            auto pushed = context.prefetched.find(target);
+            if (pushed != context.prefetched.end() && pushed->second == version)
+            {
+                prefetch_deduped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        auto frame = map_data_.BuildFrame(target, &states, version, true);
+        if (frame.empty()) return;
+
+        {
+            std::lock_guard lock(mutex_);
+            auto player = players_.find(id);
+            if (player == players_.end()) return;
+            auto& context = player->second;
+            context.prefetch_tokens -= static_cast<double>(frame.size());
+            if (auto it = context.states.find(target); it != context.states.end())
+                it->second.Ack(version);
+            context.prefetched[target] = version;
+        }
+
+        prefetch_sent_.fetch_add(1, std::memory_order_relaxed);
+        prefetch_bytes_.fetch_add(frame.size(), std::memory_order_relaxed);
+        session_manager_.Send(id, std::move(frame));
+    }
+
+    void MapHandler::HandleAckMapState(SessionId id, const uint8_t* data, uint32_t size)
+    {
+        yiso::game::C2S_AckMapState req;
+        if (!req.ParseFromArray(data, static_cast<int>(size)))
+        {
+            spdlog::warn("[Map] AckMapState ParseFromArray failed (session={})", id);
+            return;
+        }
+
+        std::lock_guard lock(mutex_);
+        auto player = players_.find(id);
+        if (player == players_.end()) return;
+        auto it = player->second.states.find(req.map_id());
+        if (it == player->second.states.end() || !it->second.Ack(req.version()))
+            spdlog::warn("[Map] Session {} acked unknown state (map={}, version={})", id, req.map_id(), req.version());
+    }
+
+    Network::Buffer MapHandler::BuildSnapshot(uint32_t mapId, MapStateLog& log)
+    {
+        // TCP라 전송한 스냅샷은 도착 보장 -> 그 버전을 다음 델타의 기준으로 삼음
+        auto frame = map_data_.BuildFrame(mapId, &log.States(), log.Version());
+        if (!frame.empty())
+            log.Ack(log.Version());
+        return frame;
+    }
+
+    MapHandler::Stats MapHandler::GetStats() const
+    {
+        Stats stats{};
+        stats.prefetch_sent = prefetch_sent_.load(std::memory_order_relaxed);
+        stats.prefetch_bytes = prefetch_bytes_.load(std::memory_order_relaxed);
+        stats.prefetch_deduped = prefetch_deduped_.load(std::memory_order_relaxed);
+        stats.prefetch_throttled = prefetch_throttled_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void MapHandler::ExportHandoff(Network::HandoffWriter& writer)
+    {
+        std::lock_guard lock(mutex_);
+        writer.Put(static_cast<uint32_t>(players_.size()));
+        for (const auto& [id, context] : players_)
+        {
+            uint32_t mapId = 0;
+            float x = 0.0f;
+            float y = 0.0f;
+            bool tracked = interest_.GetPosition(id, mapId, x, y);
+            writer.Put(id);
+            writer.Put(context.player_id);
+            writer.Put(context.saved);
+            writer.Put(static_cast<uint8_t>(context.position_dirty));
+            writer.Put(static_cast<uint8_t>(context.loading));
+            writer.Put(static_cast<uint32_t>(context.deferred.size()));
+            for (const auto& [type, body] : context.deferred)
+            {
+                writer.Put(type);
+                writer.PutBytes(body.data(), static_cast<uint32_t>(body.size()));
+            }
+            writer.Put(context.map_id);
+            writer.Put(static_cast<uint8_t>(tracked));
+            writer.Put(mapId);
+            writer.Put(x);
+            writer.Put(y);
+
+            writer.Put(static_cast<uint32_t>(context.states.size()));
+            for (const auto& [stateMapId, log] : context.states)
+            {
+                writer.Put(stateMapId);
+                log.ExportHandoff(writer);
+            }
+            writer.Put(static_cast<uint32_t>(context.prefetched.size()));
+            for (const auto& [prefetchMapId, version] : context.prefetched)
+            {
+                writer.Put(prefetchMapId);
+                writer.Put(version);
+            }
+        }
+    }
+
+    bool MapHandler::ImportHandoff(Network::HandoffReader& reader)
+    {
+        std::vector<std::pair<SessionId, PlayerId>> loads; // 조회 중이던 세션은 다시 조회
+        std::unique_lock lock(mutex_);
+        auto count = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto id = reader.Get<SessionId>();
+            auto& context = players_[id];
+            context.player_id = reader.Get<PlayerId>();
+            context.saved = reader.Get<PlayerState>();
+            context.position_dirty = reader.Get<uint8_t>() != 0;
+            context.position_saved = std::chrono::steady_clock::now();
+            context.loading = reader.Get<uint8_t>() != 0;
+            auto deferred = reader.Get<uint32_t>();
+            for (uint32_t j = 0; j < deferred && reader.Ok(); ++j)
+            {
+                auto type = reader.Get<Network::PacketType>();
+                const uint8_t* body = nullptr;
+                uint32_t bodySize = 0;
+                if (reader.GetBytes(body, bodySize))
+                    context.deferred.emplace_back(type, std::vector<uint8_t>(body, body + bodySize));
+            }
+            if (context.loading)
+                loads.emplace_back(id, context.player_id);
+            context.map_id = reader.Get<uint32_t>();
+            bool tracked = reader.Get<uint8_t>() != 0;
+            auto mapId = reader.Get<uint32_t>();
+            auto x = reader.Get<float>();
+            auto y = reader.Get<float>();
+            if (tracked)
+                interest_.Enter(id, mapId, x, y);
+
+            auto states = reader.Get<uint32_t>();
+            for (uint32_t j = 0; j < states && reader.Ok(); ++j)
+            {
+                auto stateMapId = reader.Get<uint32_t>();
+                context.states[stateMapId].ImportHandoff(reader);
+            }
+            auto prefetched = reader.Get<uint32_t>();
+            for (uint32_t j = 0; j < prefetched && reader.Ok(); ++j)
+            {
+                auto prefetchMapId = reader.Get<uint32_t>();
+                context.prefetched[prefetchMapId] = reader.Get<uint32_t>();
+            }
+        }
+        lock.unlock();
+
+        for (const auto& [id, playerId] : loads)
+            StartLoad(id, playerId);
+        return reader.Ok();
+    }
+}
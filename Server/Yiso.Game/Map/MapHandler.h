@@ -0,0 +1,118 @@
+#pragma once
+#include "Network/YisoSession.h"
+#include "Network/YisoSessionManager.h"
+#include "MapDataService.h"
+#include "MapGraph.h"
+#include "MapInterest.h"
+#include "MapStateLog.h"
+#include "Player/PlayerStateStore.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Yiso::Game
+{
+    class MapHandler
+    {
+    public:
+        using SessionId = Network::YisoSession::SessionId;
+        using Poster = std::function<void(SessionId, std::function<void()>)>; // 그 세션의 로직 스레드에서 실행 (LogicLoop::PostTask)
+        MapHandler(Network::YisoSessionManager& manager, MapDataService& map_data, MapGraph& map_graph, PlayerStateStore& player_states, Poster post);
+
+        struct Stats
+        {
+            uint64_t prefetch_sent;
+            uint64_t prefetch_bytes;
+            uint64_t prefetch_deduped; // 같은 상태 버전을 이미 보냄
+            uint64_t prefetch_throttled; // 세션 대역폭 예산 초과로 보류
+        };
+
+        static constexpr uint32_t BASE_CAMP_MAP_ID = 1; // 거점 후퇴 목적지 (콘텐츠 규약)
+
+        // 포탈 근처 프리페치: 이 반경 안에 들어오면 연결된 맵 데이터를 미리 보냄 (S2C_MapData.prefetch = true)
+        static constexpr float PREFETCH_RADIUS = 8.0f;
+        static constexpr double PREFETCH_BYTES_PER_SEC = 32 * 1024; // 세션별 토큰 버킷
+        static constexpr double PREFETCH_BURST_BYTES = 128 * 1024;
+
+        static constexpr auto POSITION_SAVE_INTERVAL = std::chrono::seconds(10); // 이동 중 실제 위치 저장 주기 (나머지는 접속 종료 때)
+        static constexpr size_t MAX_DEFERRED_PACKETS = 32; // 저장 상태 조회 중 모아 두는 맵 패킷 (넘치면 버림)
+
+        // userId: 로그인한 계정 (인증을 끄면 빈 문자열)
+        // 로그인했으면 저장된 상태를 비동기로 읽고, 다 읽을 때까지 맵 패킷은 모아 뒀다가 순서대로 처리
+        void OnConnected(SessionId id, const std::string& userId);
+        void OnDisconnected(SessionId id);
+        void OnRecv(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size);
+
+        // 서버 판단으로 맵 이동 (후퇴 / 도장 진입·탈출) -> 맵 데이터 전송 + 위치 저장
+        // resetProgress: 맵 오브젝트 진행 상태 전부 파기 (챕터 퀘스트 리셋)
+        bool Warp(SessionId id, uint32_t mapId, bool resetProgress);
+        uint32_t GetCurrentMap(SessionId id);
+        bool GetSpawnPosition(uint32_t mapId, float& x, float& y) { return map_data_.GetSpawnPosition(mapId, x, y); }
+        std::vector<SessionId> GetPlayersOn(uint32_t mapId);
+
+        // 맵 범위 / 주변 반경 방송 (맵 이벤트, 주변 채팅 등)
+        MapInterest& GetInterest() { return interest_; }
+
+        Stats GetStats() const;
+
+        // 무중단 재시작: 플레이어별 현재 맵 / 위치 / 맵 오브젝트 상태 (프리페치 예산은 새로 채움)
+        void ExportHandoff(Network::HandoffWriter& writer);
+        bool ImportHandoff(Network::HandoffReader& reader);
+
+    private:
+        void Dispatch(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size);
+        bool Defer(SessionId id, Network::PacketType type, const uint8_t* data, uint32_t size); // 조회 중이면 모아 둠
+        void StartLoad(SessionId id, const PlayerId& playerId);
+        void OnPlayerLoaded(SessionId id, bool found, const PlayerState& state);
+        void HandleRequestMapData(SessionId id, const uint8_t* data, uint32_t size);
+        void HandleChangeMap(SessionId id, const uint8_t* data, uint32_t size);
+        void HandleAckMapState(SessionId id, const uint8_t* data, uint32_t size);
+        void HandlePlayerInfo(SessionId id, const uint8_t* data, uint32_t size);
+        void HandleRetreatToBaseCamp(SessionId id, const uint8_t* data, uint32_t size);
+        void HandlePlayerMove(SessionId id, const uint8_t* data, uint32_t size);
+        void Prefetch(SessionId id, float x, float y);
+
+        // 맵 이동 확정 후 위치 저장 (새 맵의 스폰 위치, 챕터는 유지) + 그 맵 격자에 입장
+        // 로그인한 플레이어만 저장소에 (인증 없이 접속한 세션은 이번 연결 동안 메모리에만)
+        void SavePosition(SessionId id, uint32_t mapId);
+        void UpdatePosition(SessionId id, float x, float y); // 이동 패킷의 실제 위치 (저장은 POSITION_SAVE_INTERVAL마다)
+
+        Network::Buffer BuildSnapshot(uint32_t mapId, MapStateLog& log); // mutex_ 보유 상태에서 호출
+
+        struct PlayerMapContext
+        {
+            PlayerId player_id; // 저장 키 (빈 ID = 로그인 없이 접속)
+            PlayerState saved{}; // 마지막 상태 (조회 결과 + 이후 변경, 저장소에 쓰는 값)
+            bool position_dirty = false; // saved의 위치가 아직 저장소에 없음
+            std::chrono::steady_clock::time_point position_saved;
+            bool loading = false; // 저장 상태 조회 중
+            std::vector<std::pair<Network::PacketType, std::vector<uint8_t>>> deferred; // 조회 중에 온 맵 패킷
+
+            uint32_t map_id = 0; // 0 = 아직 맵에 들어가지 않음
+            std::unordered_map<uint32_t, MapStateLog> states; // map_id -> 플레이어별 오브젝트 상태
+            std::unordered_map<uint32_t, uint32_t> prefetched; // map_id -> 미리 보낸 상태 버전
+
+            double prefetch_tokens = PREFETCH_BURST_BYTES;
+            std::chrono::steady_clock::time_point prefetch_refilled = std::chrono::steady_clock::now();
+        };
+
+        Network::YisoSessionManager& session_manager_;
+        MapDataService& map_data_;
+        MapGraph& map_graph_;
+        PlayerStateStore& player_states_;
+        Poster post_;
+        MapInterest interest_;
+
+        std::mutex mutex_;
+        std::unordered_map<SessionId, PlayerMapContext> players_;
+
+        std::atomic<uint64_t> prefetch_sent_{0};
+        std::atomic<uint64_t> prefetch_bytes_{0};
+        std::atomic<uint64_t> prefetch_deduped_{0};
+        std::atomic<uint64_t> prefetch_throttled_{0};
+    };
+}
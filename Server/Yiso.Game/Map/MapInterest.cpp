@@ -0,0 +1,141 @@
+#include "MapInterest.h"
+
+namespace Yiso::Game
+{
+    MapInterest::MapInterest(Network::YisoSessionManager& manager, MapDataService& map_data)
+        : session_manager_(manager),
+          map_data_(map_data)
+    {
+    }
+
+    float MapInterest::CellSizeFor(uint32_t mapId)
+    {
+        // 칸 크기 ~ 보통 관심 반경 -> 반경 질의가 3x3 칸 안에서 끝남
+        yiso::game::MapType type;
+        if (!map_data_.GetMapType(mapId, type))
+            return DEFAULT_CELL_SIZE;
+
+        switch (type)
+        {
+        case yiso::game::MAP_TYPE_CHAPTER_FIELD:
+        case yiso::game::MAP_TYPE_CHAPTER_DUNGEON:
+            return 12.0f;
+        case yiso::game::MAP_TYPE_CHAPTER_BOSS_AREA:
+            return 24.0f;
+        case yiso::game::MAP_TYPE_INFINITE_DOJO:
+            return 32.0f;
+        default:
+            return DEFAULT_CELL_SIZE;
+        }
+    }
+
+    void MapInterest::Enter(SessionId id, uint32_t mapId, float x, float y)
+    {
+        // 맵 타입 조회(캐시 미스 시 로드)는 락 밖에서
+        float cellSize = CellSizeFor(mapId);
+
+        std::lock_guard lock(mutex_);
+        auto member = members_.find(id);
+        if (member != members_.end() && member->second.map_id != mapId)
+        {
+            if (auto grid = grids_.find(member->second.map_id); grid != grids_.end())
+                grid->second.Remove(id);
+        }
+
+        auto grid = grids_.try_emplace(mapId, cellSize).first;
+        grid->second.Insert(id, x, y);
+        members_[id] = { mapId, x, y };
+    }
+
+    void MapInterest::Move(SessionId id, float x, float y)
+    {
+        std::lock_guard lock(mutex_);
+        auto member = members_.find(id);
+        if (member == members_.end()) return;
+
+        member->second.x = x;
+        member->second.y = y;
+        grids_.at(member->second.map_id).Move(id, x, y);
+    }
+
+    void MapInterest::Leave(SessionId id)
+    {
+        std::lock_guard lock(mutex_);
+        auto member = members_.find(id);
+        if (member == members_.end()) return;
+
+        grids_.at(member->second.map_id).Remove(id);
+        members_.erase(member);
+    }
+
+    bool MapInterest::GetPosition(SessionId id, uint32_t& mapId, float& x, float& y)
+    {
+        std::lock_guard lock(mutex_);
+        auto member = members_.find(id);
+        if (member == members_.end()) return false;
+        mapId = member->second.map_id;
+        x = member->second.x;
+        y = member->second.y;
+        return true;
+    }
+
+    size_t MapInterest::QueryRadius(uint32_t mapId, float x, float y, float radius, std::vector<SessionId>& out)
+    {
+        out.clear();
+        std::lock_guard lock(mutex_);
+        auto grid = grids_.find(mapId);
+        if (grid == grids_.end()) return 0;
+        return grid->second.QueryRadius(x, y, radius, out);
+    }
+
+    void MapInterest::BroadcastToMap(uint32_t mapId, const Network::Buffer& frame, SessionId except)
+    {
+        thread_local std::vector<SessionId> targets;
+        targets.clear();
+        {
+            std::lock_guard lock(mutex_);
+            auto grid = grids_.find(mapId);
+            if (grid == grids_.end()) return;
+            grid->second.ForEach([except](SessionId id) { if (id != except) targets.push_back(id); });
+        }
+        Multicast(targets, frame);
+    }
+
+    void MapInterest::BroadcastNearby(uint32_t mapId, float x, float y, float radius, const Network::Buffer& frame, SessionId except)
+    {
+        thread_local std::vector<SessionId> targets;
+        targets.clear();
+        {
+            std::lock_guard lock(mutex_);
+            auto grid = grids_.find(mapId);
+            if (grid == grids_.end()) return;
+            grid->second.ForEachInRadius(x, y, radius, [except](SessionId id) { if (id != except) targets.push_back(id); });
+        }
+        Multicast(targets, frame);
+    }
+
+    void MapInterest::Multicast(std::vector<SessionId>& targets, const Network::Buffer& frame)
+    {
+        if (targets.empty()) return;
+        // 세션 전송은 격자 락 밖에서 -> 이동 처리가 방송에 막히지 않음
+        session_manager_.Multicast(targets.data(), targets.size(), frame);
+        multicasts_.fetch_add(1, std::memory_order_relaxed);
+        recipients_.fetch_add(targets.size(), std::memory_order_relaxed);
+    }
+
+    MapInterest::Stats MapInterest::GetStats()
+    {
+        Stats stats{};
+        stats.multicasts = multicasts_.load(std::memory_order_relaxed);
+        stats.recipients = recipients_.load(std::memory_order_relaxed);
+
+        std::lock_guard lock(mutex_);
+        stats.tracked_players = members_.size();
+        for (const auto& [mapId, grid] : grids_)
+        {
+            if (grid.Size() != 0)
+                ++stats.active_maps;
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Network/YisoSession.h"
+#include "Network/YisoSessionManager.h"
+#include "MapDataService.h"
+#include "SpatialGrid.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 맵별 플레이어 위치 격자 -> 맵 범위 방송을 그 맵(또는 주변) 세션에게만 보냄
+    // - 맵 입장/이동/퇴장 시 격자 갱신, 격자 칸 크기는 맵 종류별 (좁은 전투 맵은 촘촘하게)
+    // - 방송 대상 수집은 스레드별 버퍼 재사용 -> 방송 경로에서 할당 없음
+    class MapInterest
+    {
+    public:
+        using SessionId = Network::YisoSession::SessionId;
+        MapInterest(Network::YisoSessionManager& manager, MapDataService& map_data);
+
+        struct Stats
+        {
+            size_t tracked_players;
+            size_t active_maps;
+            uint64_t multicasts;
+            uint64_t recipients; // 누적 수신 세션 수 (multicasts로 나누면 방송당 평균)
+        };
+
+        static constexpr float DEFAULT_CELL_SIZE = 16.0f;
+
+        void Enter(SessionId id, uint32_t mapId, float x, float y); // 다른 맵에 있었으면 거기서 빠짐
+        void Move(SessionId id, float x, float y); // 맵에 없으면 무시
+        void Leave(SessionId id);
+        bool GetPosition(SessionId id, uint32_t& mapId, float& x, float& y);
+
+        size_t QueryRadius(uint32_t mapId, float x, float y, float radius, std::vector<SessionId>& out);
+
+        // except: 보낸 본인 제외용 (0 = 제외 없음)
+        void BroadcastToMap(uint32_t mapId, const Network::Buffer& frame, SessionId except = 0);
+        void BroadcastNearby(uint32_t mapId, float x, float y, float radius, const Network::Buffer& frame, SessionId except = 0);
+
+        Stats GetStats();
+
+    private:
+        struct Member
+        {
+            uint32_t map_id;
+            float x;
+            float y;
+        };
+
+        float CellSizeFor(uint32_t mapId);
+        void Multicast(std::vector<SessionId>& targets, const Network::Buffer& frame);
+
+        Network::YisoSessionManager& session_manager_;
+        MapDataService& map_data_;
+
+        std::mutex mutex_;
+        std::unordered_map<uint32_t, SpatialGrid> grids_; // map_id -> 격자 (빈 맵도 유지)
+        std::unordered_map<SessionId, Member> members_;
+
+        std::atomic<uint64_t> multicasts_{0};
+        std::atomic<uint64_t> recipients_{0};
+    };
+}
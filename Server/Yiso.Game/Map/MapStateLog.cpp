@@ -0,0 +1,73 @@
+#include "MapStateLog.h"
+#include <algorithm>
+
+namespace Yiso::Game
+{
+    bool MapStateLog::Set(MapObjectKind kind, uint32_t id, bool active)
+    {
+        uint64_t key = MapObjectStates::MakeKey(kind, id);
+        auto it = states_.Entries().find(key);
+        if (it != states_.Entries().end() && it->second == active)
+            return false;
+
+        states_.Set(kind, id, active);
+        ++version_;
+        log_[version_ % LOG_CAPACITY] = { key, active };
+        return true;
+    }
+
+    bool MapStateLog::Ack(uint32_t version)
+    {
+        if (version > version_) return false;
+        acked_version_ = std::max(acked_version_, version);
+        return true;
+    }
+
+    bool MapStateLog::CollectSince(uint32_t base, std::vector<Change>& out) const
+    {
+        out.clear();
+        if (base > version_ || version_ - base > LOG_CAPACITY)
+            return false;
+
+        // 최신 변경부터 거꾸로 -> 오브젝트별 첫 등장 = 최종 상태
+        for (uint32_t v = version_; v > base; --v)
+        {
+            const auto& entry = log_[v % LOG_CAPACITY];
+            auto kind = static_cast<MapObjectKind>(entry.key >> 32);
+            auto objectId = static_cast<uint32_t>(entry.key);
+            bool seen = std::any_of(out.begin(), out.end(), [&](const Change& c)
+            {
+                return c.kind == kind && c.object_id == objectId;
+            });
+            if (!seen)
+                out.push_back({ kind, objectId, entry.active });
+        }
+        return true;
+    }
+
+    void MapStateLog::ExportHandoff(Network::HandoffWriter& writer) const
+    {
+        writer.Put(version_);
+        writer.Put(acked_version_);
+        writer.Put(log_);
+        writer.Put(static_cast<uint32_t>(states_.Entries().size()));
+        for (const auto& [key, active] : states_.Entries())
+        {
+            writer.Put(key);
+            writer.Put(static_cast<uint8_t>(active));
+        }
+    }
+
+    void MapStateLog::ImportHandoff(Network::HandoffReader& reader)
+    {
+        version_ = reader.Get<uint32_t>();
+        acked_version_ = reader.Get<uint32_t>();
+        log_ = reader.Get<decltype(log_)>();
+        auto count = reader.Get<uint32_t>();
+        for (uint32_t i = 0; i < count && reader.Ok(); ++i)
+        {
+            auto key = reader.Get<uint64_t>();
+            states_.Set(static_cast<MapObjectKind>(key >> 32), static_cast<uint32_t>(key), reader.Get<uint8_t>() != 0);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "MapDataService.h"
+#include "Network/HotRestart.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 플레이어 한 명의 맵 하나에 대한 버전 붙은 오브젝트 상태
+    // 상태가 바뀔 때마다 버전 +1, 최근 LOG_CAPACITY개 변경은 링에 보관
+    // -> 클라이언트가 확인(ack)한 버전 이후 변경분만 델타로 보낼 수 있음
+    class MapStateLog
+    {
+    public:
+        struct Change
+        {
+            MapObjectKind kind;
+            uint32_t object_id;
+            bool active;
+        };
+
+        static constexpr size_t LOG_CAPACITY = 64; // 이보다 오래된 버전 기준이면 델타 불가 -> 전체 스냅샷
+
+        const MapObjectStates& States() const { return states_; }
+        uint32_t Version() const { return version_; }
+        uint32_t AckedVersion() const { return acked_version_; }
+
+        // 실제로 값이 바뀐 경우에만 버전 증가 (같은 값 재설정 -> false)
+        bool Set(MapObjectKind kind, uint32_t id, bool active);
+
+        // 클라이언트가 version까지 반영했음 -> 이후 델타의 기준점
+        // 아직 존재하지 않는 버전이면 false, 이미 더 최신 ack가 있으면 무시
+        bool Ack(uint32_t version);
+
+        // base 이후 ~ 현재 버전까지 바뀐 오브젝트의 최종 상태 (오브젝트당 하나)
+        // base가 링 범위를 벗어나면 false
+        bool CollectSince(uint32_t base, std::vector<Change>& out) const;
+
+        // 무중단 재시작: 상태 + 변경 링 그대로 (인계 뒤에도 델타 가능)
+        void ExportHandoff(Network::HandoffWriter& writer) const;
+        void ImportHandoff(Network::HandoffReader& reader);
+
+    private:
+        struct LogEntry
+        {
+            uint64_t key;
+            bool active;
+        };
+
+        MapObjectStates states_;
+        std::array<LogEntry, LOG_CAPACITY> log_{}; // 버전 v의 변경 -> log_[v % LOG_CAPACITY]
+        uint32_t version_ = 0;
+        uint32_t acked_version_ = 0;
+    };
+}
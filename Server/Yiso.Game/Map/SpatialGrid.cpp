@@ -0,0 +1,71 @@
+#include "SpatialGrid.h"
+
+namespace Yiso::Game
+{
+    SpatialGrid::SpatialGrid(float cellSize)
+        : cell_size_(cellSize),
+          inv_cell_size_(1.0f / cellSize)
+    {
+    }
+
+    void SpatialGrid::Insert(EntityId id, float x, float y)
+    {
+        if (Contains(id))
+        {
+            Move(id, x, y);
+            return;
+        }
+
+        uint64_t cell = CellKey(CellCoord(x), CellCoord(y));
+        auto& entries = cells_[cell];
+        locations_[id] = { cell, static_cast<uint32_t>(entries.size()) };
+        entries.push_back({ id, x, y });
+    }
+
+    void SpatialGrid::Move(EntityId id, float x, float y)
+    {
+        auto it = locations_.find(id);
+        if (it == locations_.end()) return;
+
+        auto& location = it->second;
+        uint64_t cell = CellKey(CellCoord(x), CellCoord(y));
+        if (cell == location.cell)
+        {
+            auto& entry = cells_[cell][location.index];
+            entry.x = x;
+            entry.y = y;
+            return;
+        }
+
+        RemoveFromCell(location.cell, location.index);
+        auto& entries = cells_[cell];
+        location = { cell, static_cast<uint32_t>(entries.size()) };
+        entries.push_back({ id, x, y });
+    }
+
+    void SpatialGrid::Remove(EntityId id)
+    {
+        auto it = locations_.find(id);
+        if (it == locations_.end()) return;
+        RemoveFromCell(it->second.cell, it->second.index);
+        locations_.erase(it);
+    }
+
+    void SpatialGrid::RemoveFromCell(uint64_t cell, uint32_t index)
+    {
+        auto& entries = cells_[cell];
+        if (index + 1 != entries.size())
+        {
+            entries[index] = entries.back();
+            locations_[entries[index].id].index = index;
+        }
+        entries.pop_back();
+    }
+
+    size_t SpatialGrid::QueryRadius(float x, float y, float radius, std::vector<EntityId>& out) const
+    {
+        out.clear();
+        ForEachInRadius(x, y, radius, [&out](EntityId id) { out.push_back(id); });
+        return out.size();
+    }
+}
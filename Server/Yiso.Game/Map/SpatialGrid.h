@@ -0,0 +1,92 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 맵 하나의 균일 격자 공간 인덱스
+    // - 칸 = cell_size 정사각형, 좌표 -> 칸 키는 나눗셈 한 번
+    // - 이동: 같은 칸이면 좌표만 갱신, 칸이 바뀌면 swap-remove 후 새 칸에 추가
+    // - 질의: 반경을 덮는 칸만 훑음, 방문자(ForEachInRadius) 버전은 할당 없음
+    // 빈 칸도 지우지 않고 남겨 둠 -> 같은 영역을 오가도 vector 재할당 없음
+    class SpatialGrid
+    {
+    public:
+        using EntityId = uint32_t;
+
+        explicit SpatialGrid(float cellSize);
+
+        void Insert(EntityId id, float x, float y); // 이미 있으면 Move
+        void Move(EntityId id, float x, float y);
+        void Remove(EntityId id);
+        bool Contains(EntityId id) const { return locations_.count(id) != 0; }
+        size_t Size() const { return locations_.size(); }
+        float CellSize() const { return cell_size_; }
+
+        template<typename Fn>
+        void ForEachInRadius(float x, float y, float radius, Fn&& fn) const
+        {
+            const int32_t minX = CellCoord(x - radius);
+            const int32_t maxX = CellCoord(x + radius);
+            const int32_t minY = CellCoord(y - radius);
+            const int32_t maxY = CellCoord(y + radius);
+            const float radiusSq = radius * radius;
+            for (int32_t cy = minY; cy <= maxY; ++cy)
+            {
+                for (int32_t cx = minX; cx <= maxX; ++cx)
+                {
+                    auto it = cells_.find(CellKey(cx, cy));
+                    if (it == cells_.end()) continue;
+                    for (const auto& entry : it->second)
+                    {
+                        float dx = entry.x - x;
+                        float dy = entry.y - y;
+                        if (dx * dx + dy * dy <= radiusSq)
+                            fn(entry.id);
+                    }
+                }
+            }
+        }
+
+        template<typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            for (const auto& [key, cell] : cells_)
+            {
+                for (const auto& entry : cell)
+                    fn(entry.id);
+            }
+        }
+
+        // out을 비우고 채움 (capacity 재사용 -> 충분히 커진 뒤로는 할당 없음)
+        size_t QueryRadius(float x, float y, float radius, std::vector<EntityId>& out) const;
+
+    private:
+        struct Entry
+        {
+            EntityId id;
+            float x;
+            float y;
+        };
+
+        struct Location
+        {
+            uint64_t cell;
+            uint32_t index; // cells_[cell] 안 위치
+        };
+
+        int32_t CellCoord(float v) const { return static_cast<int32_t>(std::floor(v * inv_cell_size_)); }
+        static uint64_t CellKey(int32_t cx, int32_t cy)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+        }
+        void RemoveFromCell(uint64_t cell, uint32_t index);
+
+        float cell_size_;
+        float inv_cell_size_;
+        std::unordered_map<uint64_t, std::vector<Entry>> cells_;
+        std::unordered_map<EntityId, Location> locations_;
+    };
+}
@@ -0,0 +1,108 @@
+#include "PlayerStateBackend.h"
+#include <fstream>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        int HexValue(char c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        uint64_t Fnv1a64(std::string_view text, uint64_t hash)
+        {
+            for (char c : text)
+                hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+            return hash;
+        }
+    }
+
+    PlayerId PlayerId::FromUserId(std::string_view userId)
+    {
+        PlayerId id;
+        if (userId.empty()) return id;
+
+        // GUID: 하이픈을 빼고 16진수 32자리
+        int digits = 0;
+        bool guid = true;
+        for (char c : userId)
+        {
+            if (c == '-') continue;
+            int value = HexValue(c);
+            if (value < 0 || digits >= 32)
+            {
+                guid = false;
+                break;
+            }
+            uint64_t& half = digits < 16 ? id.high : id.low;
+            half = (half << 4) | static_cast<uint64_t>(value);
+            ++digits;
+        }
+        if (guid && digits == 32 && !id.Empty())
+            return id;
+
+        // 로컬 대역 등 임의 문자열 (시드만 다른 FNV-1a 두 개)
+        id.high = Fnv1a64(userId, 14695981039346656037ull);
+        id.low = Fnv1a64(userId, 0x6C62272E07BB0142ull);
+        return id;
+    }
+
+    std::string PlayerId::ToString() const
+    {
+        static constexpr char HEX[] = "0123456789abcdef";
+        std::string text(32, '0');
+        for (int i = 0; i < 16; ++i)
+        {
+            text[15 - i] = HEX[(high >> (i * 4)) & 0xF];
+            text[31 - i] = HEX[(low >> (i * 4)) & 0xF];
+        }
+        return text;
+    }
+
+    FilePlayerStateBackend::FilePlayerStateBackend(std::filesystem::path dir)
+        : dir_(std::move(dir))
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(dir_, ec);
+        if (ec)
+            spdlog::error("[PlayerState] 저장 폴더 생성 실패: {} ({})", dir_.string(), ec.message());
+    }
+
+    std::filesystem::path FilePlayerStateBackend::PathOf(const PlayerId& playerId) const
+    {
+        return dir_ / (playerId.ToString() + ".bin");
+    }
+
+    bool FilePlayerStateBackend::Load(const PlayerId& playerId, PlayerState& out)
+    {
+        std::ifstream file(PathOf(playerId), std::ios::binary);
+        if (!file) return false;
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&out), sizeof(PlayerState)));
+    }
+
+    bool FilePlayerStateBackend::SaveBatch(const std::vector<PlayerState>& states)
+    {
+        for (const auto& state : states)
+        {
+            // 임시 파일에 쓰고 교체 -> 중간에 죽어도 이전 레코드는 온전
+            auto path = PathOf(state.player_id);
+            auto temp = path;
+            temp += ".tmp";
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                if (!file.write(reinterpret_cast<const char*>(&state), sizeof(PlayerState)))
+                    return false;
+            }
+            std::error_code ec;
+            std::filesystem::rename(temp, path, ec);
+            if (ec) return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 플레이어 ID: 로그인한 계정(Yiso.Web 유저 ID)의 128비트 값 -> 세션 / 프로세스가 바뀌어도 같은 키
+    struct PlayerId
+    {
+        uint64_t high = 0;
+        uint64_t low = 0;
+
+        static PlayerId FromUserId(std::string_view userId); // GUID면 그 값, 아니면 문자열 해시 (빈 문자열이면 빈 ID)
+        bool Empty() const { return high == 0 && low == 0; }
+        std::string ToString() const; // 16진수 32자리
+        bool operator==(const PlayerId& other) const { return high == other.high && low == other.low; }
+    };
+
+    struct PlayerIdHash
+    {
+        size_t operator()(const PlayerId& id) const { return static_cast<size_t>(id.high ^ (id.low * 0x9E3779B97F4A7C15ull)); }
+    };
+
+    // 저장 대상 플레이어 상태 (WAL / 백엔드에 그대로 기록되는 고정 크기 레코드)
+#pragma pack(push, 4)
+    struct PlayerState
+    {
+        PlayerId player_id;
+        uint32_t chapter_id; // 0 = 챕터 밖 (거점)
+        uint32_t map_id; // 0 = 아직 맵에 들어가지 않음
+        float position_x; // 마지막 저장 위치
+        float position_y;
+    };
+#pragma pack(pop)
+    static_assert(sizeof(PlayerState) == 32);
+
+    // 영구 저장소 (DB 등)
+    // PlayerStateStore의 백그라운드 스레드에서만 호출 -> io / 로직 스레드를 막지 않음
+    // Load(조회 스레드)와 SaveBatch(저장 스레드)는 동시에 불릴 수 있음
+    class PlayerStateBackend
+    {
+    public:
+        virtual ~PlayerStateBackend() = default;
+        virtual bool Load(const PlayerId& playerId, PlayerState& out) = 0; // 저장된 적 없으면 false
+        virtual bool SaveBatch(const std::vector<PlayerState>& states) = 0; // 하나라도 실패하면 false (전체 재시도)
+    };
+
+    // <dir>/<player_id 16진수>.bin 파일 하나에 레코드 하나 (DB 대신 쓰는 개발/테스트용)
+    class FilePlayerStateBackend : public PlayerStateBackend
+    {
+    public:
+        explicit FilePlayerStateBackend(std::filesystem::path dir);
+        bool Load(const PlayerId& playerId, PlayerState& out) override;
+        bool SaveBatch(const std::vector<PlayerState>& states) override;
+
+    private:
+        std::filesystem::path PathOf(const PlayerId& playerId) const;
+
+        std::filesystem::path dir_;
+    };
+}
@@ -0,0 +1,351 @@
+#include "PlayerStateStore.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Yiso::Game
+{
+    namespace
+    {
+        // WAL 레코드: [checksum][PlayerState] -> 마지막 레코드가 잘려 있거나 깨졌으면 거기서 재생 중단
+#pragma pack(push, 4)
+        struct WalRecord
+        {
+            uint32_t checksum;
+            PlayerState state;
+        };
+#pragma pack(pop)
+
+        uint32_t Checksum(const PlayerState& state)
+        {
+            // FNV-1a
+            const auto* p = reinterpret_cast<const uint8_t*>(&state);
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < sizeof(PlayerState); ++i)
+                hash = (hash ^ p[i]) * 16777619u;
+            return hash;
+        }
+
+        bool SyncFile(std::FILE* file)
+        {
+            if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+            return _commit(_fileno(file)) == 0;
+#else
+            return fsync(fileno(file)) == 0;
+#endif
+        }
+
+        void StoreMax(std::atomic<uint64_t>& target, uint64_t value)
+        {
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+    }
+
+    PlayerStateStore::PlayerStateStore(PlayerStateBackend& backend, std::filesystem::path walPath)
+        : backend_(backend),
+          wal_path_(std::move(walPath))
+    {
+    }
+
+    PlayerStateStore::~PlayerStateStore()
+    {
+        Stop();
+    }
+
+    bool PlayerStateStore::Start()
+    {
+        uint64_t validBytes = 0;
+        size_t replayed = ReplayWal(validBytes);
+        if (replayed > 0)
+        {
+            spdlog::info("[PlayerState] WAL 재생: {}명 상태 복구", dirty_.size());
+            FlushBackend(); // 실패해도 dirty_에 남아 있어 다음 주기에 재시도
+        }
+
+        // 백엔드 반영이 끝났으면 WAL을 비우고, 아니면 이어서 append
+        // 이어 쓸 때는 잘리거나 깨진 꼬리를 먼저 잘라냄 -> 그 뒤에 붙인 레코드가 다음 재생에서 버려지지 않게
+        if (!dirty_.empty())
+        {
+            std::error_code ec;
+            auto size = std::filesystem::file_size(wal_path_, ec);
+            if (!ec && size > validBytes)
+            {
+                spdlog::warn("[PlayerState] WAL 끝 {}바이트 잘라냄 (잘리거나 깨진 레코드)", size - validBytes);
+                std::filesystem::resize_file(wal_path_, validBytes, ec);
+            }
+            if (ec)
+            {
+                spdlog::error("[PlayerState] WAL 정리 실패: {} ({})", wal_path_.string(), ec.message());
+                return false;
+            }
+        }
+        if (!OpenWal(dirty_.empty()))
+            return false;
+
+        flusher_ = std::thread([this] { FlushLoop(); });
+        loader_ = std::thread([this] { LoadLoop(); });
+        return true;
+    }
+
+    void PlayerStateStore::Stop()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (stop_) return;
+            stop_ = true;
+        }
+        cv_.notify_one();
+        load_cv_.notify_one();
+        if (flusher_.joinable())
+            flusher_.join();
+        if (loader_.joinable())
+            loader_.join();
+        if (wal_)
+        {
+            std::fclose(wal_);
+            wal_ = nullptr;
+        }
+    }
+
+    void PlayerStateStore::Load(const PlayerId& playerId, OnLoaded done)
+    {
+        PlayerState state{};
+        {
+            std::lock_guard lock(mutex_);
+            released_.erase(playerId); // 다시 접속 -> 캐시 유지
+            auto it = cache_.find(playerId);
+            if (it == cache_.end())
+            {
+                loads_.emplace_back(playerId, std::move(done));
+                load_cv_.notify_one();
+                return;
+            }
+            state = it->second;
+        }
+        done(true, state);
+    }
+
+    void PlayerStateStore::LoadLoop()
+    {
+        std::vector<std::pair<PlayerId, OnLoaded>> loads;
+        for (;;)
+        {
+            {
+                std::unique_lock lock(mutex_);
+                load_cv_.wait(lock, [this] { return stop_ || !loads_.empty(); });
+                if (loads_.empty()) return; // 종료 (받은 조회는 모두 끝냄)
+                loads.swap(loads_);
+            }
+
+            for (auto& [playerId, done] : loads)
+            {
+                // 캐시에 없음 = 이번 실행에서 변경된 적 없음 -> 백엔드 값이 최신
+                PlayerState state{};
+                bool found = backend_.Load(playerId, state);
+                {
+                    std::lock_guard lock(mutex_);
+                    if (found)
+                    {
+                        if (auto it = cache_.find(playerId); it != cache_.end())
+                            state = it->second; // 그 사이 Update가 들어왔으면 그쪽 우선
+                        else if (!released_.count(playerId))
+                            cache_.emplace(playerId, state); // 조회 중에 끊겼으면 캐시하지 않음
+                    }
+                    else if (auto it = cache_.find(playerId); it != cache_.end())
+                    {
+                        found = true;
+                        state = it->second;
+                    }
+                }
+                done(found, state);
+            }
+            loads.clear();
+        }
+    }
+
+    void PlayerStateStore::Update(const PlayerState& state)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            cache_[state.player_id] = state;
+            pending_.push_back(state);
+        }
+        cv_.notify_one();
+    }
+
+    void PlayerStateStore::Release(const PlayerId& playerId)
+    {
+        std::lock_guard lock(mutex_);
+        released_.insert(playerId); // 조회 중에 끊겼어도 -> LoadLoop가 캐시에 넣지 않음
+    }
+
+    void PlayerStateStore::EvictReleased()
+    {
+        std::lock_guard lock(mutex_);
+        if (released_.empty()) return;
+
+        // WAL에만 있는 (dirty_) / 아직 WAL에도 없는 (pending_) 변경이 있으면 다음 주기에
+        std::unordered_set<PlayerId, PlayerIdHash> unsaved;
+        for (const auto& state : pending_)
+            unsaved.insert(state.player_id);
+        for (auto it = released_.begin(); it != released_.end();)
+        {
+            if (dirty_.count(*it) || unsaved.count(*it))
+            {
+                ++it;
+                continue;
+            }
+            cache_.erase(*it);
+            it = released_.erase(it);
+        }
+    }
+
+    bool PlayerStateStore::OpenWal(bool truncate)
+    {
+        wal_ = std::fopen(wal_path_.string().c_str(), truncate ? "wb" : "ab");
+        if (!wal_)
+        {
+            spdlog::error("[PlayerState] WAL 열기 실패: {}", wal_path_.string());
+            return false;
+        }
+        return true;
+    }
+
+    size_t PlayerStateStore::ReplayWal(uint64_t& validBytes)
+    {
+        validBytes = 0;
+        std::FILE* file = std::fopen(wal_path_.string().c_str(), "rb");
+        if (!file) return 0;
+
+        size_t count = 0;
+        WalRecord record;
+        while (std::fread(&record, sizeof(record), 1, file) == 1)
+        {
+            if (record.checksum != Checksum(record.state))
+            {
+                spdlog::warn("[PlayerState] WAL 레코드 손상 -> {}번째 이후 무시", count);
+                break;
+            }
+            dirty_[record.state.player_id] = record.state;
+            cache_[record.state.player_id] = record.state;
+            ++count;
+        }
+        validBytes = static_cast<uint64_t>(count) * sizeof(WalRecord);
+        std::fclose(file);
+        return count;
+    }
+
+    void PlayerStateStore::CommitWal(const std::vector<PlayerState>& group)
+    {
+        std::vector<WalRecord> records(group.size());
+        for (size_t i = 0; i < group.size(); ++i)
+            records[i] = { Checksum(group[i]), group[i] };
+
+        if (std::fwrite(records.data(), sizeof(WalRecord), records.size(), wal_) != records.size() || !SyncFile(wal_))
+            spdlog::error("[PlayerState] WAL 기록 실패 ({} records) -> 백엔드 저장 전 크래시 시 유실 가능", records.size());
+
+        wal_commits_.fetch_add(1, std::memory_order_relaxed);
+        wal_records_.fetch_add(group.size(), std::memory_order_relaxed);
+        StoreMax(wal_max_group_, group.size());
+    }
+
+    void PlayerStateStore::FlushBackend()
+    {
+        if (dirty_.empty()) return;
+
+        std::vector<PlayerState> batch;
+        batch.reserve(dirty_.size());
+        for (const auto& [id, state] : dirty_)
+            batch.push_back(state);
+
+        auto start = std::chrono::steady_clock::now();
+        bool ok = backend_.SaveBatch(batch);
+        auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        flush_last_us_.store(elapsed, std::memory_order_relaxed);
+        flush_total_us_.fetch_add(elapsed, std::memory_order_relaxed);
+        StoreMax(flush_max_us_, elapsed);
+        if (!ok)
+        {
+            backend_failures_.fetch_add(1, std::memory_order_relaxed);
+            spdlog::warn("[PlayerState] 백엔드 저장 실패 ({} records) -> 다음 주기에 재시도", batch.size());
+            return;
+        }
+
+        backend_flushes_.fetch_add(1, std::memory_order_relaxed);
+        backend_records_.fetch_add(batch.size(), std::memory_order_relaxed);
+        StoreMax(backend_max_batch_, batch.size());
+        dirty_.clear();
+
+        // WAL의 모든 레코드가 백엔드에 반영됨 -> 비움 (재생할 것 없음)
+        if (wal_)
+        {
+            std::fclose(wal_);
+            OpenWal(true);
+        }
+    }
+
+    void PlayerStateStore::FlushLoop()
+    {
+        auto nextFlush = std::chrono::steady_clock::now() + BACKEND_FLUSH_INTERVAL;
+        std::vector<PlayerState> group;
+        for (;;)
+        {
+            bool stopping;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait_until(lock, nextFlush, [this] { return stop_ || !pending_.empty(); });
+
+                // 그룹 커밋: 첫 레코드 이후 잠깐 더 기다려 fsync 한 번에 묶음
+                if (!stop_ && !pending_.empty())
+                    cv_.wait_for(lock, GROUP_COMMIT_WINDOW, [this] { return stop_ || pending_.size() >= MAX_GROUP_SIZE; });
+
+                group.swap(pending_);
+                stopping = stop_;
+            }
+
+            if (!group.empty() && wal_)
+            {
+                CommitWal(group);
+                for (const auto& state : group)
+                    dirty_[state.player_id] = state;
+                group.clear();
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (stopping || now >= nextFlush || dirty_.size() >= BACKEND_BATCH_SIZE)
+            {
+                FlushBackend();
+                EvictReleased();
+                nextFlush = now + BACKEND_FLUSH_INTERVAL;
+            }
+            if (stopping) break;
+        }
+    }
+
+    PlayerStateStore::Stats PlayerStateStore::GetStats() const
+    {
+        Stats stats{};
+        stats.wal_commits = wal_commits_.load(std::memory_order_relaxed);
+        stats.wal_records = wal_records_.load(std::memory_order_relaxed);
+        stats.wal_max_group = wal_max_group_.load(std::memory_order_relaxed);
+        stats.backend_flushes = backend_flushes_.load(std::memory_order_relaxed);
+        stats.backend_records = backend_records_.load(std::memory_order_relaxed);
+        stats.backend_failures = backend_failures_.load(std::memory_order_relaxed);
+        stats.backend_max_batch = backend_max_batch_.load(std::memory_order_relaxed);
+        stats.flush_last_us = flush_last_us_.load(std::memory_order_relaxed);
+        stats.flush_max_us = flush_max_us_.load(std::memory_order_relaxed);
+        stats.flush_total_us = flush_total_us_.load(std::memory_order_relaxed);
+        std::lock_guard lock(mutex_);
+        stats.cached = cache_.size();
+        stats.released = released_.size();
+        return stats;
+    }
+}
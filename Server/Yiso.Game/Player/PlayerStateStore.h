@@ -0,0 +1,101 @@
+#pragma once
+#include "PlayerStateBackend.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Yiso::Game
+{
+    // 플레이어 상태 write-behind 저장소
+    // - Update: 메모리에 즉시 반영 후 대기열에 넣고 바로 반환 (io 스레드는 디스크/DB를 기다리지 않음)
+    // - 백그라운드 스레드: 대기열을 모아 WAL에 한 번에 기록 + fsync (그룹 커밋)
+    //                     -> 플레이어별 최신 상태만 남겨 주기적으로 백엔드에 배치 저장 -> 성공하면 WAL 비움
+    // - 시작 시 WAL에 남은 레코드(백엔드 반영 전 크래시)를 재생
+    // - Load: 캐시에 없으면 조회 스레드에서 백엔드를 읽음 -> 로직 스레드는 저장소 조회도 기다리지 않음
+    // - Release: 접속을 끊은 플레이어는 백엔드에 반영되고 대기 중인 변경이 없을 때 캐시에서 뺌 (백엔드 저장 주기마다)
+    class PlayerStateStore
+    {
+    public:
+        struct Stats
+        {
+            uint64_t wal_commits; // fsync 횟수
+            uint64_t wal_records;
+            uint64_t wal_max_group; // 한 번의 fsync에 묶인 최대 레코드 수
+            uint64_t backend_flushes;
+            uint64_t backend_records;
+            uint64_t backend_failures;
+            uint64_t backend_max_batch;
+            uint64_t flush_last_us; // 백엔드 배치 저장 소요 시간
+            uint64_t flush_max_us;
+            uint64_t flush_total_us;
+            size_t cached; // 캐시에 있는 플레이어 수
+            size_t released; // 접속을 끊고 캐시에서 빠지길 기다리는 수
+        };
+
+        static constexpr auto GROUP_COMMIT_WINDOW = std::chrono::milliseconds(5); // 첫 레코드 이후 이만큼 더 모아서 fsync
+        static constexpr auto BACKEND_FLUSH_INTERVAL = std::chrono::seconds(1);
+        static constexpr size_t MAX_GROUP_SIZE = 1024;
+        static constexpr size_t BACKEND_BATCH_SIZE = 256; // 변경된 플레이어가 이만큼 쌓이면 주기 전이라도 저장
+
+        PlayerStateStore(PlayerStateBackend& backend, std::filesystem::path walPath);
+        ~PlayerStateStore();
+
+        bool Start(); // WAL 재생 -> 백엔드 반영 -> 백그라운드 스레드 시작
+        void Stop(); // 남은 변경을 모두 WAL + 백엔드에 반영하고 종료
+
+        // 메모리 캐시 -> 없으면 조회 스레드에서 백엔드를 읽어 캐시 (found: 저장된 적 있는 플레이어)
+        // done은 캐시 적중이면 호출자 스레드에서 바로, 아니면 조회 스레드에서 -> 로직으로 넘기는 건 호출자
+        using OnLoaded = std::function<void(bool found, const PlayerState& state)>;
+        void Load(const PlayerId& playerId, OnLoaded done);
+        void Update(const PlayerState& state);
+        void Release(const PlayerId& playerId); // 접속 종료 (마지막 Update 뒤에), 다시 Load하면 취소
+
+        Stats GetStats() const;
+
+    private:
+        void FlushLoop();
+        void LoadLoop();
+        bool OpenWal(bool truncate);
+        void CommitWal(const std::vector<PlayerState>& group);
+        void FlushBackend();
+        void EvictReleased(); // 백그라운드 스레드, 백엔드 저장 뒤
+        size_t ReplayWal(uint64_t& validBytes); // validBytes: 마지막 온전한 레코드까지의 길이
+
+        PlayerStateBackend& backend_;
+        std::filesystem::path wal_path_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::unordered_map<PlayerId, PlayerState, PlayerIdHash> cache_;
+        std::vector<PlayerState> pending_; // WAL 기록 대기
+        std::vector<std::pair<PlayerId, OnLoaded>> loads_; // 백엔드 조회 대기
+        std::unordered_set<PlayerId, PlayerIdHash> released_; // 접속 종료 -> 반영이 끝나면 cache_에서 뺌
+        std::condition_variable load_cv_;
+        bool stop_ = false;
+
+        // 아래는 백그라운드 스레드 전용 (Start 이전 재생 단계 제외)
+        std::FILE* wal_ = nullptr;
+        std::unordered_map<PlayerId, PlayerState, PlayerIdHash> dirty_; // WAL에는 있고 백엔드에는 아직 없는 최신 상태
+        std::thread flusher_;
+        std::thread loader_;
+
+        std::atomic<uint64_t> wal_commits_{0};
+        std::atomic<uint64_t> wal_records_{0};
+        std::atomic<uint64_t> wal_max_group_{0};
+        std::atomic<uint64_t> backend_flushes_{0};
+        std::atomic<uint64_t> backend_records_{0};
+        std::atomic<uint64_t> backend_failures_{0};
+        std::atomic<uint64_t> backend_max_batch_{0};
+        std::atomic<uint64_t> flush_last_us_{0};
+        std::atomic<uint64_t> flush_max_us_{0};
+        std::atomic<uint64_t> flush_total_us_{0};
+    };
+}
@@ -1,14 +1,133 @@
+#include "Auth/LoginGate.h"
+#include "Auth/RedisSessionBackend.h"
+#include "Chat/ChatCluster.h"
 #include "Chat/ChatHandler.h"
+#include "Chat/RedisChatBus.h"
+#include "Content/ContentStore.h"
+#include "Dojo/DojoHandler.h"
+#include "Logic/LogicLoop.h"
+#include "Map/MapHandler.h"
+#include "Player/PlayerStateStore.h"
+#include "Network/AllocAccounting.h"
+#include "Network/BufferPool.h"
+#include "Network/HotRestart.h"
 #include "Network/Logger.h"
+#include "Network/PacketCapture.h"
+#include "Network/Tracer.h"
 #include "Network/YisoServer.h"
 #include <boost/asio.hpp>
 #include <spdlog/spdlog.h>
+#include <csignal>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#ifdef _WIN32
 #include <windows.h>
+#endif
+
+namespace
+{
+    constexpr int FILTER_RELOAD_INTERVAL_SEC = 5;
+    constexpr int STATS_LOG_INTERVAL_SEC = 60;
+    constexpr const char* CONTENT_FILE = "content.bin";
+    constexpr const char* MAP_CONTENT_DIR = "maps";
+    constexpr const char* PLAYER_DATA_DIR = "player_data";
+    constexpr const char* PLAYER_WAL_FILE = "player_state.wal";
+    constexpr size_t DOJO_CAPACITY = 10000; // 동시 무한 도장 인스턴스 수 (시작 시 전부 할당)
+    constexpr size_t LOGIC_PARTITIONS = 1; // 게임 로직 스레드 수 (세션 ID로 분배)
+    constexpr const char* TRACE_SAMPLE_ENV = "YISO_TRACE_SAMPLE"; // 패킷 N개 중 1개 추적 (없거나 0이면 끔)
+    constexpr const char* CAPTURE_ENV = "YISO_CAPTURE"; // 값이 있으면 그 경로에 와이어 프레임 캡처 (Yiso.Replay로 재생)
+    constexpr const char* ALLOC_TABLE_FILE = "alloc_accounting.txt"; // YISO_ALLOC_ACCOUNTING 빌드의 종료 시 집계
+    constexpr size_t MAX_SESSIONS = 100000; // 이 이상이면 새 접속 거절 (S2C_SERVER_BUSY), 80%부터 수락 속도 제한
+    constexpr uint32_t RESUME_GRACE_SEC = 30; // 짧게 끊긴 세션을 방 / 맵 상태 그대로 두고 재접속을 기다리는 시간 (0이면 끔)
+    constexpr const char* NODE_ID_ENV = "YISO_NODE_ID"; // 값이 있으면 클러스터 모드: 이 프로세스의 노드 번호 (1~255)
+    constexpr const char* CLUSTER_NODES_ENV = "YISO_CLUSTER_NODES"; // 전체 노드 번호 "1,2,3" (모든 노드가 같아야 함, 없으면 자기만)
+    constexpr const char* REDIS_ENV = "YISO_REDIS"; // 채팅 버스 Redis "host:port"
+    constexpr const char* DEFAULT_REDIS = "127.0.0.1:6379";
+    constexpr const char* AUTH_ENV = "YISO_AUTH"; // 로그인 인증: "redis" (Yiso.Web 세션 저장소, YISO_REDIS), "local" (AUTH_LOCAL_FILE), 없으면 끔
+    constexpr const char* AUTH_LOCAL_FILE = "auth_sessions.txt"; // local 모드에서 유효한 세션 ID 목록 (한 줄에 "세션 ID [유저 ID]")
+    constexpr auto AUTH_LOCAL_TTL = std::chrono::hours(1);
+    constexpr const char* HANDOFF_ENV = "YISO_HANDOFF"; // 무중단 재시작 Unix 소켓 경로 (Linux, 같은 경로로 새 프로세스를 띄우면 연결째 인계)
+#ifdef _WIN32
+    constexpr int TRACE_DUMP_SIGNAL = SIGBREAK; // Ctrl + Break
+#else
+    constexpr int TRACE_DUMP_SIGNAL = SIGUSR1; // kill -USR1 <pid>
+#endif
+
+    // 추적 덤프 시그널을 받을 때마다 trace_<시각>.json 저장 (signals가 cancel되면 중단)
+    // YISO_ALLOC_ACCOUNTING 빌드면 패킷 종류별 할당/CPU 표 alloc_<시각>.txt도 같이 저장
+    void WaitTraceDump(boost::asio::signal_set& signals)
+    {
+        signals.async_wait([&signals](boost::system::error_code ec, int)
+        {
+            if (ec) return;
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            std::string path = "trace_" + std::to_string(seconds) + ".json";
+            int64_t spans = Yiso::Network::Tracer::DumpChrome(path);
+            if (spans < 0)
+                spdlog::error("[Trace] 덤프 실패: {}", path);
+            else
+                spdlog::info("[Trace] {} 저장 ({} spans, 1/{} 샘플링)", path, spans, Yiso::Network::Tracer::SampleEvery());
+            if (Yiso::Network::AllocAccounting::Enabled())
+            {
+                std::string allocPath = "alloc_" + std::to_string(seconds) + ".txt";
+                int64_t rows = Yiso::Network::AllocAccounting::DumpTable(allocPath);
+                if (rows < 0)
+                    spdlog::error("[Alloc] 덤프 실패: {}", allocPath);
+                else
+                    spdlog::info("[Alloc] {} 저장 ({} 패킷 종류)", allocPath, rows);
+            }
+            WaitTraceDump(signals);
+        });
+    }
+
+    // "1,2,3" -> {1, 2, 3}
+    std::vector<Yiso::Game::ChatCluster::NodeId> ParseNodeList(const char* text)
+    {
+        std::vector<Yiso::Game::ChatCluster::NodeId> nodes;
+        std::string list(text);
+        size_t begin = 0;
+        while (begin <= list.size())
+        {
+            size_t end = list.find(',', begin);
+            if (end == std::string::npos) end = list.size();
+            auto node = static_cast<Yiso::Game::ChatCluster::NodeId>(std::strtoul(list.substr(begin, end - begin).c_str(), nullptr, 10));
+            if (node != 0)
+                nodes.push_back(node);
+            begin = end + 1;
+        }
+        return nodes;
+    }
+
+    // "host:port" -> (host, port), 포트가 없으면 6379
+    std::pair<std::string, uint16_t> ParseRedisAddress(const std::string& address)
+    {
+        size_t colon = address.rfind(':');
+        if (colon == std::string::npos)
+            return { address, 6379 };
+        return { address.substr(0, colon), static_cast<uint16_t>(std::strtoul(address.c_str() + colon + 1, nullptr, 10)) };
+    }
+
+    // io 스레드에서 interval마다 task 실행 (timer가 cancel되면 중단)
+    void SchedulePeriodic(boost::asio::steady_timer& timer, std::chrono::seconds interval, std::function<void()> task)
+    {
+        timer.expires_after(interval);
+        timer.async_wait([&timer, interval, task = std::move(task)](boost::system::error_code ec) mutable
+        {
+            if (ec) return; // Stop() 시 cancel
+            task();
+            SchedulePeriodic(timer, interval, std::move(task));
+        });
+    }
+}
 
 int main(int argc, char* argv[])
 {
+#ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
+#endif
     Yiso::InitLogger();
 
     uint16_t port = 7777;
@@ -27,36 +146,402 @@ int main(int argc, char* argv[])
     {
         boost::asio::io_context io;
 
+        // 무중단 재시작: 이전 프로세스가 있으면 리슨 소켓 / 세션 / 상태를 넘겨받음 (저장소를 놓을 때까지 기다림)
+        const char* handoff_path = std::getenv(HANDOFF_ENV);
+        Yiso::Network::HotRestart hot_restart;
+        Yiso::Network::HotRestart::Package handoff;
+        bool took_over = handoff_path && Yiso::Network::HotRestart::Receive(handoff_path, handoff);
+
         // ChatHandler는 Server의 SessionManager를 참조해야 하므로
         // Server를 먼저 만들고, 이후 ChatHandler 초기화
         std::unique_ptr<Yiso::Game::ChatHandler> chat;
+        std::unique_ptr<Yiso::Game::MapHandler> map;
+        std::unique_ptr<Yiso::Game::DojoHandler> dojo;
+        std::unique_ptr<Yiso::Game::RedisChatBus> chat_bus;
+        std::unique_ptr<Yiso::Game::ChatCluster> cluster;
+        std::unique_ptr<Yiso::Game::SessionBackend> auth_backend;
+        std::unique_ptr<Yiso::Game::TokenValidator> validator;
+        std::unique_ptr<Yiso::Game::LoginGate> login_gate;
+        Yiso::Game::RedisSessionBackend* redis_sessions = nullptr;
+
+        // 핸들러는 로직 스레드에서만 실행, io 스레드는 디코딩된 패킷을 큐에 넣기만 함
+        Yiso::Game::LogicLoop logic(LOGIC_PARTITIONS, {
+            [&chat, &map](auto id, const auto& userId)
+            {
+                if (chat) chat->OnConnected(id);
+                if (map) map->OnConnected(id, userId);
+            },
+            [&chat, &map, &dojo](auto id, auto type, auto data, auto size)
+            {
+                if (chat) chat->OnRecv(id, type, data, size);
+                if (map) map->OnRecv(id, type, data, size);
+                if (dojo) dojo->OnRecv(id, type, data, size);
+            },
+            [&chat, &map, &dojo](auto id)
+            {
+                if (chat) chat->OnDisconnected(id);
+                if (map) map->OnDisconnected(id);
+                if (dojo) dojo->OnDisconnected(id);
+            },
+            [&cluster](auto data, auto size) { if (cluster) cluster->HandleBatch(data, size); }
+        });
+
+        // 과부하 보호: 이벤트 루프 지연 / 로직 큐 / 송신 큐 바이트 / 세션 수 (지연·큐 임계값은 기본값)
+        Yiso::Network::OverloadController::Config overload_config;
+        overload_config.sessions_critical = MAX_SESSIONS;
+        overload_config.sessions_elevated = MAX_SESSIONS * 8 / 10;
+
+        // 세션 재개: 재전송 보관 / 대기 중 송신 큐 한도는 기본값
+        Yiso::Network::YisoSession::ResumeConfig resume_config;
+        resume_config.grace_sec = RESUME_GRACE_SEC;
+
+        // 로직 큐가 가득 참 -> 패킷을 버리면 상태가 어긋나므로 그 세션을 끊음 (끊김 작업은 항상 큐에 들어감)
+        Yiso::Network::YisoSessionManager* session_manager = nullptr;
+        auto post_recv = [&logic, &session_manager](auto id, auto type, auto data, auto size)
+        {
+            if (logic.PostRecv(id, type, data, size)) return;
+            spdlog::warn("[Logic] 로직 큐 가득 참, 세션 {} 연결 종료", id);
+            if (auto session = session_manager->Find(id))
+                session->Disconnect();
+        };
 
         Yiso::Network::YisoServer server(
             io,
             port,
-            [&chat](auto id) { if (chat) chat->OnConnected(id); },
-            [&chat](auto id, auto type, auto data, auto size) { if (chat) chat->OnRecv(id, type, data, size); },
-            [&chat](auto id) { if (chat) chat->OnDisconnected(id); }
+            [&logic, &login_gate](auto id) { if (login_gate) login_gate->OnConnect(id); else logic.PostConnect(id); },
+            [&post_recv, &login_gate](auto id, auto type, auto data, auto size)
+            {
+                if (login_gate) login_gate->OnRecv(id, type, data, size);
+                else post_recv(id, type, data, size);
+            },
+            [&logic, &login_gate](auto id) { if (login_gate) login_gate->OnDisconnect(id); else logic.PostDisconnect(id); },
+            overload_config,
+            resume_config,
+            took_over ? handoff.listen_fd : -1
         );
+        session_manager = &server.GetSessionManager();
+        server.GetOverload().SetLogicProbe([&logic]()
+        {
+            auto load = logic.GetLoad();
+            return Yiso::Network::OverloadController::LogicLoad{ load.queue_depth, load.oldest_wait_us };
+        });
+
+        // 클러스터 모드: 여러 게임 프로세스가 Redis pub/sub로 글로벌 채팅 / 귓속말 / 방을 공유
+        // 세션 / 방 ID는 노드 번호로 나눠 써서 프로세스끼리 겹치지 않음
+        if (const char* node_id = std::getenv(NODE_ID_ENV))
+        {
+            Yiso::Game::ChatCluster::Config cluster_config;
+            cluster_config.node_id = static_cast<Yiso::Game::ChatCluster::NodeId>(std::strtoul(node_id, nullptr, 10));
+            const char* nodes = std::getenv(CLUSTER_NODES_ENV);
+            cluster_config.nodes = nodes ? ParseNodeList(nodes) : std::vector<Yiso::Game::ChatCluster::NodeId>{ cluster_config.node_id };
+
+            auto [redis_host, redis_port] = ParseRedisAddress(std::getenv(REDIS_ENV) ? std::getenv(REDIS_ENV) : DEFAULT_REDIS);
+            chat_bus = std::make_unique<Yiso::Game::RedisChatBus>(io, redis_host, redis_port);
+            cluster = std::make_unique<Yiso::Game::ChatCluster>(io, *chat_bus, cluster_config);
+            server.SetSessionIdSpace(cluster_config.node_id, Yiso::Game::ChatCluster::ID_STRIDE);
+        }
+
+        // 로그인 인증: 로그인 전 세션은 로직에 알리지 않음 (LoginGate)
+        // 토큰 검증은 캐시 + 같은 토큰 합치기 + 배치 조회로 로그인 폭주 때도 저장소에 가는 요청을 줄임
+        if (const char* auth = std::getenv(AUTH_ENV))
+        {
+            std::string mode = auth;
+            if (mode == "redis")
+            {
+                auto [redis_host, redis_port] = ParseRedisAddress(std::getenv(REDIS_ENV) ? std::getenv(REDIS_ENV) : DEFAULT_REDIS);
+                auto backend = std::make_unique<Yiso::Game::RedisSessionBackend>(io, redis_host, redis_port);
+                if (!backend->Start())
+                {
+                    spdlog::critical("[Server] 세션 저장소 연결 시작 실패");
+                    return 1;
+                }
+                redis_sessions = backend.get();
+                auth_backend = std::move(backend);
+            }
+            else if (mode == "local")
+            {
+                auto backend = std::make_unique<Yiso::Game::LocalSessionBackend>(io, std::chrono::milliseconds(0));
+                size_t count = backend->LoadFile(AUTH_LOCAL_FILE, AUTH_LOCAL_TTL);
+                spdlog::info("[Auth] 로컬 세션 저장소 ({}개, {})", count, AUTH_LOCAL_FILE);
+                auth_backend = std::move(backend);
+            }
+            else
+            {
+                spdlog::critical("[Server] 알 수 없는 {}={} (redis / local)", AUTH_ENV, mode);
+                return 1;
+            }
+
+            validator = std::make_unique<Yiso::Game::TokenValidator>(io, *auth_backend);
+            login_gate = std::make_unique<Yiso::Game::LoginGate>(io, server.GetSessionManager(), *validator, Yiso::Game::LoginGate::Handlers{
+                [&logic](auto id, const auto& userId) { logic.PostConnect(id, userId); },
+                post_recv,
+                [&logic](auto id) { logic.PostDisconnect(id); }
+            });
+            login_gate->Start();
+        }
 
         // io.run() 전에 초기화하므로 콜백 호출 전 보장됨
-        chat = std::make_unique<Yiso::Game::ChatHandler>(server.GetSessionManager());
-        
+        chat = std::make_unique<Yiso::Game::ChatHandler>(server.GetSessionManager(), server.GetOverload(), cluster.get());
+        if (cluster && !cluster->Start([&logic](auto batch) { logic.PostRemote(std::move(batch)); }))
+        {
+            spdlog::critical("[Server] 채팅 클러스터 시작 실패");
+            return 1;
+        }
+
+        // 패킹된 콘텐츠 파일(mmap)이 있으면 사용, 없으면 개발용 텍스트 맵 폴더에서 요청 시 로드
+        Yiso::Game::ContentStore content_store;
+        Yiso::Game::TextMapContentSource text_map_content(MAP_CONTENT_DIR);
+        Yiso::Game::MapContentSource& map_content = content_store.Open(CONTENT_FILE)
+            ? static_cast<Yiso::Game::MapContentSource&>(content_store)
+            : text_map_content;
+        Yiso::Game::MapDataService map_data(map_content);
+        Yiso::Game::MapGraph map_graph(map_data); // 포탈 근처 맵 프리페치 대상 예측
+        map_graph.LoadChapters(map_content);
+
+        // 플레이어 상태: 메모리 즉시 반영 + WAL 그룹 커밋 + 백그라운드 배치 저장 (DB 연동 전까지 파일 백엔드)
+        Yiso::Game::FilePlayerStateBackend player_backend(PLAYER_DATA_DIR);
+        Yiso::Game::PlayerStateStore player_states(player_backend, PLAYER_WAL_FILE);
+        if (!player_states.Start())
+        {
+            spdlog::critical("[Server] 플레이어 상태 저장소 시작 실패");
+            return 1;
+        }
+
+        map = std::make_unique<Yiso::Game::MapHandler>(server.GetSessionManager(), map_data, map_graph, player_states,
+            [&logic](auto id, auto task) { logic.PostTask(id, std::move(task)); });
+
+        // 무한 도장: io 스레드 1개를 뺀 나머지 코어에 인스턴스 틱 분산
+        size_t dojo_workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        Yiso::Game::DojoManager dojo_manager(DOJO_CAPACITY, std::max<size_t>(dojo_workers, 1));
+        dojo_manager.Start();
+        dojo = std::make_unique<Yiso::Game::DojoHandler>(dojo_manager, *map);
+
+        // 상태 블록: 채팅 -> 클러스터 디렉터리 -> 맵 -> 로그인 (없으면 빈 블록) -> 세션 (마지막에 읽기 / 쓰기 시작)
+        // 블록마다 길이가 붙어 있어 한 블록이 깨져도 세션 인계는 항상 진행 (넘겨받은 소켓을 놓치지 않게)
+        if (took_over)
+        {
+            Yiso::Network::HandoffReader reader(handoff.state.data(), handoff.state.size());
+            const uint8_t* chat_state = nullptr;
+            const uint8_t* directory = nullptr;
+            const uint8_t* map_state = nullptr;
+            const uint8_t* login = nullptr;
+            uint32_t chat_size = 0, directory_size = 0, map_size = 0, login_size = 0;
+            bool ok = reader.GetBytes(chat_state, chat_size) && reader.GetBytes(directory, directory_size) &&
+                      reader.GetBytes(map_state, map_size) && reader.GetBytes(login, login_size);
+
+            Yiso::Network::HandoffReader chat_reader(chat_state, chat_size);
+            ok = chat->ImportHandoff(chat_reader) && ok;
+            if (cluster && directory_size > 0)
+            {
+                Yiso::Network::HandoffReader directory_reader(directory, directory_size);
+                ok = cluster->ImportHandoff(directory_reader) && ok;
+            }
+            Yiso::Network::HandoffReader map_reader(map_state, map_size);
+            ok = map->ImportHandoff(map_reader) && ok;
+
+            // 가져가지 못한 소켓은 여기서 닫힘, 상태가 깨진 세션은 lost -> 로그인 상태까지 복원한 뒤 로직에 끊김으로
+            std::vector<Yiso::Network::YisoSession::SessionId> lost;
+            ok = server.ImportHandoff(reader, handoff.fds, lost) && ok;
+
+            if (login_size > 0)
+            {
+                // 이전 프로세스는 인증을 켰음 -> 켠 채면 그대로, 껐으면 로그인 전이던 세션을 이제 로직에 알림
+                Yiso::Network::HandoffReader login_reader(login, login_size);
+                if (login_gate)
+                    ok = login_gate->ImportHandoff(login_reader) && ok;
+                else
+                    for (auto id : Yiso::Game::LoginGate::WaitingInHandoff(login_reader))
+                        logic.PostConnect(id);
+            }
+            else if (login_gate)
+            {
+                login_gate->AdmitAll(); // 인증 없이 받은 세션
+            }
+            for (auto id : lost)
+            {
+                if (login_gate) login_gate->OnDisconnect(id);
+                else logic.PostDisconnect(id);
+            }
+
+            // 도장 인스턴스는 넘기지 않음 -> 도장에 있던 플레이어는 거점으로
+            dojo->ReturnAfterHandoff();
+            if (!ok)
+                spdlog::error("[HotRestart] 인계 상태 일부를 읽지 못함 (받은 만큼으로 계속)");
+        }
+        logic.Start();
+
+        // 금칙어 파일 핫 리로드: 주기적으로 수정 시각만 확인 -> 바뀌었으면 오토마톤 재컴파일 후 교체
+        boost::asio::steady_timer filter_reload_timer(io);
+        SchedulePeriodic(filter_reload_timer, std::chrono::seconds(FILTER_RELOAD_INTERVAL_SEC), [&chat]()
+        {
+            chat->GetFilter().ReloadIfChanged();
+        });
+
+        boost::asio::steady_timer stats_timer(io);
+        SchedulePeriodic(stats_timer, std::chrono::seconds(STATS_LOG_INTERVAL_SEC), [&server, &map_data, &map, &player_states, &dojo_manager, &logic, &cluster, &chat_bus, &login_gate, &validator, &redis_sessions]()
+        {
+            auto o = server.GetOverload().GetStats();
+            spdlog::info("[Stats] overload level={} lag_us={} logic_queue={} logic_wait_us={} send_queue_bytes={} transitions={} rejected_accepts={} shed_presence={} shed_global_chat={} rejected_joins={}",
+                Yiso::Network::OverloadController::LevelName(o.level), o.lag_us, o.logic_queue_depth, o.logic_wait_us, o.send_queue_bytes, o.transitions,
+                o.rejected_accepts, o.shed_presence, o.shed_global_chat, o.rejected_joins);
+            auto pool = server.GetPoolStats();
+            spdlog::info("[Stats] sessions={} pool_blocks={} in_use={} block_size={}",
+                server.GetSessionManager().Count(), pool.blocks, pool.in_use, pool.block_size);
+            auto envelope = Yiso::Network::YisoSession::GetEnvelopeStats();
+            spdlog::info("[Stats] envelope connections={} recv={} recv_items={} sent={} sent_items={} sent_bytes={} plain_bytes={}",
+                envelope.connections, envelope.received, envelope.received_items, envelope.sent, envelope.sent_items,
+                envelope.sent_bytes, envelope.plain_bytes);
+            auto buffers = Yiso::Network::BufferPool::GetStats();
+            std::string peaks; // 쓰인 등급만: 크기:최대 보유 블록
+            for (const auto& c : buffers.classes)
+                if (c.high_water > 0)
+                    peaks += " " + std::to_string(c.size) + ":" + std::to_string(c.high_water);
+            spdlog::info("[Stats] buffer_pool allocs={} hit_rate={:.1f}% live_bytes={} held_bytes={} remote_frees={} oversize={} high_water=[{} ]",
+                buffers.allocs, buffers.allocs > 0 ? 100.0 * static_cast<double>(buffers.hits) / static_cast<double>(buffers.allocs) : 0.0,
+                buffers.live_bytes, buffers.held_bytes, buffers.remote_frees, buffers.oversize_allocs, peaks);
+            auto stats = map_data.GetStats();
+            spdlog::info("[Stats] map_data hit={} miss={} load_fail={} negative_hit={} maps={} bytes={}",
+                stats.hits, stats.misses, stats.load_failures, stats.negative_hits, stats.cached_maps, stats.cached_bytes);
+            auto state = map->GetStats();
+            spdlog::info("[Stats] map_prefetch sent={} bytes={} deduped={} throttled={}",
+                state.prefetch_sent, state.prefetch_bytes, state.prefetch_deduped, state.prefetch_throttled);
+            auto save = player_states.GetStats();
+            spdlog::info("[Stats] player_state wal_commits={} wal_records={} max_group={} flushes={} records={} fail={} max_batch={} flush_us(last/max/avg)={}/{}/{} cached={} released={}",
+                save.wal_commits, save.wal_records, save.wal_max_group, save.backend_flushes, save.backend_records,
+                save.backend_failures, save.backend_max_batch, save.flush_last_us, save.flush_max_us,
+                save.backend_flushes + save.backend_failures > 0 ? save.flush_total_us / (save.backend_flushes + save.backend_failures) : 0,
+                save.cached, save.released);
+            auto d = dojo_manager.GetStats();
+            spdlog::info("[Stats] dojo active={}/{} workers={} instances/worker={} cpu_per_instance_tick_ns={} overruns={} skipped_ticks={} jitter_us(avg/max)={}/{}",
+                d.active, d.capacity, d.workers, d.active / d.workers, d.instance_ticks > 0 ? d.instance_cpu_ns / d.instance_ticks : 0,
+                d.budget_overruns, d.skipped_ticks, d.jitter_avg_us, d.jitter_max_us);
+            auto l = logic.GetStats();
+            spdlog::info("[Stats] logic partitions={} jobs={} batches={} max_batch={} queue_wait_us(avg/max)={}/{} rejected={}",
+                l.partitions, l.jobs, l.batches, l.max_batch, l.queue_wait_avg_us, l.queue_wait_max_us, l.rejected);
+            if (cluster)
+            {
+                auto c = cluster->GetStats();
+                auto r = chat_bus->GetStats();
+                spdlog::info("[Stats] cluster node={} directory={} batches_out={} records_out={} bytes_out={} batches_in={} records_in={} nodes_lost={}",
+                    cluster->Self(), c.directory_size, c.batches_out, c.records_out, c.bytes_out, c.batches_in, c.records_in, c.nodes_lost);
+                spdlog::info("[Stats] redis published={} bytes={} received={} bytes={} dropped={} reconnects={} errors={}",
+                    r.published, r.published_bytes, r.received, r.received_bytes, r.dropped, r.reconnects, r.errors);
+            }
+            if (login_gate)
+            {
+                auto g = login_gate->GetStats();
+                auto v = validator->GetStats();
+                spdlog::info("[Stats] login ok={} fail={} unavailable={} dropped_packets={} kicked={} waiting={}",
+                    g.succeeded, g.failed, g.unavailable, g.dropped_packets, g.kicked, g.waiting);
+                spdlog::info("[Stats] token_validator requests={} cache_hits={} coalesced={} backend_batches={} backend_keys={} unavailable={} cache={} in_flight={}",
+                    v.requests, v.cache_hits, v.coalesced, v.backend_batches, v.backend_keys, v.unavailable, v.cache_size, v.in_flight);
+            }
+            if (redis_sessions)
+            {
+                auto a = redis_sessions->GetStats();
+                spdlog::info("[Stats] session_store batches={} keys={} unavailable={} reconnects={} errors={}",
+                    a.batches, a.keys, a.unavailable, a.reconnects, a.errors);
+            }
+        });
+
+        if (const char* sample = std::getenv(TRACE_SAMPLE_ENV))
+        {
+            Yiso::Network::Tracer::SetSampleEvery(static_cast<uint32_t>(std::strtoul(sample, nullptr, 10)));
+            spdlog::info("[Trace] 패킷 추적 1/{} 샘플링", Yiso::Network::Tracer::SampleEvery());
+        }
+        Yiso::Network::PacketCapture capture;
+        if (const char* capturePath = std::getenv(CAPTURE_ENV))
+            capture.Start(capturePath);
+
+        boost::asio::signal_set trace_signals(io, TRACE_DUMP_SIGNAL);
+        WaitTraceDump(trace_signals);
+
         // SIGINT (2) : Ctrl + C
         // SIGTERM (15): 프로세스 종료 요청 (kill 등)
         // SIGKILL (9) : 강제 종료 (catch 불가)
         // SIGHUP (1) : 터미널 종료 / 설정 리로드
         // -> 그 중, SIGINT, SIGTERM 수신 시 Graceful Shutdown
         boost::asio::signal_set signals(io, SIGINT, SIGTERM);
-        signals.async_wait([&server](boost::system::error_code, int signo)
+        bool handed_off = false;
+
+        // 다음 프로세스의 인계 요청: 세션을 멈추고 -> 로직 큐를 비운 뒤 -> 상태 + fd 전송
+        // 전송에 실패하면 그대로 계속 (다시 요청을 기다림), 성공하면 이 프로세스는 남은 저장을 마치고 종료
+        std::function<void()> listen_handoff = [&]()
+        {
+            hot_restart.Listen(io, handoff_path, [&]()
+            {
+                int64_t paused_at = Yiso::Network::HotRestart::NowNs();
+                server.BeginHandoff([&, paused_at]()
+                {
+                    boost::asio::post(io, [&, paused_at]() // 로직이 방금 보낸 프레임(post)이 세션 큐에 들어간 뒤
+                    {
+                        logic.Drain();
+                        Yiso::Network::HandoffWriter writer;
+                        Yiso::Network::HotRestart::Package package;
+                        Yiso::Network::HandoffWriter chat_state, directory, map_state, login;
+                        chat->ExportHandoff(chat_state);
+                        if (cluster)
+                            cluster->ExportHandoff(directory);
+                        map->ExportHandoff(map_state);
+                        if (login_gate)
+                            login_gate->ExportHandoff(login);
+                        for (auto* block : { &chat_state, &directory, &map_state, &login })
+                            writer.PutBytes(block->Data().data(), block->Data().size());
+                        server.ExportHandoff(writer, package);
+                        package.state = std::move(writer.Data());
+                        package.paused_at_ns = paused_at;
+
+                        if (!hot_restart.Send(package))
+                        {
+                            server.AbortHandoff();
+                            listen_handoff();
+                            return;
+                        }
+                        handed_off = true;
+                        filter_reload_timer.cancel();
+                        stats_timer.cancel();
+                        trace_signals.cancel();
+                        signals.cancel();
+                        if (cluster) cluster->Stop(); // 다음 프로세스가 같은 노드 번호로 다시 구독 (그 사이 발행은 놓침)
+                        if (login_gate) login_gate->Stop();
+                        if (redis_sessions) redis_sessions->Stop();
+                        server.FinishHandoff();
+                        spdlog::info("[HotRestart] 인계 전송 완료 ({} bytes, 멈춘 지 {}us)", package.state.size(),
+                            (Yiso::Network::HotRestart::NowNs() - paused_at) / 1000);
+                    });
+                });
+            });
+        };
+        if (handoff_path)
+            listen_handoff();
+
+        signals.async_wait([&](boost::system::error_code ec, int signo)
         {
+            if (ec) return; // 인계 완료로 cancel
             spdlog::info("[Server] 시그널 수신 (signo={}), Graceful Shutdown 시작...", signo);
+            filter_reload_timer.cancel();
+            stats_timer.cancel();
+            trace_signals.cancel();
+            hot_restart.StopListening();
+            if (cluster) cluster->Stop(); // 모아 둔 배치 발행 후 버스 연결 닫기 (이 노드 세션은 다른 노드가 NODE_TIMEOUT 뒤 정리)
+            if (login_gate) login_gate->Stop();
+            if (redis_sessions) redis_sessions->Stop();
             server.Stop();
             // Stop() 후 진행 중인 비동기 I/O가 모두 에러로 완료되면 io_context 자연 종료
         });
 
+        if (took_over)
+            spdlog::info("[HotRestart] 인계 완료, 멈춘 시간 {}us", (Yiso::Network::HotRestart::NowNs() - handoff.paused_at_ns) / 1000);
         spdlog::info("[Server] 포트 {} 에서 수신 대기 중", port);
         io.run();
+        logic.Stop(); // 남은 패킷 처리 후 로직 스레드 종료 (핸들러가 참조하는 객체보다 먼저)
+        if (Yiso::Network::AllocAccounting::Enabled())
+            Yiso::Network::AllocAccounting::DumpTable(ALLOC_TABLE_FILE);
+        capture.Stop();
+        dojo_manager.Stop();
+        player_states.Stop(); // 남은 변경 저장 후 종료
+        if (handed_off)
+            hot_restart.Finish(); // 다음 프로세스가 저장소를 열어도 됨
         spdlog::info("[Server] 서버 종료");
     }
     catch (std::exception& e)
@@ -0,0 +1,485 @@
+#include "Network/PacketHeader.h"
+#include "Network/PacketCapture.h"
+#include "Network/ChunkAssembler.h"
+#include "Network/Envelope.h"
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 캡처 재생기: YISO_CAPTURE로 남긴 캡처 파일의 클라이언트 프레임을 원래 시간 간격대로 서버에 다시 보냄
+// - 캡처된 세션마다 연결 하나 (copies > 1이면 같은 세션을 여러 벌 복제해 부하를 키움)
+// - speed: 1 = 원래 속도, N = N배속, max = 대기 없이 최대한 빨리
+// - 응답 지연: 캡처에서 같은 세션에 그 요청의 응답 type이 실제로 왔던 요청만, 보낸 뒤 같은 type의 프레임이 올 때까지 측정
+//   (다른 세션이 보낸 채팅 방송 같은 프레임은 짝이 되지 않음, 응답을 기다리는 요청이 여러 개여도 type별로 먼저 보낸 것부터)
+// 사용법:
+//   Yiso.Replay <capture_file> <host> <port> [speed] [copies]
+
+using boost::asio::ip::tcp;
+using namespace Yiso::Network;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    struct Step
+    {
+        uint64_t ts_ns;
+        std::vector<uint8_t> frame; // 헤더 포함 C2S 프레임 그대로
+        std::vector<PacketType> replies; // 캡처에서 실제로 돌아온 응답 type (봉투면 item마다, 없으면 측정 안 함)
+    };
+
+    struct Script
+    {
+        uint32_t session_id = 0;
+        uint64_t open_ns = UINT64_MAX;
+        uint64_t close_ns = UINT64_MAX; // UINT64_MAX = 캡처 안에서 닫히지 않음
+        std::vector<Step> steps;
+    };
+
+    // 요청 -> 그 요청에 직접 답하는 S2C type (UNKNOWN = 응답 없는 요청)
+    PacketType ReplyTypeOf(PacketType request)
+    {
+        switch (request)
+        {
+        case PacketType::C2S_CHAT: return PacketType::S2C_CHAT;
+        case PacketType::C2S_WHISPER: return PacketType::S2C_WHISPER;
+        case PacketType::C2S_CREATE_ROOM: return PacketType::S2C_CREATE_ROOM;
+        case PacketType::C2S_DELETE_ROOM: return PacketType::S2C_DELETE_ROOM;
+        case PacketType::C2S_JOIN_ROOM: return PacketType::S2C_JOIN_ROOM;
+        case PacketType::C2S_LEAVE_ROOM: return PacketType::S2C_LEAVE_ROOM;
+        case PacketType::C2S_ROOM_CHAT: return PacketType::S2C_ROOM_CHAT;
+        case PacketType::C2S_PLAYER_INFO: return PacketType::S2C_PLAYER_INFO;
+        case PacketType::C2S_CHANGE_MAP:
+        case PacketType::C2S_REQUEST_MAP_DATA:
+        case PacketType::C2S_RETREAT_TO_BASE_CAMP:
+        case PacketType::C2S_ENTER_DOJO:
+        case PacketType::C2S_EXIT_DOJO: return PacketType::S2C_MAP_DATA;
+        case PacketType::C2S_ENTER_CHAPTER: return PacketType::S2C_CHAPTER_INFO;
+        case PacketType::C2S_RESUME_SESSION: return PacketType::S2C_RESUME_RESULT;
+        case PacketType::C2S_LOGIN: return PacketType::S2C_LOGIN_RESULT;
+        default: return PacketType::UNKNOWN;
+        }
+    }
+
+    // 캡처 레코드 하나에 이어 붙은 프레임들을 메시지 type 단위로 (봉투는 item마다, 조각은 다 모였을 때 원본 type으로)
+    // 잘린 프레임 / 잘못된 봉투·조각이면 그 뒤는 버림
+    template<typename F>
+    void ForEachMessage(const std::vector<uint8_t>& bytes, ChunkAssembler* assembler, F&& onMessage)
+    {
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= bytes.size())
+        {
+            PacketHeader header;
+            std::memcpy(&header, bytes.data() + offset, HEADER_SIZE);
+            if (offset + HEADER_SIZE + header.body_size > bytes.size()) return;
+            const uint8_t* body = bytes.data() + offset + HEADER_SIZE;
+            offset += HEADER_SIZE + header.body_size;
+
+            auto type = static_cast<PacketType>(header.type);
+            if (type == PacketType::C2S_ENVELOPE || type == PacketType::S2C_ENVELOPE)
+            {
+                EnvelopeReader reader(body, header.body_size);
+                const uint8_t* item;
+                uint32_t itemSize;
+                while (reader.Next(type, item, itemSize) == EnvelopeReader::Result::Item)
+                    onMessage(type);
+            }
+            else if (type == PacketType::C2S_FRAME_CHUNK || type == PacketType::S2C_FRAME_CHUNK)
+            {
+                const uint8_t* message;
+                uint32_t messageSize;
+                if (assembler && assembler->Feed(body, header.body_size, type, message, messageSize) == ChunkAssembler::Result::Complete)
+                    onMessage(type);
+            }
+            else
+            {
+                onMessage(type);
+            }
+        }
+    }
+
+    constexpr size_t MAX_OPEN_REQUESTS = 64; // 세션당 응답을 기다리는 요청 (로드 / 재생 공통)
+
+    bool LoadScripts(const std::string& path, std::vector<Script>& out, uint64_t& records)
+    {
+        PacketCapture::Reader reader;
+        if (!reader.Open(path)) return false;
+
+        // 응답을 아직 못 본 요청 (세션별, 보낸 순서) -> 같은 세션의 S2C 메시지가 같은 type의 가장 오래된 것과 짝
+        struct Open
+        {
+            size_t step;
+            PacketType reply;
+        };
+        struct Loading
+        {
+            Script script;
+            std::deque<Open> open;
+            ChunkAssembler assembler; // S2C 조각 (C2S 조각 요청은 측정하지 않음)
+        };
+
+        std::map<uint32_t, Loading> sessions;
+        PacketCapture::RecordHeader header;
+        std::vector<uint8_t> bytes;
+        while (reader.Next(header, bytes))
+        {
+            ++records;
+            Loading& loading = sessions[header.session_id];
+            Script& script = loading.script;
+            script.session_id = header.session_id;
+            script.open_ns = std::min(script.open_ns, header.ts_ns);
+
+            switch (header.direction)
+            {
+            case PacketCapture::Direction::ClientToServer:
+                script.steps.push_back({ header.ts_ns, bytes, {} });
+                ForEachMessage(bytes, nullptr, [&](PacketType type)
+                {
+                    PacketType reply = ReplyTypeOf(type);
+                    if (reply == PacketType::UNKNOWN) return;
+                    if (loading.open.size() >= MAX_OPEN_REQUESTS)
+                        loading.open.pop_front(); // 끝내 응답이 없던 요청
+                    loading.open.push_back({ script.steps.size() - 1, reply });
+                });
+                break;
+            case PacketCapture::Direction::ServerToClient:
+                ForEachMessage(bytes, &loading.assembler, [&](PacketType type)
+                {
+                    auto it = std::find_if(loading.open.begin(), loading.open.end(), [type](const Open& o) { return o.reply == type; });
+                    if (it == loading.open.end()) return; // 방송 / 다른 세션 때문에 온 프레임
+                    script.steps[it->step].replies.push_back(type);
+                    loading.open.erase(it);
+                });
+                break;
+            case PacketCapture::Direction::Close:
+                script.close_ns = header.ts_ns;
+                break;
+            default:
+                break;
+            }
+        }
+        for (auto& [id, loading] : sessions)
+        {
+            if (!loading.script.steps.empty())
+                out.push_back(std::move(loading.script));
+        }
+        return true;
+    }
+
+    struct Report
+    {
+        uint64_t sessions = 0;
+        uint64_t connect_failures = 0;
+        uint64_t frames_sent = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t frames_received = 0;
+        uint64_t bytes_received = 0;
+        uint64_t unanswered = 0; // 응답을 기다리던 중 연결이 닫힘 / 기다리는 요청이 너무 많아 버림
+        std::vector<uint64_t> latencies_us;
+    };
+
+    class ReplaySession : public std::enable_shared_from_this<ReplaySession>
+    {
+    public:
+        static constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(5); // 마지막 요청의 응답을 기다리는 한도
+
+        ReplaySession(boost::asio::io_context& io, const Script& script, const tcp::endpoint& endpoint,
+                      Clock::time_point base, double speed, Report& report)
+            : socket_(io), timer_(io), script_(script), endpoint_(endpoint), base_(base), speed_(speed), report_(report)
+        {
+        }
+
+        void Start()
+        {
+            auto self = shared_from_this();
+            WaitUntil(script_.open_ns, [this, self]
+            {
+                socket_.async_connect(endpoint_, [this, self](const boost::system::error_code& ec)
+                {
+                    if (ec)
+                    {
+                        ++report_.connect_failures;
+                        return;
+                    }
+                    socket_.set_option(tcp::no_delay(true));
+                    ++report_.sessions;
+                    DoReadHeader();
+                    SendNext();
+                });
+            });
+        }
+
+    private:
+        Clock::time_point Due(uint64_t tsNs) const
+        {
+            if (speed_ <= 0.0) return base_;
+            return base_ + std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(tsNs) / speed_));
+        }
+
+        template<typename F>
+        void WaitUntil(uint64_t tsNs, F&& then)
+        {
+            auto due = Due(tsNs);
+            if (due <= Clock::now())
+            {
+                then();
+                return;
+            }
+            timer_.expires_at(due);
+            timer_.async_wait([then = std::forward<F>(then)](const boost::system::error_code& ec)
+            {
+                if (!ec) then();
+            });
+        }
+
+        void SendNext()
+        {
+            if (next_ >= script_.steps.size())
+            {
+                // 캡처에서 닫힌 시각까지 유지 -> 마지막 응답을 못 받았으면 DRAIN_TIMEOUT까지 더 기다림
+                auto self = shared_from_this();
+                WaitUntil(script_.close_ns != UINT64_MAX ? script_.close_ns : 0, [this, self]
+                {
+                    done_sending_ = true;
+                    if (pending_.empty()) { Finish(); return; }
+                    timer_.expires_after(DRAIN_TIMEOUT);
+                    timer_.async_wait([this, self](const boost::system::error_code& ec)
+                    {
+                        if (!ec) Finish();
+                    });
+                });
+                return;
+            }
+
+            auto self = shared_from_this();
+            WaitUntil(script_.steps[next_].ts_ns, [this, self]
+            {
+                const Step& step = script_.steps[next_];
+                auto now = Clock::now();
+                for (PacketType reply : step.replies)
+                {
+                    if (pending_.size() >= MAX_OPEN_REQUESTS)
+                    {
+                        pending_.pop_front();
+                        ++report_.unanswered;
+                    }
+                    pending_.push_back({ reply, now });
+                }
+                boost::asio::async_write(socket_, boost::asio::buffer(step.frame),
+                    [this, self](const boost::system::error_code& ec, size_t bytes)
+                    {
+                        if (ec) { Finish(); return; }
+                        ++report_.frames_sent;
+                        report_.bytes_sent += bytes;
+                        ++next_;
+                        SendNext();
+                    });
+            });
+        }
+
+        void DoReadHeader()
+        {
+            auto self = shared_from_this();
+            boost::asio::async_read(socket_, boost::asio::buffer(header_buf_, HEADER_SIZE),
+                [this, self](const boost::system::error_code& ec, size_t)
+                {
+                    if (ec) { Finish(); return; }
+                    PacketHeader header;
+                    std::memcpy(&header, header_buf_, HEADER_SIZE);
+                    if (header.body_size > MAX_MESSAGE_SIZE) { Finish(); return; }
+                    type_ = header.type;
+                    body_buf_.resize(header.body_size);
+                    DoReadBody();
+                });
+        }
+
+        void DoReadBody()
+        {
+            auto self = shared_from_this();
+            boost::asio::async_read(socket_, boost::asio::buffer(body_buf_),
+                [this, self](const boost::system::error_code& ec, size_t)
+                {
+                    if (ec) { Finish(); return; }
+                    report_.bytes_received += HEADER_SIZE + body_buf_.size();
+
+                    auto type = static_cast<PacketType>(type_);
+                    if (type == PacketType::S2C_FRAME_CHUNK)
+                    {
+                        const uint8_t* body;
+                        uint32_t bodySize;
+                        auto result = assembler_.Feed(body_buf_.data(), static_cast<uint32_t>(body_buf_.size()), type, body, bodySize);
+                        if (result == ChunkAssembler::Result::Error) { Finish(); return; }
+                        if (result == ChunkAssembler::Result::Complete) OnFrame(type);
+                    }
+                    else if (type == PacketType::S2C_ENVELOPE)
+                    {
+                        // 캡처에 C2S_HELLO가 있었으면 서버가 묶어 보냄 -> item 하나를 프레임 하나로
+                        EnvelopeReader reader(body_buf_.data(), static_cast<uint32_t>(body_buf_.size()));
+                        const uint8_t* item;
+                        uint32_t itemSize;
+                        EnvelopeReader::Result result;
+                        while ((result = reader.Next(type, item, itemSize)) == EnvelopeReader::Result::Item && !finished_)
+                            OnFrame(type);
+                        if (result == EnvelopeReader::Result::Error) { Finish(); return; }
+                    }
+                    else
+                    {
+                        OnFrame(type);
+                    }
+                    if (finished_) return;
+                    DoReadHeader();
+                });
+        }
+
+        void OnFrame(PacketType type)
+        {
+            ++report_.frames_received;
+            auto it = std::find_if(pending_.begin(), pending_.end(), [type](const Pending& p) { return p.reply == type; });
+            if (it == pending_.end()) return; // 방송 등 요청과 짝이 없는 프레임
+            report_.latencies_us.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - it->sent_at).count()));
+            pending_.erase(it);
+            if (done_sending_ && pending_.empty())
+            {
+                timer_.cancel();
+                Finish();
+            }
+        }
+
+        void Finish()
+        {
+            if (finished_) return;
+            finished_ = true;
+            report_.unanswered += pending_.size();
+            pending_.clear();
+            boost::system::error_code ec;
+            timer_.cancel();
+            socket_.shutdown(tcp::socket::shutdown_both, ec);
+            socket_.close(ec);
+        }
+
+        tcp::socket socket_;
+        boost::asio::steady_timer timer_;
+        const Script& script_;
+        tcp::endpoint endpoint_;
+        Clock::time_point base_;
+        double speed_;
+        Report& report_;
+
+        struct Pending
+        {
+            PacketType reply;
+            Clock::time_point sent_at;
+        };
+
+        size_t next_ = 0;
+        std::deque<Pending> pending_; // 응답을 기다리는 요청 (보낸 순서)
+        bool done_sending_ = false;
+        bool finished_ = false;
+
+        uint8_t header_buf_[HEADER_SIZE];
+        uint16_t type_ = 0;
+        std::vector<uint8_t> body_buf_;
+        ChunkAssembler assembler_;
+    };
+
+    uint64_t Percentile(const std::vector<uint64_t>& sorted, double p)
+    {
+        if (sorted.empty()) return 0;
+        size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    if (argc < 4)
+    {
+        std::cerr << "usage: Yiso.Replay <capture_file> <host> <port> [speed: 1|N|max] [copies]\n";
+        return 1;
+    }
+    std::string capturePath = argv[1];
+    std::string host = argv[2];
+    std::string port = argv[3];
+    std::string speedArg = argc > 4 ? argv[4] : "1";
+    double speed = speedArg == "max" ? 0.0 : std::atof(speedArg.c_str());
+    int copies = argc > 5 ? std::atoi(argv[5]) : 1;
+    if ((speedArg != "max" && speed <= 0.0) || copies < 1)
+    {
+        std::cerr << "[Replay] speed는 양수 또는 max, copies는 1 이상\n";
+        return 1;
+    }
+
+    std::vector<Script> scripts;
+    uint64_t records = 0;
+    if (!LoadScripts(capturePath, scripts, records))
+    {
+        std::cerr << "[Replay] 캡처 파일 열기 실패: " << capturePath << "\n";
+        return 1;
+    }
+    // 캡처 시작 ~ 첫 연결 사이의 빈 시간은 건너뜀
+    uint64_t firstOpen = UINT64_MAX;
+    for (const auto& script : scripts)
+        firstOpen = std::min(firstOpen, script.open_ns);
+    size_t totalSteps = 0;
+    for (auto& script : scripts)
+    {
+        script.open_ns -= firstOpen;
+        if (script.close_ns != UINT64_MAX) script.close_ns -= firstOpen;
+        for (auto& step : script.steps)
+            step.ts_ns -= firstOpen;
+        totalSteps += script.steps.size();
+    }
+    std::cout << "[Replay] " << capturePath << ": records=" << records << " sessions=" << scripts.size()
+              << " frames=" << totalSteps << " (x" << copies << ", speed " << speedArg << ")\n";
+    if (scripts.empty()) return 0;
+
+    boost::asio::io_context io;
+    tcp::resolver resolver(io);
+    boost::system::error_code ec;
+    auto endpoints = resolver.resolve(host, port, ec);
+    if (ec || endpoints.empty())
+    {
+        std::cerr << "[Replay] 주소 해석 실패: " << host << ":" << port << "\n";
+        return 1;
+    }
+    tcp::endpoint endpoint = *endpoints.begin();
+
+    Report report;
+    auto base = Clock::now();
+    for (int copy = 0; copy < copies; ++copy)
+    {
+        for (const auto& script : scripts)
+            std::make_shared<ReplaySession>(io, script, endpoint, base, speed, report)->Start();
+    }
+    io.run();
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - base).count();
+    std::sort(report.latencies_us.begin(), report.latencies_us.end());
+    const auto& lat = report.latencies_us;
+
+    std::cout << "[Replay] sessions=" << report.sessions << " connect_failures=" << report.connect_failures
+              << " elapsed=" << elapsed << "s\n"
+              << "  sent: " << report.frames_sent << " frames, " << report.bytes_sent << " bytes ("
+              << (elapsed > 0 ? report.frames_sent / elapsed : 0) << " frames/s)\n"
+              << "  recv: " << report.frames_received << " frames, " << report.bytes_received << " bytes ("
+              << (elapsed > 0 ? report.frames_received / elapsed : 0) << " frames/s)\n"
+              << "  reply latency(us): n=" << lat.size()
+              << " p50=" << Percentile(lat, 0.50) << " p90=" << Percentile(lat, 0.90)
+              << " p99=" << Percentile(lat, 0.99) << " max=" << (lat.empty() ? 0 : lat.back())
+              << " unanswered=" << report.unanswered << "\n";
+    return report.connect_failures == 0 ? 0 : 2;
+}
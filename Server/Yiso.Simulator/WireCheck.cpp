@@ -0,0 +1,178 @@
+#include "WireCheck.h"
+#include "Dojo/DojoHandler.h"
+#include "Map/MapHandler.h"
+#include "Network/PacketCodec.h"
+#include "Network/YisoServer.h"
+#include "Player/PlayerStateStore.h"
+#include "game_packet.pb.h"
+#include <boost/asio.hpp>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+using namespace Yiso::Network;
+using boost::asio::ip::tcp;
+
+namespace
+{
+    constexpr uint32_t BASE_CAMP = Yiso::Game::MapHandler::BASE_CAMP_MAP_ID;
+    constexpr uint32_t DOJO = Yiso::Game::DojoHandler::DOJO_MAP_ID;
+    constexpr auto REPLY_WAIT = std::chrono::seconds(2);
+    constexpr auto ACCEPT_WAIT = std::chrono::milliseconds(10);
+
+    // 거점 / 도장만 있는 맵 콘텐츠
+    class WireMapContent : public Yiso::Game::MapContentSource
+    {
+    public:
+        bool LoadMap(uint32_t mapId, yiso::game::S2C_MapData& out) override
+        {
+            if (mapId != BASE_CAMP && mapId != DOJO) return false;
+            out.set_map_id(mapId);
+            out.set_map_type(mapId == BASE_CAMP ? yiso::game::MAP_TYPE_BASE_CAMP : yiso::game::MAP_TYPE_INFINITE_DOJO);
+            out.mutable_spawn_position()->set_x(static_cast<float>(mapId));
+            out.mutable_spawn_position()->set_y(0.0f);
+            return true;
+        }
+    };
+
+    // 응답 대기는 시한을 두고 (핸들러가 조용히 무시하면 실패로)
+    class WireClient
+    {
+    public:
+        explicit WireClient(uint16_t port)
+            : socket_(io_)
+        {
+            socket_.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+        }
+
+        bool Send(PacketType type, const google::protobuf::Message& msg)
+        {
+            auto frame = PacketCodec::Encode(type, msg);
+            boost::system::error_code ec;
+            boost::asio::write(socket_, boost::asio::buffer(frame.data(), frame.size()), ec);
+            return !ec; // 앞 패킷에서 서버가 끊었으면 실패
+        }
+
+        // expected 타입 프레임이 올 때까지 (다른 프레임은 건너뜀), 끊기거나 시간 초과면 false
+        bool Expect(PacketType expected, std::vector<uint8_t>& body)
+        {
+            auto deadline = std::chrono::steady_clock::now() + REPLY_WAIT;
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                PacketHeader header{};
+                if (!Read(&header, HEADER_SIZE, deadline)) return false;
+                body.resize(header.body_size);
+                if (!Read(body.data(), body.size(), deadline)) return false;
+                if (header.type == static_cast<uint16_t>(expected)) return true;
+            }
+            return false;
+        }
+
+    private:
+        bool Read(void* data, size_t size, std::chrono::steady_clock::time_point deadline)
+        {
+            if (size == 0) return true;
+            boost::system::error_code result = boost::asio::error::timed_out;
+            boost::asio::async_read(socket_, boost::asio::buffer(data, size), [&result](boost::system::error_code ec, size_t) { result = ec; });
+            io_.restart();
+            io_.run_until(deadline);
+            if (!io_.stopped())
+            {
+                socket_.cancel();
+                io_.restart();
+                io_.run(); // 취소된 읽기 완료까지
+                return false;
+            }
+            return !result;
+        }
+
+        boost::asio::io_context io_;
+        tcp::socket socket_;
+    };
+
+    bool Check(const char* name, bool ok)
+    {
+        std::printf("[Sim] wire %-32s %s\n", name, ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    bool ExpectMap(WireClient& client, uint32_t mapId)
+    {
+        std::vector<uint8_t> body;
+        yiso::game::S2C_MapData msg;
+        return client.Expect(PacketType::S2C_MAP_DATA, body) &&
+               msg.ParseFromArray(body.data(), static_cast<int>(body.size())) && msg.map_id() == mapId;
+    }
+}
+
+int RunWireCheck(uint16_t port)
+{
+    auto dataDir = std::filesystem::temp_directory_path() / "yiso-wire-check";
+    std::error_code ec;
+    std::filesystem::remove_all(dataDir, ec);
+    std::filesystem::create_directories(dataDir, ec);
+
+    WireMapContent content;
+    Yiso::Game::MapDataService mapData(content);
+    Yiso::Game::MapGraph mapGraph(mapData);
+    Yiso::Game::FilePlayerStateBackend playerBackend(dataDir / "players");
+    Yiso::Game::PlayerStateStore playerStates(playerBackend, dataDir / "player.wal");
+    if (!playerStates.Start())
+    {
+        std::fprintf(stderr, "[Sim] wire 플레이어 상태 저장소 시작 실패\n");
+        return 1;
+    }
+    Yiso::Game::DojoManager dojoManager(4, 1);
+    dojoManager.Start();
+
+    // 핸들러는 모두 io 스레드에서 (로직 스레드 대신)
+    boost::asio::io_context io;
+    auto guard = boost::asio::make_work_guard(io);
+    std::unique_ptr<YisoServer> server;
+    std::unique_ptr<Yiso::Game::MapHandler> map;
+    std::unique_ptr<Yiso::Game::DojoHandler> dojo;
+    server = std::make_unique<YisoServer>(io, port,
+        [&map](auto id) { map->OnConnected(id, ""); },
+        [&map, &dojo](auto id, auto type, auto data, auto size)
+        {
+            map->OnRecv(id, type, data, size);
+            dojo->OnRecv(id, type, data, size);
+        },
+        [&map, &dojo](auto id)
+        {
+            map->OnDisconnected(id);
+            dojo->OnDisconnected(id);
+        });
+    map = std::make_unique<Yiso::Game::MapHandler>(server->GetSessionManager(), mapData, mapGraph, playerStates,
+        [&io](auto, auto task) { boost::asio::post(io, std::move(task)); });
+    dojo = std::make_unique<Yiso::Game::DojoHandler>(dojoManager, *map);
+    std::thread ioThread([&io] { io.run(); });
+
+    bool ok = true;
+    {
+        WireClient client(port);
+        while (server->GetSessionManager().Count() == 0)
+            std::this_thread::sleep_for(ACCEPT_WAIT);
+
+        std::vector<uint8_t> body;
+        ok = Check("empty PLAYER_INFO -> player data",
+            client.Send(PacketType::C2S_PLAYER_INFO, yiso::game::C2S_RequestPlayerData()) && client.Expect(PacketType::S2C_PLAYER_INFO, body)) && ok;
+        ok = Check("empty RETREAT -> base camp",
+            client.Send(PacketType::C2S_RETREAT_TO_BASE_CAMP, yiso::game::C2S_RetreatToBaseCamp()) && ExpectMap(client, BASE_CAMP)) && ok;
+        ok = Check("empty ENTER_DOJO -> dojo",
+            client.Send(PacketType::C2S_ENTER_DOJO, yiso::game::C2S_EnterDojo()) && ExpectMap(client, DOJO)) && ok;
+        ok = Check("empty EXIT_DOJO -> base camp",
+            client.Send(PacketType::C2S_EXIT_DOJO, yiso::game::C2S_ExitDojo()) && ExpectMap(client, BASE_CAMP)) && ok;
+    }
+
+    boost::asio::post(io, [&server] { server->Stop(); });
+    guard.reset();
+    ioThread.join();
+    dojoManager.Stop();
+    playerStates.Stop();
+    std::filesystem::remove_all(dataDir, ec);
+    std::printf("[Sim] wire %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
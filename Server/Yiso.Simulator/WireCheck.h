@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+// 실제 소켓 점검: 같은 프로세스에 YisoServer + 맵 / 도장 핸들러를 띄우고 루프백 클라이언트로 빈 본문 패킷을 보냄
+// - 필드 없는 메시지 (C2S_RequestPlayerData / C2S_RetreatToBaseCamp / C2S_EnterDojo / C2S_ExitDojo)는 Encode가 0바이트 본문으로 씀
+//   -> 세션이 끊지 않고 핸들러까지 가서 플레이어 정보 / 맵 이동이 오는지 확인
+// - 맵 콘텐츠는 메모리의 거점 / 도장 두 개, 로그인 없이 접속 (플레이어 상태는 저장하지 않음)
+// 반환: 0 = 모두 통과
+int RunWireCheck(uint16_t port);
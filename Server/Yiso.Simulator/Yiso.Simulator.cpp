@@ -0,0 +1,321 @@
+#include "WireCheck.h"
+#include "Chat/ChatHandler.h"
+#include "Network/LoopbackTransport.h"
+#include "Network/OverloadController.h"
+#include "Network/PacketCodec.h"
+#include "Network/SimClock.h"
+#include "Network/YisoSessionManager.h"
+#include "game_packet.pb.h"
+#include <boost/asio.hpp>
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 결정적 시뮬레이터: 소켓 없이 LoopbackTransport + SimClock 위에서 채팅 로직(ChatHandler / ChatRoomManager / YisoSessionManager)을
+// 대규모 세션으로 한 프로세스 한 스레드에서 돌림
+// - 모든 동작은 가상 시계 작업 -> 같은 인자 / 시드면 같은 순서, 같은 결과 (세션별 수신 프레임 digest로 확인)
+// - 단계: 접속 -> 방 생성 / 입장 -> 채팅 라운드 (방 채팅 + 귓속말 + 글로벌) -> 퇴장
+// - 단계별 CPU 시간 / 전달한 프레임 수 출력 -> 네트워크 잡음 없는 로직 계층 벤치마크
+// 사용법:
+//   Yiso.Simulator [sessions] [room_size] [rounds] [seed] [latency_us]
+//   Yiso.Simulator wire [port]   실제 소켓으로 빈 본문 패킷 점검 (WireCheck.h)
+
+using namespace Yiso::Network;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    using SessionId = Connection::SessionId;
+    using Duration = SimClock::Duration;
+
+    constexpr size_t PRESENCE_SESSIONS = 2000; // 이 세션 수부터 접속/퇴장 알림 버림 (서버는 MAX_SESSIONS의 80%) -> 전체 방송이 n²로 커지지 않게
+    constexpr Duration CONNECT_WINDOW = std::chrono::seconds(10);
+    constexpr Duration ROOM_WINDOW = std::chrono::seconds(2);
+    constexpr Duration JOIN_SPREAD = std::chrono::milliseconds(500); // 방이 생긴 뒤 멤버가 들어오는 시간 폭
+    constexpr Duration ROUND_WINDOW = std::chrono::seconds(1);
+    constexpr Duration DISCONNECT_WINDOW = std::chrono::seconds(10);
+    constexpr uint64_t WHISPER_PERCENT = 10; // 라운드마다 귓속말 보내는 세션 비율
+    constexpr uint64_t GLOBAL_PER_ROUND = 1; // 라운드마다 글로벌 채팅 수 (세션 수만큼 퍼짐)
+
+    constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    uint64_t Fnv(uint64_t hash, const void* data, size_t size)
+    {
+        auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * FNV_PRIME;
+        return hash;
+    }
+
+    struct Client
+    {
+        uint32_t group = 0;
+        uint32_t room_id = 0;
+        uint64_t frames = 0;
+        uint64_t digest = FNV_OFFSET; // 이 세션이 받은 프레임 (타입 + 본문) 순서대로
+    };
+
+    class Simulator
+    {
+    public:
+        Simulator(size_t sessions, size_t roomSize, Duration latency, uint64_t seed)
+            : overload_(io_, sessions_, OverloadConfig()),
+              chat_(sessions_, overload_),
+              transport_(clock_, sessions_,
+                  {
+                      [this](SessionId id) { chat_.OnConnected(id); },
+                      [this](SessionId id, PacketType type, const uint8_t* data, uint32_t size) { chat_.OnRecv(id, type, data, size); },
+                      [this](SessionId id) { chat_.OnDisconnected(id); },
+                  },
+                  {
+                      [this](SessionId id, PacketType type, const uint8_t* data, uint32_t size) { OnClientRecv(id, type, data, size); },
+                      [this](SessionId id) { ++server_closed_; },
+                  },
+                  latency),
+              session_count_(sessions),
+              room_size_(roomSize),
+              rng_(seed),
+              clients_(sessions + 1) // 세션 ID는 1부터 접속 순서대로
+        {
+        }
+
+        void Run(size_t rounds)
+        {
+            Phase("connect", [this]()
+            {
+                ScheduleProbes(CONNECT_WINDOW);
+                for (size_t i = 0; i < session_count_; ++i)
+                    clock_.Schedule(RandomDelay(CONNECT_WINDOW), [this]() { transport_.Connect(); });
+            });
+
+            Phase("rooms", [this]()
+            {
+                AssignGroups();
+                for (uint32_t g = 0; g < groups_.size(); ++g)
+                {
+                    SessionId owner = groups_[g].front();
+                    yiso::game::C2S_CreateRoom req;
+                    req.set_room_name("room-" + std::to_string(g));
+                    SendAt(RandomDelay(ROOM_WINDOW), owner, PacketType::C2S_CREATE_ROOM, req);
+                }
+            });
+
+            for (size_t round = 0; round < rounds; ++round)
+            {
+                std::string name = "chat " + std::to_string(round + 1);
+                Phase(name.c_str(), [this, round]() { ScheduleChatRound(round); });
+            }
+
+            Phase("disconnect", [this]()
+            {
+                ScheduleProbes(DISCONNECT_WINDOW);
+                for (SessionId id = 1; id <= session_count_; ++id)
+                    clock_.Schedule(RandomDelay(DISCONNECT_WINDOW), [this, id]() { transport_.ClientClose(id); });
+            });
+
+            // 세션별 digest를 ID 순서로 합침 -> 세션 사이의 전달 순서(해시맵 순회 순서)와 무관하게 세션별 수신 순서만 반영
+            uint64_t digest = FNV_OFFSET;
+            uint64_t frames = 0;
+            for (SessionId id = 1; id <= session_count_; ++id)
+            {
+                digest = Fnv(digest, &clients_[id].digest, sizeof(uint64_t));
+                frames += clients_[id].frames;
+            }
+            auto stats = transport_.GetStats();
+            std::printf("[Sim] total cpu=%.0fms sim_time=%.1fs tasks=%llu c2s=%llu s2c=%llu dropped=%llu rooms=%zu open=%zu server_closed=%llu\n",
+                total_cpu_ms_, std::chrono::duration<double>(clock_.Now()).count(),
+                static_cast<unsigned long long>(clock_.Executed()),
+                static_cast<unsigned long long>(stats.c2s_frames), static_cast<unsigned long long>(stats.s2c_frames),
+                static_cast<unsigned long long>(stats.dropped_frames), rooms_created_, sessions_.Count(),
+                static_cast<unsigned long long>(server_closed_));
+            std::printf("[Sim] digest=%016llx (client frames=%llu)\n", static_cast<unsigned long long>(digest), static_cast<unsigned long long>(frames));
+        }
+
+    private:
+        static OverloadController::Config OverloadConfig()
+        {
+            OverloadController::Config config;
+            config.sessions_elevated = PRESENCE_SESSIONS;
+            config.sessions_critical = SIZE_MAX; // 방 생성/입장은 거절하지 않음
+            return config;
+        }
+
+        // 표준 분포 클래스는 구현마다 결과가 달라 시드 재현이 안 됨 -> mt19937_64 출력(표준이 고정)을 직접 나눔
+        uint64_t Random(uint64_t bound) { return bound == 0 ? 0 : rng_() % bound; }
+        Duration RandomDelay(Duration window) { return Duration(static_cast<Duration::rep>(Random(static_cast<uint64_t>(window.count())))); }
+
+        template<typename F>
+        void Phase(const char* name, F schedule)
+        {
+            auto before = transport_.GetStats();
+            uint64_t tasksBefore = clock_.Executed();
+            auto wallBegin = Clock::now();
+            std::clock_t cpuBegin = std::clock();
+
+            schedule();
+            clock_.RunUntilIdle();
+
+            double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuBegin) / CLOCKS_PER_SEC;
+            double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - wallBegin).count();
+            total_cpu_ms_ += cpuMs;
+            auto after = transport_.GetStats();
+            uint64_t s2c = after.s2c_frames - before.s2c_frames;
+            std::printf("[Sim] %-11s cpu=%8.1fms wall=%8.1fms tasks=%9llu c2s=%8llu s2c=%10llu (%.2fM s2c/cpu-s) sessions=%zu level=%s\n",
+                name, cpuMs, wallMs,
+                static_cast<unsigned long long>(clock_.Executed() - tasksBefore),
+                static_cast<unsigned long long>(after.c2s_frames - before.c2s_frames),
+                static_cast<unsigned long long>(s2c),
+                cpuMs > 0 ? static_cast<double>(s2c) / cpuMs / 1000.0 : 0.0,
+                sessions_.Count(), OverloadController::LevelName(overload_.GetLevel()));
+        }
+
+        // 서버의 100ms 과부하 판정을 가상 시계로 (세션 수에 따라 접속/퇴장 알림 버림)
+        void ScheduleProbes(Duration window)
+        {
+            for (Duration at = Duration::zero(); at <= window; at += OverloadController::PROBE_INTERVAL)
+                clock_.Schedule(at, [this]() { overload_.ProbeNow(); });
+        }
+
+        void SendAt(Duration delay, SessionId id, PacketType type, const google::protobuf::Message& msg)
+        {
+            clock_.Schedule(delay, [this, id, frame = PacketCodec::Encode(type, msg)]() mutable
+            {
+                transport_.ClientSend(id, std::move(frame));
+            });
+        }
+
+        // 세션을 시드 순서로 섞어 room_size씩 묶음 (첫 번째가 방장)
+        void AssignGroups()
+        {
+            std::vector<SessionId> order(session_count_);
+            for (size_t i = 0; i < session_count_; ++i)
+                order[i] = static_cast<SessionId>(i + 1);
+            for (size_t i = order.size(); i > 1; --i)
+                std::swap(order[i - 1], order[Random(i)]);
+
+            for (size_t begin = 0; begin < order.size(); begin += room_size_)
+            {
+                size_t end = std::min(order.size(), begin + room_size_);
+                groups_.emplace_back(order.begin() + static_cast<std::ptrdiff_t>(begin), order.begin() + static_cast<std::ptrdiff_t>(end));
+                for (size_t i = begin; i < end; ++i)
+                    clients_[order[i]].group = static_cast<uint32_t>(groups_.size() - 1);
+            }
+        }
+
+        void ScheduleChatRound(size_t round)
+        {
+            for (SessionId id = 1; id <= session_count_; ++id)
+            {
+                if (clients_[id].room_id != 0)
+                {
+                    yiso::game::C2S_RoomChat req;
+                    req.set_room_id(clients_[id].room_id);
+                    req.set_message("r" + std::to_string(round) + " from " + std::to_string(id));
+                    SendAt(RandomDelay(ROUND_WINDOW), id, PacketType::C2S_ROOM_CHAT, req);
+                }
+                if (Random(100) < WHISPER_PERCENT)
+                {
+                    yiso::game::C2S_Whisper req;
+                    req.set_target_session_id(static_cast<SessionId>(1 + Random(session_count_)));
+                    req.set_message("psst " + std::to_string(id));
+                    SendAt(RandomDelay(ROUND_WINDOW), id, PacketType::C2S_WHISPER, req);
+                }
+            }
+            for (uint64_t i = 0; i < GLOBAL_PER_ROUND; ++i)
+            {
+                yiso::game::C2S_Chat req;
+                req.set_message("global r" + std::to_string(round));
+                SendAt(RandomDelay(ROUND_WINDOW), static_cast<SessionId>(1 + Random(session_count_)), PacketType::C2S_CHAT, req);
+            }
+        }
+
+        void OnClientRecv(SessionId id, PacketType type, const uint8_t* data, uint32_t size)
+        {
+            Client& client = clients_[id];
+            auto rawType = static_cast<uint16_t>(type);
+            client.digest = Fnv(client.digest, &rawType, sizeof(rawType));
+            client.digest = Fnv(client.digest, data, size);
+            ++client.frames;
+
+            if (type == PacketType::S2C_CREATE_ROOM)
+            {
+                yiso::game::S2C_CreateRoom msg;
+                if (!msg.ParseFromArray(data, static_cast<int>(size)) || !msg.success()) return;
+                client.room_id = msg.room_id();
+                ++rooms_created_;
+                // 방이 생기면 같은 그룹 멤버들이 들어옴
+                for (SessionId member : groups_[client.group])
+                {
+                    if (member == id) continue;
+                    yiso::game::C2S_JoinRoom req;
+                    req.set_room_id(msg.room_id());
+                    SendAt(RandomDelay(JOIN_SPREAD), member, PacketType::C2S_JOIN_ROOM, req);
+                }
+            }
+            else if (type == PacketType::S2C_JOIN_ROOM)
+            {
+                yiso::game::S2C_JoinRoom msg;
+                if (msg.ParseFromArray(data, static_cast<int>(size)) && msg.success() && msg.joined_session() == id)
+                    client.room_id = msg.room_id();
+            }
+        }
+
+        SimClock clock_;
+        boost::asio::io_context io_; // OverloadController 타이머용 (돌리지 않음 -> ProbeNow로만 판정)
+        YisoSessionManager sessions_;
+        OverloadController overload_;
+        Yiso::Game::ChatHandler chat_;
+        LoopbackTransport transport_;
+
+        size_t session_count_;
+        size_t room_size_;
+        std::mt19937_64 rng_;
+        std::vector<Client> clients_;
+        std::vector<std::vector<SessionId>> groups_;
+        size_t rooms_created_ = 0;
+        uint64_t server_closed_ = 0;
+        double total_cpu_ms_ = 0.0;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    if (argc > 1 && std::string(argv[1]) == "wire")
+    {
+        spdlog::set_level(spdlog::level::warn);
+        return RunWireCheck(static_cast<uint16_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 17778));
+    }
+
+    size_t sessions = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    size_t roomSize = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+    size_t rounds = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5;
+    uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+    long long latencyUs = argc > 5 ? std::atoll(argv[5]) : 200;
+    if (sessions == 0 || roomSize == 0 || latencyUs < 0)
+    {
+        std::cerr << "usage: Yiso.Simulator [sessions] [room_size] [rounds] [seed] [latency_us]\n";
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::warn); // 세션마다 찍는 접속/종료 로그 생략
+    std::printf("[Sim] sessions=%zu room_size=%zu rounds=%zu seed=%llu latency=%lldus\n",
+        sessions, roomSize, rounds, static_cast<unsigned long long>(seed), latencyUs);
+
+    Simulator simulator(sessions, roomSize, std::chrono::microseconds(latencyUs), seed);
+    simulator.Run(rounds);
+    return 0;
+}